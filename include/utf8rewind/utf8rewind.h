@@ -92,13 +92,13 @@
 	\def UTF8_VERSION_MINOR
 	\brief The minor version number of this release.
 */
-#define UTF8_VERSION_MINOR   5
+#define UTF8_VERSION_MINOR   6
 
 /*!
 	\def UTF8_VERSION_BUGFIX
 	\brief The bugfix version number of this release.
 */
-#define UTF8_VERSION_BUGFIX  1
+#define UTF8_VERSION_BUGFIX  0
 
 /*!
 	\def UTF8_VERSION
@@ -111,7 +111,7 @@
 	\def UTF8_VERSION_STRING
 	\brief The verion number as a string.
 */
-#define UTF8_VERSION_STRING  "1.5.1"
+#define UTF8_VERSION_STRING  "1.6.0"
 
 /*!
 	\def UTF8_VERSION_GUARD
@@ -165,6 +165,18 @@
 */
 #define UTF8_ERR_INVALID_LOCALE                 (-5)
 
+/*!
+	\def UTF8_ERR_DATABASE_UNAVAILABLE
+	\brief Database file could not be opened or mapped into memory.
+*/
+#define UTF8_ERR_DATABASE_UNAVAILABLE           (-6)
+
+/*!
+	\def UTF8_ERR_OUT_OF_MEMORY
+	\brief Memory for the result could not be allocated.
+*/
+#define UTF8_ERR_OUT_OF_MEMORY                  (-7)
+
 /*!
 	\}
 */
@@ -663,6 +675,80 @@
 	#error Invalid size for wchar_t type.
 #endif
 
+/*!
+	\def UTF8_EXCLUDE_NFC
+	\brief Configuration macros for leaving Unicode data out of the library.
+
+	When the library is built with one of the `UTF8_EXCLUDE_*` macros set to
+	1, the tables used only by that feature are not compiled in. The affected
+	function, including its variants ending in `_ex`, `_alloc` and
+	`_inplace`, fails with #UTF8_ERR_INVALID_FLAG instead. This error is
+	returned before the parameters are validated, so an excluded function
+	never reads or writes its buffers, even when they are NULL. Tables shared by
+	features are kept as long as one of them is included, e.g. the
+	lowercase table is needed by both #utf8tolower and #utf8totitle.
+
+	The macros must be set on the command line of the library build, see
+	the `utf8_exclude` variable in `utf8rewind.gyp`.
+
+	Macro                      | Feature
+	-------------------------- | ------------------------------------------------
+	`UTF8_EXCLUDE_NFC`         | Normalization Form C (NFC) with #utf8normalize
+	`UTF8_EXCLUDE_NFD`         | Normalization Form D (NFD) with #utf8normalize
+	`UTF8_EXCLUDE_NFKC`        | Normalization Form KC (NFKC) with #utf8normalize
+	`UTF8_EXCLUDE_NFKD`        | Normalization Form KD (NFKD) with #utf8normalize
+	`UTF8_EXCLUDE_UPPERCASE`   | #utf8toupper
+	`UTF8_EXCLUDE_LOWERCASE`   | #utf8tolower
+	`UTF8_EXCLUDE_TITLECASE`   | #utf8totitle
+	`UTF8_EXCLUDE_CASEFOLDING` | #utf8casefold
+*/
+
+#ifndef UTF8_EXCLUDE_NFC
+	#define UTF8_EXCLUDE_NFC (0)
+#endif
+
+#ifndef UTF8_EXCLUDE_NFD
+	#define UTF8_EXCLUDE_NFD (0)
+#endif
+
+#ifndef UTF8_EXCLUDE_NFKC
+	#define UTF8_EXCLUDE_NFKC (0)
+#endif
+
+#ifndef UTF8_EXCLUDE_NFKD
+	#define UTF8_EXCLUDE_NFKD (0)
+#endif
+
+#ifndef UTF8_EXCLUDE_UPPERCASE
+	#define UTF8_EXCLUDE_UPPERCASE (0)
+#endif
+
+#ifndef UTF8_EXCLUDE_LOWERCASE
+	#define UTF8_EXCLUDE_LOWERCASE (0)
+#endif
+
+#ifndef UTF8_EXCLUDE_TITLECASE
+	#define UTF8_EXCLUDE_TITLECASE (0)
+#endif
+
+#ifndef UTF8_EXCLUDE_CASEFOLDING
+	#define UTF8_EXCLUDE_CASEFOLDING (0)
+#endif
+
+/*!
+	\def UTF8_DISABLE_SIMD
+	\brief Build the library without SSE2 and AVX2 code paths.
+
+	By default, functions like #utf8validate use SSE2 when the compiler
+	targets it and select AVX2 at runtime when the processor supports it.
+	Set this macro to 1 on the command line of the library build to use only
+	the portable implementation.
+*/
+
+#ifndef UTF8_DISABLE_SIMD
+	#define UTF8_DISABLE_SIMD (0)
+#endif
+
 /*!
 	\def UTF8_API
 	\brief Calling convention for public functions.
@@ -697,6 +783,202 @@ typedef uint16_t utf16_t;
 */
 typedef uint32_t unicode_t;
 
+/*!
+	\brief Result of a resumable transformation.
+
+	Returned by the functions ending in `_ex`. When the target buffer is too
+	small, the transformation stops on a position in the input where it can
+	be resumed. Calling the same function again for the remaining input
+	produces the same output as transforming the whole input at once.
+
+	Example:
+
+	\code{.c}
+		uint8_t File_WriteUtf16(FILE* file, const char* input, size_t inputSize)
+		{
+			utf16_t buffer[256];
+			utf8result_t result;
+
+			while (inputSize > 0)
+			{
+				result = utf8toutf16_ex(input, inputSize, buffer, sizeof(buffer));
+				if ((result.error != UTF8_ERR_NONE && result.error != UTF8_ERR_NOT_ENOUGH_SPACE) ||
+					result.consumed == 0)
+				{
+					return 0;
+				}
+
+				fwrite(buffer, 1, result.produced, file);
+
+				input += result.consumed;
+				inputSize -= result.consumed;
+			}
+
+			return 1;
+		}
+	\endcode
+*/
+typedef struct {
+	size_t consumed; /*!< Amount of input bytes that were transformed. */
+	size_t produced; /*!< Amount of bytes written for the consumed input. */
+	int32_t error; /*!< Error code, see \ref errors. */
+} utf8result_t;
+
+/*!
+	\brief Memory allocation callbacks.
+
+	Used by the functions ending in `_alloc` to allocate their result. The
+	context is passed to every callback, which makes it possible to
+	allocate from an arena instead of the heap. When `reallocate` is NULL,
+	a new block is allocated and the result is copied to it instead. When
+	`deallocate` is NULL, blocks are never freed by the library.
+
+	Example:
+
+	\code{.c}
+		typedef struct {
+			char* data;
+			size_t used;
+			size_t capacity;
+		} Arena;
+
+		void* Arena_Allocate(void* context, size_t size)
+		{
+			Arena* arena = (Arena*)context;
+			void* memory;
+
+			if (size > arena->capacity - arena->used)
+			{
+				return NULL;
+			}
+
+			memory = arena->data + arena->used;
+			arena->used += size;
+
+			return memory;
+		}
+
+		utf8allocator_t Arena_GetAllocator(Arena* arena)
+		{
+			utf8allocator_t allocator = { Arena_Allocate, NULL, NULL, arena };
+			return allocator;
+		}
+	\endcode
+*/
+typedef struct {
+	void* (*allocate)(void* context, size_t size); /*!< Allocates a block of memory, returns NULL on failure. */
+	void* (*reallocate)(void* context, void* memory, size_t size); /*!< Resizes a block of memory, returns NULL on failure. Can be NULL. */
+	void (*deallocate)(void* context, void* memory); /*!< Frees a block of memory. Can be NULL. */
+	void* context; /*!< Passed to every callback. */
+} utf8allocator_t;
+
+/*!
+	\brief Callback for running tasks in parallel.
+
+	Used by the functions ending in `_parallel` to convert chunks of the
+	input at the same time. The library does not create threads itself,
+	the executor hands the tasks to a thread pool of the application
+	instead.
+
+	The count passed to the executor can be larger than the concurrency,
+	because the input is split into more chunks than there are threads to
+	even out the work. The executor must queue the tasks that do not fit
+	on its threads and run them when a thread becomes available.
+
+	Example:
+
+	\code{.cpp}
+		struct Pool
+		{
+			std::vector<std::thread> workers;
+			std::mutex mutex;
+			std::condition_variable wake;
+			std::deque<std::function<void()>> queue;
+		};
+
+		void Pool_Execute(void* context, void (*task)(void* data, size_t index), void* data, size_t count)
+		{
+			Pool* pool = (Pool*)context;
+			std::mutex done_mutex;
+			std::condition_variable done;
+			size_t remaining = count;
+
+			// Queue every task, the workers of the pool take them one at a time
+
+			{
+				std::lock_guard<std::mutex> lock(pool->mutex);
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					pool->queue.push_back([&, i] {
+						task(data, i);
+
+						std::lock_guard<std::mutex> done_lock(done_mutex);
+						if (--remaining == 0)
+						{
+							done.notify_one();
+						}
+					});
+				}
+			}
+
+			pool->wake.notify_all();
+
+			std::unique_lock<std::mutex> done_lock(done_mutex);
+			done.wait(done_lock, [&] { return remaining == 0; });
+		}
+
+		utf8executor_t executor = { Pool_Execute, &pool, pool.workers.size(), 0 };
+	\endcode
+*/
+typedef struct {
+	void (*execute)(void* context, void (*task)(void* data, size_t index), void* data, size_t count); /*!< Calls the task for every index below the count and returns when all of them have finished. The count can exceed the concurrency. */
+	void* context; /*!< Passed to every call to execute. */
+	size_t concurrency; /*!< Amount of tasks that can run at the same time, usually the amount of threads of the executor. */
+	size_t chunkSize; /*!< Minimum amount of input bytes converted by a task, or 0 for the default of 1 MiB. */
+} utf8executor_t;
+
+/*!
+	\brief Position in a UTF-8 encoded string.
+
+	Keeps track of both the byte offset and the index in code points while
+	moving through a string with #utf8cursor_next, #utf8cursor_prev and
+	#utf8cursor_advance. Moving by a small amount of code points only reads
+	the bytes in between, instead of seeking from the start of the string.
+
+	The members can be read directly, but should only be modified by the
+	cursor functions.
+
+	Example:
+
+	\code{.c}
+		size_t CountSpaces(const char* text, size_t textSize)
+		{
+			utf8cursor_t cursor;
+			size_t spaces = 0;
+
+			utf8cursor_init(&cursor, text, textSize);
+
+			do
+			{
+				if (utf8cursor_codepoint(&cursor) == 0x20)
+				{
+					spaces++;
+				}
+			}
+			while (utf8cursor_next(&cursor));
+
+			return spaces;
+		}
+	\endcode
+*/
+typedef struct {
+	const char* text; /*!< Start of the string. */
+	size_t textSize; /*!< Size of the string in bytes. */
+	size_t offset; /*!< Offset of the current code point in bytes. */
+	size_t index; /*!< Offset of the current code point in code points. */
+} utf8cursor_t;
+
 /*!
 	\}
 */
@@ -722,9 +1004,82 @@ typedef uint32_t unicode_t;
 	\param[in]  text  UTF-8 encoded string.
 
 	\return Length in code points.
+
+	\sa utf8nlen
 */
 UTF8_API size_t utf8len(const char* text);
 
+/*!
+	\brief Get the length in code points of a UTF-8 encoded string of a
+	specified size.
+
+	Unlike #utf8len, the input does not have to be zero-terminated. NUL
+	bytes are counted as code points, which makes this function suitable for
+	counting the contents of files and other binary buffers. Invalid and
+	truncated sequences are counted the same way as in #utf8len.
+
+	The input is read once, using SSE2 instructions where available.
+
+	Example:
+
+	\code{.c}
+		size_t CountFile(const char* contents, size_t contentsSize)
+		{
+			return utf8nlen(contents, contentsSize);
+		}
+	\endcode
+
+	\param[in]  text      UTF-8 encoded string.
+	\param[in]  textSize  Size of the input in bytes.
+
+	\return Length in code points or 0 if the input is NULL.
+
+	\sa utf8len
+*/
+UTF8_API size_t utf8nlen(const char* text, size_t textSize);
+
+/*!
+	\brief Check if a string is valid UTF-8.
+
+	A string is valid when every sequence decodes to a code point without
+	errors. Overlong sequences, encoded surrogate pairs, code points above
+	U+10FFFF, unexpected continuation bytes and sequences that are cut off
+	by the end of the input are all invalid. These are the same sequences
+	that the conversion functions replace with U+FFFD REPLACEMENT CHARACTER.
+
+	Blocks of Basic Latin text are skipped without decoding, using SSE2 or
+	AVX2 instructions where available. Validating is therefore a lot cheaper
+	than converting the input and looking for replacement characters.
+
+	Example:
+
+	\code{.c}
+		uint8_t ReadName(const char* input, size_t inputSize)
+		{
+			size_t offset;
+
+			if (utf8validate(input, inputSize, &offset) == 0)
+			{
+				printf("Invalid byte sequence at offset %u.\n", (unsigned int)offset);
+
+				return 0;
+			}
+
+			return 1;
+		}
+	\endcode
+
+	\param[in]   input        UTF-8 encoded string.
+	\param[in]   inputSize    Size of the input in bytes.
+	\param[out]  errorOffset  Offset in bytes to the first invalid sequence or size of the input when valid. Can be NULL.
+
+	\retval 1  Input is valid UTF-8.
+	\retval 0  Input contains an invalid sequence or input is NULL while inputSize is not zero.
+
+	\sa utf8len
+*/
+UTF8_API uint8_t utf8validate(const char* input, size_t inputSize, size_t* errorOffset);
+
 /*!
 	\brief Convert a UTF-16 encoded string to a UTF-8 encoded string.
 
@@ -1064,184 +1419,997 @@ UTF8_API size_t utf8toutf32(const char* input, size_t inputSize, unicode_t* targ
 UTF8_API size_t utf8towide(const char* input, size_t inputSize, wchar_t* target, size_t targetSize, int32_t* errors);
 
 /*!
-	\brief Seek into a UTF-8 encoded string.
-
-	Working with UTF-8 encoded strings can be tricky due to the nature of the
-	variable-length encoding. Because one character no longer equals one byte,
-	it can be difficult to skip around in a UTF-8 encoded string without
-	decoding the code points.
+	\brief Get the size of a UTF-16 encoded string converted to UTF-8.
 
-	This function provides an interface similar to `fseek` in order to enable
-	skipping to another part of the string.
-
-	\note `textStart` must come before `text` in memory when seeking from the
-	current or end position.
+	Returns the same amount and error as calling #utf16toutf8 without a
+	target buffer, but only measures the output instead of encoding it.
+	Blocks of code points are measured using SSE2 instructions where
+	available, which makes this a cheap way to size a buffer before
+	converting.
 
 	Example:
 
 	\code{.c}
-		const char* text = "Press \xE0\x80\x13 to continue.";
-		const char fixed[1024];
-		const char* commandStart;
-		const char* commandEnd;
-
-		memset(fixed, 0, sizeof(fixed));
-
-		commandStart = strstr(text, "\xE0\x80\x13");
-		if (commandStart == 0)
+		char* Path_FromUtf16(const utf16_t* path, size_t pathSize)
 		{
-			return 0;
-		}
+			char* converted;
+			size_t converted_size;
+			int32_t errors;
 
-		strncpy(fixed, text, commandStart - text);
-		strcat(fixed, "ENTER");
+			converted_size = utf16toutf8_size(path, pathSize, &errors);
+			if (converted_size == 0 ||
+				errors != UTF8_ERR_NONE)
+			{
+				return NULL;
+			}
 
-		commandEnd = utf8seek(commandStart, strlen(commandStart), text, 1, SEEK_CUR);
-		if (commandEnd != commandStart)
-		{
-			strcat(fixed, commandEnd);
+			converted = (char*)malloc(converted_size + 1);
+			utf16toutf8(path, pathSize, converted, converted_size, NULL);
+			converted[converted_size] = 0;
+
+			return converted;
 		}
 	\endcode
 
-	\param[in]  text       Input string.
-	\param[in]  textSize   Size of the complete input string in bytes, starting from `textStart`.
-	\param[in]  textStart  Start of input string.
-	\param[in]  offset     Requested offset in code points.
-	\param[in]  direction  Direction to seek in.
-	\arg `SEEK_SET` Offset is from the start of the string.
-	\arg `SEEK_CUR` Offset is from the current position of the string.
-	\arg `SEEK_END` Offset is from the end of the string.
+	\param[in]   input      UTF-16 encoded string.
+	\param[in]   inputSize  Size of the input in bytes.
+	\param[out]  errors     Output for errors.
 
-	\return Pointer to offset string or no change on error.
+	\return Amount of bytes needed for storing output.
 
-	\sa utf8iscategory
+	\retval #UTF8_ERR_NONE          No errors.
+	\retval #UTF8_ERR_INVALID_DATA  Failed to decode data.
+
+	\sa utf16toutf8
+	\sa widetoutf8_size
 */
-UTF8_API const char* utf8seek(const char* text, size_t textSize, const char* textStart, off_t offset, int direction);
+UTF8_API size_t utf16toutf8_size(const utf16_t* input, size_t inputSize, int32_t* errors);
 
 /*!
-	\brief Returns the environment's locale as an enum value.
-
-	This function retrieves the (thread-local) environment locale as an enum
-	value in the \ref locales "list of locales". This value can be used with
-	functions in this library that change behavior on certain inputs, depending
-	on the specified locale.
+	\brief Get the size of a UTF-32 encoded string converted to UTF-8.
 
-	Unfortunately, no cross-platform way of setting and retrieving the system
-	locale is available without adding dependencies to the library. Please refer
-	to your operating system's manual to determine how to setup the system
-	locale on your target system.
+	Returns the same amount and error as calling #utf32toutf8 without a target
+	buffer, but only measures the output instead of encoding it. Blocks of
+	code points are measured using SSE2 instructions where available.
 
-	\warning This function should not be used as a replacement for platform-
-	specific methods for retrieving the locale. Its intended usage is to
-	"guess" the desired locale by looking at the system locale.
+	\param[in]   input      UTF-32 encoded string.
+	\param[in]   inputSize  Size of the input in bytes.
+	\param[out]  errors     Output for errors.
 
-	Example:
+	\return Amount of bytes needed for storing output.
 
-	\code{.c}
-		uint8_t Employee_PrintNames(const char** names, size_t nameCount)
-		{
-			size_t locale = utf8envlocale();
-			char buffer[256];
-			size_t buffer_size = 255;
-			int32_t errors;
-			size_t i;
+	\retval #UTF8_ERR_NONE          No errors.
+	\retval #UTF8_ERR_INVALID_DATA  Failed to decode data.
 
-			for (i = 0; i < nameCount; ++i)
-			{
-				size_t buffer_filled;
+	\sa utf32toutf8
+	\sa widetoutf8_size
+*/
+UTF8_API size_t utf32toutf8_size(const unicode_t* input, size_t inputSize, int32_t* errors);
 
-				memset(buffer, 0, buffer_size);
+/*!
+	\brief Get the size of a wide string converted to UTF-8.
 
-				if ((buffer_filled = utf8toupper(names[i], strlen(names[i]), buffer, buffer_size, locale, &errors)) == 0 ||
-					errors != UTF8_ERR_NONE)
-				{
-					return 0;
-				}
+	Returns the same amount and error as calling #widetoutf8 without a target
+	buffer, but only measures the output instead of encoding it. Calls
+	either #utf16toutf8_size or #utf32toutf8_size, depending on the platform.
 
-				Log_Print(buffer, buffer_filled);
-			}
+	\param[in]   input      Wide-encoded string.
+	\param[in]   inputSize  Size of the input in bytes.
+	\param[out]  errors     Output for errors.
 
-			return 1;
-		}
-	\endcode
+	\return Amount of bytes needed for storing output.
 
-	\return A specific \ref locales "locale" or #UTF8_LOCALE_DEFAULT.
+	\retval #UTF8_ERR_NONE          No errors.
+	\retval #UTF8_ERR_INVALID_DATA  Failed to decode data.
 
-	\sa utf8toupper
-	\sa utf8tolower
-	\sa utf8totitle
-	\sa utf8casefold
+	\sa widetoutf8
+	\sa utf8towide_size
+*/
+UTF8_API size_t widetoutf8_size(const wchar_t* input, size_t inputSize, int32_t* errors);
+
+/*!
+	\brief Get the size of a UTF-8 encoded string converted to UTF-16.
+
+	Returns the same amount and error as calling #utf8toutf16 without a target
+	buffer, but only measures the output instead of encoding it. Valid
+	parts of the input are measured by counting bytes after validating them
+	with #utf8validate, so only invalid sequences are decoded.
+
+	\param[in]   input      UTF-8 encoded string.
+	\param[in]   inputSize  Size of the input in bytes.
+	\param[out]  errors     Output for errors.
+
+	\return Amount of bytes needed for storing output.
+
+	\retval #UTF8_ERR_NONE          No errors.
+	\retval #UTF8_ERR_INVALID_DATA  Failed to decode data.
+
+	\sa utf8toutf16
+	\sa utf8towide_size
+*/
+UTF8_API size_t utf8toutf16_size(const char* input, size_t inputSize, int32_t* errors);
+
+/*!
+	\brief Get the size of a UTF-8 encoded string converted to UTF-32.
+
+	Returns the same amount and error as calling #utf8toutf32 without a target
+	buffer, but only measures the output instead of encoding it. Valid
+	parts of the input are measured by counting bytes after validating them
+	with #utf8validate, so only invalid sequences are decoded.
+
+	\param[in]   input      UTF-8 encoded string.
+	\param[in]   inputSize  Size of the input in bytes.
+	\param[out]  errors     Output for errors.
+
+	\return Amount of bytes needed for storing output.
+
+	\retval #UTF8_ERR_NONE          No errors.
+	\retval #UTF8_ERR_INVALID_DATA  Failed to decode data.
+
+	\sa utf8toutf32
+	\sa utf8towide_size
+*/
+UTF8_API size_t utf8toutf32_size(const char* input, size_t inputSize, int32_t* errors);
+
+/*!
+	\brief Get the size of a UTF-8 encoded string converted to a wide string.
+
+	Returns the same amount and error as calling #utf8towide without a target
+	buffer, but only measures the output instead of encoding it. Calls
+	either #utf8toutf16_size or #utf8toutf32_size, depending on the
+	platform.
+
+	\param[in]   input      UTF-8 encoded string.
+	\param[in]   inputSize  Size of the input in bytes.
+	\param[out]  errors     Output for errors.
+
+	\return Amount of bytes needed for storing output.
+
+	\retval #UTF8_ERR_NONE          No errors.
+	\retval #UTF8_ERR_INVALID_DATA  Failed to decode data.
+
+	\sa utf8towide
+	\sa widetoutf8_size
+*/
+UTF8_API size_t utf8towide_size(const char* input, size_t inputSize, int32_t* errors);
+
+/*!
+	\brief Convert a UTF-16 encoded string to UTF-8 and report how much of the input was consumed.
+
+	Behaves like #utf16toutf8, but the result also holds the amount of input
+	bytes that were converted. When the target buffer is too small, the
+	conversion stops before the first code point that does not fit and
+	can be resumed from there with a new buffer. Surrogate pairs are
+	never split.
+
+	\param[in]   input       UTF-16 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+
+	\return Input bytes consumed, output bytes produced and the error.
+
+	\sa widetoutf8_ex
+	\sa utf8result_t
+*/
+UTF8_API utf8result_t utf16toutf8_ex(const utf16_t* input, size_t inputSize, char* target, size_t targetSize);
+
+/*!
+	\brief Convert a UTF-32 encoded string to UTF-8 and report how much of the input was consumed.
+
+	Behaves like #utf32toutf8, but the result also holds the amount of input
+	bytes that were converted. When the target buffer is too small, the
+	conversion stops before the first code point that does not fit and
+	can be resumed from there with a new buffer. Surrogate pairs are
+	never split.
+
+	\param[in]   input       UTF-32 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+
+	\return Input bytes consumed, output bytes produced and the error.
+
+	\sa widetoutf8_ex
+	\sa utf8result_t
+*/
+UTF8_API utf8result_t utf32toutf8_ex(const unicode_t* input, size_t inputSize, char* target, size_t targetSize);
+
+/*!
+	\brief Convert a wide string to UTF-8 and report how much of the input was consumed.
+
+	Behaves like #widetoutf8, but the result also holds the amount of input
+	bytes that were converted. When the target buffer is too small, the
+	conversion stops before the first code point that does not fit and
+	can be resumed from there with a new buffer. Surrogate pairs are
+	never split.
+
+	\param[in]   input       Wide-encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+
+	\return Input bytes consumed, output bytes produced and the error.
+
+	\sa utf8towide_ex
+	\sa utf8result_t
+*/
+UTF8_API utf8result_t widetoutf8_ex(const wchar_t* input, size_t inputSize, char* target, size_t targetSize);
+
+/*!
+	\brief Convert a UTF-8 encoded string to UTF-16 and report how much of the input was consumed.
+
+	Behaves like #utf8toutf16, but the result also holds the amount of input
+	bytes that were converted. When the target buffer is too small, the
+	conversion stops before the first code point that does not fit and
+	can be resumed from there with a new buffer. Surrogate pairs are
+	never split.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+
+	\return Input bytes consumed, output bytes produced and the error.
+
+	\sa utf8towide_ex
+	\sa utf8result_t
+*/
+UTF8_API utf8result_t utf8toutf16_ex(const char* input, size_t inputSize, utf16_t* target, size_t targetSize);
+
+/*!
+	\brief Convert a UTF-8 encoded string to UTF-32 and report how much of the input was consumed.
+
+	Behaves like #utf8toutf32, but the result also holds the amount of input
+	bytes that were converted. When the target buffer is too small, the
+	conversion stops before the first code point that does not fit and
+	can be resumed from there with a new buffer. Surrogate pairs are
+	never split.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+
+	\return Input bytes consumed, output bytes produced and the error.
+
+	\sa utf8towide_ex
+	\sa utf8result_t
+*/
+UTF8_API utf8result_t utf8toutf32_ex(const char* input, size_t inputSize, unicode_t* target, size_t targetSize);
+
+/*!
+	\brief Convert a UTF-8 encoded string to a wide string and report how much of the input was consumed.
+
+	Behaves like #utf8towide, but the result also holds the amount of input
+	bytes that were converted. When the target buffer is too small, the
+	conversion stops before the first code point that does not fit and
+	can be resumed from there with a new buffer. Surrogate pairs are
+	never split.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+
+	\return Input bytes consumed, output bytes produced and the error.
+
+	\sa widetoutf8_ex
+	\sa utf8result_t
+*/
+UTF8_API utf8result_t utf8towide_ex(const char* input, size_t inputSize, wchar_t* target, size_t targetSize);
+
+/*!
+	\brief Convert a large UTF-16 encoded string to UTF-8 on multiple threads.
+
+	Behaves like #utf16toutf8, but the input is split into chunks that are
+	converted by the tasks of the executor. Chunks never start inside a
+	surrogate pair, so the output and the errors are the same as when the
+	input is converted in one go. The output size of every chunk is
+	measured first, after which the chunks are converted to their offset in
+	the target.
+
+	Input that is smaller than twice the chunk size is converted on the
+	calling thread, as is all input when the executor is NULL or cannot run
+	more than one task at a time.
+
+	\param[in]   input       UTF-16 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+	\param[in]   executor    Runs the tasks in parallel, can be NULL to convert on the calling thread.
+	\param[out]  errors      Output for errors.
+
+	\return Amount of bytes written to the output buffer.
+
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_OVERLAPPING_PARAMETERS  Input and output buffers overlap in memory.
+	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        Target buffer size is insufficient for result.
+
+	\sa utf16toutf8
+	\sa utf8executor_t
+*/
+UTF8_API size_t utf16toutf8_parallel(const utf16_t* input, size_t inputSize, char* target, size_t targetSize, const utf8executor_t* executor, int32_t* errors);
+
+/*!
+	\brief Convert a large UTF-8 encoded string to UTF-16 on multiple threads.
+
+	Behaves like #utf8toutf16, but the input is split into chunks that are
+	converted by the tasks of the executor. Chunks never start inside a
+	UTF-8 encoded sequence, so the output and the errors are the same as
+	when the input is converted in one go. The output size of every chunk is
+	measured first, after which the chunks are converted to their offset in
+	the target.
+
+	Input that is smaller than twice the chunk size is converted on the
+	calling thread, as is all input when the executor is NULL or cannot run
+	more than one task at a time.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+	\param[in]   executor    Runs the tasks in parallel, can be NULL to convert on the calling thread.
+	\param[out]  errors      Output for errors.
+
+	\return Amount of bytes written to the output buffer.
+
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_OVERLAPPING_PARAMETERS  Input and output buffers overlap in memory.
+	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        Target buffer size is insufficient for result.
+
+	\sa utf8toutf16
+	\sa utf8executor_t
+*/
+UTF8_API size_t utf8toutf16_parallel(const char* input, size_t inputSize, utf16_t* target, size_t targetSize, const utf8executor_t* executor, int32_t* errors);
+
+/*!
+	\brief Seek into a UTF-8 encoded string.
+
+	Working with UTF-8 encoded strings can be tricky due to the nature of the
+	variable-length encoding. Because one character no longer equals one byte,
+	it can be difficult to skip around in a UTF-8 encoded string without
+	decoding the code points.
+
+	This function provides an interface similar to `fseek` in order to enable
+	skipping to another part of the string.
+
+	Seeking over large offsets skips blocks of 16 bytes at a time by counting
+	the bytes that start a code point, using SSE2 instructions where
+	available. Only the last block is stepped through one sequence at a time.
+
+	\note `textStart` must come before `text` in memory when seeking from the
+	current or end position.
+
+	Example:
+
+	\code{.c}
+		const char* text = "Press \xE0\x80\x13 to continue.";
+		const char fixed[1024];
+		const char* commandStart;
+		const char* commandEnd;
+
+		memset(fixed, 0, sizeof(fixed));
+
+		commandStart = strstr(text, "\xE0\x80\x13");
+		if (commandStart == 0)
+		{
+			return 0;
+		}
+
+		strncpy(fixed, text, commandStart - text);
+		strcat(fixed, "ENTER");
+
+		commandEnd = utf8seek(commandStart, strlen(commandStart), text, 1, SEEK_CUR);
+		if (commandEnd != commandStart)
+		{
+			strcat(fixed, commandEnd);
+		}
+	\endcode
+
+	\param[in]  text       Input string.
+	\param[in]  textSize   Size of the complete input string in bytes, starting from `textStart`.
+	\param[in]  textStart  Start of input string.
+	\param[in]  offset     Requested offset in code points.
+	\param[in]  direction  Direction to seek in.
+	\arg `SEEK_SET` Offset is from the start of the string.
+	\arg `SEEK_CUR` Offset is from the current position of the string.
+	\arg `SEEK_END` Offset is from the end of the string.
+
+	\return Pointer to offset string or no change on error.
+
+	\sa utf8iscategory
+*/
+UTF8_API const char* utf8seek(const char* text, size_t textSize, const char* textStart, off_t offset, int direction);
+
+/*!
+	\brief Build an index of code point offsets for seeking in a string.
+
+	Seeking from the start of a string with #utf8seek has to step over every
+	code point before the requested offset. The index built by this function
+	records the byte offset of every `interval`th code point, so
+	#utf8seek_indexed can jump to the nearest checkpoint and only step over
+	the remainder.
+
+	The index is a flat array of `size_t` values without pointers:
+
+	\arg index[0] The interval between checkpoints in code points.
+	\arg index[1] The size of the indexed string in bytes.
+	\arg index[n + 2] Byte offset of code point `(n + 1) * interval`.
+
+	This means it can be written to disk next to the text and read back on
+	a platform with the same size of `size_t`. The index stays valid until
+	the text is modified.
+
+	Call this function without a target buffer to get the amount of bytes
+	needed for the index. No more than
+	`(textSize / interval + 2) * sizeof(size_t)` bytes are needed, so a
+	buffer of that size can be allocated up front to avoid reading the text
+	twice.
+
+	Example:
+
+	\code{.c}
+		size_t* build_index(const char* text, size_t textSize, size_t* indexSize)
+		{
+			size_t* index;
+			int32_t errors;
+
+			*indexSize = utf8seekindex(text, textSize, 256, NULL, 0, &errors);
+			if (errors != UTF8_ERR_NONE)
+			{
+				return NULL;
+			}
+
+			index = (size_t*)malloc(*indexSize);
+
+			utf8seekindex(text, textSize, 256, index, *indexSize, NULL);
+
+			return index;
+		}
+
+		const char* codepoint_at(const char* text, size_t textSize, const size_t* index, size_t indexSize, off_t codepoint)
+		{
+			return utf8seek_indexed(text, textSize, text, codepoint, SEEK_SET, index, indexSize);
+		}
+	\endcode
+
+	\param[in]   text        Input string.
+	\param[in]   textSize    Size of the input string in bytes.
+	\param[in]   interval    Amount of code points between checkpoints, 0 uses 1024.
+	\param[out]  target      Output buffer for the index.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+	\param[out]  errors      Output for errors.
+
+	\return Amount of bytes needed for storing the index.
+
+	\retval #UTF8_ERR_NONE              No errors.
+	\retval #UTF8_ERR_INVALID_DATA      Input does not point to a string.
+	\retval #UTF8_ERR_NOT_ENOUGH_SPACE  Target buffer could not contain the whole index.
+
+	\sa utf8seek_indexed
+*/
+UTF8_API size_t utf8seekindex(const char* text, size_t textSize, size_t interval, size_t* target, size_t targetSize, int32_t* errors);
+
+/*!
+	\brief Seek into a string using an index of code point offsets.
+
+	Returns the same result as #utf8seek, but seeking from the start of the
+	string with `SEEK_SET` starts from the closest checkpoint in an index
+	built by #utf8seekindex. This turns random access into a large string
+	from stepping over every code point before the offset into a lookup and
+	a scan of at most `interval` code points.
+
+	Seeking with `SEEK_CUR` and `SEEK_END` does not use the index. When the
+	index is missing, or when it was built for a string of a different
+	size, the function behaves exactly like #utf8seek.
+
+	\param[in]  text       Input string.
+	\param[in]  textSize   Size of the complete input string in bytes, starting from `textStart`.
+	\param[in]  textStart  Start of input string.
+	\param[in]  offset     Requested offset in code points.
+	\param[in]  direction  Direction to seek in.
+	\arg `SEEK_SET` Offset is from the start of the string.
+	\arg `SEEK_CUR` Offset is from the current position of the string.
+	\arg `SEEK_END` Offset is from the end of the string.
+	\param[in]  index      Index built by #utf8seekindex for the string at `textStart`.
+	\param[in]  indexSize  Size of the index in bytes.
+
+	\return Pointer to offset string or no change on error.
+
+	\sa utf8seek
+	\sa utf8seekindex
+*/
+UTF8_API const char* utf8seek_indexed(const char* text, size_t textSize, const char* textStart, off_t offset, int direction, const size_t* index, size_t indexSize);
+
+/*!
+	\brief Place a cursor at the start of a UTF-8 encoded string.
+
+	\param[out]  cursor    Cursor to initialize.
+	\param[in]   text      Input string.
+	\param[in]   textSize  Size of the input string in bytes.
+
+	\sa utf8cursor_t
+*/
+UTF8_API void utf8cursor_init(utf8cursor_t* cursor, const char* text, size_t textSize);
+
+/*!
+	\brief Move a cursor to the next code point.
+
+	Code points are counted the same way as in #utf8seek, so a cursor moved
+	by a number of code points ends up at the same position.
+
+	\param[in,out]  cursor  Cursor to move.
+
+	\return 1 when the cursor was moved or 0 when it was already at the end
+	of the string.
+
+	\sa utf8cursor_prev
+	\sa utf8cursor_advance
+*/
+UTF8_API uint8_t utf8cursor_next(utf8cursor_t* cursor);
+
+/*!
+	\brief Move a cursor to the previous code point.
+
+	Only the bytes of the previous code point are read, no matter how long
+	the string is.
+
+	\param[in,out]  cursor  Cursor to move.
+
+	\return 1 when the cursor was moved or 0 when it was already at the
+	start of the string.
+
+	\sa utf8cursor_next
+	\sa utf8cursor_advance
+*/
+UTF8_API uint8_t utf8cursor_prev(utf8cursor_t* cursor);
+
+/*!
+	\brief Move a cursor by an amount of code points.
+
+	A positive offset moves towards the end of the string and a negative
+	offset towards the start. The cursor stops at either end of the string.
+	Large offsets skip blocks of text the same way as #utf8seek.
+
+	\param[in,out]  cursor  Cursor to move.
+	\param[in]      offset  Amount of code points to move by.
+
+	\return Amount of code points the cursor was moved by, which is smaller
+	than the offset when the cursor stopped at the end or start of the
+	string.
+
+	\sa utf8cursor_next
+	\sa utf8cursor_prev
+*/
+UTF8_API off_t utf8cursor_advance(utf8cursor_t* cursor, off_t offset);
+
+/*!
+	\brief Decode the code point at the position of a cursor.
+
+	Invalid and truncated sequences are decoded as U+FFFD REPLACEMENT
+	CHARACTER.
+
+	\param[in]  cursor  Cursor to read from.
+
+	\return Decoded code point or 0 when the cursor is at the end of the
+	string.
+*/
+UTF8_API unicode_t utf8cursor_codepoint(const utf8cursor_t* cursor);
+
+/*!
+	\brief Returns the environment's locale as an enum value.
+
+	This function retrieves the (thread-local) environment locale as an enum
+	value in the \ref locales "list of locales". This value can be used with
+	functions in this library that change behavior on certain inputs, depending
+	on the specified locale.
+
+	Unfortunately, no cross-platform way of setting and retrieving the system
+	locale is available without adding dependencies to the library. Please refer
+	to your operating system's manual to determine how to setup the system
+	locale on your target system.
+
+	\warning This function should not be used as a replacement for platform-
+	specific methods for retrieving the locale. Its intended usage is to
+	"guess" the desired locale by looking at the system locale.
+
+	Example:
+
+	\code{.c}
+		uint8_t Employee_PrintNames(const char** names, size_t nameCount)
+		{
+			size_t locale = utf8envlocale();
+			char buffer[256];
+			size_t buffer_size = 255;
+			int32_t errors;
+			size_t i;
+
+			for (i = 0; i < nameCount; ++i)
+			{
+				size_t buffer_filled;
+
+				memset(buffer, 0, buffer_size);
+
+				if ((buffer_filled = utf8toupper(names[i], strlen(names[i]), buffer, buffer_size, locale, &errors)) == 0 ||
+					errors != UTF8_ERR_NONE)
+				{
+					return 0;
+				}
+
+				Log_Print(buffer, buffer_filled);
+			}
+
+			return 1;
+		}
+	\endcode
+
+	\return A specific \ref locales "locale" or #UTF8_LOCALE_DEFAULT.
+
+	\sa utf8toupper
+	\sa utf8tolower
+	\sa utf8totitle
+	\sa utf8casefold
 */
 UTF8_API size_t utf8envlocale();
 
-/*!
-	\brief Convert UTF-8 encoded text to uppercase.
+/*!
+	\brief Convert UTF-8 encoded text to uppercase.
+
+	This function allows conversion of UTF-8 encoded strings to uppercase
+	without first changing the encoding to UTF-32. Conversion is fully compliant
+	with the Unicode 7.0 standard.
+
+	Although most code points can be converted in-place, there are notable
+	exceptions. For example, U+00DF (LATIN SMALL LETTER SHARP S) maps to
+	"U+0053 U+0053" (LATIN CAPITAL LETTER S and LATIN CAPITAL LETTER S) when
+	converted to uppercase. Therefor, it is advised to first determine the size
+	in bytes of the output by calling the function with a NULL output buffer.
+
+	Only a handful of scripts make a distinction between upper and lowercase.
+	In addition to modern scripts, such as Latin, Greek, Armenian and Cyrillic,
+	a few historic or archaic scripts have case. The vast majority of scripts
+	do not have case distinctions.
+
+	\note Case mapping is not reversible. That is, `toUpper(toLower(x))
+	!= toLower(toUpper(x))`.
+
+	\warning Certain code points (or combinations of code points) apply rules
+	based on the locale. For more information about these exceptional
+	code points, please refer to the Unicode standard:
+	ftp://ftp.unicode.org/Public/UNIDATA/SpecialCasing.txt
+	
+
+	Example:
+
+	\code{.c}
+		void Button_Draw(int32_t x, int32_t y, const char* text)
+		{
+			size_t input_size = strlen(text);
+			char* converted = NULL;
+			size_t converted_size;
+			int32_t text_box_width, text_box_height;
+			int32_t errors;
+
+			if ((utf8toupper(text, input_size, NULL, 0, UTF8_LOCALE_DEFAULT, &errors)) == 0 ||
+				errors != UTF8_ERR_NONE)
+			{
+				goto cleanup;
+			}
+
+			converted = (char*)malloc(converted_size + 1);
+
+			if (converted == NULL ||
+				utf8toupper(text, input_size, converted, converted_size, UTF8_LOCALE_DEFAULT, &errors) == 0 ||
+				errors != UTF8_ERR_NONE)
+			{
+				goto cleanup;
+			}
+
+			converted[converted_size] = 0;
+
+			Font_GetTextDimensions(converted, &text_box_width, &text_box_height);
+
+			Draw_BoxFilled(x - 4, y - 4, text_box_width + 8, text_box_height + 8, 0x088A08);
+			Draw_BoxOutline(x - 4, y - 4, text_box_width + 8, text_box_height + 8, 0xA9F5A9);
+			Font_DrawText(x + 2, y + 1, converted, 0x000000);
+			Font_DrawText(x, y, converted, 0xFFFFFF);
+
+		cleanup:
+			if (converted != NULL)
+			{
+				free(converted);
+				converted = NULL;
+			}
+		}
+	\endcode
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+	\param[out]  errors      Output for errors.
+
+	\return Amount of bytes needed to contain output.
+
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
+	\retval #UTF8_ERR_INVALID_FLAG            Function was excluded from the build with \ref UTF8_EXCLUDE_NFC "UTF8_EXCLUDE_*".
+	\retval #UTF8_ERR_OVERLAPPING_PARAMETERS  Input and output buffers overlap in memory.
+	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        Target buffer size is insufficient for result.
+
+	\sa utf8tolower
+	\sa utf8totitle
+	\sa utf8casefold
+*/
+UTF8_API size_t utf8toupper(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors);
+
+/*!
+	\brief Convert UTF-8 encoded text to lowercase.
+
+	This function allows conversion of UTF-8 encoded strings to lowercase
+	without first changing the encoding to UTF-32. Conversion is fully compliant
+	with the Unicode 7.0 standard.
+
+	Although most code points can be converted to lowercase in-place, there are
+	notable exceptions. For example, U+0130 (LATIN CAPITAL LETTER I WITH DOT
+	ABOVE) maps to "U+0069 U+0307" (LATIN SMALL LETTER I and COMBINING DOT
+	ABOVE) when converted to lowercase. Therefor, it is advised to first
+	determine the size in bytes of the output by calling the function with a
+	NULL output buffer.
+
+	Only a handful of scripts make a distinction between upper- and lowercase.
+	In addition to modern scripts, such as Latin, Greek, Armenian and Cyrillic,
+	a few historic or archaic scripts have case. The vast majority of scripts do
+	not have case distinctions.
+
+	\note Case mapping is not reversible. That is, `toUpper(toLower(x))
+	!= toLower(toUpper(x))`.
+
+	\warning Certain code points (or combinations of code points) apply rules
+	based on the locale. For more information about these exceptional
+	code points, please refer to the Unicode standard:
+	ftp://ftp.unicode.org/Public/UNIDATA/SpecialCasing.txt
+
+	Example:
+
+	\code{.c}
+		author_t* Author_ByName(const char* name)
+		{
+			author_t* result = NULL;
+			size_t name_size = strlen(name);
+			char* converted = NULL;
+			size_t converted_size;
+			int32_t errors;
+			size_t i;
+			
+			if ((converted_size = utf8tolower(name, name_size, NULL, 0, UTF8_LOCALE_DEFAULT, &errors)) == 0 ||
+				errors != UTF8_ERR_NONE)
+			{
+				goto cleanup;
+			}
+
+			converted = (char*)malloc(converted_size + 1);
+
+			if (converted == NULL ||
+				utf8tolower(name, name_size, converted, converted_size, UTF8_LOCALE_DEFAULT, &errors) == 0 ||
+				errors != UTF8_ERR_NONE)
+			{
+				goto cleanup;
+			}
+
+			converted[converted_size] = 0;
+			
+			for (i = 0; i < g_AuthorCount; ++i)
+			{
+				if (!strcmp(g_Author[i].name, converted))
+				{
+					result = &g_Author[i];
+					break;
+				}
+			}
+		
+		cleanup:
+			if (converted != NULL)
+			{
+				free(converted);
+				converted = NULL;
+			}
+			return result;
+		}
+	\endcode
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+	\param[out]  errors      Output for errors.
+
+	\return Amount of bytes needed for storing output.
+
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
+	\retval #UTF8_ERR_INVALID_FLAG            Function was excluded from the build with \ref UTF8_EXCLUDE_NFC "UTF8_EXCLUDE_*".
+	\retval #UTF8_ERR_OVERLAPPING_PARAMETERS  Input and output buffers overlap in memory.
+	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        Target buffer size is insufficient for result.
+
+	\sa utf8toupper
+	\sa utf8totitle
+	\sa utf8casefold
+*/
+UTF8_API size_t utf8tolower(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors);
+
+/*!
+	\brief Convert UTF-8 encoded text to titlecase.
+
+	This function allows conversion of UTF-8 encoded strings to titlecase
+	without first changing the encoding to UTF-32. Conversion is fully compliant
+	with the Unicode 7.0 standard.
+
+	Titlecase requires a bit more explanation than uppercase and lowercase,
+	because it is not a common text transformation. Titlecase uses uppercase
+	for the first letter of each word and lowercase for the rest. Words are
+	defined as "collections of code points with general category Lu, Ll, Lt, Lm
+	or Lo according to the Unicode database".
+
+	Effectively, any type of punctuation can break up a word, even if this is
+	not grammatically valid. This happens because the titlecasing algorithm
+	does not and cannot take grammar rules into account.
+
+	Text                                 | Titlecase
+	-------------------------------------|-------------------------------------
+	The running man                      | The Running Man
+	NATO Alliance                        | Nato Alliance
+	You're amazing at building libraries | You'Re Amazing At Building Libraries
+	
+	Although most code points can be converted to titlecase in-place, there are
+	notable exceptions. For example, U+00DF (LATIN SMALL LETTER SHARP S) maps to
+	"U+0053 U+0073" (LATIN CAPITAL LETTER S and LATIN SMALL LETTER S) when
+	converted to titlecase. Therefor, it is advised to first determine the size
+	in bytes of the output by calling the function with a NULL output buffer.
+
+	Only a handful of scripts make a distinction between upper- and lowercase.
+	In addition to modern scripts, such as Latin, Greek, Armenian and Cyrillic,
+	a few historic or archaic scripts have case. The vast majority of scripts
+	do not have case distinctions.
+
+	\note Case mapping is not reversible. That is, `toUpper(toLower(x))
+	!= toLower(toUpper(x))`.
+
+	\warning Certain code points (or combinations of code points) apply rules
+	based on the locale. For more information about these exceptional
+	code points, please refer to the Unicode standard:
+	ftp://ftp.unicode.org/Public/UNIDATA/SpecialCasing.txt
+
+	Example:
+
+	\code{.c}
+		void Book_SetTitle(book_t* book, const char* title)
+		{
+			size_t converted_size;
+			int32_t errors;
+			size_t i;
+
+			if ((converted_size = utf8totitle(title, strlen(title), book->title, sizeof(book->title) - 1, UTF8_LOCALE_DEFAULT, &errors)) == 0 ||
+				errors != UTF8_ERR_NONE)
+			{
+				memset(book->title, 0, sizeof(book->title));
+
+				return;
+			}
+			book->title[converted_size] = 0;
+		}
+	\endcode
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+	\param[out]  errors      Output for errors.
+
+	\return Amount of bytes needed for storing output.
+
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
+	\retval #UTF8_ERR_INVALID_FLAG            Function was excluded from the build with \ref UTF8_EXCLUDE_NFC "UTF8_EXCLUDE_*".
+	\retval #UTF8_ERR_OVERLAPPING_PARAMETERS  Input and output buffers overlap in memory.
+	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        Target buffer size is insufficient for result.
+
+	\sa utf8tolower
+	\sa utf8toupper
+	\sa utf8casefold
+*/
+UTF8_API size_t utf8totitle(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors);
+
+/*!
+	\brief Remove case distinction from UTF-8 encoded text.
+
+	Case folding is the process of eliminating differences between code points
+	concerning case mapping. It is most commonly used for comparing strings in a
+	case-insensitive manner. Conversion is fully compliant with the Unicode 7.0
+	standard.
+
+	Although similar to lowercasing text, there are significant differences.
+	For one, case folding does _not_ take locale into account when converting.
+	In some cases, case folding can be up to 20% faster than lowercasing the
+	same text, but the result cannot be treated as correct lowercased text.
 
-	This function allows conversion of UTF-8 encoded strings to uppercase
-	without first changing the encoding to UTF-32. Conversion is fully compliant
-	with the Unicode 7.0 standard.
+	Only two locale-specific exception are made when case folding text.
+	In Turkish, U+0049 LATIN CAPITAL LETTER I maps to U+0131 LATIN SMALL LETTER
+	DOTLESS I and U+0130 LATIN CAPITAL LETTER I WITH DOT ABOVE maps to U+0069
+	LATIN SMALL LETTER I.
 
-	Although most code points can be converted in-place, there are notable
-	exceptions. For example, U+00DF (LATIN SMALL LETTER SHARP S) maps to
-	"U+0053 U+0053" (LATIN CAPITAL LETTER S and LATIN CAPITAL LETTER S) when
-	converted to uppercase. Therefor, it is advised to first determine the size
+	Although most code points can be case folded in-place, there are notable
+	exceptions. For example, U+0130 (LATIN CAPITAL LETTER I WITH DOT ABOVE) maps
+	to "U+0069 U+0307" (LATIN SMALL LETTER I and COMBINING DOT ABOVE) when
+	converted to lowercase. Therefor, it is advised to first determine the size
 	in bytes of the output by calling the function with a NULL output buffer.
 
-	Only a handful of scripts make a distinction between upper and lowercase.
+	Only a handful of scripts make a distinction between upper- and lowercase.
 	In addition to modern scripts, such as Latin, Greek, Armenian and Cyrillic,
 	a few historic or archaic scripts have case. The vast majority of scripts
 	do not have case distinctions.
 
-	\note Case mapping is not reversible. That is, `toUpper(toLower(x))
-	!= toLower(toUpper(x))`.
-
-	\warning Certain code points (or combinations of code points) apply rules
-	based on the locale. For more information about these exceptional
-	code points, please refer to the Unicode standard:
-	ftp://ftp.unicode.org/Public/UNIDATA/SpecialCasing.txt
-	
-
 	Example:
 
 	\code{.c}
-		void Button_Draw(int32_t x, int32_t y, const char* text)
+		int32_t Command_ParseCommand(const char* argument)
 		{
-			size_t input_size = strlen(text);
-			char* converted = NULL;
-			size_t converted_size;
-			int32_t text_box_width, text_box_height;
+			char* buffer = NULL;
+			size_t buffer_size = 0;
 			int32_t errors;
+			int32_t result = 0;
 
-			if ((utf8toupper(text, input_size, NULL, 0, UTF8_LOCALE_DEFAULT, &errors)) == 0 ||
+			if ((buffer_size = utf8casefold(argument, strlen(argument), NULL, 0, UTF8_LOCALE_DEFAULT, &errors)) == 0 ||
 				errors != UTF8_ERR_NONE)
 			{
+				result = -1;
+
 				goto cleanup;
 			}
 
-			converted = (char*)malloc(converted_size + 1);
+			buffer = (char*)malloc(buffer_size);
 
-			if (converted == NULL ||
-				utf8toupper(text, input_size, converted, converted_size, UTF8_LOCALE_DEFAULT, &errors) == 0 ||
+			if (buffer == NULL ||
+				utf8casefold(argument, strlen(argument), buffer, buffer_size, UTF8_LOCALE_DEFAULT, &errors) == 0 ||
 				errors != UTF8_ERR_NONE)
 			{
+				result = -1;
+
 				goto cleanup;
 			}
 
-			converted[converted_size] = 0;
-
-			Font_GetTextDimensions(converted, &text_box_width, &text_box_height);
-
-			Draw_BoxFilled(x - 4, y - 4, text_box_width + 8, text_box_height + 8, 0x088A08);
-			Draw_BoxOutline(x - 4, y - 4, text_box_width + 8, text_box_height + 8, 0xA9F5A9);
-			Font_DrawText(x + 2, y + 1, converted, 0x000000);
-			Font_DrawText(x, y, converted, 0xFFFFFF);
+			if (!strncmp(buffer, "-username", strlen("-username")))
+			{
+				result = eCommand_Username;
+			}
+			else if (
+				!strncmp(buffer, "-password", strlen("-password")))
+			{
+				result = eCommand_Password;
+			}
+			else if (
+				!strncmp(buffer, "-message", strlen("-message")))
+			{
+				result = eCommand_Message;
+			}
 
 		cleanup:
-			if (converted != NULL)
+			if (buffer != NULL)
 			{
-				free(converted);
-				converted = NULL;
+				free(buffer);
+				buffer = NULL;
 			}
+
+			return result;
 		}
 	\endcode
 
@@ -1252,303 +2420,422 @@ UTF8_API size_t utf8envlocale();
 	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
 	\param[out]  errors      Output for errors.
 
-	\return Amount of bytes needed to contain output.
+	\return Amount of bytes needed for storing output.
 
 	\retval #UTF8_ERR_NONE                    No errors.
 	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
 	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
+	\retval #UTF8_ERR_INVALID_FLAG            Function was excluded from the build with \ref UTF8_EXCLUDE_NFC "UTF8_EXCLUDE_*".
 	\retval #UTF8_ERR_OVERLAPPING_PARAMETERS  Input and output buffers overlap in memory.
 	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        Target buffer size is insufficient for result.
 
 	\sa utf8tolower
+	\sa utf8toupper
 	\sa utf8totitle
-	\sa utf8casefold
 */
-UTF8_API size_t utf8toupper(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors);
+UTF8_API size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors);
 
 /*!
-	\brief Convert UTF-8 encoded text to lowercase.
+	\brief Convert UTF-8 encoded text to uppercase and report how much of the input was consumed.
 
-	This function allows conversion of UTF-8 encoded strings to lowercase
-	without first changing the encoding to UTF-32. Conversion is fully compliant
-	with the Unicode 7.0 standard.
+	Behaves like #utf8toupper, but the result also holds the amount of input
+	bytes that were case mapped. When the target buffer is too small, the
+	case mapping stops on a position where it can be resumed from with a
+	new buffer.
 
-	Although most code points can be converted to lowercase in-place, there are
-	notable exceptions. For example, U+0130 (LATIN CAPITAL LETTER I WITH DOT
-	ABOVE) maps to "U+0069 U+0307" (LATIN SMALL LETTER I and COMBINING DOT
-	ABOVE) when converted to lowercase. Therefor, it is advised to first
-	determine the size in bytes of the output by calling the function with a
-	NULL output buffer.
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
 
-	Only a handful of scripts make a distinction between upper- and lowercase.
-	In addition to modern scripts, such as Latin, Greek, Armenian and Cyrillic,
-	a few historic or archaic scripts have case. The vast majority of scripts do
-	not have case distinctions.
+	\return Input bytes consumed, output bytes produced and the error.
 
-	\note Case mapping is not reversible. That is, `toUpper(toLower(x))
-	!= toLower(toUpper(x))`.
+	\sa utf8tolower_ex
+	\sa utf8result_t
+*/
+UTF8_API utf8result_t utf8toupper_ex(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale);
 
-	\warning Certain code points (or combinations of code points) apply rules
-	based on the locale. For more information about these exceptional
-	code points, please refer to the Unicode standard:
-	ftp://ftp.unicode.org/Public/UNIDATA/SpecialCasing.txt
+/*!
+	\brief Convert UTF-8 encoded text to lowercase and report how much of the input was consumed.
+
+	Behaves like #utf8tolower, but the result also holds the amount of input
+	bytes that were case mapped. When the target buffer is too small, the
+	case mapping stops on a position where it can be resumed from with a
+	new buffer. It never stops right before a GREEK CAPITAL LETTER SIGMA,
+	because its lowercase form depends on the code point before it.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+
+	\return Input bytes consumed, output bytes produced and the error.
+
+	\sa utf8toupper_ex
+	\sa utf8result_t
+*/
+UTF8_API utf8result_t utf8tolower_ex(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale);
+
+/*!
+	\brief Convert UTF-8 encoded text to titlecase and report how much of the input was consumed.
+
+	Behaves like #utf8totitle, but the result also holds the amount of input
+	bytes that were case mapped. When the target buffer is too small, the
+	case mapping stops on a position where it can be resumed from with a
+	new buffer. Because only the first letter of a word is converted to
+	titlecase, the case mapping stops at the start of the word that did not
+	fit. When the first word does not fit, nothing is consumed.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+
+	\return Input bytes consumed, output bytes produced and the error.
+
+	\sa utf8tolower_ex
+	\sa utf8result_t
+*/
+UTF8_API utf8result_t utf8totitle_ex(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale);
+
+/*!
+	\brief Remove case distinction from UTF-8 encoded text and report how much of the input was consumed.
+
+	Behaves like #utf8casefold, but the result also holds the amount of input
+	bytes that were case mapped. When the target buffer is too small, the
+	case mapping stops on a position where it can be resumed from with a
+	new buffer.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+
+	\return Input bytes consumed, output bytes produced and the error.
+
+	\sa utf8tolower_ex
+	\sa utf8result_t
+*/
+UTF8_API utf8result_t utf8casefold_ex(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale);
+
+/*!
+	\brief Convert UTF-8 encoded text to uppercase and allocate memory for the result.
+
+	Behaves like #utf8toupper, but the output is written to memory allocated with
+	the allocator. The output grows while the input is case mapped, which means
+	the input is only read once. The result is terminated with a NUL byte
+	that is not included in the output size.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+	\param[in]   allocator   Callbacks for allocating memory, can be NULL to use the C runtime.
+	\param[out]  outputSize  Size of the result in bytes, can be NULL.
+	\param[out]  errors      Output for errors.
+
+	\return Allocated result that must be freed with #utf8free, or NULL on error.
+
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
+	\retval #UTF8_ERR_OUT_OF_MEMORY           The allocator failed to provide memory for the result.
+
+	\sa utf8tolower_alloc
+	\sa utf8allocator_t
+*/
+UTF8_API char* utf8toupper_alloc(const char* input, size_t inputSize, size_t locale, const utf8allocator_t* allocator, size_t* outputSize, int32_t* errors);
+
+/*!
+	\brief Convert UTF-8 encoded text to lowercase and allocate memory for the result.
+
+	Behaves like #utf8tolower, but the output is written to memory allocated with
+	the allocator. The output grows while the input is case mapped, which means
+	the input is only read once. The result is terminated with a NUL byte
+	that is not included in the output size.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+	\param[in]   allocator   Callbacks for allocating memory, can be NULL to use the C runtime.
+	\param[out]  outputSize  Size of the result in bytes, can be NULL.
+	\param[out]  errors      Output for errors.
+
+	\return Allocated result that must be freed with #utf8free, or NULL on error.
+
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
+	\retval #UTF8_ERR_OUT_OF_MEMORY           The allocator failed to provide memory for the result.
+
+	\sa utf8toupper_alloc
+	\sa utf8allocator_t
+*/
+UTF8_API char* utf8tolower_alloc(const char* input, size_t inputSize, size_t locale, const utf8allocator_t* allocator, size_t* outputSize, int32_t* errors);
+
+/*!
+	\brief Convert UTF-8 encoded text to titlecase and allocate memory for the result.
+
+	Behaves like #utf8totitle, but the output is written to memory allocated with
+	the allocator. The output grows while the input is case mapped, which means
+	the input is only read once. The result is terminated with a NUL byte
+	that is not included in the output size.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+	\param[in]   allocator   Callbacks for allocating memory, can be NULL to use the C runtime.
+	\param[out]  outputSize  Size of the result in bytes, can be NULL.
+	\param[out]  errors      Output for errors.
+
+	\return Allocated result that must be freed with #utf8free, or NULL on error.
+
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
+	\retval #UTF8_ERR_OUT_OF_MEMORY           The allocator failed to provide memory for the result.
+
+	\sa utf8tolower_alloc
+	\sa utf8allocator_t
+*/
+UTF8_API char* utf8totitle_alloc(const char* input, size_t inputSize, size_t locale, const utf8allocator_t* allocator, size_t* outputSize, int32_t* errors);
+
+/*!
+	\brief Remove case distinction from UTF-8 encoded text and allocate memory for the result.
+
+	Behaves like #utf8casefold, but the output is written to memory allocated with
+	the allocator. The output grows while the input is case mapped, which means
+	the input is only read once. The result is terminated with a NUL byte
+	that is not included in the output size.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+	\param[in]   allocator   Callbacks for allocating memory, can be NULL to use the C runtime.
+	\param[out]  outputSize  Size of the result in bytes, can be NULL.
+	\param[out]  errors      Output for errors.
+
+	\return Allocated result that must be freed with #utf8free, or NULL on error.
+
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
+	\retval #UTF8_ERR_OUT_OF_MEMORY           The allocator failed to provide memory for the result.
+
+	\sa utf8tolower_alloc
+	\sa utf8allocator_t
+*/
+UTF8_API char* utf8casefold_alloc(const char* input, size_t inputSize, size_t locale, const utf8allocator_t* allocator, size_t* outputSize, int32_t* errors);
+
+/*!
+	\brief Convert UTF-8 encoded text to uppercase in the buffer it is stored in.
+
+	Behaves like #utf8toupper, but the result overwrites the input. This is
+	possible as long as the result is not longer than the input it
+	replaced. The case mapping stops before the first sequence that would
+	make the result longer and leaves the text after it untouched.
+
+	The result holds the amount of input bytes that were case mapped and
+	the size of the result. When the case mapping stopped early, the error
+	is #UTF8_ERR_NOT_ENOUGH_SPACE and the rest of the input can be case
+	mapped to a new buffer with #utf8toupper_ex.
 
 	Example:
 
 	\code{.c}
-		author_t* Author_ByName(const char* name)
+		size_t Key_Normalize(char* key, size_t keySize, char* fallback, size_t fallbackSize)
 		{
-			author_t* result = NULL;
-			size_t name_size = strlen(name);
-			char* converted = NULL;
-			size_t converted_size;
-			int32_t errors;
-			size_t i;
-			
-			if ((converted_size = utf8tolower(name, name_size, NULL, 0, UTF8_LOCALE_DEFAULT, &errors)) == 0 ||
-				errors != UTF8_ERR_NONE)
-			{
-				goto cleanup;
-			}
-
-			converted = (char*)malloc(converted_size + 1);
-
-			if (converted == NULL ||
-				utf8tolower(name, name_size, converted, converted_size, UTF8_LOCALE_DEFAULT, &errors) == 0 ||
-				errors != UTF8_ERR_NONE)
-			{
-				goto cleanup;
-			}
+			utf8result_t result = utf8toupper_inplace(key, keySize, UTF8_LOCALE_DEFAULT);
+			utf8result_t rest;
 
-			converted[converted_size] = 0;
-			
-			for (i = 0; i < g_AuthorCount; ++i)
-			{
-				if (!strcmp(g_Author[i].name, converted))
-				{
-					result = &g_Author[i];
-					break;
-				}
-			}
-		
-		cleanup:
-			if (converted != NULL)
+			if (result.error != UTF8_ERR_NOT_ENOUGH_SPACE)
 			{
-				free(converted);
-				converted = NULL;
+				return result.produced;
 			}
-			return result;
+
+			memcpy(fallback, key, result.produced);
+
+			rest = utf8toupper_ex(key + result.consumed, keySize - result.consumed,
+				fallback + result.produced, fallbackSize - result.produced, UTF8_LOCALE_DEFAULT);
+
+			return result.produced + rest.produced;
 		}
 	\endcode
 
-	\param[in]   input       UTF-8 encoded string.
-	\param[in]   inputSize   Size of the input in bytes.
-	\param[out]  target      Output buffer for the result, can be NULL.
-	\param[in]   targetSize  Size of the output buffer in bytes.
-	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
-	\param[out]  errors      Output for errors.
+	\param[in,out]  text      UTF-8 encoded string, overwritten with the result.
+	\param[in]      textSize  Size of the text in bytes.
+	\param[in]      locale    Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
 
-	\return Amount of bytes needed for storing output.
+	\return Input bytes consumed, output bytes produced and the error.
 
 	\retval #UTF8_ERR_NONE                    No errors.
-	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_INVALID_DATA            Input is NULL.
+	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        The result does not fit in the input from the consumed offset onwards.
 	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
-	\retval #UTF8_ERR_OVERLAPPING_PARAMETERS  Input and output buffers overlap in memory.
-	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        Target buffer size is insufficient for result.
+	\retval #UTF8_ERR_INVALID_FLAG            Function was excluded from the build with \ref UTF8_EXCLUDE_NFC "UTF8_EXCLUDE_*".
 
-	\sa utf8toupper
-	\sa utf8totitle
-	\sa utf8casefold
+	\sa utf8tolower_inplace
+	\sa utf8toupper_ex
 */
-UTF8_API size_t utf8tolower(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors);
+UTF8_API utf8result_t utf8toupper_inplace(char* text, size_t textSize, size_t locale);
 
 /*!
-	\brief Convert UTF-8 encoded text to titlecase.
+	\brief Convert UTF-8 encoded text to lowercase in the buffer it is stored in.
 
-	This function allows conversion of UTF-8 encoded strings to titlecase
-	without first changing the encoding to UTF-32. Conversion is fully compliant
-	with the Unicode 7.0 standard.
+	Behaves like #utf8tolower, but the result overwrites the input. The case
+	mapping stops before the first sequence that would make the result
+	longer than the input it replaced, after which the rest of the input
+	can be case mapped to a new buffer with #utf8tolower_ex.
 
-	Titlecase requires a bit more explanation than uppercase and lowercase,
-	because it is not a common text transformation. Titlecase uses uppercase
-	for the first letter of each word and lowercase for the rest. Words are
-	defined as "collections of code points with general category Lu, Ll, Lt, Lm
-	or Lo according to the Unicode database".
+	\param[in,out]  text      UTF-8 encoded string, overwritten with the result.
+	\param[in]      textSize  Size of the text in bytes.
+	\param[in]      locale    Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
 
-	Effectively, any type of punctuation can break up a word, even if this is
-	not grammatically valid. This happens because the titlecasing algorithm
-	does not and cannot take grammar rules into account.
+	\return Input bytes consumed, output bytes produced and the error.
 
-	Text                                 | Titlecase
-	-------------------------------------|-------------------------------------
-	The running man                      | The Running Man
-	NATO Alliance                        | Nato Alliance
-	You're amazing at building libraries | You'Re Amazing At Building Libraries
-	
-	Although most code points can be converted to titlecase in-place, there are
-	notable exceptions. For example, U+00DF (LATIN SMALL LETTER SHARP S) maps to
-	"U+0053 U+0073" (LATIN CAPITAL LETTER S and LATIN SMALL LETTER S) when
-	converted to titlecase. Therefor, it is advised to first determine the size
-	in bytes of the output by calling the function with a NULL output buffer.
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            Input is NULL.
+	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        The result does not fit in the input from the consumed offset onwards.
+	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
+	\retval #UTF8_ERR_INVALID_FLAG            Function was excluded from the build with \ref UTF8_EXCLUDE_NFC "UTF8_EXCLUDE_*".
 
-	Only a handful of scripts make a distinction between upper- and lowercase.
-	In addition to modern scripts, such as Latin, Greek, Armenian and Cyrillic,
-	a few historic or archaic scripts have case. The vast majority of scripts
-	do not have case distinctions.
+	\sa utf8toupper_inplace
+	\sa utf8tolower_ex
+*/
+UTF8_API utf8result_t utf8tolower_inplace(char* text, size_t textSize, size_t locale);
 
-	\note Case mapping is not reversible. That is, `toUpper(toLower(x))
-	!= toLower(toUpper(x))`.
+/*!
+	\brief Remove case distinction from UTF-8 encoded text in the buffer it is stored in.
 
-	\warning Certain code points (or combinations of code points) apply rules
-	based on the locale. For more information about these exceptional
-	code points, please refer to the Unicode standard:
-	ftp://ftp.unicode.org/Public/UNIDATA/SpecialCasing.txt
+	Behaves like #utf8casefold, but the result overwrites the input. The case
+	mapping stops before the first sequence that would make the result
+	longer than the input it replaced, after which the rest of the input
+	can be case mapped to a new buffer with #utf8casefold_ex.
+
+	\param[in,out]  text      UTF-8 encoded string, overwritten with the result.
+	\param[in]      textSize  Size of the text in bytes.
+	\param[in]      locale    Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+
+	\return Input bytes consumed, output bytes produced and the error.
+
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            Input is NULL.
+	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        The result does not fit in the input from the consumed offset onwards.
+	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
+	\retval #UTF8_ERR_INVALID_FLAG            Function was excluded from the build with \ref UTF8_EXCLUDE_NFC "UTF8_EXCLUDE_*".
+
+	\sa utf8tolower_inplace
+	\sa utf8casefold_ex
+*/
+UTF8_API utf8result_t utf8casefold_inplace(char* text, size_t textSize, size_t locale);
+
+/*!
+	\brief Compare two UTF-8 encoded strings without case distinction.
+
+	The result is the same as comparing the output of #utf8casefold for
+	both strings with `memcmp`, which orders them by code point. Both
+	strings are case folded one code point at a time, which means no
+	memory is allocated and the comparison ends at the first difference.
+	A case folding that results in more than one code point is compared
+	against the code points that follow on the other side, e.g. U+00DF LATIN
+	SMALL LETTER SHARP S is equal to "SS".
+
+	Invalid sequences are compared as U+FFFD REPLACEMENT CHARACTER.
 
 	Example:
 
 	\code{.c}
-		void Book_SetTitle(book_t* book, const char* title)
+		uint8_t Header_IsContentType(const char* name, size_t nameSize)
 		{
-			size_t converted_size;
 			int32_t errors;
-			size_t i;
-
-			if ((converted_size = utf8totitle(title, strlen(title), book->title, sizeof(book->title) - 1, UTF8_LOCALE_DEFAULT, &errors)) == 0 ||
-				errors != UTF8_ERR_NONE)
-			{
-				memset(book->title, 0, sizeof(book->title));
 
-				return;
-			}
-			book->title[converted_size] = 0;
+			return utf8casecmp(name, nameSize, "content-type", 12, UTF8_LOCALE_DEFAULT, &errors) == 0;
 		}
 	\endcode
 
-	\param[in]   input       UTF-8 encoded string.
-	\param[in]   inputSize   Size of the input in bytes.
-	\param[out]  target      Output buffer for the result, can be NULL.
-	\param[in]   targetSize  Size of the output buffer in bytes.
+	\param[in]   input1      UTF-8 encoded string.
+	\param[in]   input1Size  Size of the first string in bytes.
+	\param[in]   input2      UTF-8 encoded string.
+	\param[in]   input2Size  Size of the second string in bytes.
 	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
 	\param[out]  errors      Output for errors.
 
-	\return Amount of bytes needed for storing output.
+	\return Less than, equal to or greater than zero if the first string is ordered before, the same as or after the second string.
 
 	\retval #UTF8_ERR_NONE                    No errors.
-	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_INVALID_DATA            One of the strings is NULL.
 	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
-	\retval #UTF8_ERR_OVERLAPPING_PARAMETERS  Input and output buffers overlap in memory.
-	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        Target buffer size is insufficient for result.
 
-	\sa utf8tolower
-	\sa utf8toupper
+	\sa utf8ncasecmp
 	\sa utf8casefold
 */
-UTF8_API size_t utf8totitle(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors);
+UTF8_API int utf8casecmp(const char* input1, size_t input1Size, const char* input2, size_t input2Size, size_t locale, int32_t* errors);
 
 /*!
-	\brief Remove case distinction from UTF-8 encoded text.
+	\brief Compare the start of two UTF-8 encoded strings without case distinction.
 
-	Case folding is the process of eliminating differences between code points
-	concerning case mapping. It is most commonly used for comparing strings in a
-	case-insensitive manner. Conversion is fully compliant with the Unicode 7.0
-	standard.
+	Behaves like #utf8casecmp, but compares at most the specified amount of
+	code points of the case folded strings.
 
-	Although similar to lowercasing text, there are significant differences.
-	For one, case folding does _not_ take locale into account when converting.
-	In some cases, case folding can be up to 20% faster than lowercasing the
-	same text, but the result cannot be treated as correct lowercased text.
+	\param[in]   input1      UTF-8 encoded string.
+	\param[in]   input1Size  Size of the first string in bytes.
+	\param[in]   input2      UTF-8 encoded string.
+	\param[in]   input2Size  Size of the second string in bytes.
+	\param[in]   length      Maximum amount of case folded code points to compare.
+	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+	\param[out]  errors      Output for errors.
 
-	Only two locale-specific exception are made when case folding text.
-	In Turkish, U+0049 LATIN CAPITAL LETTER I maps to U+0131 LATIN SMALL LETTER
-	DOTLESS I and U+0130 LATIN CAPITAL LETTER I WITH DOT ABOVE maps to U+0069
-	LATIN SMALL LETTER I.
+	\return Less than, equal to or greater than zero if the start of the first string is ordered before, the same as or after the start of the second string.
 
-	Although most code points can be case folded in-place, there are notable
-	exceptions. For example, U+0130 (LATIN CAPITAL LETTER I WITH DOT ABOVE) maps
-	to "U+0069 U+0307" (LATIN SMALL LETTER I and COMBINING DOT ABOVE) when
-	converted to lowercase. Therefor, it is advised to first determine the size
-	in bytes of the output by calling the function with a NULL output buffer.
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            One of the strings is NULL.
+	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
 
-	Only a handful of scripts make a distinction between upper- and lowercase.
-	In addition to modern scripts, such as Latin, Greek, Armenian and Cyrillic,
-	a few historic or archaic scripts have case. The vast majority of scripts
-	do not have case distinctions.
+	\sa utf8casecmp
+*/
+UTF8_API int utf8ncasecmp(const char* input1, size_t input1Size, const char* input2, size_t input2Size, size_t length, size_t locale, int32_t* errors);
+
+/*!
+	\brief Hash UTF-8 encoded text without case distinction.
+
+	Calculates a 64-bit hash of the output of #utf8casefold without writing
+	it to memory. Strings that are equal according to #utf8casecmp in the
+	same locale have the same hash, which makes it suitable for hash tables
+	with case-insensitive keys. The mixing function is based on wyhash.
+
+	The hash is not meant for cryptography and may change between versions
+	of the library and between platforms, so it should not be stored.
 
 	Example:
 
 	\code{.c}
-		int32_t Command_ParseCommand(const char* argument)
+		size_t Table_FindBucket(const Table* table, const char* key, size_t keySize)
 		{
-			char* buffer = NULL;
-			size_t buffer_size = 0;
 			int32_t errors;
-			int32_t result = 0;
-
-			if ((buffer_size = utf8casefold(argument, strlen(argument), NULL, 0, UTF8_LOCALE_DEFAULT, &errors)) == 0 ||
-				errors != UTF8_ERR_NONE)
-			{
-				result = -1;
-
-				goto cleanup;
-			}
-
-			buffer = (char*)malloc(buffer_size);
-
-			if (buffer == NULL ||
-				utf8casefold(argument, strlen(argument), buffer, buffer_size, UTF8_LOCALE_DEFAULT, &errors) == 0 ||
-				errors != UTF8_ERR_NONE)
-			{
-				result = -1;
-
-				goto cleanup;
-			}
-
-			if (!strncmp(buffer, "-username", strlen("-username")))
-			{
-				result = eCommand_Username;
-			}
-			else if (
-				!strncmp(buffer, "-password", strlen("-password")))
-			{
-				result = eCommand_Password;
-			}
-			else if (
-				!strncmp(buffer, "-message", strlen("-message")))
-			{
-				result = eCommand_Message;
-			}
-
-		cleanup:
-			if (buffer != NULL)
-			{
-				free(buffer);
-				buffer = NULL;
-			}
 
-			return result;
+			return (size_t)(utf8casefold_hash(key, keySize, UTF8_LOCALE_DEFAULT, table->seed, &errors) % table->bucketCount);
 		}
 	\endcode
 
-	\param[in]   input       UTF-8 encoded string.
-	\param[in]   inputSize   Size of the input in bytes.
-	\param[out]  target      Output buffer for the result, can be NULL.
-	\param[in]   targetSize  Size of the output buffer in bytes.
-	\param[in]   locale      Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
-	\param[out]  errors      Output for errors.
+	\param[in]   input      UTF-8 encoded string.
+	\param[in]   inputSize  Size of the input in bytes.
+	\param[in]   locale     Enables locale-specific behavior in the implementation. \ref locales "List of valid locales."
+	\param[in]   seed       Value that changes the hash of every string.
+	\param[out]  errors     Output for errors.
 
-	\return Amount of bytes needed for storing output.
+	\return 64-bit hash of the case folded text.
 
 	\retval #UTF8_ERR_NONE                    No errors.
-	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_INVALID_DATA            Input is NULL.
 	\retval #UTF8_ERR_INVALID_LOCALE          Invalid locale specified.
-	\retval #UTF8_ERR_OVERLAPPING_PARAMETERS  Input and output buffers overlap in memory.
-	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        Target buffer size is insufficient for result.
 
-	\sa utf8tolower
-	\sa utf8toupper
-	\sa utf8totitle
+	\sa utf8casecmp
+	\sa utf8casefold
 */
-UTF8_API size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors);
+UTF8_API uint64_t utf8casefold_hash(const char* input, size_t inputSize, size_t locale, uint64_t seed, int32_t* errors);
 
 /*!
 	\brief Check if a string is stable in the specified Unicode Normalization
@@ -1759,7 +3046,7 @@ UTF8_API uint8_t utf8isnormalized(const char* input, size_t inputSize, size_t fl
 	\return Amount of bytes needed for storing output.
 
 	\retval #UTF8_ERR_NONE                    No errors.
-	\retval #UTF8_ERR_INVALID_FLAG            Invalid combination of flags was specified.
+	\retval #UTF8_ERR_INVALID_FLAG            Invalid combination of flags was specified, or the requested form was excluded from the build with \ref UTF8_EXCLUDE_NFC "UTF8_EXCLUDE_*".
 	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
 	\retval #UTF8_ERR_OVERLAPPING_PARAMETERS  Input and output buffers overlap in memory.
 	\retval #UTF8_ERR_NOT_ENOUGH_SPACE        Target buffer size is insufficient for result.
@@ -1768,6 +3055,69 @@ UTF8_API uint8_t utf8isnormalized(const char* input, size_t inputSize, size_t fl
 */
 UTF8_API size_t utf8normalize(const char* input, size_t inputSize, char* target, size_t targetSize, size_t flags, int32_t* errors);
 
+/*!
+	\brief Normalize a string and report how much of the input was consumed.
+
+	Behaves like #utf8normalize, but the result also holds the amount of
+	input bytes that were normalized. The input is normalized in segments
+	that start on a code point that is a starter and stable in the
+	requested normalization form, because the normalization of a segment
+	does not depend on the text around it. When the target buffer is too
+	small, the normalization stops at the start of the segment that did not
+	fit and can be resumed from there with a new buffer.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[out]  target      Output buffer for the result, can be NULL.
+	\param[in]   targetSize  Size of the output buffer in bytes.
+	\param[in]   flags       Desired normalization form. Must be a combination of #UTF8_NORMALIZE_COMPOSE, #UTF8_NORMALIZE_DECOMPOSE and #UTF8_NORMALIZE_COMPATIBILITY.
+
+	\return Input bytes consumed, output bytes produced and the error.
+
+	\sa utf8normalize
+	\sa utf8result_t
+*/
+UTF8_API utf8result_t utf8normalize_ex(const char* input, size_t inputSize, char* target, size_t targetSize, size_t flags);
+
+/*!
+	\brief Normalize a string and allocate memory for the result.
+
+	Behaves like #utf8normalize, but the output is written to memory allocated with
+	the allocator. The output grows while the input is normalized, which means
+	the input is only read once. The result is terminated with a NUL byte
+	that is not included in the output size.
+
+	\param[in]   input       UTF-8 encoded string.
+	\param[in]   inputSize   Size of the input in bytes.
+	\param[in]   flags       Desired normalization form. Must be a combination of #UTF8_NORMALIZE_COMPOSE, #UTF8_NORMALIZE_DECOMPOSE and #UTF8_NORMALIZE_COMPATIBILITY.
+	\param[in]   allocator   Callbacks for allocating memory, can be NULL to use the C runtime.
+	\param[out]  outputSize  Size of the result in bytes, can be NULL.
+	\param[out]  errors      Output for errors.
+
+	\return Allocated result that must be freed with #utf8free, or NULL on error.
+
+	\retval #UTF8_ERR_NONE                    No errors.
+	\retval #UTF8_ERR_INVALID_DATA            Failed to decode data.
+	\retval #UTF8_ERR_INVALID_FLAG            Invalid normalization form specified.
+	\retval #UTF8_ERR_OUT_OF_MEMORY           The allocator failed to provide memory for the result.
+
+	\sa utf8normalize
+	\sa utf8allocator_t
+*/
+UTF8_API char* utf8normalize_alloc(const char* input, size_t inputSize, size_t flags, const utf8allocator_t* allocator, size_t* outputSize, int32_t* errors);
+
+/*!
+	\brief Free memory returned by one of the functions ending in `_alloc`.
+
+	The allocator must be the same one that was used to allocate the memory.
+
+	\param[in]  allocator  Callbacks for allocating memory, can be NULL to use the C runtime.
+	\param[in]  memory     Memory to free, can be NULL.
+
+	\sa utf8allocator_t
+*/
+UTF8_API void utf8free(const utf8allocator_t* allocator, void* memory);
+
 /*!
 	\brief Check if the input string conforms to the category specified by the
 	flags.
@@ -1863,6 +3213,105 @@ UTF8_API size_t utf8normalize(const char* input, size_t inputSize, char* target,
 */
 UTF8_API size_t utf8iscategory(const char* input, size_t inputSize, size_t flags);
 
+/*!
+	\brief Load the Unicode database from a file.
+
+	By default, the library uses the Unicode database compiled into it. This
+	function replaces it with a database file generated by
+	`tools/converter/unicodedata.py`, which allows the Unicode version to be
+	updated without recompiling the application.
+
+	The file is mapped into memory read-only instead of being copied. When
+	multiple processes load the same file, the operating system shares its
+	pages between them.
+
+	Loading a database while another one is loaded replaces it. Call
+	#utf8unloaddatabase to return to the compiled-in database.
+
+	The file is validated before it replaces the current database. Every
+	offset stored in its tables is checked, so a file written by a different
+	version of the converter is rejected instead of being read out of bounds.
+	Use #utf8databaseversion to find out which Unicode version was loaded.
+
+	\warning This function is not thread-safe. The tables are replaced one
+	pointer at a time, so a call that runs at the same time on another
+	thread can read a mix of the old and the new database. Load the
+	database before any other function in the library is called, and make
+	sure no other call is running on any thread, including the tasks of an
+	executor passed to the functions ending in `_parallel`.
+
+	Example:
+
+	\code{.c}
+		void Application_Initialize(const char* dataPath)
+		{
+			int32_t errors;
+
+			if (!utf8loaddatabase(dataPath, &errors))
+			{
+				Log_Print("Using compiled-in Unicode database.");
+			}
+		}
+	\endcode
+
+	\param[in]   path    Path to the database file.
+	\param[out]  errors  Output for errors.
+
+	\retval #UTF8_ERR_NONE                   The database was loaded.
+	\retval #UTF8_ERR_INVALID_DATA           The path is `NULL`, the file is not a database with a supported format or the machine is not little-endian.
+	\retval #UTF8_ERR_DATABASE_UNAVAILABLE   The file could not be opened or mapped into memory.
+
+	\return 1 if the database was loaded, 0 otherwise.
+
+	\sa utf8unloaddatabase
+	\sa utf8databaseversion
+*/
+UTF8_API uint8_t utf8loaddatabase(const char* path, int32_t* errors);
+
+/*!
+	\brief Unload the Unicode database loaded from a file.
+
+	Unmaps the file loaded with #utf8loaddatabase and returns to the Unicode
+	database compiled into the library. Does nothing if no database file is
+	loaded.
+
+	\warning This function is not thread-safe. The memory of the file is
+	unmapped immediately, so no other call to the library may be running on
+	any thread, including the tasks of an executor passed to the functions
+	ending in `_parallel`.
+
+	\sa utf8loaddatabase
+*/
+UTF8_API void utf8unloaddatabase();
+
+/*!
+	\brief Get the Unicode version of the database in use.
+
+	Returns the version of the database loaded with #utf8loaddatabase, or
+	of the database compiled into the library if no file is loaded. The
+	major version is stored in bits 16 - 23, the minor version in bits
+	8 - 15 and the update version in bits 0 - 7.
+
+	Example:
+
+	\code{.c}
+		void Application_PrintUnicodeVersion()
+		{
+			uint32_t version = utf8databaseversion();
+
+			printf("Unicode %u.%u.%u\n",
+				(unsigned int)((version >> 16) & 0xFF),
+				(unsigned int)((version >> 8) & 0xFF),
+				(unsigned int)(version & 0xFF));
+		}
+	\endcode
+
+	\return Unicode version of the database.
+
+	\sa utf8loaddatabase
+*/
+UTF8_API uint32_t utf8databaseversion();
+
 /*!
 	\}
 */
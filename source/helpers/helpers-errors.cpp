@@ -19,6 +19,10 @@ namespace helpers {
 	#if UTF8_VERSION_GUARD(1, 5, 0)
 		MAKE_CASE(INVALID_LOCALE);
 	#endif
+	#if UTF8_VERSION_GUARD(1, 6, 0)
+		MAKE_CASE(DATABASE_UNAVAILABLE);
+		MAKE_CASE(OUT_OF_MEMORY);
+	#endif
 
 	#undef MAKE_CASE
 
@@ -0,0 +1,36 @@
+#include "helpers-random.hpp"
+
+namespace helpers {
+
+	Random::Random(uint32_t seed)
+		: m_state(seed)
+	{
+	}
+
+	uint32_t Random::next()
+	{
+		m_state ^= m_state << 13;
+		m_state ^= m_state >> 17;
+		m_state ^= m_state << 5;
+
+		return m_state;
+	}
+
+	uint32_t Random::next(uint32_t range)
+	{
+		return next() % range;
+	}
+
+	std::string Random::fragments(const char* const* fragments, size_t fragmentCount, size_t count)
+	{
+		std::string result;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			result += fragments[next((uint32_t)fragmentCount)];
+		}
+
+		return result;
+	}
+
+};
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+/*!
+	\file
+	\brief Random input helper functions.
+
+	\cond INTERNAL
+*/
+
+#include "helpers-base.hpp"
+
+namespace helpers {
+
+	/*
+		Xorshift generator for differential tests. Every test creates its own
+		generator with a fixed seed, so failures can be reproduced.
+	*/
+
+	class Random
+	{
+
+	public:
+
+		Random(uint32_t seed);
+
+		uint32_t next();
+		uint32_t next(uint32_t range);
+
+		std::string fragments(const char* const* fragments, size_t fragmentCount, size_t count);
+
+	private:
+
+		uint32_t m_state;
+
+	};
+
+};
+
+/*! \endcond */
\ No newline at end of file
@@ -0,0 +1,188 @@
+/*
+	Copyright (C) 2014-2016 Quinten Lansu
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "allocation.h"
+
+#include <stdlib.h>
+
+#include "base.h"
+
+/* Initial output size relative to the input, most text does not grow when it is transformed */
+
+#define ALLOCATION_INITIAL_SIZE(_inputSize) ((_inputSize) + ((_inputSize) / 8) + 16)
+
+void* allocation_allocate(const utf8allocator_t* allocator, size_t size)
+{
+	if (allocator == 0)
+	{
+		return malloc(size);
+	}
+
+	return allocator->allocate(allocator->context, size);
+}
+
+void* allocation_reallocate(const utf8allocator_t* allocator, void* memory, size_t usedSize, size_t size)
+{
+	void* resized;
+
+	if (allocator == 0)
+	{
+		return realloc(memory, size);
+	}
+	else if (
+		allocator->reallocate != 0)
+	{
+		return allocator->reallocate(allocator->context, memory, size);
+	}
+
+	/* Move to a new block when the allocator cannot resize */
+
+	resized = allocator->allocate(allocator->context, size);
+	if (resized != 0)
+	{
+		memcpy(resized, memory, usedSize);
+
+		allocation_free(allocator, memory);
+	}
+
+	return resized;
+}
+
+void allocation_free(const utf8allocator_t* allocator, void* memory)
+{
+	if (memory == 0)
+	{
+		return;
+	}
+
+	if (allocator == 0)
+	{
+		free(memory);
+	}
+	else if (
+		allocator->deallocate != 0)
+	{
+		allocator->deallocate(allocator->context, memory);
+	}
+}
+
+char* allocation_transform(TransformFunction transform, const char* input, size_t inputSize, size_t option, const utf8allocator_t* allocator, size_t* outputSize, int32_t* errors)
+{
+	char* output;
+	size_t output_capacity;
+	size_t bytes_written = 0;
+	utf8result_t result;
+
+	if (outputSize != 0)
+	{
+		*outputSize = 0;
+	}
+
+	if (allocator != 0 &&
+		allocator->allocate == 0)
+	{
+		UTF8_SET_ERROR(OUT_OF_MEMORY);
+
+		return 0;
+	}
+
+	/* Leave room for the NUL terminator */
+
+	output_capacity = ALLOCATION_INITIAL_SIZE(inputSize);
+
+	output = (char*)allocation_allocate(allocator, output_capacity);
+	if (output == 0)
+	{
+		UTF8_SET_ERROR(OUT_OF_MEMORY);
+
+		return 0;
+	}
+
+	while (1)
+	{
+		result = transform(input, inputSize, output + bytes_written, output_capacity - bytes_written - 1, option);
+
+		bytes_written += result.produced;
+		input += result.consumed;
+		inputSize -= result.consumed;
+
+		if (result.error != UTF8_ERR_NOT_ENOUGH_SPACE)
+		{
+			break;
+		}
+
+		/* Grow the output and resume where the transformation stopped */
+
+		{
+			size_t resized_capacity = output_capacity * 2;
+			char* resized;
+
+			if (resized_capacity < output_capacity)
+			{
+				allocation_free(allocator, output);
+
+				UTF8_SET_ERROR(OUT_OF_MEMORY);
+
+				return 0;
+			}
+
+			resized = (char*)allocation_reallocate(allocator, output, bytes_written, resized_capacity);
+			if (resized == 0)
+			{
+				allocation_free(allocator, output);
+
+				UTF8_SET_ERROR(OUT_OF_MEMORY);
+
+				return 0;
+			}
+
+			output = resized;
+			output_capacity = resized_capacity;
+		}
+	}
+
+	if (result.error != UTF8_ERR_NONE)
+	{
+		allocation_free(allocator, output);
+
+		if (errors != 0)
+		{
+			*errors = result.error;
+		}
+
+		return 0;
+	}
+
+	output[bytes_written] = 0;
+
+	if (outputSize != 0)
+	{
+		*outputSize = bytes_written;
+	}
+
+	UTF8_SET_ERROR(NONE);
+
+	return output;
+}
\ No newline at end of file
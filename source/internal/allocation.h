@@ -0,0 +1,62 @@
+/*
+	Copyright (C) 2014-2016 Quinten Lansu
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef _UTF8REWIND_INTERNAL_ALLOCATION_H_
+#define _UTF8REWIND_INTERNAL_ALLOCATION_H_
+
+/*!
+	\file
+	\brief Allocation interface.
+
+	\cond INTERNAL
+*/
+
+#include "utf8rewind.h"
+
+/*
+	The allocation functions call the callbacks of the allocator, or the
+	C runtime when the allocator is NULL.
+*/
+
+void* allocation_allocate(const utf8allocator_t* allocator, size_t size);
+
+void* allocation_reallocate(const utf8allocator_t* allocator, void* memory, size_t usedSize, size_t size);
+
+void allocation_free(const utf8allocator_t* allocator, void* memory);
+
+/*
+	Runs a resumable transformation on the input and writes the result to
+	allocated memory. The output is grown geometrically every time the
+	transformation runs out of space and is resumed from the input it
+	stopped on, so the input is only read once.
+*/
+
+typedef utf8result_t (*TransformFunction)(const char* input, size_t inputSize, char* target, size_t targetSize, size_t option);
+
+char* allocation_transform(TransformFunction transform, const char* input, size_t inputSize, size_t option, const utf8allocator_t* allocator, size_t* outputSize, int32_t* errors);
+
+/*! \endcond */
+
+#endif /* _UTF8REWIND_INTERNAL_ALLOCATION_H_ */
\ No newline at end of file
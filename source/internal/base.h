@@ -41,9 +41,24 @@
 	#define UTF8_UNUSED(_parameter) _parameter
 #endif
 
+/* Forces functions on the per-code-point path to be inlined, C89 has no inline keyword */
+
+#if defined(__GNUC__) || defined(__clang__)
+	#define UTF8_INLINE __inline__ __attribute__ ((always_inline))
+#elif defined(_MSC_VER)
+	#define UTF8_INLINE __forceinline
+#else
+	#define UTF8_INLINE
+#endif
+
 #define UTF8_SET_ERROR(_error) \
 	if (errors != 0) { *errors = UTF8_ERR_ ## _error; }
 
+/* Stores the position to resume from for the functions ending in _ex */
+
+#define UTF8_SET_PROGRESS(_consumed, _produced) \
+	if (progress != 0) { progress->consumed = (_consumed); progress->produced = (_produced); }
+
 /* Validates input before transforming */
 /* Check for parameter overlap using the separating axis theorem */
 
@@ -60,6 +75,7 @@
 			} \
 			memcpy(target, REPLACEMENT_CHARACTER_STRING, REPLACEMENT_CHARACTER_STRING_LENGTH); \
 		} \
+		UTF8_SET_PROGRESS(inputSize, _result + REPLACEMENT_CHARACTER_STRING_LENGTH); \
 		UTF8_SET_ERROR(INVALID_DATA); \
 		return _result + REPLACEMENT_CHARACTER_STRING_LENGTH; \
 	} \
@@ -94,6 +110,7 @@
 			} \
 			*target = REPLACEMENT_CHARACTER; \
 		} \
+		UTF8_SET_PROGRESS(inputSize, _result + sizeof(_outputType)); \
 		UTF8_SET_ERROR(INVALID_DATA); \
 		return _result + sizeof(_outputType); \
 	} \
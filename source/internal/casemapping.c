@@ -28,8 +28,13 @@
 #include "base.h"
 #include "codepoint.h"
 #include "database.h"
+#include "simd.h"
 #include "streaming.h"
 
+#if defined(_MSC_VER) && defined(_M_X64)
+	#include <intrin.h>
+#endif
+
 static const char basic_latin_lowercase_table[58] = {
 	/* LATIN CAPITAL LETTER A - LATIN CAPITAL LETTER Z */
 	0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C,
@@ -98,332 +103,108 @@ uint8_t casemapping_initialize(
 	return 1;
 }
 
-size_t casemapping_execute(CaseMappingState* state, int32_t* errors)
+static size_t casemapping_write_resolved(CaseMappingState* state, const char* resolved, uint8_t bytes_needed, int32_t* errors)
 {
-	uint8_t qc_casemapped = 0;
-	uint8_t bytes_needed = 0;
-	const char* resolved = 0;
-	StreamState stream;
-	uint8_t i;
-
-	/* Read next code point */
+	/* Move source cursor */
 
-	state->last_code_point_size = codepoint_read(state->src, state->src_size, &state->last_code_point);
-	if (state->last_code_point_size == 0)
+	if (state->src_size >= state->last_code_point_size)
 	{
-		goto invaliddata;
+		state->src += state->last_code_point_size;
+		state->src_size -= state->last_code_point_size;
 	}
-
-	/* Check for invalid characters */
-
-	if (state->last_code_point == REPLACEMENT_CHARACTER)
+	else
 	{
-		/* Get code point properties */
-
-		state->last_canonical_combining_class = CCC_NOT_REORDERED;
-		state->last_general_category = UTF8_CATEGORY_SYMBOL_OTHER;
-
-		resolved = REPLACEMENT_CHARACTER_STRING;
-		bytes_needed = REPLACEMENT_CHARACTER_STRING_LENGTH;
-
-		goto writeresolved;
+		state->src_size = 0;
 	}
 
-	if (state->locale == UTF8_LOCALE_TURKISH_AND_AZERI_LATIN)
-	{
-		/*
-			Code point General Category does not need to be modified, because
-			all mappings result in the same General Category
-		*/
-
-		if (state->property_data == LowercaseDataPtr)
-		{
-			if (state->last_code_point == CP_LATIN_CAPITAL_LETTER_I_WITH_DOT_ABOVE)
-			{
-				state->last_code_point = CP_LATIN_SMALL_LETTER_I;
-
-				resolved = "i";
-				bytes_needed = 1;
-			}
-			else if (
-				state->last_code_point == CP_LATIN_CAPITAL_LETTER_I)
-			{
-				if (state->src_size == 0)
-				{
-					/* Early-out for easy case */
-
-					state->last_code_point = CP_LATIN_SMALL_LETTER_DOTLESS_I;
-
-					resolved = "\xC4\xB1";
-					bytes_needed = 2;
-				}
-				else
-				{
-					uint8_t found = 0;
-
-					/* Initialize stream and read the next sequence */
-
-					if (!stream_initialize(&stream, state->src, state->src_size) ||
-						!stream_read(&stream, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr))
-					{
-						goto writeregular;
-					}
-
-					/* Erase COMBINING DOT ABOVE from sequence */
-
-					for (i = stream.current - 1; i > 0; --i)
-					{
-						if (stream.codepoint[i] == CP_COMBINING_DOT_ABOVE)
-						{
-							stream.canonical_combining_class[i] = CCC_INVALID;
-
-							found++;
-						}
-					}
-
-					/* Stabilize sequence and write to output */
-
-					if (!stream.stable ||
-						found > 0)
-					{
-						stream_reorder(&stream);
-
-						stream.current -= found;
-					}
-
-					stream.codepoint[0] = (found > 0) ? CP_LATIN_SMALL_LETTER_I : CP_LATIN_SMALL_LETTER_DOTLESS_I;
+	/* Write resolved string to output */
 
-					goto writestream;
-				}
-			}
-		}
-		else
+	if (state->dst != 0)
+	{
+		if (state->dst_size < bytes_needed)
 		{
-			if (state->last_code_point == CP_LATIN_SMALL_LETTER_I)
-			{
-				state->last_code_point = CP_LATIN_CAPITAL_LETTER_I_WITH_DOT_ABOVE;
+			UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
 
-				resolved = "\xC4\xB0";
-				bytes_needed = 2;
-			}
-			else if (
-				state->last_code_point == CP_LATIN_SMALL_LETTER_DOTLESS_I)
-			{
-				state->last_code_point = CP_LATIN_CAPITAL_LETTER_I;
+			state->src_size = 0;
 
-				resolved = "I";
-				bytes_needed = 1;
-			}
+			return 0;
 		}
 
-		/* Check if mapping succeeded */
-
-		if (resolved != 0)
-		{
-			/* Code point properties */
-
-			state->last_general_category = UTF8_CATEGORY_LETTER;
+		memcpy(state->dst, resolved, bytes_needed);
 
-			goto writeresolved;
-		}
+		state->dst += bytes_needed;
+		state->dst_size -= bytes_needed;
 	}
-	else if (
-		state->locale == UTF8_LOCALE_LITHUANIAN)
-	{
-		if (state->property_data == LowercaseDataPtr)
-		{
-			unicode_t cp_additional_accent = 0;
-			uint8_t write_soft_dot = 1;
-
-			switch (state->last_code_point)
-			{
-
-			case CP_LATIN_CAPITAL_LETTER_I:
-				state->last_code_point = CP_LATIN_SMALL_LETTER_I;
-				break;
-
-			case CP_LATIN_CAPITAL_LETTER_J:
-				state->last_code_point = CP_LATIN_SMALL_LETTER_J;
-				break;
-
-			case CP_LATIN_CAPITAL_LETTER_I_WITH_OGONEK:
-				state->last_code_point = CP_LATIN_SMALL_LETTER_I_WITH_OGONEK;
-				break;
-
-			case CP_LATIN_CAPITAL_LETTER_I_WITH_GRAVE:
-				state->last_code_point = CP_LATIN_SMALL_LETTER_I;
-				cp_additional_accent = CP_COMBINING_GRAVE_ACCENT;
-				break;
-
-			case CP_LATIN_CAPITAL_LETTER_I_WITH_ACUTE:
-				state->last_code_point = CP_LATIN_SMALL_LETTER_I;
-				cp_additional_accent = CP_COMBINING_ACUTE_ACCENT;
-				break;
-
-			case CP_LATIN_CAPITAL_LETTER_I_WITH_TILDE:
-				state->last_code_point = CP_LATIN_SMALL_LETTER_I;
-				cp_additional_accent = CP_COMBINING_TILDE_ACCENT;
-				break;
-
-			default:
-				goto writeregular;
-
-			}
-
-			/* Initialize stream and read the next sequence */
-
-			if (!stream_initialize(&stream, state->src, state->src_size) ||
-				!stream_read(&stream, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr))
-			{
-				goto writeregular;
-			}
-
-			/* Assign the lowercase code point to the start of the stream */
-
-			stream.codepoint[0] = state->last_code_point;
-
-			/* Check if COMBINING DOT ABOVE is not yet present */ 
-
-			for (i = stream.current - 1; i > 0; --i)
-			{
-				if (stream.codepoint[i] == CP_COMBINING_DOT_ABOVE)
-				{
-					write_soft_dot = 0;
-
-					break;
-				}
-			}
-
-			/* Stabilize the sequence */
-
-			if (!stream.stable)
-			{
-				stream_reorder(&stream);
-
-				stream.stable = 1;
-			}
-
-			/* Write COMBINING DOT ABOVE */
-
-			if (write_soft_dot &&
-				stream.current < STREAM_BUFFER_MAX)
-			{
-				/* Ensure the COMBINING DOT ABOVE comes before other accents with the same CCC */
-
-				if (stream.canonical_combining_class[stream.current - 1] == CCC_ABOVE)
-				{
-					unicode_t cp_swap = stream.codepoint[stream.current - 1];
-					stream.codepoint[stream.current - 1] = CP_COMBINING_DOT_ABOVE;
-					stream.codepoint[stream.current] = cp_swap;
-				}
-				else
-				{
-					stream.codepoint[stream.current] = CP_COMBINING_DOT_ABOVE;
-				}
-
-				stream.canonical_combining_class[stream.current] = CCC_ABOVE;
-
-				/* Check if sequence has become unstable */
-
-				stream.stable = stream.canonical_combining_class[stream.current - 1] <= CCC_ABOVE;
-
-				stream.current++;
-			}
-
-			/* Write additional accent */
-
-			if (cp_additional_accent != 0 &&
-				stream.current < STREAM_BUFFER_MAX)
-			{
-				/* Additional accents are always of the upper variety */
-
-				stream.codepoint[stream.current] = cp_additional_accent;
-				stream.canonical_combining_class[stream.current] = CCC_ABOVE;
-
-				/* Check if sequence has become unstable */
-
-				if (stream.stable &&
-					stream.canonical_combining_class[stream.current] < stream.canonical_combining_class[stream.current - 1])
-				{
-					stream.stable = 0;
-				}
 
-				stream.current++;
-			}
+	return bytes_needed;
+}
 
-			/* Stabilize the sequence */
+static size_t casemapping_write_stream(CaseMappingState* state, StreamState* stream, int32_t* errors)
+{
+	uint8_t bytes_needed = 0;
 
-			if (!stream.stable)
-			{
-				stream_reorder(&stream);
-			}
-		}
-		else
-		{
-			uint8_t erase_count = 0;
+	/* Get code point properties */
 
-			switch (state->last_code_point)
-			{
+	state->last_code_point = stream->codepoint[stream->current - 1];
+	state->last_canonical_combining_class = stream->canonical_combining_class[stream->current - 1];
+	state->last_general_category = PROPERTY_GET_GC(stream->codepoint[0]);
 
-			case CP_LATIN_SMALL_LETTER_I:
-				state->last_code_point = CP_LATIN_CAPITAL_LETTER_I;
-				break;
+	/* Move source cursor */
 
-			case CP_LATIN_SMALL_LETTER_J:
-				state->last_code_point = CP_LATIN_CAPITAL_LETTER_J;
-				break;
+	state->src = stream->src;
+	state->src_size = stream->src_size;
 
-			case CP_LATIN_SMALL_LETTER_I_WITH_OGONEK:
-				state->last_code_point = CP_LATIN_CAPITAL_LETTER_I_WITH_OGONEK;
-				break;
+	/* Write result to the output buffer */
 
-			default:
-				goto writeregular;
+	if (!stream_write(stream, &state->dst, &state->dst_size, &bytes_needed))
+	{
+		UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
 
-			}
+		state->src_size = 0;
 
-			/* Initialize stream and read the next sequence */
+		return 0;
+	}
 
-			if (!stream_initialize(&stream, state->src, state->src_size) ||
-				!stream_read(&stream, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr))
-			{
-				goto writeregular;
-			}
+	return bytes_needed;
+}
 
-			/* Assign the uppercase code point to the start of the stream */
+size_t casemapping_execute_default(CaseMappingState* state, int32_t* errors)
+{
+	uint32_t properties;
+	uint8_t bytes_needed = 0;
+	const char* resolved = 0;
+	unicode_t mapped;
+	uint32_t record;
 
-			stream.codepoint[0] = state->last_code_point;
+	/* Read next code point */
 
-			/* Remove COMBINING DOT ABOVE from sequence */
+	state->last_code_point_size = codepoint_read(state->src, state->src_size, &state->last_code_point);
+	if (state->last_code_point_size == 0)
+	{
+		goto invaliddata;
+	}
 
-			for (i = 1; i < stream.current; ++i)
-			{
-				if (stream.codepoint[i] == CP_COMBINING_DOT_ABOVE)
-				{
-					stream.canonical_combining_class[i] = CCC_INVALID;
-					erase_count++;
-				}
-			}
+	/* Check for invalid characters */
 
-			/* Stabilize the sequence */
+	if (state->last_code_point == REPLACEMENT_CHARACTER)
+	{
+		/* Get code point properties */
 
-			if (!stream.stable ||
-				erase_count > 0)
-			{
-				stream_reorder(&stream);
+		state->last_canonical_combining_class = CCC_NOT_REORDERED;
+		state->last_general_category = UTF8_CATEGORY_SYMBOL_OTHER;
 
-				stream.current -= erase_count;
-			}
-		}
+		resolved = REPLACEMENT_CHARACTER_STRING;
+		bytes_needed = REPLACEMENT_CHARACTER_STRING_LENGTH;
 
-		goto writestream;
+		goto writeresolved;
 	}
 
-writeregular:
 	/* Get code point properties */
 
-	state->last_canonical_combining_class = PROPERTY_GET_CCC(state->last_code_point);
-	state->last_general_category = PROPERTY_GET_GC(state->last_code_point);
+	properties = database_queryproperties(state->last_code_point);
+
+	state->last_canonical_combining_class = PROPERTY_RECORD_CCC(properties);
+	state->last_general_category = PROPERTY_RECORD_GC(properties);
 
 	/* Move source cursor */
 
@@ -553,25 +334,38 @@ writeregular:
 
 		/* Check if the code point is case mapped */
 
-		qc_casemapped = PROPERTY_GET_CM(state->last_code_point);
-		if ((qc_casemapped & state->quickcheck_flags) != 0)
+		mapped = state->last_code_point;
+
+		if ((PROPERTY_RECORD_CM(properties) & state->quickcheck_flags) != 0)
 		{
 			/* Attempt to resolve the case mapping */
 
-			resolved = database_querydecomposition(state->last_code_point, state->property_index1, state->property_index2, state->property_data, &bytes_needed);
-			if (resolved != 0)
+			record = CASEMAPPING_GET(state->last_code_point, state->property_index1, state->property_index2, state->property_data);
+			if ((record & CASEMAPPING_RECORD_SIMPLE) != 0)
+			{
+				/* Code point properties */
+
+				state->last_general_category = UTF8_CATEGORY_LETTER;
+
+				mapped = CASEMAPPING_RECORD_MAPPED(state->last_code_point, record);
+			}
+			else if (
+				record != 0)
 			{
 				/* Code point properties */
 
 				state->last_general_category = UTF8_CATEGORY_LETTER;
 
+				resolved = CASEMAPPING_RECORD_STRING(record);
+				bytes_needed = CASEMAPPING_RECORD_LENGTH(record);
+
 				goto writeresolvedonly;
 			}
 		}
 
-		/* Write code point unchanged to output */
+		/* Write code point to output, mapped if it has a simple case mapping */
 
-		bytes_needed = codepoint_write(state->last_code_point, &state->dst, &state->dst_size);
+		bytes_needed = codepoint_write(mapped, &state->dst, &state->dst_size);
 		if (bytes_needed == 0)
 		{
 			goto outofspace;
@@ -611,38 +405,946 @@ writeresolvedonly:
 
 	return bytes_needed;
 
-writestream:
-	/* Get code point properties */
+invaliddata:
+	UTF8_SET_ERROR(INVALID_DATA);
+
+	state->src_size = 0;
 
-	state->last_code_point = stream.codepoint[stream.current - 1];
-	state->last_canonical_combining_class = stream.canonical_combining_class[stream.current - 1];
-	state->last_general_category = PROPERTY_GET_GC(stream.codepoint[0]);
+	return 0;
 
-	/* Move source cursor */
+outofspace:
+	UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
 
-	state->src = stream.src;
-	state->src_size = stream.src_size;
+	state->src_size = 0;
 
-	/* Write result to the output buffer */
+	return 0;
+}
+
+size_t casemapping_execute_turkish(CaseMappingState* state, int32_t* errors)
+{
+	const char* resolved = 0;
+	uint8_t bytes_needed = 0;
+	StreamState stream;
+	uint8_t i;
+
+	/* Read next code point, invalid data is handled by the default engine */
 
-	if (!stream_write(&stream, &state->dst, &state->dst_size, &bytes_needed))
+	state->last_code_point_size = codepoint_read(state->src, state->src_size, &state->last_code_point);
+	if (state->last_code_point_size == 0)
 	{
-		goto outofspace;
+		return casemapping_execute_default(state, errors);
 	}
 
-	return bytes_needed;
+	/*
+		Code point General Category does not need to be modified, because
+		all mappings result in the same General Category
+	*/
 
-invaliddata:
-	UTF8_SET_ERROR(INVALID_DATA);
+	if (state->property_data == LowercaseDataPtr)
+	{
+		if (state->last_code_point == CP_LATIN_CAPITAL_LETTER_I_WITH_DOT_ABOVE)
+		{
+			state->last_code_point = CP_LATIN_SMALL_LETTER_I;
 
-	state->src_size = 0;
+			resolved = "i";
+			bytes_needed = 1;
+		}
+		else if (
+			state->last_code_point == CP_LATIN_CAPITAL_LETTER_I)
+		{
+			if (state->src_size == 0)
+			{
+				/* Early-out for easy case */
 
-	return 0;
+				state->last_code_point = CP_LATIN_SMALL_LETTER_DOTLESS_I;
 
-outofspace:
-	UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
+				resolved = "\xC4\xB1";
+				bytes_needed = 2;
+			}
+			else
+			{
+				uint8_t found = 0;
 
-	state->src_size = 0;
+				/* Initialize stream and read the next sequence */
 
-	return 0;
+				if (!stream_initialize(&stream, state->src, state->src_size) ||
+					!stream_read(&stream, PROPERTY_SHIFT_NFC))
+				{
+					return casemapping_execute_default(state, errors);
+				}
+
+				/* Erase COMBINING DOT ABOVE from sequence */
+
+				for (i = stream.current - 1; i > 0; --i)
+				{
+					if (stream.codepoint[i] == CP_COMBINING_DOT_ABOVE)
+					{
+						stream.canonical_combining_class[i] = CCC_INVALID;
+
+						found++;
+					}
+				}
+
+				/* Stabilize sequence and write to output */
+
+				if (!stream.stable ||
+					found > 0)
+				{
+					stream_reorder(&stream);
+
+					stream.current -= found;
+				}
+
+				stream.codepoint[0] = (found > 0) ? CP_LATIN_SMALL_LETTER_I : CP_LATIN_SMALL_LETTER_DOTLESS_I;
+
+				return casemapping_write_stream(state, &stream, errors);
+			}
+		}
+	}
+	else
+	{
+		if (state->last_code_point == CP_LATIN_SMALL_LETTER_I)
+		{
+			state->last_code_point = CP_LATIN_CAPITAL_LETTER_I_WITH_DOT_ABOVE;
+
+			resolved = "\xC4\xB0";
+			bytes_needed = 2;
+		}
+		else if (
+			state->last_code_point == CP_LATIN_SMALL_LETTER_DOTLESS_I)
+		{
+			state->last_code_point = CP_LATIN_CAPITAL_LETTER_I;
+
+			resolved = "I";
+			bytes_needed = 1;
+		}
+	}
+
+	/* Check if mapping succeeded */
+
+	if (resolved != 0)
+	{
+		/* Code point properties */
+
+		state->last_general_category = UTF8_CATEGORY_LETTER;
+
+		return casemapping_write_resolved(state, resolved, bytes_needed, errors);
+	}
+
+	/* Other code points are mapped the same as in the default locale */
+
+	return casemapping_execute_default(state, errors);
+}
+
+size_t casemapping_execute_lithuanian(CaseMappingState* state, int32_t* errors)
+{
+	StreamState stream;
+	uint8_t i;
+
+	/* Read next code point, invalid data is handled by the default engine */
+
+	state->last_code_point_size = codepoint_read(state->src, state->src_size, &state->last_code_point);
+	if (state->last_code_point_size == 0)
+	{
+		return casemapping_execute_default(state, errors);
+	}
+
+	if (state->property_data == LowercaseDataPtr)
+	{
+		unicode_t cp_additional_accent = 0;
+		uint8_t write_soft_dot = 1;
+
+		switch (state->last_code_point)
+		{
+
+		case CP_LATIN_CAPITAL_LETTER_I:
+			state->last_code_point = CP_LATIN_SMALL_LETTER_I;
+			break;
+
+		case CP_LATIN_CAPITAL_LETTER_J:
+			state->last_code_point = CP_LATIN_SMALL_LETTER_J;
+			break;
+
+		case CP_LATIN_CAPITAL_LETTER_I_WITH_OGONEK:
+			state->last_code_point = CP_LATIN_SMALL_LETTER_I_WITH_OGONEK;
+			break;
+
+		case CP_LATIN_CAPITAL_LETTER_I_WITH_GRAVE:
+			state->last_code_point = CP_LATIN_SMALL_LETTER_I;
+			cp_additional_accent = CP_COMBINING_GRAVE_ACCENT;
+			break;
+
+		case CP_LATIN_CAPITAL_LETTER_I_WITH_ACUTE:
+			state->last_code_point = CP_LATIN_SMALL_LETTER_I;
+			cp_additional_accent = CP_COMBINING_ACUTE_ACCENT;
+			break;
+
+		case CP_LATIN_CAPITAL_LETTER_I_WITH_TILDE:
+			state->last_code_point = CP_LATIN_SMALL_LETTER_I;
+			cp_additional_accent = CP_COMBINING_TILDE_ACCENT;
+			break;
+
+		default:
+			return casemapping_execute_default(state, errors);
+
+		}
+
+		/* Initialize stream and read the next sequence */
+
+		if (!stream_initialize(&stream, state->src, state->src_size) ||
+			!stream_read(&stream, PROPERTY_SHIFT_NFC))
+		{
+			return casemapping_execute_default(state, errors);
+		}
+
+		/* Assign the lowercase code point to the start of the stream */
+
+		stream.codepoint[0] = state->last_code_point;
+
+		/* Check if COMBINING DOT ABOVE is not yet present */ 
+
+		for (i = stream.current - 1; i > 0; --i)
+		{
+			if (stream.codepoint[i] == CP_COMBINING_DOT_ABOVE)
+			{
+				write_soft_dot = 0;
+
+				break;
+			}
+		}
+
+		/* Stabilize the sequence */
+
+		if (!stream.stable)
+		{
+			stream_reorder(&stream);
+
+			stream.stable = 1;
+		}
+
+		/* Write COMBINING DOT ABOVE */
+
+		if (write_soft_dot &&
+			stream.current < STREAM_BUFFER_MAX)
+		{
+			/* Ensure the COMBINING DOT ABOVE comes before other accents with the same CCC */
+
+			if (stream.canonical_combining_class[stream.current - 1] == CCC_ABOVE)
+			{
+				unicode_t cp_swap = stream.codepoint[stream.current - 1];
+				stream.codepoint[stream.current - 1] = CP_COMBINING_DOT_ABOVE;
+				stream.codepoint[stream.current] = cp_swap;
+			}
+			else
+			{
+				stream.codepoint[stream.current] = CP_COMBINING_DOT_ABOVE;
+			}
+
+			stream.canonical_combining_class[stream.current] = CCC_ABOVE;
+
+			/* Check if sequence has become unstable */
+
+			stream.stable = stream.canonical_combining_class[stream.current - 1] <= CCC_ABOVE;
+
+			stream.current++;
+		}
+
+		/* Write additional accent */
+
+		if (cp_additional_accent != 0 &&
+			stream.current < STREAM_BUFFER_MAX)
+		{
+			/* Additional accents are always of the upper variety */
+
+			stream.codepoint[stream.current] = cp_additional_accent;
+			stream.canonical_combining_class[stream.current] = CCC_ABOVE;
+
+			/* Check if sequence has become unstable */
+
+			if (stream.stable &&
+				stream.canonical_combining_class[stream.current] < stream.canonical_combining_class[stream.current - 1])
+			{
+				stream.stable = 0;
+			}
+
+			stream.current++;
+		}
+
+		/* Stabilize the sequence */
+
+		if (!stream.stable)
+		{
+			stream_reorder(&stream);
+		}
+	}
+	else
+	{
+		uint8_t erase_count = 0;
+
+		switch (state->last_code_point)
+		{
+
+		case CP_LATIN_SMALL_LETTER_I:
+			state->last_code_point = CP_LATIN_CAPITAL_LETTER_I;
+			break;
+
+		case CP_LATIN_SMALL_LETTER_J:
+			state->last_code_point = CP_LATIN_CAPITAL_LETTER_J;
+			break;
+
+		case CP_LATIN_SMALL_LETTER_I_WITH_OGONEK:
+			state->last_code_point = CP_LATIN_CAPITAL_LETTER_I_WITH_OGONEK;
+			break;
+
+		default:
+			return casemapping_execute_default(state, errors);
+
+		}
+
+		/* Initialize stream and read the next sequence */
+
+		if (!stream_initialize(&stream, state->src, state->src_size) ||
+			!stream_read(&stream, PROPERTY_SHIFT_NFC))
+		{
+			return casemapping_execute_default(state, errors);
+		}
+
+		/* Assign the uppercase code point to the start of the stream */
+
+		stream.codepoint[0] = state->last_code_point;
+
+		/* Remove COMBINING DOT ABOVE from sequence */
+
+		for (i = 1; i < stream.current; ++i)
+		{
+			if (stream.codepoint[i] == CP_COMBINING_DOT_ABOVE)
+			{
+				stream.canonical_combining_class[i] = CCC_INVALID;
+				erase_count++;
+			}
+		}
+
+		/* Stabilize the sequence */
+
+		if (!stream.stable ||
+			erase_count > 0)
+		{
+			stream_reorder(&stream);
+
+			stream.current -= erase_count;
+		}
+	}
+
+	return casemapping_write_stream(state, &stream, errors);
+}
+
+size_t casemapping_execute_casefold(CaseMappingState* state, int32_t* errors)
+{
+	const char* resolved = 0;
+	uint8_t bytes_needed = 0;
+	unicode_t mapped;
+	uint32_t record;
+
+	/* Read next code point */
+
+	state->last_code_point_size = codepoint_read(state->src, state->src_size, &state->last_code_point);
+	if (state->last_code_point_size == 0)
+	{
+		UTF8_SET_ERROR(INVALID_DATA);
+
+		state->src_size = 0;
+
+		return 0;
+	}
+
+	mapped = state->last_code_point;
+
+	/* Move source cursor */
+
+	if (state->src_size >= state->last_code_point_size)
+	{
+		state->src += state->last_code_point_size;
+		state->src_size -= state->last_code_point_size;
+	}
+	else
+	{
+		state->src_size = 0;
+	}
+
+	/* Resolve case folding */
+
+	if ((PROPERTY_GET_CM(state->last_code_point) & state->quickcheck_flags) != 0)
+	{
+		if (state->locale == UTF8_LOCALE_TURKISH_AND_AZERI_LATIN &&
+			state->last_code_point == CP_LATIN_CAPITAL_LETTER_I)
+		{
+			resolved = "\xC4\xB1";
+			bytes_needed = 2;
+		}
+		else if (
+			state->locale == UTF8_LOCALE_TURKISH_AND_AZERI_LATIN &&
+			state->last_code_point == CP_LATIN_CAPITAL_LETTER_I_WITH_DOT_ABOVE)
+		{
+			resolved = "i";
+			bytes_needed = 1;
+		}
+		else
+		{
+			record = CASEMAPPING_GET(state->last_code_point, state->property_index1, state->property_index2, state->property_data);
+			if ((record & CASEMAPPING_RECORD_SIMPLE) != 0)
+			{
+				mapped = CASEMAPPING_RECORD_MAPPED(state->last_code_point, record);
+			}
+			else if (
+				record != 0)
+			{
+				resolved = CASEMAPPING_RECORD_STRING(record);
+				bytes_needed = CASEMAPPING_RECORD_LENGTH(record);
+			}
+		}
+	}
+
+	/* Write to output */
+
+	if (resolved != 0)
+	{
+		if (state->dst != 0)
+		{
+			if (state->dst_size < bytes_needed)
+			{
+				goto outofspace;
+			}
+
+			memcpy(state->dst, resolved, bytes_needed);
+
+			state->dst += bytes_needed;
+			state->dst_size -= bytes_needed;
+		}
+	}
+	else
+	{
+		/* Write code point to output, mapped if it has a simple case mapping */
+
+		bytes_needed = codepoint_write(mapped, &state->dst, &state->dst_size);
+		if (bytes_needed == 0)
+		{
+			goto outofspace;
+		}
+	}
+
+	return bytes_needed;
+
+outofspace:
+	UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
+
+	state->src_size = 0;
+
+	return 0;
+}
+
+CaseMappingExecute casemapping_engine(size_t locale)
+{
+	switch (locale)
+	{
+
+	case UTF8_LOCALE_LITHUANIAN:
+		return casemapping_execute_lithuanian;
+
+	case UTF8_LOCALE_TURKISH_AND_AZERI_LATIN:
+		return casemapping_execute_turkish;
+
+	default:
+		return casemapping_execute_default;
+
+	}
+}
+
+size_t casemapping_execute(CaseMappingState* state, int32_t* errors)
+{
+	return casemapping_engine(state->locale)(state, errors);
+}
+
+size_t casemapping_execute_basic_latin(CaseMappingState* state)
+{
+#if UTF8_SIMD_SSE2
+	const char* src_start = state->src;
+	__m128i first;
+	__m128i last;
+	__m128i special_upper;
+	__m128i special_lower;
+	uint8_t to_lower = state->property_data == LowercaseDataPtr || state->property_data == CaseFoldingDataPtr;
+
+	/* Mapping either case to the other, case folding maps Basic Latin to lowercase */
+
+	if (to_lower)
+	{
+		first = _mm_set1_epi8(0x41 - 1);
+		last = _mm_set1_epi8(0x5A + 1);
+	}
+	else
+	{
+		first = _mm_set1_epi8(0x61 - 1);
+		last = _mm_set1_epi8(0x7A + 1);
+	}
+
+	/* Letters with locale-specific mappings are left to casemapping_execute */
+
+	switch (state->locale)
+	{
+
+	case UTF8_LOCALE_LITHUANIAN:
+		special_upper = _mm_set1_epi8(to_lower ? 'I' : 'i');
+		special_lower = _mm_set1_epi8(to_lower ? 'J' : 'j');
+		break;
+
+	case UTF8_LOCALE_TURKISH_AND_AZERI_LATIN:
+		special_upper = _mm_set1_epi8(to_lower ? 'I' : 'i');
+		special_lower = special_upper;
+		break;
+
+	default:
+		/* Never matches a Basic Latin byte */
+
+		special_upper = _mm_set1_epi8((char)0x80);
+		special_lower = special_upper;
+		break;
+
+	}
+
+	while (state->src_size >= 16 &&
+		(state->dst == 0 || state->dst_size >= 16))
+	{
+		__m128i block = _mm_loadu_si128((const __m128i*)state->src);
+		__m128i letters;
+		unsigned int stop;
+		size_t count;
+
+		/* Stop at the first byte that is not Basic Latin or has a locale-specific mapping */
+
+		stop = (unsigned int)_mm_movemask_epi8(_mm_or_si128(block,
+			_mm_or_si128(_mm_cmpeq_epi8(block, special_upper), _mm_cmpeq_epi8(block, special_lower))));
+
+		if (stop == 0)
+		{
+			count = 16;
+		}
+		else
+		{
+			for (count = 0; (stop & (1 << count)) == 0; ++count)
+			{
+			}
+		}
+
+		if (count == 0)
+		{
+			break;
+		}
+
+		/* Flip the case bit of letters in range */
+
+		letters = _mm_and_si128(_mm_cmpgt_epi8(block, first), _mm_cmplt_epi8(block, last));
+		block = _mm_xor_si128(block, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+
+		if (state->dst != 0)
+		{
+			if (count == 16)
+			{
+				_mm_storeu_si128((__m128i*)state->dst, block);
+			}
+			else
+			{
+				char mapped[16];
+
+				_mm_storeu_si128((__m128i*)mapped, block);
+				memcpy(state->dst, mapped, count);
+			}
+
+			state->dst += count;
+			state->dst_size -= count;
+		}
+
+		state->src += count;
+		state->src_size -= count;
+
+		if (count < 16)
+		{
+			break;
+		}
+	}
+
+	if (state->src == src_start)
+	{
+		return 0;
+	}
+
+	/* Code point properties */
+
+	state->last_code_point = (unicode_t)(uint8_t)state->src[-1];
+	state->last_code_point_size = 1;
+	state->last_canonical_combining_class = CCC_NOT_REORDERED;
+	state->last_general_category = PROPERTY_GET_GC(state->last_code_point);
+
+	return (size_t)(state->src - src_start);
+#else
+	/* Every code point is mapped by casemapping_execute */
+
+	(void)state;
+
+	return 0;
+#endif
+}
+
+static void casemapping_fold_initialize(CaseFoldingState* state, const char* input, size_t inputSize, size_t locale)
+{
+	state->src = input;
+	state->src_size = inputSize;
+	state->resolved = 0;
+	state->resolved_size = 0;
+	state->locale = locale;
+}
+
+static UTF8_INLINE uint8_t casemapping_fold(CaseFoldingState* state, unicode_t* codePoint)
+{
+	uint8_t code_point_size;
+	uint32_t record;
+
+	if (state->resolved_size > 0)
+	{
+		/* Continue with the code points of a folding to a string */
+
+		code_point_size = codepoint_read(state->resolved, state->resolved_size, codePoint);
+
+		state->resolved += code_point_size;
+		state->resolved_size -= code_point_size;
+
+		return 1;
+	}
+
+	if (state->src_size == 0)
+	{
+		return 0;
+	}
+
+	if ((uint8_t)state->src[0] <= MAX_BASIC_LATIN)
+	{
+		/* Basic Latin is folded to lowercase, except for the Turkish dotless I */
+
+		*codePoint = (unicode_t)state->src[0];
+
+		if (*codePoint >= 0x41 &&
+			*codePoint <= 0x5A)
+		{
+			*codePoint = (*codePoint == CP_LATIN_CAPITAL_LETTER_I && state->locale == UTF8_LOCALE_TURKISH_AND_AZERI_LATIN)
+				? CP_LATIN_SMALL_LETTER_DOTLESS_I
+				: *codePoint + 0x20;
+		}
+
+		state->src++;
+		state->src_size--;
+
+		return 1;
+	}
+
+	/* Read next code point, invalid sequences are read as U+FFFD REPLACEMENT CHARACTER */
+
+	code_point_size = codepoint_read(state->src, state->src_size, codePoint);
+
+	/* Move source cursor */
+
+	if (state->src_size >= code_point_size)
+	{
+		state->src += code_point_size;
+		state->src_size -= code_point_size;
+	}
+	else
+	{
+		state->src_size = 0;
+	}
+
+	/* Resolve case folding, code points without one are left as they are */
+
+	if ((PROPERTY_GET_CM(*codePoint) & QuickCheckCaseMapped_Casefolded) != 0)
+	{
+		if (*codePoint == CP_LATIN_CAPITAL_LETTER_I_WITH_DOT_ABOVE &&
+			state->locale == UTF8_LOCALE_TURKISH_AND_AZERI_LATIN)
+		{
+			*codePoint = CP_LATIN_SMALL_LETTER_I;
+		}
+		else
+		{
+			record = CASEMAPPING_GET(*codePoint, CaseFoldingIndex1Ptr, CaseFoldingIndex2Ptr, CaseFoldingDataPtr);
+			if ((record & CASEMAPPING_RECORD_SIMPLE) != 0)
+			{
+				*codePoint = CASEMAPPING_RECORD_MAPPED(*codePoint, record);
+			}
+			else if (
+				record != 0)
+			{
+				state->resolved = CASEMAPPING_RECORD_STRING(record);
+				state->resolved_size = CASEMAPPING_RECORD_LENGTH(record);
+
+				/* Start with the first code point of the string */
+
+				code_point_size = codepoint_read(state->resolved, state->resolved_size, codePoint);
+
+				state->resolved += code_point_size;
+				state->resolved_size -= code_point_size;
+			}
+		}
+	}
+
+	return 1;
+}
+
+int casemapping_compare(const char* left, size_t leftSize, const char* right, size_t rightSize, size_t count, size_t locale)
+{
+	CaseFoldingState left_state;
+	CaseFoldingState right_state;
+	unicode_t left_code_point;
+	unicode_t right_code_point;
+	uint8_t left_read;
+	uint8_t right_read;
+
+	casemapping_fold_initialize(&left_state, left, leftSize, locale);
+	casemapping_fold_initialize(&right_state, right, rightSize, locale);
+
+	while (count > 0)
+	{
+#if UTF8_SIMD_SSE2
+		/* Compare blocks of Basic Latin while neither side is in the middle of a folding to a string */
+
+		while (
+			left_state.resolved_size == 0 && right_state.resolved_size == 0 &&
+			left_state.src_size >= 16 && right_state.src_size >= 16 &&
+			count >= 16)
+		{
+			__m128i left_block = _mm_loadu_si128((const __m128i*)left_state.src);
+			__m128i right_block = _mm_loadu_si128((const __m128i*)right_state.src);
+			__m128i first = _mm_set1_epi8(0x41 - 1);
+			__m128i last = _mm_set1_epi8(0x5A + 1);
+			__m128i letters;
+			unsigned int differ;
+			size_t index;
+
+			if (_mm_movemask_epi8(_mm_or_si128(left_block, right_block)) != 0)
+			{
+				break;
+			}
+
+			if (locale == UTF8_LOCALE_TURKISH_AND_AZERI_LATIN)
+			{
+				/* LATIN CAPITAL LETTER I is folded to a code point outside Basic Latin */
+
+				__m128i dotless = _mm_set1_epi8('I');
+
+				if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(left_block, dotless), _mm_cmpeq_epi8(right_block, dotless))) != 0)
+				{
+					break;
+				}
+			}
+
+			/* Fold uppercase letters to lowercase */
+
+			letters = _mm_and_si128(_mm_cmpgt_epi8(left_block, first), _mm_cmplt_epi8(left_block, last));
+			left_block = _mm_xor_si128(left_block, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+
+			letters = _mm_and_si128(_mm_cmpgt_epi8(right_block, first), _mm_cmplt_epi8(right_block, last));
+			right_block = _mm_xor_si128(right_block, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+
+			differ = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(left_block, right_block)) ^ 0xFFFF;
+			if (differ != 0)
+			{
+				char left_folded[16];
+				char right_folded[16];
+
+				for (index = 0; (differ & (1 << index)) == 0; ++index)
+				{
+				}
+
+				_mm_storeu_si128((__m128i*)left_folded, left_block);
+				_mm_storeu_si128((__m128i*)right_folded, right_block);
+
+				return (left_folded[index] < right_folded[index]) ? -1 : 1;
+			}
+
+			left_state.src += 16;
+			left_state.src_size -= 16;
+			right_state.src += 16;
+			right_state.src_size -= 16;
+
+			count -= 16;
+		}
+
+		if (count == 0)
+		{
+			break;
+		}
+#endif
+
+		/*
+			Compare one folded code point of each side at a time. A folding to
+			more than one code point is compared against the foldings that
+			follow on the other side.
+		*/
+
+		left_read = casemapping_fold(&left_state, &left_code_point);
+		right_read = casemapping_fold(&right_state, &right_code_point);
+
+		if (left_read == 0 ||
+			right_read == 0)
+		{
+			/* The shorter text comes first */
+
+			return (int)left_read - (int)right_read;
+		}
+
+		if (left_code_point != right_code_point)
+		{
+			return (left_code_point < right_code_point) ? -1 : 1;
+		}
+
+		count--;
+	}
+
+	return 0;
+}
+
+/*
+	Mixing and secrets from wyhash, which is released into the public domain.
+	The 128-bit product of two 64-bit values is folded to 64 bits.
+*/
+
+#define CASEMAPPING_HASH_SECRET0 (0xA0761D6478BD642FULL)
+#define CASEMAPPING_HASH_SECRET1 (0xE7037ED1A0B428DBULL)
+
+static UTF8_INLINE uint64_t casemapping_hash_mix(uint64_t left, uint64_t right)
+{
+#if defined(__SIZEOF_INT128__)
+	__extension__ unsigned __int128 product = (unsigned __int128)left * right;
+
+	return (uint64_t)product ^ (uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	uint64_t high;
+	uint64_t low = _umul128(left, right, &high);
+
+	return low ^ high;
+#else
+	uint64_t left_high = left >> 32;
+	uint64_t left_low = (uint32_t)left;
+	uint64_t right_high = right >> 32;
+	uint64_t right_low = (uint32_t)right;
+	uint64_t high_high = left_high * right_high;
+	uint64_t high_low = left_high * right_low;
+	uint64_t low_high = left_low * right_high;
+	uint64_t low_low = left_low * right_low;
+	uint64_t middle = high_low + (low_low >> 32) + (uint32_t)low_high;
+
+	return ((middle << 32) | (uint32_t)low_low) ^ (high_high + (middle >> 32) + (low_high >> 32));
+#endif
+}
+
+static UTF8_INLINE uint64_t casemapping_hash_block(const char* block, uint64_t hash)
+{
+	uint64_t first;
+	uint64_t second;
+
+	memcpy(&first, block, sizeof(uint64_t));
+	memcpy(&second, block + sizeof(uint64_t), sizeof(uint64_t));
+
+	return casemapping_hash_mix(first ^ CASEMAPPING_HASH_SECRET1, second ^ hash);
+}
+
+uint64_t casemapping_hash(const char* input, size_t inputSize, size_t locale, uint64_t seed)
+{
+	CaseFoldingState state;
+	unicode_t code_point;
+	char buffer[32];
+	size_t buffered = 0;
+	uint64_t length = 0;
+	uint64_t hash;
+	char* dst;
+	size_t dst_size;
+
+	casemapping_fold_initialize(&state, input, inputSize, locale);
+
+	hash = seed ^ casemapping_hash_mix(seed ^ CASEMAPPING_HASH_SECRET0, CASEMAPPING_HASH_SECRET1);
+
+	/*
+		The folded UTF-8 is hashed in blocks of 16 bytes. Folded code points
+		are collected in a buffer until a block is complete, so the hash only
+		depends on the folded text and not on how it was read.
+	*/
+
+	while (1)
+	{
+#if UTF8_SIMD_SSE2
+		/* Fold blocks of Basic Latin at once */
+
+		while (
+			state.resolved_size == 0 &&
+			state.src_size >= 16)
+		{
+			__m128i block = _mm_loadu_si128((const __m128i*)state.src);
+			__m128i letters;
+
+			if (_mm_movemask_epi8(block) != 0 ||
+				(locale == UTF8_LOCALE_TURKISH_AND_AZERI_LATIN &&
+				_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8('I'))) != 0))
+			{
+				break;
+			}
+
+			letters = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(0x41 - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8(0x5A + 1)));
+			block = _mm_xor_si128(block, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+
+			_mm_storeu_si128((__m128i*)(buffer + buffered), block);
+
+			hash = casemapping_hash_block(buffer, hash);
+
+			memcpy(buffer, buffer + 16, 16);
+
+			state.src += 16;
+			state.src_size -= 16;
+
+			length += 16;
+		}
+#endif
+
+		if (!casemapping_fold(&state, &code_point))
+		{
+			break;
+		}
+
+		/* Append folded code point to the buffer */
+
+		if (code_point <= MAX_BASIC_LATIN)
+		{
+			buffer[buffered++] = (char)code_point;
+		}
+		else
+		{
+			dst = buffer + buffered;
+			dst_size = sizeof(buffer) - buffered;
+
+			buffered += codepoint_write(code_point, &dst, &dst_size);
+		}
+
+		if (buffered >= 16)
+		{
+			hash = casemapping_hash_block(buffer, hash);
+
+			memcpy(buffer, buffer + 16, 16);
+			buffered -= 16;
+
+			length += 16;
+		}
+	}
+
+	/* Hash the remaining bytes padded with zeroes, the length tells them apart from actual zeroes */
+
+	memset(buffer + buffered, 0, 16 - buffered);
+
+	length += buffered;
+
+	return casemapping_hash_mix(CASEMAPPING_HASH_SECRET1 ^ length, casemapping_hash_block(buffer, hash));
 }
\ No newline at end of file
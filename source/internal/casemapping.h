@@ -52,6 +52,14 @@ typedef struct {
 	uint8_t quickcheck_flags;
 } CaseMappingState;
 
+typedef struct {
+	const char* src;
+	size_t src_size;
+	const char* resolved;
+	size_t resolved_size;
+	size_t locale;
+} CaseFoldingState;
+
 uint8_t casemapping_initialize(
 	CaseMappingState* state,
 	const char* input, size_t inputSize,
@@ -60,8 +68,26 @@ uint8_t casemapping_initialize(
 	uint8_t quickCheck, size_t locale,
 	int32_t* errors);
 
+typedef size_t (*CaseMappingExecute)(CaseMappingState* state, int32_t* errors);
+
+size_t casemapping_execute_default(CaseMappingState* state, int32_t* errors);
+
+size_t casemapping_execute_lithuanian(CaseMappingState* state, int32_t* errors);
+
+size_t casemapping_execute_turkish(CaseMappingState* state, int32_t* errors);
+
+size_t casemapping_execute_casefold(CaseMappingState* state, int32_t* errors);
+
+CaseMappingExecute casemapping_engine(size_t locale);
+
 size_t casemapping_execute(CaseMappingState* state, int32_t* errors);
 
+size_t casemapping_execute_basic_latin(CaseMappingState* state);
+
+int casemapping_compare(const char* left, size_t leftSize, const char* right, size_t rightSize, size_t count, size_t locale);
+
+uint64_t casemapping_hash(const char* input, size_t inputSize, size_t locale, uint64_t seed);
+
 /*! \endcond */
 
 #endif /* _UTF8REWIND_INTERNAL_CASEMAPPING_H_ */
\ No newline at end of file
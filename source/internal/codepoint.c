@@ -77,6 +77,75 @@ const uint8_t codepoint_decoded_length[256] = {
 	7, 7                    /* 0xFE - 0xFF */
 };
 
+/*
+	Decoding is driven by a state machine. Every byte is mapped to one of
+	sixteen classes, which selects the transition from the current state.
+	States are stored premultiplied by the number of classes.
+
+	A sequence is consumed according to its lead byte, like before, but
+	whether the result is valid is already decided by the first two bytes.
+	The "X" states consume the rest of an overlong sequence, a surrogate
+	pair or a code point above U+10FFFF that is replaced afterwards.
+*/
+
+#define DECODE_STATE_START   (0)
+#define DECODE_STATE_ACCEPT  (208)
+#define DECODE_STATE_REJECT  (224)
+#define DECODE_STATE_STOP    (240)
+
+const uint8_t codepoint_decoded_class[256] = {
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x00 - 0x0F */
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x10 - 0x1F */
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x20 - 0x2F */
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x30 - 0x3F */
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x40 - 0x4F */
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x50 - 0x5F */
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x60 - 0x6F */
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x70 - 0x7F */
+	 1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1, /* 0x80 - 0x8F */
+	 2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2, /* 0x90 - 0x9F */
+	 3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3, /* 0xA0 - 0xAF */
+	 3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3, /* 0xB0 - 0xBF */
+	 4,  4,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5, /* 0xC0 - 0xCF */
+	 5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5, /* 0xD0 - 0xDF */
+	 6,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  8,  7,  7, /* 0xE0 - 0xEF */
+	 9, 10, 10, 10, 11, 12, 12, 12, 13, 13, 13, 13, 14, 14, 15, 15  /* 0xF0 - 0xFF */
+};
+
+const uint8_t codepoint_decoded_state[208] = {
+	/* Start of sequence */
+	208, 224, 224, 224, 128,  16,  64,  32,  80,  96,  48, 112, 160, 176, 192, 224,
+	/* One byte left */
+	240, 208, 208, 208, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	/* Two bytes left */
+	240,  16,  16,  16, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	/* Three bytes left */
+	240,  32,  32,  32, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	/* After 0xE0, 0xA0 - 0xBF */
+	240, 128, 128,  16, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	/* After 0xED, 0x80 - 0x9F */
+	240,  16,  16, 128, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	/* After 0xF0, 0x90 - 0xBF */
+	240, 144,  32,  32, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	/* After 0xF4, 0x80 - 0x8F */
+	240,  32, 144, 144, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	/* Invalid, one byte left */
+	240, 224, 224, 224, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	/* Invalid, two bytes left */
+	240, 128, 128, 128, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	/* Invalid, three bytes left */
+	240, 144, 144, 144, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	/* Invalid, four bytes left */
+	240, 160, 160, 160, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	/* Invalid, five bytes left */
+	240, 176, 176, 176, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240
+};
+
+static const uint8_t DecodeMask[16] = {
+	0x7F, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x0F, 0x0F,
+	0x0F, 0x07, 0x07, 0x07, 0x07, 0x00, 0x00, 0x00
+};
+
 uint8_t codepoint_write(unicode_t encoded, char** target, size_t* targetSize)
 {
 	uint8_t encoded_length;
@@ -161,6 +230,9 @@ uint8_t codepoint_write(unicode_t encoded, char** target, size_t* targetSize)
 uint8_t codepoint_read(const char* input, size_t inputSize, unicode_t* decoded)
 {
 	const uint8_t* src = (const uint8_t*)input;
+	uint8_t src_class;
+	uint8_t state;
+	uint8_t decoded_length;
 
 	if (input == 0 ||
 		inputSize == 0)
@@ -178,95 +250,43 @@ uint8_t codepoint_read(const char* input, size_t inputSize, unicode_t* decoded)
 
 		return 1;
 	}
-	else
-	{
-		/* Multi-byte sequence */
 
-		static const uint8_t SequenceMask[7] = {
-			0x00, 0x7F, 0x1F, 0x0F,
-			0x07, 0x03, 0x01
-		};
-		static const unicode_t SequenceMinimum[7] = {
-			0x0000, 0x0000, 0x0080, 0x0800,
-			0x10000, MAX_LEGAL_UNICODE, MAX_LEGAL_UNICODE
-		};
+	/* Lead byte */
 
-		size_t src_size = inputSize;
-		uint8_t src_index;
+	src_class = codepoint_decoded_class[*src];
+	state = codepoint_decoded_state[DECODE_STATE_START + src_class];
+	*decoded = (unicode_t)(*src & DecodeMask[src_class]);
+	decoded_length = 1;
 
-		/* Length of sequence is determined by first byte */
+	/* Continuation bytes */
 
-		uint8_t decoded_length = codepoint_decoded_length[*src];
-		if (decoded_length < 1 ||
-			decoded_length > 6)
-		{
-			/* Not a multi-byte sequence starter */
-
-			*decoded = REPLACEMENT_CHARACTER;
-			decoded_length = 1;
-		}
-		else if (decoded_length > 4)
+	while (state < DECODE_STATE_ACCEPT)
+	{
+		if ((size_t)decoded_length == inputSize)
 		{
-			/* Always an overlong sequence */
-
-			*decoded = REPLACEMENT_CHARACTER;
-
-			/* All bytes in the sequence must be processed */
-
-			for (src_index = 1; src_index < decoded_length; ++src_index)
-			{
-				src++;
+			/* Not enough data */
 
-				/* Check if next byte is valid */
+			state = DECODE_STATE_STOP;
 
-				if (src_size == 0 ||               /* Not enough data */
-					(*src < 0x80 || *src > 0xBF))  /* Not a continuation byte */
-				{
-					return src_index;
-				}
-
-				src_size--;
-			}
+			break;
 		}
-		else
-		{
-			/* Use mask to strip value from first byte */
-
-			*decoded = (unicode_t)(*src & SequenceMask[decoded_length]);
-
-			/* All bytes in the sequence must be processed */
-
-			for (src_index = 1; src_index < decoded_length; ++src_index)
-			{
-				src++;
-
-				/* Check if next byte is valid */
-
-				if (src_size == 0 ||               /* Not enough data */
-					(*src < 0x80 || *src > 0xBF))  /* Not a continuation byte */
-				{
-					*decoded = REPLACEMENT_CHARACTER;
-
-					return src_index;
-				}
 
-				src_size--;
-
-				/* Add value of continuation byte to codepoint */
-
-				*decoded = (*decoded << 6) | (*src & 0x3F);
-			}
-
-			/* Check for overlong sequences and surrogate pairs */
+		state = codepoint_decoded_state[state + codepoint_decoded_class[src[decoded_length]]];
+		if (state == DECODE_STATE_STOP)
+		{
+			/* Not a continuation byte */
 
-			if (*decoded < SequenceMinimum[decoded_length] ||
-				*decoded > MAX_LEGAL_UNICODE ||
-				(*decoded >= SURROGATE_HIGH_START && *decoded <= SURROGATE_LOW_END))
-			{
-				*decoded = REPLACEMENT_CHARACTER;
-			}
+			break;
 		}
 
-		return decoded_length;
+		*decoded = (*decoded << 6) | (src[decoded_length] & 0x3F);
+		decoded_length++;
 	}
+
+	if (state != DECODE_STATE_ACCEPT)
+	{
+		*decoded = REPLACEMENT_CHARACTER;
+	}
+
+	return decoded_length;
 }
\ No newline at end of file
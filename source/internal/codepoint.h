@@ -258,6 +258,23 @@
 */
 extern const uint8_t codepoint_decoded_length[256];
 
+/*!
+	\brief Get the class of a byte used for decoding.
+
+	\param[in]  byte  Encoded byte
+
+	\return Column in #codepoint_decoded_state.
+*/
+extern const uint8_t codepoint_decoded_class[256];
+
+/*!
+	\brief Transitions between the states used for decoding.
+
+	Indexed by the current state plus the class of the next byte. States are
+	multiples of 16, values of 208 and above end the sequence.
+*/
+extern const uint8_t codepoint_decoded_state[208];
+
 /*!
 	\brief Write Unicode code point to UTF-8 encoded string.
 
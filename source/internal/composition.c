@@ -51,13 +51,11 @@ uint8_t compose_initialize(ComposeState* state, StreamState* input, StreamState*
 
 	if (compatibility == 1)
 	{
-		state->qc_index = QuickCheckNFKCIndexPtr;
-		state->qc_data = QuickCheckNFKCDataPtr;
+		state->qc_shift = PROPERTY_SHIFT_NFKC;
 	}
 	else
 	{
-		state->qc_index = QuickCheckNFCIndexPtr;
-		state->qc_data = QuickCheckNFCDataPtr;
+		state->qc_shift = PROPERTY_SHIFT_NFC;
 	}
 
 	return 1;
@@ -66,7 +64,7 @@ uint8_t compose_initialize(ComposeState* state, StreamState* input, StreamState*
 uint8_t compose_readcodepoint(ComposeState* state, uint8_t index)
 {
 	if (state->input->index == state->input->current &&
-		!stream_read(state->input, state->qc_index, state->qc_data))
+		!stream_read(state->input, state->qc_shift))
 	{
 		/* End of data */
 
@@ -146,6 +144,7 @@ uint8_t compose_execute(ComposeState* state)
 				(state->output->quick_check[cursor_next] != QuickCheckResult_Yes && state->output->canonical_combining_class[cursor_next - 1] == CCC_NOT_REORDERED))
 			{
 				unicode_t composed = 0;
+				uint32_t composed_properties;
 
 				/*
 					Hangul composition
@@ -216,9 +215,11 @@ uint8_t compose_execute(ComposeState* state)
 
 					/* Add composition to output */
 
+					composed_properties = database_queryproperties(composed);
+
 					state->output->codepoint[cursor_current]                  = composed;
-					state->output->quick_check[cursor_current]                = PROPERTY_GET(state->qc_index, state->qc_data, composed);
-					state->output->canonical_combining_class[cursor_current]  = PROPERTY_GET_CCC(composed);
+					state->output->quick_check[cursor_current]                = PROPERTY_RECORD_QC(composed_properties, state->qc_shift);
+					state->output->canonical_combining_class[cursor_current]  = PROPERTY_RECORD_CCC(composed_properties);
 
 					/* Clear next codepoint from output */
 
@@ -0,0 +1,1568 @@
+/*
+	Copyright (C) 2014-2016 Quinten Lansu
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "conversion.h"
+
+#include "codepoint.h"
+#include "simd.h"
+#include "validation.h"
+
+#if UTF8_SIMD_SSE2
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+static size_t conversion_popcount(uint32_t mask)
+{
+	mask = mask - ((mask >> 1) & 0x55555555);
+	mask = (mask & 0x33333333) + ((mask >> 2) & 0x33333333);
+	mask = (mask + (mask >> 4)) & 0x0F0F0F0F;
+
+	return (size_t)((mask * 0x01010101) >> 24);
+}
+
+static size_t conversion_lowest_bit(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (size_t)__builtin_ctz(mask);
+#elif defined(_MSC_VER)
+	unsigned long index;
+
+	_BitScanForward(&index, mask);
+
+	return (size_t)index;
+#else
+	size_t index = 0;
+
+	while ((mask & 1) == 0)
+	{
+		mask >>= 1;
+		index++;
+	}
+
+	return index;
+#endif
+}
+
+static size_t conversion_highest_bit(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (size_t)(31 - __builtin_clz(mask));
+#elif defined(_MSC_VER)
+	unsigned long index;
+
+	_BitScanReverse(&index, mask);
+
+	return (size_t)index;
+#else
+	size_t index = 31;
+
+	while ((mask & 0x80000000) == 0)
+	{
+		mask <<= 1;
+		index--;
+	}
+
+	return index;
+#endif
+}
+
+static size_t conversion_encode_bmp(unicode_t codepoint, char* target)
+{
+	/* Code point must be in the Basic Multilingual Plane and not a surrogate */
+
+	if (codepoint <= MAX_BASIC_LATIN)
+	{
+		target[0] = (char)codepoint;
+
+		return 1;
+	}
+	else if (
+		codepoint <= 0x7FF)
+	{
+		target[0] = (char)(0xC0 | (codepoint >> 6));
+		target[1] = (char)(0x80 | (codepoint & 0x3F));
+
+		return 2;
+	}
+	else
+	{
+		target[0] = (char)(0xE0 | (codepoint >> 12));
+		target[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+		target[2] = (char)(0x80 | (codepoint & 0x3F));
+
+		return 3;
+	}
+}
+
+#endif
+
+size_t conversion_utf16toutf8(const utf16_t* input, size_t inputSize, char* target, size_t targetSize, size_t* written)
+{
+#if UTF8_SIMD_SSE2
+	const __m128i surrogate_mask = _mm_set1_epi16((short)0xF800);
+	const __m128i surrogate_value = _mm_set1_epi16((short)SURROGATE_HIGH_START);
+	const __m128i one_byte_maximum = _mm_set1_epi16(MAX_BASIC_LATIN);
+	const __m128i two_bytes_maximum = _mm_set1_epi16(0x7FF);
+	const __m128i continuation_mask = _mm_set1_epi32(0x3F);
+	const __m128i continuation_marker = _mm_set1_epi32(0x80);
+	const __m128i zero = _mm_setzero_si128();
+
+	const utf16_t* src = input;
+	size_t src_size = inputSize;
+	char* dst = target;
+	size_t dst_size = targetSize;
+	size_t bytes_written = 0;
+
+	/* Blocks of eight units, the output of a block takes at most 24 bytes */
+
+	while (src_size >= 8 * sizeof(utf16_t) &&
+		dst_size >= 32)
+	{
+		__m128i units = _mm_loadu_si128((const __m128i*)src);
+		int surrogates;
+		int one_byte;
+		int up_to_two_bytes;
+		size_t length;
+
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(units, one_byte_maximum), zero)) == 0xFFFF)
+		{
+			/* Basic Latin, sixteen units at a time while possible */
+
+			_mm_storel_epi64((__m128i*)dst, _mm_packus_epi16(units, units));
+
+			src += 8;
+			src_size -= 8 * sizeof(utf16_t);
+			dst += 8;
+			dst_size -= 8;
+			bytes_written += 8;
+
+			while (src_size >= 16 * sizeof(utf16_t) &&
+				dst_size >= 32)
+			{
+				__m128i first = _mm_loadu_si128((const __m128i*)src);
+				__m128i second = _mm_loadu_si128((const __m128i*)(src + 8));
+
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(_mm_or_si128(first, second), one_byte_maximum), zero)) != 0xFFFF)
+				{
+					break;
+				}
+
+				_mm_storeu_si128((__m128i*)dst, _mm_packus_epi16(first, second));
+
+				src += 16;
+				src_size -= 16 * sizeof(utf16_t);
+				dst += 16;
+				dst_size -= 16;
+				bytes_written += 16;
+			}
+
+			continue;
+		}
+
+		surrogates = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, surrogate_mask), surrogate_value));
+		if (surrogates != 0)
+		{
+			/* Convert the units before the surrogate pair and leave the pair to the caller */
+
+			while (*src < SURROGATE_HIGH_START ||
+				*src > SURROGATE_LOW_END)
+			{
+				length = conversion_encode_bmp((unicode_t)*src, dst);
+
+				dst += length;
+				dst_size -= length;
+				bytes_written += length;
+				src++;
+				src_size -= sizeof(utf16_t);
+			}
+
+			break;
+		}
+
+		/* Determine length of output, every bit is set twice */
+
+		one_byte = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(units, one_byte_maximum), zero));
+		up_to_two_bytes = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(units, two_bytes_maximum), zero));
+
+		length = 24 - (conversion_popcount((uint32_t)one_byte) / 2) - (conversion_popcount((uint32_t)up_to_two_bytes) / 2);
+
+		if (up_to_two_bytes == 0xFFFF &&
+			one_byte == 0)
+		{
+			/* Two bytes, lead byte in the low half of every unit */
+
+			__m128i lead = _mm_or_si128(_mm_srli_epi16(units, 6), _mm_set1_epi16(0xC0));
+			__m128i continuation = _mm_or_si128(_mm_and_si128(units, _mm_set1_epi16(0x3F)), _mm_set1_epi16(0x80));
+
+			_mm_storeu_si128((__m128i*)dst, _mm_or_si128(lead, _mm_slli_epi16(continuation, 8)));
+		}
+		else if (
+			up_to_two_bytes == 0)
+		{
+			/* Three bytes, written four bytes at a time and overlapping the next sequence */
+
+			char sequences[28];
+			size_t i;
+			size_t j;
+
+			for (i = 0; i < 2; ++i)
+			{
+				__m128i codepoints = (i == 0) ? _mm_unpacklo_epi16(units, zero) : _mm_unpackhi_epi16(units, zero);
+				__m128i lead = _mm_or_si128(_mm_srli_epi32(codepoints, 12), _mm_set1_epi32(0xE0));
+				__m128i middle = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(codepoints, 6), continuation_mask), continuation_marker);
+				__m128i last = _mm_or_si128(_mm_and_si128(codepoints, continuation_mask), continuation_marker);
+				__m128i encoded = _mm_or_si128(lead, _mm_or_si128(_mm_slli_epi32(middle, 8), _mm_slli_epi32(last, 16)));
+
+				for (j = 0; j < 4; ++j)
+				{
+					uint32_t sequence = (uint32_t)_mm_cvtsi128_si32(encoded);
+
+					memcpy(sequences + (i * 12) + (j * 3), &sequence, sizeof(sequence));
+
+					encoded = _mm_srli_si128(encoded, 4);
+				}
+			}
+
+			memcpy(dst, sequences, 24);
+		}
+		else
+		{
+			/* Mixed lengths */
+
+			char* encoded = dst;
+			size_t i;
+
+			for (i = 0; i < 8; ++i)
+			{
+				encoded += conversion_encode_bmp((unicode_t)src[i], encoded);
+			}
+		}
+
+		dst += length;
+		dst_size -= length;
+		bytes_written += length;
+		src += 8;
+		src_size -= 8 * sizeof(utf16_t);
+	}
+
+	*written = bytes_written;
+
+	return inputSize - src_size;
+#else
+	(void)input;
+	(void)inputSize;
+	(void)target;
+	(void)targetSize;
+
+	*written = 0;
+
+	return 0;
+#endif
+}
+
+size_t conversion_utf8toutf16(const char* input, size_t inputSize, utf16_t* target, size_t targetSize, size_t* written)
+{
+#if UTF8_SIMD_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i continuation_mask = _mm_set1_epi16(0x3F);
+
+	const char* src = input;
+	size_t src_size = inputSize;
+	utf16_t* dst = target;
+	size_t dst_size = targetSize;
+	size_t bytes_written = 0;
+
+	/* Blocks of sixteen bytes, the two bytes after a block are read as well */
+
+	while (src_size >= 18 &&
+		dst_size >= 16 * sizeof(utf16_t))
+	{
+		__m128i first = _mm_loadu_si128((const __m128i*)src);
+		__m128i second;
+		__m128i third;
+		uint32_t basic_latin;
+		uint32_t continuation;
+		uint32_t two_bytes;
+		uint32_t three_bytes;
+		uint32_t expected;
+		uint32_t invalid;
+		uint32_t starts;
+		uint32_t remaining;
+		utf16_t decoded[16];
+		size_t consumed;
+		size_t length;
+		size_t i;
+
+		if ((uint8_t)*src >= 0xF0)
+		{
+			/* Surrogate pair or invalid sequence */
+
+			break;
+		}
+		else if (
+			_mm_movemask_epi8(first) == 0)
+		{
+			/* Basic Latin */
+
+			_mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi8(first, zero));
+			_mm_storeu_si128((__m128i*)(dst + 8), _mm_unpackhi_epi8(first, zero));
+
+			dst += 16;
+			dst_size -= 16 * sizeof(utf16_t);
+			bytes_written += 16 * sizeof(utf16_t);
+			src += 16;
+			src_size -= 16;
+
+			continue;
+		}
+
+		second = _mm_loadu_si128((const __m128i*)(src + 1));
+		third = _mm_loadu_si128((const __m128i*)(src + 2));
+
+		/* Classify bytes, compared as signed values */
+
+		basic_latin = (uint32_t)_mm_movemask_epi8(first) ^ 0xFFFF;
+		continuation = (uint32_t)_mm_movemask_epi8(_mm_cmplt_epi8(first, _mm_set1_epi8((char)0xC0)));
+		two_bytes = (uint32_t)_mm_movemask_epi8(_mm_and_si128(
+			_mm_cmpgt_epi8(first, _mm_set1_epi8((char)0xC1)),
+			_mm_cmplt_epi8(first, _mm_set1_epi8((char)0xE0))));
+		three_bytes = (uint32_t)_mm_movemask_epi8(_mm_and_si128(
+			_mm_cmpgt_epi8(first, _mm_set1_epi8((char)0xDF)),
+			_mm_cmplt_epi8(first, _mm_set1_epi8((char)0xF0))));
+
+		/* Overlong sequences after 0xE0 and surrogates after 0xED are invalid */
+
+		invalid = (uint32_t)_mm_movemask_epi8(_mm_or_si128(
+			_mm_and_si128(
+				_mm_cmpeq_epi8(first, _mm_set1_epi8((char)0xE0)),
+				_mm_cmplt_epi8(second, _mm_set1_epi8((char)0xA0))),
+			_mm_and_si128(
+				_mm_cmpeq_epi8(first, _mm_set1_epi8((char)0xED)),
+				_mm_cmpgt_epi8(second, _mm_set1_epi8((char)0x9F)))));
+
+		/* Sequences must be followed by exactly the expected continuation bytes */
+
+		expected = (two_bytes << 1) | (three_bytes << 1) | (three_bytes << 2);
+		starts = (continuation ^ 0xFFFF) & ~expected;
+
+		invalid |= (continuation ^ expected) & 0xFFFF;
+		invalid |= (continuation | basic_latin | two_bytes | three_bytes) ^ 0xFFFF;
+		invalid |= 0x10000;
+
+		if ((expected & 0x10000) == 0)
+		{
+			starts |= 0x10000;
+		}
+
+		/* Stop at the start of the sequence containing the first problem */
+
+		starts &= ((invalid & (0 - invalid)) << 1) - 1;
+		if (starts == 0)
+		{
+			break;
+		}
+
+		consumed = conversion_highest_bit(starts);
+		if (consumed == 0)
+		{
+			break;
+		}
+
+		starts &= ((uint32_t)1 << consumed) - 1;
+		length = conversion_popcount(starts);
+
+		for (i = 0; i < 2; ++i)
+		{
+			__m128i lead = (i == 0) ? _mm_unpacklo_epi8(first, zero) : _mm_unpackhi_epi8(first, zero);
+			__m128i middle = _mm_and_si128((i == 0) ? _mm_unpacklo_epi8(second, zero) : _mm_unpackhi_epi8(second, zero), continuation_mask);
+			__m128i last = _mm_and_si128((i == 0) ? _mm_unpacklo_epi8(third, zero) : _mm_unpackhi_epi8(third, zero), continuation_mask);
+
+			__m128i is_basic_latin = _mm_cmplt_epi16(lead, _mm_set1_epi16(0x80));
+			__m128i is_two_bytes = _mm_cmplt_epi16(lead, _mm_set1_epi16(0xE0));
+
+			__m128i decoded_two = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(lead, _mm_set1_epi16(0x1F)), 6), middle);
+			__m128i decoded_three = _mm_or_si128(
+				_mm_slli_epi16(lead, 12),
+				_mm_or_si128(_mm_slli_epi16(middle, 6), last));
+
+			__m128i selected = _mm_or_si128(
+				_mm_and_si128(is_two_bytes, decoded_two),
+				_mm_andnot_si128(is_two_bytes, decoded_three));
+			selected = _mm_or_si128(
+				_mm_and_si128(is_basic_latin, lead),
+				_mm_andnot_si128(is_basic_latin, selected));
+
+			_mm_storeu_si128((__m128i*)(decoded + (i * 8)), selected);
+		}
+
+		/* Keep the code points decoded at the start of a sequence */
+
+		for (remaining = starts; remaining != 0; remaining &= remaining - 1)
+		{
+			*dst++ = decoded[conversion_lowest_bit(remaining)];
+		}
+
+		dst_size -= length * sizeof(utf16_t);
+		bytes_written += length * sizeof(utf16_t);
+
+		src += consumed;
+		src_size -= consumed;
+
+		if ((invalid & 0xFFFF) != 0)
+		{
+			/* Next block starts with a sequence for the caller */
+
+			break;
+		}
+	}
+
+	*written = bytes_written;
+
+	return inputSize - src_size;
+#else
+	(void)input;
+	(void)inputSize;
+	(void)target;
+	(void)targetSize;
+
+	*written = 0;
+
+	return 0;
+#endif
+}
+
+#if UTF8_SIMD_AVX2
+
+/*
+	Code points are encoded to four bytes in every 32-bit lane, after which
+	the bytes in use are moved together by a shuffle. The shuffle for a
+	128-bit lane is selected by the encoded lengths of its four code points,
+	stored as two bits per code point.
+*/
+
+static const uint8_t ConversionEncodedShuffle[256][16] = {
+	{ 0x00, 0x04, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80 },
+	{ 0x00, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80 },
+	{ 0x00, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F } 
+};
+
+static const uint8_t ConversionEncodedSpread[16] = {
+	0x00, 0x01, 0x04, 0x05, 0x10, 0x11, 0x14, 0x15, 0x40, 0x41, 0x44, 0x45, 0x50, 0x51, 0x54, 0x55
+};
+
+/*
+	Indices of the lanes selected by a mask of eight lanes, one byte per
+	index, used to move decoded code points together.
+*/
+
+static const uint64_t ConversionCompactIndices[256] = {
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL, 0x0000000000000100ULL,
+	0x0000000000000002ULL, 0x0000000000000200ULL, 0x0000000000000201ULL, 0x0000000000020100ULL,
+	0x0000000000000003ULL, 0x0000000000000300ULL, 0x0000000000000301ULL, 0x0000000000030100ULL,
+	0x0000000000000302ULL, 0x0000000000030200ULL, 0x0000000000030201ULL, 0x0000000003020100ULL,
+	0x0000000000000004ULL, 0x0000000000000400ULL, 0x0000000000000401ULL, 0x0000000000040100ULL,
+	0x0000000000000402ULL, 0x0000000000040200ULL, 0x0000000000040201ULL, 0x0000000004020100ULL,
+	0x0000000000000403ULL, 0x0000000000040300ULL, 0x0000000000040301ULL, 0x0000000004030100ULL,
+	0x0000000000040302ULL, 0x0000000004030200ULL, 0x0000000004030201ULL, 0x0000000403020100ULL,
+	0x0000000000000005ULL, 0x0000000000000500ULL, 0x0000000000000501ULL, 0x0000000000050100ULL,
+	0x0000000000000502ULL, 0x0000000000050200ULL, 0x0000000000050201ULL, 0x0000000005020100ULL,
+	0x0000000000000503ULL, 0x0000000000050300ULL, 0x0000000000050301ULL, 0x0000000005030100ULL,
+	0x0000000000050302ULL, 0x0000000005030200ULL, 0x0000000005030201ULL, 0x0000000503020100ULL,
+	0x0000000000000504ULL, 0x0000000000050400ULL, 0x0000000000050401ULL, 0x0000000005040100ULL,
+	0x0000000000050402ULL, 0x0000000005040200ULL, 0x0000000005040201ULL, 0x0000000504020100ULL,
+	0x0000000000050403ULL, 0x0000000005040300ULL, 0x0000000005040301ULL, 0x0000000504030100ULL,
+	0x0000000005040302ULL, 0x0000000504030200ULL, 0x0000000504030201ULL, 0x0000050403020100ULL,
+	0x0000000000000006ULL, 0x0000000000000600ULL, 0x0000000000000601ULL, 0x0000000000060100ULL,
+	0x0000000000000602ULL, 0x0000000000060200ULL, 0x0000000000060201ULL, 0x0000000006020100ULL,
+	0x0000000000000603ULL, 0x0000000000060300ULL, 0x0000000000060301ULL, 0x0000000006030100ULL,
+	0x0000000000060302ULL, 0x0000000006030200ULL, 0x0000000006030201ULL, 0x0000000603020100ULL,
+	0x0000000000000604ULL, 0x0000000000060400ULL, 0x0000000000060401ULL, 0x0000000006040100ULL,
+	0x0000000000060402ULL, 0x0000000006040200ULL, 0x0000000006040201ULL, 0x0000000604020100ULL,
+	0x0000000000060403ULL, 0x0000000006040300ULL, 0x0000000006040301ULL, 0x0000000604030100ULL,
+	0x0000000006040302ULL, 0x0000000604030200ULL, 0x0000000604030201ULL, 0x0000060403020100ULL,
+	0x0000000000000605ULL, 0x0000000000060500ULL, 0x0000000000060501ULL, 0x0000000006050100ULL,
+	0x0000000000060502ULL, 0x0000000006050200ULL, 0x0000000006050201ULL, 0x0000000605020100ULL,
+	0x0000000000060503ULL, 0x0000000006050300ULL, 0x0000000006050301ULL, 0x0000000605030100ULL,
+	0x0000000006050302ULL, 0x0000000605030200ULL, 0x0000000605030201ULL, 0x0000060503020100ULL,
+	0x0000000000060504ULL, 0x0000000006050400ULL, 0x0000000006050401ULL, 0x0000000605040100ULL,
+	0x0000000006050402ULL, 0x0000000605040200ULL, 0x0000000605040201ULL, 0x0000060504020100ULL,
+	0x0000000006050403ULL, 0x0000000605040300ULL, 0x0000000605040301ULL, 0x0000060504030100ULL,
+	0x0000000605040302ULL, 0x0000060504030200ULL, 0x0000060504030201ULL, 0x0006050403020100ULL,
+	0x0000000000000007ULL, 0x0000000000000700ULL, 0x0000000000000701ULL, 0x0000000000070100ULL,
+	0x0000000000000702ULL, 0x0000000000070200ULL, 0x0000000000070201ULL, 0x0000000007020100ULL,
+	0x0000000000000703ULL, 0x0000000000070300ULL, 0x0000000000070301ULL, 0x0000000007030100ULL,
+	0x0000000000070302ULL, 0x0000000007030200ULL, 0x0000000007030201ULL, 0x0000000703020100ULL,
+	0x0000000000000704ULL, 0x0000000000070400ULL, 0x0000000000070401ULL, 0x0000000007040100ULL,
+	0x0000000000070402ULL, 0x0000000007040200ULL, 0x0000000007040201ULL, 0x0000000704020100ULL,
+	0x0000000000070403ULL, 0x0000000007040300ULL, 0x0000000007040301ULL, 0x0000000704030100ULL,
+	0x0000000007040302ULL, 0x0000000704030200ULL, 0x0000000704030201ULL, 0x0000070403020100ULL,
+	0x0000000000000705ULL, 0x0000000000070500ULL, 0x0000000000070501ULL, 0x0000000007050100ULL,
+	0x0000000000070502ULL, 0x0000000007050200ULL, 0x0000000007050201ULL, 0x0000000705020100ULL,
+	0x0000000000070503ULL, 0x0000000007050300ULL, 0x0000000007050301ULL, 0x0000000705030100ULL,
+	0x0000000007050302ULL, 0x0000000705030200ULL, 0x0000000705030201ULL, 0x0000070503020100ULL,
+	0x0000000000070504ULL, 0x0000000007050400ULL, 0x0000000007050401ULL, 0x0000000705040100ULL,
+	0x0000000007050402ULL, 0x0000000705040200ULL, 0x0000000705040201ULL, 0x0000070504020100ULL,
+	0x0000000007050403ULL, 0x0000000705040300ULL, 0x0000000705040301ULL, 0x0000070504030100ULL,
+	0x0000000705040302ULL, 0x0000070504030200ULL, 0x0000070504030201ULL, 0x0007050403020100ULL,
+	0x0000000000000706ULL, 0x0000000000070600ULL, 0x0000000000070601ULL, 0x0000000007060100ULL,
+	0x0000000000070602ULL, 0x0000000007060200ULL, 0x0000000007060201ULL, 0x0000000706020100ULL,
+	0x0000000000070603ULL, 0x0000000007060300ULL, 0x0000000007060301ULL, 0x0000000706030100ULL,
+	0x0000000007060302ULL, 0x0000000706030200ULL, 0x0000000706030201ULL, 0x0000070603020100ULL,
+	0x0000000000070604ULL, 0x0000000007060400ULL, 0x0000000007060401ULL, 0x0000000706040100ULL,
+	0x0000000007060402ULL, 0x0000000706040200ULL, 0x0000000706040201ULL, 0x0000070604020100ULL,
+	0x0000000007060403ULL, 0x0000000706040300ULL, 0x0000000706040301ULL, 0x0000070604030100ULL,
+	0x0000000706040302ULL, 0x0000070604030200ULL, 0x0000070604030201ULL, 0x0007060403020100ULL,
+	0x0000000000070605ULL, 0x0000000007060500ULL, 0x0000000007060501ULL, 0x0000000706050100ULL,
+	0x0000000007060502ULL, 0x0000000706050200ULL, 0x0000000706050201ULL, 0x0000070605020100ULL,
+	0x0000000007060503ULL, 0x0000000706050300ULL, 0x0000000706050301ULL, 0x0000070605030100ULL,
+	0x0000000706050302ULL, 0x0000070605030200ULL, 0x0000070605030201ULL, 0x0007060503020100ULL,
+	0x0000000007060504ULL, 0x0000000706050400ULL, 0x0000000706050401ULL, 0x0000070605040100ULL,
+	0x0000000706050402ULL, 0x0000070605040200ULL, 0x0000070605040201ULL, 0x0007060504020100ULL,
+	0x0000000706050403ULL, 0x0000070605040300ULL, 0x0000070605040301ULL, 0x0007060504030100ULL,
+	0x0000070605040302ULL, 0x0007060504030200ULL, 0x0007060504030201ULL, 0x0706050403020100ULL
+};
+
+UTF8_SIMD_TARGET_AVX2 static size_t conversion_utf32toutf8_avx2(const unicode_t* input, size_t inputSize, char* target, size_t targetSize, size_t* written)
+{
+	const __m256i surrogate_mask = _mm256_set1_epi32((int)0xFFFFF800);
+	const __m256i surrogate_value = _mm256_set1_epi32(SURROGATE_HIGH_START);
+	const __m256i legal_maximum = _mm256_set1_epi32(MAX_LEGAL_UNICODE);
+	const __m256i one_byte_maximum = _mm256_set1_epi32(MAX_BASIC_LATIN);
+	const __m256i two_bytes_maximum = _mm256_set1_epi32(0x7FF);
+	const __m256i three_bytes_maximum = _mm256_set1_epi32(MAX_BASIC_MULTILINGUAL_PLANE);
+	const __m256i continuation_mask = _mm256_set1_epi32(0x3F);
+	const __m256i continuation_marker = _mm256_set1_epi32(0x80);
+	const __m128i offsets = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+	const unicode_t* src = input;
+	size_t src_size = inputSize;
+	char* dst = target;
+	size_t dst_size = targetSize;
+	size_t bytes_written = 0;
+
+	/* Blocks of eight code points, the output of a block takes at most 32 bytes */
+
+	while (src_size >= 8 * sizeof(unicode_t) &&
+		dst_size >= 32)
+	{
+		__m256i codepoints = _mm256_loadu_si256((const __m256i*)src);
+		__m256i valid;
+		__m256i more_than_one_byte;
+		__m256i more_than_two_bytes;
+		__m256i more_than_three_bytes;
+		uint32_t invalid;
+		uint32_t two_bytes;
+		uint32_t three_bytes;
+		uint32_t four_bytes;
+		size_t length;
+
+		/* Surrogates and code points above U+10FFFF are left to the caller */
+
+		valid = _mm256_andnot_si256(
+			_mm256_cmpeq_epi32(_mm256_and_si256(codepoints, surrogate_mask), surrogate_value),
+			_mm256_cmpeq_epi32(_mm256_min_epu32(codepoints, legal_maximum), codepoints));
+
+		invalid = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(valid)) ^ 0xFF;
+		if (invalid != 0)
+		{
+			/* Convert the code points before the first invalid one */
+
+			while ((invalid & 1) == 0)
+			{
+				bytes_written += codepoint_write(*src, &dst, &dst_size);
+
+				src++;
+				src_size -= sizeof(unicode_t);
+				invalid >>= 1;
+			}
+
+			break;
+		}
+
+		/* Determine length of output */
+
+		more_than_one_byte = _mm256_cmpgt_epi32(codepoints, one_byte_maximum);
+		more_than_two_bytes = _mm256_cmpgt_epi32(codepoints, two_bytes_maximum);
+		more_than_three_bytes = _mm256_cmpgt_epi32(codepoints, three_bytes_maximum);
+
+		two_bytes = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(more_than_one_byte));
+		three_bytes = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(more_than_two_bytes));
+		four_bytes = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(more_than_three_bytes));
+
+		length = 8 + conversion_popcount(two_bytes | (three_bytes << 8) | (four_bytes << 16));
+
+		if (two_bytes == 0)
+		{
+			/* Basic Latin, the first four bytes of each 128-bit lane */
+
+			__m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(codepoints, codepoints), codepoints);
+			uint32_t low = (uint32_t)_mm_cvtsi128_si32(_mm256_castsi256_si128(packed));
+			uint32_t high = (uint32_t)_mm_cvtsi128_si32(_mm256_extracti128_si256(packed, 1));
+
+			memcpy(dst, &low, sizeof(low));
+			memcpy(dst + 4, &high, sizeof(high));
+		}
+		else
+		{
+			__m256i last = _mm256_or_si256(_mm256_and_si256(codepoints, continuation_mask), continuation_marker);
+			__m256i third = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(codepoints, 6), continuation_mask), continuation_marker);
+			__m256i second = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(codepoints, 12), continuation_mask), continuation_marker);
+			__m256i encoded;
+			__m256i shuffled;
+			uint8_t low_index;
+			uint8_t high_index;
+			size_t low_length;
+			__m128i following;
+
+			encoded = _mm256_blendv_epi8(
+				codepoints,
+				_mm256_or_si256(
+					_mm256_or_si256(_mm256_srli_epi32(codepoints, 6), _mm256_set1_epi32(0xC0)),
+					_mm256_slli_epi32(last, 8)),
+				more_than_one_byte);
+			encoded = _mm256_blendv_epi8(
+				encoded,
+				_mm256_or_si256(
+					_mm256_or_si256(_mm256_srli_epi32(codepoints, 12), _mm256_set1_epi32(0xE0)),
+					_mm256_or_si256(_mm256_slli_epi32(third, 8), _mm256_slli_epi32(last, 16))),
+				more_than_two_bytes);
+			encoded = _mm256_blendv_epi8(
+				encoded,
+				_mm256_or_si256(
+					_mm256_or_si256(_mm256_srli_epi32(codepoints, 18), _mm256_set1_epi32(0xF0)),
+					_mm256_or_si256(
+						_mm256_slli_epi32(second, 8),
+						_mm256_or_si256(_mm256_slli_epi32(third, 16), _mm256_slli_epi32(last, 24)))),
+				more_than_three_bytes);
+
+			/* Move the bytes of each 128-bit lane together */
+
+			low_index = (uint8_t)(
+				ConversionEncodedSpread[two_bytes & 0x0F] +
+				ConversionEncodedSpread[three_bytes & 0x0F] +
+				ConversionEncodedSpread[four_bytes & 0x0F]);
+			high_index = (uint8_t)(
+				ConversionEncodedSpread[two_bytes >> 4] +
+				ConversionEncodedSpread[three_bytes >> 4] +
+				ConversionEncodedSpread[four_bytes >> 4]);
+
+			shuffled = _mm256_shuffle_epi8(
+				encoded,
+				_mm256_inserti128_si256(
+					_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)ConversionEncodedShuffle[low_index])),
+					_mm_loadu_si128((const __m128i*)ConversionEncodedShuffle[high_index]),
+					1));
+
+			/* The second half is merged with the target, so nothing is changed after the output */
+
+			low_length = 4 + conversion_popcount((two_bytes & 0x0F) | ((three_bytes & 0x0F) << 4) | ((four_bytes & 0x0F) << 8));
+			following = _mm_loadu_si128((const __m128i*)(dst + low_length));
+
+			_mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(shuffled));
+			_mm_storeu_si128(
+				(__m128i*)(dst + low_length),
+				_mm_blendv_epi8(
+					following,
+					_mm256_extracti128_si256(shuffled, 1),
+					_mm_cmplt_epi8(offsets, _mm_set1_epi8((char)(length - low_length)))));
+		}
+
+		dst += length;
+		dst_size -= length;
+		bytes_written += length;
+		src += 8;
+		src_size -= 8 * sizeof(unicode_t);
+	}
+
+	*written = bytes_written;
+
+	return inputSize - src_size;
+}
+
+UTF8_SIMD_TARGET_AVX2 static size_t conversion_utf8toutf32_avx2(const char* input, size_t inputSize, unicode_t* target, size_t targetSize, size_t* written)
+{
+	const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	const __m256i continuation_mask = _mm256_set1_epi32(0x3F);
+
+	const char* src = input;
+	size_t src_size = inputSize;
+	unicode_t* dst = target;
+	size_t dst_size = targetSize;
+	size_t bytes_written = 0;
+
+	/* Blocks of sixteen bytes, the three bytes after a block are read as well */
+
+	while (src_size >= 19 &&
+		dst_size >= 16 * sizeof(unicode_t))
+	{
+		__m128i first = _mm_loadu_si128((const __m128i*)src);
+		__m128i second;
+		__m128i third;
+		__m128i fourth;
+		uint32_t basic_latin;
+		uint32_t continuation;
+		uint32_t two_bytes;
+		uint32_t three_bytes;
+		uint32_t four_bytes;
+		uint32_t expected;
+		uint32_t invalid;
+		uint32_t starts;
+		size_t consumed;
+		size_t i;
+
+		if (_mm_movemask_epi8(first) == 0)
+		{
+			/* Basic Latin */
+
+			_mm256_storeu_si256((__m256i*)dst, _mm256_cvtepu8_epi32(first));
+			_mm256_storeu_si256((__m256i*)(dst + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(first, 8)));
+
+			dst += 16;
+			dst_size -= 16 * sizeof(unicode_t);
+			bytes_written += 16 * sizeof(unicode_t);
+			src += 16;
+			src_size -= 16;
+
+			continue;
+		}
+
+		second = _mm_loadu_si128((const __m128i*)(src + 1));
+		third = _mm_loadu_si128((const __m128i*)(src + 2));
+		fourth = _mm_loadu_si128((const __m128i*)(src + 3));
+
+		/* Classify bytes, compared as signed values */
+
+		basic_latin = (uint32_t)_mm_movemask_epi8(first) ^ 0xFFFF;
+		continuation = (uint32_t)_mm_movemask_epi8(_mm_cmplt_epi8(first, _mm_set1_epi8((char)0xC0)));
+		two_bytes = (uint32_t)_mm_movemask_epi8(_mm_and_si128(
+			_mm_cmpgt_epi8(first, _mm_set1_epi8((char)0xC1)),
+			_mm_cmplt_epi8(first, _mm_set1_epi8((char)0xE0))));
+		three_bytes = (uint32_t)_mm_movemask_epi8(_mm_and_si128(
+			_mm_cmpgt_epi8(first, _mm_set1_epi8((char)0xDF)),
+			_mm_cmplt_epi8(first, _mm_set1_epi8((char)0xF0))));
+		four_bytes = (uint32_t)_mm_movemask_epi8(_mm_and_si128(
+			_mm_cmpgt_epi8(first, _mm_set1_epi8((char)0xEF)),
+			_mm_cmplt_epi8(first, _mm_set1_epi8((char)0xF5))));
+
+		/* Overlong sequences, surrogates and code points above U+10FFFF are invalid */
+
+		invalid = (uint32_t)_mm_movemask_epi8(_mm_or_si128(
+			_mm_or_si128(
+				_mm_and_si128(
+					_mm_cmpeq_epi8(first, _mm_set1_epi8((char)0xE0)),
+					_mm_cmplt_epi8(second, _mm_set1_epi8((char)0xA0))),
+				_mm_and_si128(
+					_mm_cmpeq_epi8(first, _mm_set1_epi8((char)0xED)),
+					_mm_cmpgt_epi8(second, _mm_set1_epi8((char)0x9F)))),
+			_mm_or_si128(
+				_mm_and_si128(
+					_mm_cmpeq_epi8(first, _mm_set1_epi8((char)0xF0)),
+					_mm_cmplt_epi8(second, _mm_set1_epi8((char)0x90))),
+				_mm_and_si128(
+					_mm_cmpeq_epi8(first, _mm_set1_epi8((char)0xF4)),
+					_mm_cmpgt_epi8(second, _mm_set1_epi8((char)0x8F))))));
+
+		/* Sequences must be followed by exactly the expected continuation bytes */
+
+		expected =
+			((two_bytes | three_bytes | four_bytes) << 1) |
+			((three_bytes | four_bytes) << 2) |
+			(four_bytes << 3);
+		starts = (continuation ^ 0xFFFF) & ~expected;
+
+		invalid |= (continuation ^ expected) & 0xFFFF;
+		invalid |= (continuation | basic_latin | two_bytes | three_bytes | four_bytes) ^ 0xFFFF;
+		invalid |= 0x10000;
+
+		if ((expected & 0x10000) == 0)
+		{
+			starts |= 0x10000;
+		}
+
+		/* Stop at the start of the sequence containing the first problem */
+
+		starts &= ((invalid & (0 - invalid)) << 1) - 1;
+		if (starts == 0)
+		{
+			break;
+		}
+
+		consumed = conversion_highest_bit(starts);
+		if (consumed == 0)
+		{
+			break;
+		}
+
+		starts &= ((uint32_t)1 << consumed) - 1;
+
+		/* Decode eight code points at a time */
+
+		for (i = 0; i < 2; ++i)
+		{
+			uint32_t selected = (starts >> (i * 8)) & 0xFF;
+			size_t length = conversion_popcount(selected);
+
+			if (length > 0)
+			{
+				__m256i lead = _mm256_cvtepu8_epi32(first);
+				__m256i continuation_1 = _mm256_and_si256(_mm256_cvtepu8_epi32(second), continuation_mask);
+				__m256i continuation_2 = _mm256_and_si256(_mm256_cvtepu8_epi32(third), continuation_mask);
+				__m256i continuation_3 = _mm256_and_si256(_mm256_cvtepu8_epi32(fourth), continuation_mask);
+				__m256i decoded;
+
+				decoded = _mm256_blendv_epi8(
+					lead,
+					_mm256_or_si256(
+						_mm256_slli_epi32(_mm256_and_si256(lead, _mm256_set1_epi32(0x1F)), 6),
+						continuation_1),
+					_mm256_cmpgt_epi32(lead, _mm256_set1_epi32(0x7F)));
+				decoded = _mm256_blendv_epi8(
+					decoded,
+					_mm256_or_si256(
+						_mm256_slli_epi32(_mm256_and_si256(lead, _mm256_set1_epi32(0x0F)), 12),
+						_mm256_or_si256(_mm256_slli_epi32(continuation_1, 6), continuation_2)),
+					_mm256_cmpgt_epi32(lead, _mm256_set1_epi32(0xDF)));
+				decoded = _mm256_blendv_epi8(
+					decoded,
+					_mm256_or_si256(
+						_mm256_slli_epi32(_mm256_and_si256(lead, _mm256_set1_epi32(0x07)), 18),
+						_mm256_or_si256(
+							_mm256_slli_epi32(continuation_1, 12),
+							_mm256_or_si256(_mm256_slli_epi32(continuation_2, 6), continuation_3))),
+					_mm256_cmpgt_epi32(lead, _mm256_set1_epi32(0xEF)));
+
+				/* Keep the code points decoded at the start of a sequence */
+
+				decoded = _mm256_permutevar8x32_epi32(
+					decoded,
+					_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)&ConversionCompactIndices[selected])));
+
+				_mm256_maskstore_epi32((int*)dst, _mm256_cmpgt_epi32(_mm256_set1_epi32((int)length), lanes), decoded);
+
+				dst += length;
+				dst_size -= length * sizeof(unicode_t);
+			}
+
+			bytes_written += length * sizeof(unicode_t);
+
+			first = _mm_srli_si128(first, 8);
+			second = _mm_srli_si128(second, 8);
+			third = _mm_srli_si128(third, 8);
+			fourth = _mm_srli_si128(fourth, 8);
+		}
+
+		src += consumed;
+		src_size -= consumed;
+
+		if ((invalid & 0xFFFF) != 0)
+		{
+			/* Next block starts with a sequence for the caller */
+
+			break;
+		}
+	}
+
+	*written = bytes_written;
+
+	return inputSize - src_size;
+}
+
+#endif
+
+size_t conversion_utf32toutf8(const unicode_t* input, size_t inputSize, char* target, size_t targetSize, size_t* written)
+{
+#if UTF8_SIMD_AVX2
+	if (simd_supports_avx2())
+	{
+		return conversion_utf32toutf8_avx2(input, inputSize, target, targetSize, written);
+	}
+#else
+	(void)input;
+	(void)inputSize;
+	(void)target;
+	(void)targetSize;
+#endif
+
+	*written = 0;
+
+	return 0;
+}
+
+size_t conversion_utf8toutf32(const char* input, size_t inputSize, unicode_t* target, size_t targetSize, size_t* written)
+{
+#if UTF8_SIMD_AVX2
+	if (simd_supports_avx2())
+	{
+		return conversion_utf8toutf32_avx2(input, inputSize, target, targetSize, written);
+	}
+#else
+	(void)input;
+	(void)inputSize;
+	(void)target;
+	(void)targetSize;
+#endif
+
+	*written = 0;
+
+	return 0;
+}
+
+size_t conversion_utf16toutf8_size(const utf16_t* input, size_t inputSize, size_t* measured)
+{
+#if UTF8_SIMD_SSE2
+	const __m128i surrogate_mask = _mm_set1_epi16((short)0xF800);
+	const __m128i surrogate_value = _mm_set1_epi16((short)SURROGATE_HIGH_START);
+	const __m128i pair_mask = _mm_set1_epi16((short)0xFC00);
+	const __m128i low_value = _mm_set1_epi16((short)SURROGATE_LOW_START);
+	const __m128i one_byte_maximum = _mm_set1_epi16(MAX_BASIC_LATIN);
+	const __m128i two_bytes_maximum = _mm_set1_epi16(0x7FF);
+	const __m128i ones = _mm_set1_epi16(1);
+	const __m128i zero = _mm_setzero_si128();
+
+	const utf16_t* src = input;
+	size_t src_size = inputSize;
+	size_t bytes_measured = 0;
+	int pending = 0;
+
+	/*
+		Every unit takes three bytes, one less below 0x800 and another one
+		less below 0x80. A surrogate pair takes four bytes, so each surrogate
+		takes two. The deductions are summed per unit in 16 bits, which holds
+		those of 8192 blocks.
+	*/
+
+	while (src_size >= 8 * sizeof(utf16_t))
+	{
+		__m128i deducted = zero;
+		size_t blocks = 0;
+
+		while (src_size >= 8 * sizeof(utf16_t) &&
+			blocks < 8192)
+		{
+			__m128i units = _mm_loadu_si128((const __m128i*)src);
+			__m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(units, surrogate_mask), surrogate_value);
+
+			if (pending != 0 ||
+				_mm_movemask_epi8(surrogates) != 0)
+			{
+				__m128i pairs = _mm_and_si128(units, pair_mask);
+				int high = _mm_movemask_epi8(_mm_cmpeq_epi16(pairs, surrogate_value));
+				int low = _mm_movemask_epi8(_mm_cmpeq_epi16(pairs, low_value));
+
+				/* Every low surrogate must follow a high surrogate */
+
+				if ((((high << 2) | pending) & 0xFFFF) != low)
+				{
+					break;
+				}
+
+				pending = high >> 14;
+			}
+
+			deducted = _mm_sub_epi16(deducted, _mm_cmpeq_epi16(_mm_subs_epu16(units, one_byte_maximum), zero));
+			deducted = _mm_sub_epi16(deducted, _mm_cmpeq_epi16(_mm_subs_epu16(units, two_bytes_maximum), zero));
+			deducted = _mm_sub_epi16(deducted, surrogates);
+
+			blocks++;
+			src += 8;
+			src_size -= 8 * sizeof(utf16_t);
+		}
+
+		deducted = _mm_madd_epi16(deducted, ones);
+		deducted = _mm_add_epi32(deducted, _mm_srli_si128(deducted, 8));
+		deducted = _mm_add_epi32(deducted, _mm_srli_si128(deducted, 4));
+
+		bytes_measured += (blocks * 24) - (size_t)_mm_cvtsi128_si32(deducted);
+
+		if (blocks < 8192)
+		{
+			break;
+		}
+	}
+
+	if (pending != 0)
+	{
+		/* Leave the high surrogate at the end to the caller */
+
+		src--;
+		src_size += sizeof(utf16_t);
+		bytes_measured -= 2;
+	}
+
+	*measured = bytes_measured;
+
+	return inputSize - src_size;
+#else
+	(void)input;
+	(void)inputSize;
+
+	*measured = 0;
+
+	return 0;
+#endif
+}
+
+size_t conversion_utf32toutf8_size(const unicode_t* input, size_t inputSize, size_t* measured)
+{
+#if UTF8_SIMD_SSE2
+	const __m128i sign = _mm_set1_epi32((int)0x80000000);
+	const __m128i one_byte_limit = _mm_set1_epi32((int)(0x80 ^ 0x80000000));
+	const __m128i two_bytes_limit = _mm_set1_epi32((int)(0x800 ^ 0x80000000));
+	const __m128i three_bytes_limit = _mm_set1_epi32((int)(0x10000 ^ 0x80000000));
+	const __m128i legal_maximum = _mm_set1_epi32((int)(MAX_LEGAL_UNICODE ^ 0x80000000));
+	const __m128i surrogate_mask = _mm_set1_epi32((int)0xFFFFF800);
+	const __m128i surrogate_value = _mm_set1_epi32(SURROGATE_HIGH_START);
+	const __m128i pair_mask = _mm_set1_epi32((int)0xFFFFFC00);
+	const __m128i low_value = _mm_set1_epi32(SURROGATE_LOW_START);
+	const __m128i zero = _mm_setzero_si128();
+
+	const unicode_t* src = input;
+	size_t src_size = inputSize;
+	size_t bytes_measured = 0;
+	int pending = 0;
+
+	/*
+		Every code point takes four bytes, one less below U+10000, below
+		U+0800 and below U+0080 each. Code points above U+10FFFF are replaced
+		with U+FFFD, which takes three bytes, and surrogates take two, like in
+		UTF-16. Code points are compared as signed values after flipping the
+		sign bit. The deductions are summed per lane in 32 bits for at most
+		65536 blocks at a time.
+	*/
+
+	while (src_size >= 8 * sizeof(unicode_t))
+	{
+		__m128i deducted = zero;
+		size_t blocks = 0;
+
+		while (src_size >= 8 * sizeof(unicode_t) &&
+			blocks < 65536)
+		{
+			__m128i first = _mm_loadu_si128((const __m128i*)src);
+			__m128i second = _mm_loadu_si128((const __m128i*)(src + 4));
+			__m128i first_signed = _mm_xor_si128(first, sign);
+			__m128i second_signed = _mm_xor_si128(second, sign);
+			__m128i first_surrogates = _mm_cmpeq_epi32(_mm_and_si128(first, surrogate_mask), surrogate_value);
+			__m128i second_surrogates = _mm_cmpeq_epi32(_mm_and_si128(second, surrogate_mask), surrogate_value);
+
+			if (pending != 0 ||
+				_mm_movemask_epi8(_mm_or_si128(first_surrogates, second_surrogates)) != 0)
+			{
+				__m128i first_pairs = _mm_and_si128(first, pair_mask);
+				__m128i second_pairs = _mm_and_si128(second, pair_mask);
+				int high =
+					_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(first_pairs, surrogate_value))) |
+					(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(second_pairs, surrogate_value))) << 4);
+				int low =
+					_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(first_pairs, low_value))) |
+					(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(second_pairs, low_value))) << 4);
+
+				/* Every low surrogate must follow a high surrogate */
+
+				if ((((high << 1) | pending) & 0xFF) != low)
+				{
+					break;
+				}
+
+				pending = high >> 7;
+			}
+
+			deducted = _mm_sub_epi32(deducted, _mm_cmplt_epi32(first_signed, one_byte_limit));
+			deducted = _mm_sub_epi32(deducted, _mm_cmplt_epi32(first_signed, two_bytes_limit));
+			deducted = _mm_sub_epi32(deducted, _mm_cmplt_epi32(first_signed, three_bytes_limit));
+			deducted = _mm_sub_epi32(deducted, _mm_cmpgt_epi32(first_signed, legal_maximum));
+			deducted = _mm_sub_epi32(deducted, first_surrogates);
+
+			deducted = _mm_sub_epi32(deducted, _mm_cmplt_epi32(second_signed, one_byte_limit));
+			deducted = _mm_sub_epi32(deducted, _mm_cmplt_epi32(second_signed, two_bytes_limit));
+			deducted = _mm_sub_epi32(deducted, _mm_cmplt_epi32(second_signed, three_bytes_limit));
+			deducted = _mm_sub_epi32(deducted, _mm_cmpgt_epi32(second_signed, legal_maximum));
+			deducted = _mm_sub_epi32(deducted, second_surrogates);
+
+			blocks++;
+			src += 8;
+			src_size -= 8 * sizeof(unicode_t);
+		}
+
+		deducted = _mm_add_epi32(deducted, _mm_srli_si128(deducted, 8));
+		deducted = _mm_add_epi32(deducted, _mm_srli_si128(deducted, 4));
+
+		bytes_measured += (blocks * 32) - (size_t)(uint32_t)_mm_cvtsi128_si32(deducted);
+
+		if (blocks < 65536)
+		{
+			break;
+		}
+	}
+
+	if (pending != 0)
+	{
+		/* Leave the high surrogate at the end to the caller */
+
+		src--;
+		src_size += sizeof(unicode_t);
+		bytes_measured -= 2;
+	}
+
+	*measured = bytes_measured;
+
+	return inputSize - src_size;
+#else
+	(void)input;
+	(void)inputSize;
+
+	*measured = 0;
+
+	return 0;
+#endif
+}
+
+/*
+	Valid UTF-8 is measured by counting bytes: every byte that is not a
+	continuation byte starts a code point, and every four byte lead byte
+	starts one outside the Basic Multilingual Plane.
+*/
+
+static size_t conversion_count_utf8(const uint8_t* input, size_t inputSize, size_t* supplementary)
+{
+	const uint8_t* src = input;
+	size_t src_size = inputSize;
+	size_t continuations = 0;
+	size_t four_bytes = 0;
+
+#if UTF8_SIMD_SSE2
+	const __m128i continuation_end = _mm_set1_epi8((char)0xC0);
+	const __m128i four_bytes_start = _mm_set1_epi8((char)0xF0);
+	const __m128i zero = _mm_setzero_si128();
+
+	while (src_size >= 32)
+	{
+		/* Counted per byte, which holds the counts of 127 blocks of two */
+
+		__m128i continuation_count = zero;
+		__m128i four_bytes_count = zero;
+		size_t blocks = src_size / 32;
+
+		if (blocks > 127)
+		{
+			blocks = 127;
+		}
+
+		src_size -= blocks * 32;
+
+		for (; blocks > 0; --blocks)
+		{
+			__m128i first = _mm_loadu_si128((const __m128i*)src);
+			__m128i second = _mm_loadu_si128((const __m128i*)(src + 16));
+
+			continuation_count = _mm_sub_epi8(continuation_count, _mm_cmplt_epi8(first, continuation_end));
+			continuation_count = _mm_sub_epi8(continuation_count, _mm_cmplt_epi8(second, continuation_end));
+			four_bytes_count = _mm_sub_epi8(four_bytes_count, _mm_cmpeq_epi8(_mm_max_epu8(first, four_bytes_start), first));
+			four_bytes_count = _mm_sub_epi8(four_bytes_count, _mm_cmpeq_epi8(_mm_max_epu8(second, four_bytes_start), second));
+
+			src += 32;
+		}
+
+		continuation_count = _mm_sad_epu8(continuation_count, zero);
+		four_bytes_count = _mm_sad_epu8(four_bytes_count, zero);
+
+		continuations +=
+			(size_t)_mm_cvtsi128_si32(continuation_count) +
+			(size_t)_mm_cvtsi128_si32(_mm_srli_si128(continuation_count, 8));
+		four_bytes +=
+			(size_t)_mm_cvtsi128_si32(four_bytes_count) +
+			(size_t)_mm_cvtsi128_si32(_mm_srli_si128(four_bytes_count, 8));
+	}
+#endif
+
+	for (; src_size > 0; --src_size)
+	{
+		if ((*src & 0xC0) == 0x80)
+		{
+			continuations++;
+		}
+		else if (
+			*src >= 0xF0)
+		{
+			four_bytes++;
+		}
+
+		src++;
+	}
+
+	*supplementary = four_bytes;
+
+	return inputSize - continuations;
+}
+
+/*
+	Valid parts of the input are found by the validation kernels and counted
+	without decoding. An invalid sequence is decoded to U+FFFD the same way
+	as in the conversion functions. Because errors rarely come alone, the
+	bytes after it are decoded as well before validating again.
+
+	Basic Latin at the cursor is counted before validating, so text that is
+	mostly ASCII is only read once.
+*/
+
+static size_t conversion_measure_utf8(const char* input, size_t inputSize, size_t* supplementary)
+{
+	const char* src = input;
+	size_t src_size = inputSize;
+	size_t codepoints = 0;
+
+	*supplementary = 0;
+
+	while (src_size > 0)
+	{
+		size_t valid;
+		size_t four_bytes;
+		const char* decoded_end;
+
+	#if UTF8_SIMD_SSE2
+		while (src_size >= 16 &&
+			_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)src)) == 0)
+		{
+			codepoints += 16;
+
+			src += 16;
+			src_size -= 16;
+		}
+	#endif
+
+		valid = validation_execute((const uint8_t*)src, src_size);
+
+		codepoints += conversion_count_utf8((const uint8_t*)src, valid, &four_bytes);
+		*supplementary += four_bytes;
+
+		src += valid;
+		src_size -= valid;
+
+		if (src_size == 0)
+		{
+			break;
+		}
+
+		decoded_end = src + ((src_size < CONVERSION_MINIMUM_SIZE) ? src_size : CONVERSION_MINIMUM_SIZE);
+
+		while (src < decoded_end)
+		{
+			unicode_t decoded;
+			uint8_t length = 1;
+
+			if ((uint8_t)*src > MAX_BASIC_LATIN)
+			{
+				length = codepoint_read(src, src_size, &decoded);
+				if (decoded > MAX_BASIC_MULTILINGUAL_PLANE)
+				{
+					*supplementary += 1;
+				}
+			}
+
+			codepoints++;
+
+			src += length;
+			src_size -= length;
+		}
+	}
+
+	return codepoints;
+}
+
+size_t conversion_utf8toutf16_size(const char* input, size_t inputSize, size_t* measured)
+{
+	size_t supplementary;
+	size_t codepoints = conversion_measure_utf8(input, inputSize, &supplementary);
+
+	/* Code points outside the Basic Multilingual Plane take a surrogate pair */
+
+	*measured = (codepoints + supplementary) * sizeof(utf16_t);
+
+	return inputSize;
+}
+
+size_t conversion_utf8toutf32_size(const char* input, size_t inputSize, size_t* measured)
+{
+	size_t supplementary;
+
+	*measured = conversion_measure_utf8(input, inputSize, &supplementary) * sizeof(unicode_t);
+
+	return inputSize;
+}
\ No newline at end of file
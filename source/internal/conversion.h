@@ -0,0 +1,80 @@
+/*
+	Copyright (C) 2014-2016 Quinten Lansu
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef _UTF8REWIND_INTERNAL_CONVERSION_H_
+#define _UTF8REWIND_INTERNAL_CONVERSION_H_
+
+/*!
+	\file
+	\brief Conversion interface.
+
+	\cond INTERNAL
+*/
+
+#include "utf8rewind.h"
+
+/*
+	Bulk conversion kernels used by the public conversion functions. Each
+	kernel converts as much of the input as it can handle in blocks. The
+	remainder, including everything that requires error handling, is left
+	to the scalar loop of the caller.
+
+	Sizes are in bytes and the target must not be NULL. The return value is
+	the amount of input that was converted and the amount of output written
+	is stored in written.
+
+	The kernels are not called for input shorter than the minimum size,
+	which is too short to be converted in blocks.
+*/
+
+#define CONVERSION_MINIMUM_SIZE (32)
+
+size_t conversion_utf16toutf8(const utf16_t* input, size_t inputSize, char* target, size_t targetSize, size_t* written);
+
+size_t conversion_utf8toutf16(const char* input, size_t inputSize, utf16_t* target, size_t targetSize, size_t* written);
+
+size_t conversion_utf32toutf8(const unicode_t* input, size_t inputSize, char* target, size_t targetSize, size_t* written);
+
+size_t conversion_utf8toutf32(const char* input, size_t inputSize, unicode_t* target, size_t targetSize, size_t* written);
+
+/*
+	Measuring kernels used when the target is NULL. Like the conversion
+	kernels, they measure as much of the input as they can in blocks and
+	leave the remainder to the scalar loop of the caller. The return value
+	is the amount of input that was measured and the size of its output is
+	stored in measured.
+*/
+
+size_t conversion_utf16toutf8_size(const utf16_t* input, size_t inputSize, size_t* measured);
+
+size_t conversion_utf8toutf16_size(const char* input, size_t inputSize, size_t* measured);
+
+size_t conversion_utf32toutf8_size(const unicode_t* input, size_t inputSize, size_t* measured);
+
+size_t conversion_utf8toutf32_size(const char* input, size_t inputSize, size_t* measured);
+
+/*! \endcond */
+
+#endif /* _UTF8REWIND_INTERNAL_CONVERSION_H_ */
\ No newline at end of file
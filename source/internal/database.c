@@ -26,8 +26,20 @@
 #include "database.h"
 
 #include "../unicodedatabase.h"
+#include "base.h"
 #include "codepoint.h"
 
+#if WIN32 || _WINDOWS
+	#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+
+	#define DATABASE_MAPPING_POSIX (1)
+#endif
+
 #define DECOMPOSE_INDEX1_SHIFT (12)
 #define DECOMPOSE_INDEX2_SHIFT (5)
 
@@ -35,14 +47,26 @@ static const unicode_t DECOMPOSE_INDEX1_MASK = MAX_LEGAL_UNICODE;
 static const unicode_t DECOMPOSE_INDEX2_MASK = (1 << DECOMPOSE_INDEX1_SHIFT) - 1;
 static const unicode_t DECOMPOSE_DATA_MASK = (1 << DECOMPOSE_INDEX2_SHIFT) - 1;
 
+uint32_t database_queryproperties(unicode_t codepoint)
+{
+	return PROPERTY_GET(codepoint);
+}
+
 const char* database_querydecomposition(unicode_t codepoint, const uint32_t* index1Array, const uint32_t* index2Array, const uint32_t* dataArray, uint8_t* length)
 {
 	uint32_t index;
 	uint32_t data;
 
-	index = index1Array[codepoint >> DECOMPOSE_INDEX1_SHIFT];
-	index = index2Array[index + ((codepoint & DECOMPOSE_INDEX2_MASK) >> DECOMPOSE_INDEX2_SHIFT)];
-	index = index + (codepoint & DECOMPOSE_DATA_MASK);
+	if (codepoint < DATABASE_DIRECT_LOOKUP_COUNT)
+	{
+		index = codepoint;
+	}
+	else
+	{
+		index = index1Array[codepoint >> DECOMPOSE_INDEX1_SHIFT];
+		index = index2Array[index + ((codepoint & DECOMPOSE_INDEX2_MASK) >> DECOMPOSE_INDEX2_SHIFT)];
+		index = index + (codepoint & DECOMPOSE_DATA_MASK);
+	}
 
 	if (index == 0 ||
 		(data = dataArray[index]) == 0)
@@ -57,57 +81,445 @@ const char* database_querydecomposition(unicode_t codepoint, const uint32_t* ind
 	return CompressedStringData + (data & 0x00FFFFFF);
 }
 
+const char* database_querycasemapping(unicode_t codepoint, const uint32_t* index1Array, const uint32_t* index2Array, const uint32_t* dataArray, unicode_t* mapped, uint8_t* length)
+{
+	uint32_t record = CASEMAPPING_GET(codepoint, index1Array, index2Array, dataArray);
+
+	if ((record & CASEMAPPING_RECORD_SIMPLE) != 0)
+	{
+		*mapped = CASEMAPPING_RECORD_MAPPED(codepoint, record);
+		*length = 0;
+
+		return 0;
+	}
+
+	*mapped = codepoint;
+	*length = CASEMAPPING_RECORD_LENGTH(record);
+
+	return (record != 0) ? CASEMAPPING_RECORD_STRING(record) : 0;
+}
+
+static size_t database_hashcomposition(uint64_t key, uint64_t salt, size_t count)
+{
+	/* Must match hashing in the converter's compositionHash */
+
+	uint64_t hashed = (((key + salt) * 0x9E3779B97F4A7C15ULL) ^ (key * 0x31415926ULL)) >> 32;
+
+	return (size_t)((hashed * (uint64_t)count) >> 32);
+}
+
 unicode_t database_querycomposition(unicode_t left, unicode_t right)
 {
+	/*
+		Records are stored as a minimal perfect hash. The first hash selects
+		a salt, the salted hash selects the only record that can match the key.
+	*/
+
 	uint64_t key = ((uint64_t)left << 32) + (uint64_t)right;
-	size_t offset_start = 0;
-	size_t offset_end = UnicodeCompositionRecordCount - 1;
-	size_t offset_pivot;
-	size_t i;
+	uint16_t salt = UnicodeCompositionSaltPtr[database_hashcomposition(key, 0, UnicodeCompositionRecordCount)];
+	const CompositionRecord* record = UnicodeCompositionRecordPtr + database_hashcomposition(key, salt, UnicodeCompositionRecordCount);
+
+	return (record->key == key) ? record->value : 0;
+}
+
+/*
+	Database files are produced by tools/converter/unicodedata.py. A file
+	starts with a header and a table of sections, followed by the sections
+	themselves in the order of DatabaseSections. Every section is aligned on
+	eight bytes and stored in little-endian byte order, so the file can be
+	mapped and used in place.
+
+	Every entry in the tries is checked once when the file is loaded, so a
+	file produced with a different trie geometry is rejected instead of
+	reading out of bounds on the first lookup.
+*/
+
+#define DATABASE_FILE_FORMAT (2)
+#define DATABASE_SECTION_COUNT (24)
+#define DATABASE_SECTION_COMPOSITION_SALT (21)
+#define DATABASE_SECTION_COMPOSITION_RECORD (22)
+#define DATABASE_INDEX1_COUNT ((MAX_LEGAL_UNICODE >> PROPERTY_INDEX1_SHIFT) + 1)
+
+typedef struct {
+	char magic[4];
+	uint32_t format;
+	uint32_t unicode_version;
+	uint32_t section_count;
+} DatabaseFileHeader;
+
+typedef struct {
+	uint32_t offset;
+	uint32_t size;
+} DatabaseFileSection;
+
+enum DatabaseSectionType
+{
+	DatabaseSectionType_Index1,
+	DatabaseSectionType_Index2,
+	DatabaseSectionType_Properties,
+	DatabaseSectionType_Decomposition,
+	DatabaseSectionType_CaseMapping,
+	DatabaseSectionType_Other,
+};
+
+typedef struct {
+	const void** pointer;
+	size_t element_size;
+	size_t minimum_count;
+	uint8_t type;
+} DatabaseSection;
+
+static const DatabaseSection DatabaseSections[DATABASE_SECTION_COUNT] = {
+	{ (const void**)&PropertiesIndex1Ptr, sizeof(uint16_t), DATABASE_INDEX1_COUNT, DatabaseSectionType_Index1 },
+	{ (const void**)&PropertiesIndex2Ptr, sizeof(uint16_t), 1, DatabaseSectionType_Index2 },
+	{ (const void**)&PropertiesDataPtr, sizeof(uint32_t), DATABASE_DIRECT_LOOKUP_COUNT, DatabaseSectionType_Properties },
+	{ (const void**)&NFDIndex1Ptr, sizeof(uint32_t), DATABASE_INDEX1_COUNT, DatabaseSectionType_Index1 },
+	{ (const void**)&NFDIndex2Ptr, sizeof(uint32_t), 1, DatabaseSectionType_Index2 },
+	{ (const void**)&NFDDataPtr, sizeof(uint32_t), DATABASE_DIRECT_LOOKUP_COUNT, DatabaseSectionType_Decomposition },
+	{ (const void**)&NFKDIndex1Ptr, sizeof(uint32_t), DATABASE_INDEX1_COUNT, DatabaseSectionType_Index1 },
+	{ (const void**)&NFKDIndex2Ptr, sizeof(uint32_t), 1, DatabaseSectionType_Index2 },
+	{ (const void**)&NFKDDataPtr, sizeof(uint32_t), DATABASE_DIRECT_LOOKUP_COUNT, DatabaseSectionType_Decomposition },
+	{ (const void**)&UppercaseIndex1Ptr, sizeof(uint32_t), DATABASE_INDEX1_COUNT, DatabaseSectionType_Index1 },
+	{ (const void**)&UppercaseIndex2Ptr, sizeof(uint32_t), 1, DatabaseSectionType_Index2 },
+	{ (const void**)&UppercaseDataPtr, sizeof(uint32_t), DATABASE_DIRECT_LOOKUP_COUNT, DatabaseSectionType_CaseMapping },
+	{ (const void**)&LowercaseIndex1Ptr, sizeof(uint32_t), DATABASE_INDEX1_COUNT, DatabaseSectionType_Index1 },
+	{ (const void**)&LowercaseIndex2Ptr, sizeof(uint32_t), 1, DatabaseSectionType_Index2 },
+	{ (const void**)&LowercaseDataPtr, sizeof(uint32_t), DATABASE_DIRECT_LOOKUP_COUNT, DatabaseSectionType_CaseMapping },
+	{ (const void**)&TitlecaseIndex1Ptr, sizeof(uint32_t), DATABASE_INDEX1_COUNT, DatabaseSectionType_Index1 },
+	{ (const void**)&TitlecaseIndex2Ptr, sizeof(uint32_t), 1, DatabaseSectionType_Index2 },
+	{ (const void**)&TitlecaseDataPtr, sizeof(uint32_t), DATABASE_DIRECT_LOOKUP_COUNT, DatabaseSectionType_CaseMapping },
+	{ (const void**)&CaseFoldingIndex1Ptr, sizeof(uint32_t), DATABASE_INDEX1_COUNT, DatabaseSectionType_Index1 },
+	{ (const void**)&CaseFoldingIndex2Ptr, sizeof(uint32_t), 1, DatabaseSectionType_Index2 },
+	{ (const void**)&CaseFoldingDataPtr, sizeof(uint32_t), DATABASE_DIRECT_LOOKUP_COUNT, DatabaseSectionType_CaseMapping },
+	{ (const void**)&UnicodeCompositionSaltPtr, sizeof(uint16_t), 1, DatabaseSectionType_Other },
+	{ (const void**)&UnicodeCompositionRecordPtr, sizeof(CompositionRecord), 1, DatabaseSectionType_Other },
+	{ (const void**)&CompressedStringData, sizeof(char), 1, DatabaseSectionType_Other },
+};
+
+static const uint8_t* database_mapping = 0;
+static size_t database_mapping_size = 0;
+static uint32_t database_mapping_version = 0;
+static const void* database_fallback[DATABASE_SECTION_COUNT];
+static size_t database_fallback_composition_count = 0;
+static size_t database_fallback_string_length = 0;
+
+static const uint8_t* database_map(const char* path, size_t* size)
+{
+#if WIN32 || _WINDOWS
+	HANDLE file;
+	HANDLE mapping;
+	LARGE_INTEGER file_size;
+	const uint8_t* view = 0;
 
-	if (key < UnicodeCompositionRecordPtr[offset_start].key ||
-		key > UnicodeCompositionRecordPtr[offset_end].key)
+	file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if (file == INVALID_HANDLE_VALUE)
 	{
 		return 0;
 	}
 
-	do
+	if (GetFileSizeEx(file, &file_size) &&
+		file_size.QuadPart > 0 &&
+		(uint64_t)file_size.QuadPart <= (uint64_t)((size_t)-1))
 	{
-		offset_pivot = offset_start + ((offset_end - offset_start) / 2);
-
-		if (key == UnicodeCompositionRecordPtr[offset_start].key)
-		{
-			return UnicodeCompositionRecordPtr[offset_start].value;
-		}
-		else if (key == UnicodeCompositionRecordPtr[offset_end].key)
+		mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+		if (mapping != 0)
 		{
-			return UnicodeCompositionRecordPtr[offset_end].value;
-		}
-		else if (key == UnicodeCompositionRecordPtr[offset_pivot].key)
-		{
-			return UnicodeCompositionRecordPtr[offset_pivot].value;
+			/* The view keeps the mapping alive after its handle is closed */
+
+			view = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			*size = (size_t)file_size.QuadPart;
+
+			CloseHandle(mapping);
 		}
-		else
+	}
+
+	CloseHandle(file);
+
+	return view;
+#elif DATABASE_MAPPING_POSIX
+	int file;
+	struct stat info;
+	void* view = MAP_FAILED;
+
+	file = open(path, O_RDONLY);
+	if (file == -1)
+	{
+		return 0;
+	}
+
+	if (fstat(file, &info) == 0 &&
+		info.st_size > 0)
+	{
+		/* Shared mappings of the same file use the same physical pages */
+
+		view = mmap(0, (size_t)info.st_size, PROT_READ, MAP_SHARED, file, 0);
+		*size = (size_t)info.st_size;
+	}
+
+	close(file);
+
+	return (view != MAP_FAILED) ? (const uint8_t*)view : 0;
+#else
+	(void)path;
+	(void)size;
+
+	return 0;
+#endif
+}
+
+static void database_unmap(const uint8_t* mapping, size_t size)
+{
+#if WIN32 || _WINDOWS
+	(void)size;
+
+	UnmapViewOfFile(mapping);
+#elif DATABASE_MAPPING_POSIX
+	munmap((void*)mapping, size);
+#else
+	(void)mapping;
+	(void)size;
+#endif
+}
+
+static const uint16_t database_byte_order = 1;
+
+static uint32_t database_entry(const uint8_t* section, size_t elementSize, size_t index)
+{
+	return (elementSize == sizeof(uint16_t)) ? ((const uint16_t*)section)[index] : ((const uint32_t*)section)[index];
+}
+
+static uint8_t database_validate(const uint8_t* mapping, const DatabaseFileSection* sections)
+{
+	size_t string_length = sections[DATABASE_SECTION_COUNT - 1].size;
+	size_t blocks = (PROPERTY_INDEX2_MASK >> PROPERTY_INDEX2_SHIFT) + 1;
+	size_t block_size = PROPERTY_DATA_MASK + 1;
+	size_t next_count;
+	uint32_t entry;
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < DATABASE_SECTION_COUNT; ++i)
+	{
+		const uint8_t* section = mapping + sections[i].offset;
+		size_t element_size = DatabaseSections[i].element_size;
+		size_t count = sections[i].size / element_size;
+
+		switch (DatabaseSections[i].type)
 		{
-			if (key > UnicodeCompositionRecordPtr[offset_pivot].key)
+
+		case DatabaseSectionType_Index1:
+			/* Every first stage entry starts a range of blocks in the second stage, which is the next section */
+
+			next_count = sections[i + 1].size / DatabaseSections[i + 1].element_size;
+
+			for (j = 0; j < DATABASE_INDEX1_COUNT; ++j)
+			{
+				if (next_count < blocks ||
+					database_entry(section, element_size, j) > next_count - blocks)
+				{
+					return 0;
+				}
+			}
+			break;
+
+		case DatabaseSectionType_Index2:
+			/* Every second stage entry starts a block of values in the data stage, which is the next section */
+
+			next_count = sections[i + 1].size / DatabaseSections[i + 1].element_size;
+
+			for (j = 0; j < count; ++j)
 			{
-				offset_start = offset_pivot;
+				if (next_count < block_size ||
+					database_entry(section, element_size, j) > next_count - block_size)
+				{
+					return 0;
+				}
 			}
-			else
+			break;
+
+		case DatabaseSectionType_Decomposition:
+			for (j = 0; j < count; ++j)
 			{
-				offset_end = offset_pivot;
+				entry = database_entry(section, element_size, j);
+
+				if ((entry & 0x00FFFFFF) + (entry >> 24) > string_length)
+				{
+					return 0;
+				}
 			}
+			break;
+
+		case DatabaseSectionType_CaseMapping:
+			/* Simple mappings store a distance instead of an offset */
+
+			for (j = 0; j < count; ++j)
+			{
+				entry = database_entry(section, element_size, j);
+
+				if ((entry & CASEMAPPING_RECORD_SIMPLE) == 0 &&
+					(entry & 0x00FFFFFF) + CASEMAPPING_RECORD_LENGTH(entry) > string_length)
+				{
+					return 0;
+				}
+			}
+			break;
+
+		default:
+			break;
+
+		}
+	}
+
+	return 1;
+}
+
+uint8_t database_load(const char* path, int32_t* errors)
+{
+	const uint8_t* mapping;
+	size_t mapping_size = 0;
+	const DatabaseFileHeader* header;
+	const DatabaseFileSection* sections;
+	size_t composition_count;
+	size_t i;
+
+	if (path == 0)
+	{
+		UTF8_SET_ERROR(INVALID_DATA);
+
+		return 0;
+	}
+
+	/* Tables are used in place, which requires a little-endian machine */
+
+	if (*(const uint8_t*)&database_byte_order != 1)
+	{
+		UTF8_SET_ERROR(INVALID_DATA);
+
+		return 0;
+	}
+
+	if ((mapping = database_map(path, &mapping_size)) == 0)
+	{
+		UTF8_SET_ERROR(DATABASE_UNAVAILABLE);
+
+		return 0;
+	}
+
+	/* Check header */
+
+	if (mapping_size < sizeof(DatabaseFileHeader) + (DATABASE_SECTION_COUNT * sizeof(DatabaseFileSection)))
+	{
+		goto invaliddata;
+	}
+
+	header = (const DatabaseFileHeader*)mapping;
+
+	if (memcmp(header->magic, "U8DB", 4) != 0 ||
+		header->format != DATABASE_FILE_FORMAT ||
+		header->unicode_version == 0 ||
+		header->section_count != DATABASE_SECTION_COUNT)
+	{
+		goto invaliddata;
+	}
+
+	/* Check sections */
+
+	sections = (const DatabaseFileSection*)(mapping + sizeof(DatabaseFileHeader));
+
+	for (i = 0; i < DATABASE_SECTION_COUNT; ++i)
+	{
+		if ((sections[i].offset % 8) != 0 ||
+			sections[i].offset > mapping_size ||
+			sections[i].size > mapping_size - sections[i].offset ||
+			(sections[i].size % DatabaseSections[i].element_size) != 0 ||
+			(sections[i].size / DatabaseSections[i].element_size) < DatabaseSections[i].minimum_count)
+		{
+			goto invaliddata;
 		}
 	}
-	while (offset_end - offset_start > 32);
 
-	for (i = offset_start; i <= offset_end; ++i)
+	/* Composition records are hashed, every salt has exactly one record */
+
+	composition_count = sections[DATABASE_SECTION_COMPOSITION_SALT].size / sizeof(uint16_t);
+
+	if (sections[DATABASE_SECTION_COMPOSITION_RECORD].size != composition_count * sizeof(CompositionRecord))
+	{
+		goto invaliddata;
+	}
+
+	/* Check every offset stored in the tries */
+
+	if (!database_validate(mapping, sections))
+	{
+		goto invaliddata;
+	}
+
+	/* Replace tables, one pointer at a time; the public header forbids queries on other threads while this runs */
+
+	if (database_mapping == 0)
 	{
-		if (key == UnicodeCompositionRecordPtr[i].key)
+		for (i = 0; i < DATABASE_SECTION_COUNT; ++i)
 		{
-			return UnicodeCompositionRecordPtr[i].value;
+			database_fallback[i] = *DatabaseSections[i].pointer;
 		}
+
+		database_fallback_composition_count = UnicodeCompositionRecordCount;
+		database_fallback_string_length = CompressedStringDataLength;
+	}
+	else
+	{
+		database_unmap(database_mapping, database_mapping_size);
 	}
 
+	for (i = 0; i < DATABASE_SECTION_COUNT; ++i)
+	{
+		*DatabaseSections[i].pointer = mapping + sections[i].offset;
+	}
+
+	UnicodeCompositionRecordCount = composition_count;
+	CompressedStringDataLength = sections[DATABASE_SECTION_COUNT - 1].size;
+
+	database_mapping = mapping;
+	database_mapping_size = mapping_size;
+	database_mapping_version = header->unicode_version;
+
+	UTF8_SET_ERROR(NONE);
+
+	return 1;
+
+invaliddata:
+	database_unmap(mapping, mapping_size);
+
+	UTF8_SET_ERROR(INVALID_DATA);
+
 	return 0;
-}
\ No newline at end of file
+}
+
+void database_unload()
+{
+	size_t i;
+
+	if (database_mapping == 0)
+	{
+		return;
+	}
+
+	for (i = 0; i < DATABASE_SECTION_COUNT; ++i)
+	{
+		*DatabaseSections[i].pointer = database_fallback[i];
+	}
+
+	UnicodeCompositionRecordCount = database_fallback_composition_count;
+	CompressedStringDataLength = database_fallback_string_length;
+
+	database_unmap(database_mapping, database_mapping_size);
+
+	database_mapping = 0;
+	database_mapping_size = 0;
+	database_mapping_version = 0;
+}
+
+uint32_t database_version()
+{
+	return (database_mapping != 0) ? database_mapping_version : UnicodeDatabaseVersion;
+}
@@ -52,40 +52,131 @@ enum QuickCheckResult
 	QuickCheckResult_No,
 };
 
-#define PROPERTY_INDEX_SHIFT (5)
+/*
+	Properties are stored in a three-stage trie. The first stage is indexed
+	by the upper bits of the code point and points into the deduplicated
+	second stage, which in turn points at a deduplicated block of 32 values
+	in the data stage. Both index stages use 16-bit offsets.
+
+	Every property of a code point is packed in a single 32-bit record, so
+	only one trie walk is needed to retrieve all of them:
+
+	bits  0 -  7  canonical combining class
+	bits  8 - 11  case mapped quick check flags
+	bits 12 - 13  NFC quick check
+	bits 14 - 15  NFD quick check
+	bits 16 - 17  NFKC quick check
+	bits 18 - 19  NFKD quick check
+	bits 24 - 28  general category, stored as the position of its flag plus one
+
+	Code points below U+0800 are stored uncompressed at the start of every
+	data table. Text in the one- and two-byte ranges of UTF-8 (Latin, Greek,
+	Cyrillic, Hebrew, Arabic) is looked up without walking the trie.
+*/
+
+#define DATABASE_DIRECT_LOOKUP_COUNT (0x800)
+
+#define PROPERTY_INDEX1_SHIFT (12)
+#define PROPERTY_INDEX2_SHIFT (5)
 
-static const unicode_t PROPERTY_DATA_MASK = (1 << PROPERTY_INDEX_SHIFT) - 1;
+static const unicode_t PROPERTY_INDEX2_MASK = (1 << PROPERTY_INDEX1_SHIFT) - 1;
+static const unicode_t PROPERTY_DATA_MASK = (1 << PROPERTY_INDEX2_SHIFT) - 1;
 
-#define PROPERTY_GET(_indexArray, _dataArray, _cp) \
-	(_dataArray)[ \
-		(_indexArray)[(_cp) >> PROPERTY_INDEX_SHIFT] + \
+#define PROPERTY_SHIFT_CCC   (0)
+#define PROPERTY_SHIFT_CM    (8)
+#define PROPERTY_SHIFT_NFC   (12)
+#define PROPERTY_SHIFT_NFD   (14)
+#define PROPERTY_SHIFT_NFKC  (16)
+#define PROPERTY_SHIFT_NFKD  (18)
+#define PROPERTY_SHIFT_GC    (24)
+
+#define PROPERTY_GET(_cp) \
+	PropertiesDataPtr[ \
+		((_cp) < DATABASE_DIRECT_LOOKUP_COUNT) ? (_cp) : \
+		PropertiesIndex2Ptr[ \
+			PropertiesIndex1Ptr[(_cp) >> PROPERTY_INDEX1_SHIFT] + \
+			(((_cp) & PROPERTY_INDEX2_MASK) >> PROPERTY_INDEX2_SHIFT)] + \
 		((_cp) & PROPERTY_DATA_MASK)]
 
+#define PROPERTY_RECORD_CCC(_record) \
+	((uint8_t)(((_record) >> PROPERTY_SHIFT_CCC) & 0xFF))
+
+#define PROPERTY_RECORD_CM(_record) \
+	((uint8_t)(((_record) >> PROPERTY_SHIFT_CM) & 0x0F))
+
+#define PROPERTY_RECORD_QC(_record, _shift) \
+	((uint8_t)(((_record) >> (_shift)) & 0x03))
+
+#define PROPERTY_RECORD_GC(_record) \
+	(((uint32_t)1 << (((_record) >> PROPERTY_SHIFT_GC) & 0x1F)) >> 1)
+
 #define PROPERTY_GET_GC(_cp) \
-	PROPERTY_GET(GeneralCategoryIndexPtr, GeneralCategoryDataPtr, _cp)
+	PROPERTY_RECORD_GC(PROPERTY_GET(_cp))
 
 #define PROPERTY_GET_CCC(_cp) \
-	PROPERTY_GET(CanonicalCombiningClassIndexPtr, CanonicalCombiningClassDataPtr, _cp)
+	PROPERTY_RECORD_CCC(PROPERTY_GET(_cp))
 
 #define PROPERTY_GET_CM(_cp) \
-	PROPERTY_GET(QuickCheckCaseMappedIndexPtr, QuickCheckCaseMappedDataPtr, _cp)
+	PROPERTY_RECORD_CM(PROPERTY_GET(_cp))
 
 #define PROPERTY_GET_NFC(_cp) \
-	PROPERTY_GET(QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr, _cp)
+	PROPERTY_RECORD_QC(PROPERTY_GET(_cp), PROPERTY_SHIFT_NFC)
 
 #define PROPERTY_GET_NFD(_cp) \
-	PROPERTY_GET(QuickCheckNFDIndexPtr, QuickCheckNFDDataPtr, _cp)
+	PROPERTY_RECORD_QC(PROPERTY_GET(_cp), PROPERTY_SHIFT_NFD)
 
 #define PROPERTY_GET_NFKC(_cp) \
-	PROPERTY_GET(QuickCheckNFKCIndexPtr, QuickCheckNFKCDataPtr, _cp)
+	PROPERTY_RECORD_QC(PROPERTY_GET(_cp), PROPERTY_SHIFT_NFKC)
 
 #define PROPERTY_GET_NFKD(_cp) \
-	PROPERTY_GET(QuickCheckNFKDIndexPtr, QuickCheckNFKDDataPtr, _cp)
+	PROPERTY_RECORD_QC(PROPERTY_GET(_cp), PROPERTY_SHIFT_NFKD)
+
+/*
+	Decompositions and case mappings are stored in tries with the same
+	layout as the properties, but with 32-bit offsets. A record in the data
+	stage is either zero, for code points that are not mapped, or:
+
+	bits  0 - 23  offset of the mapped string in CompressedStringData
+	bits 24 - 30  length of the mapped string in bytes
+
+	Most case mappings map a single code point to another. Those records
+	have bit 31 set and store the signed distance to the mapped code point
+	in bits 0 - 23 instead, so they can be written without any string data.
+*/
+
+#define CASEMAPPING_RECORD_SIMPLE (0x80000000)
+
+#define CASEMAPPING_GET(_cp, _index1, _index2, _data) \
+	(_data)[ \
+		((_cp) < DATABASE_DIRECT_LOOKUP_COUNT) ? (_cp) : \
+		(_index2)[ \
+			(_index1)[(_cp) >> PROPERTY_INDEX1_SHIFT] + \
+			(((_cp) & PROPERTY_INDEX2_MASK) >> PROPERTY_INDEX2_SHIFT)] + \
+		((_cp) & PROPERTY_DATA_MASK)]
+
+#define CASEMAPPING_RECORD_MAPPED(_cp, _record) \
+	((unicode_t)((int32_t)(_cp) + (int32_t)(((_record) & 0x00FFFFFF) ^ 0x00800000) - 0x00800000))
+
+#define CASEMAPPING_RECORD_LENGTH(_record) \
+	((uint8_t)(((_record) >> 24) & 0x7F))
+
+#define CASEMAPPING_RECORD_STRING(_record) \
+	(CompressedStringData + ((_record) & 0x00FFFFFF))
+
+uint32_t database_queryproperties(unicode_t codepoint);
 
 const char* database_querydecomposition(unicode_t codepoint, const uint32_t* index1Array, const uint32_t* index2Array, const uint32_t* dataArray, uint8_t* length);
 
+const char* database_querycasemapping(unicode_t codepoint, const uint32_t* index1Array, const uint32_t* index2Array, const uint32_t* dataArray, unicode_t* mapped, uint8_t* length);
+
 unicode_t database_querycomposition(unicode_t left, unicode_t right);
 
+uint8_t database_load(const char* path, int32_t* errors);
+
+void database_unload();
+
+uint32_t database_version();
+
 /*! \endcond */
 
 #endif /* _UTF8REWIND_INTERNAL_DATABASE_H_ */
\ No newline at end of file
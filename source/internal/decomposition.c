@@ -58,8 +58,7 @@ uint8_t decompose_initialize(
 		state->property_index2 = NFKDIndex2Ptr;
 		state->property_data = NFKDDataPtr;
 
-		state->qc_index = QuickCheckNFKDIndexPtr;
-		state->qc_data = QuickCheckNFKDDataPtr;
+		state->qc_shift = PROPERTY_SHIFT_NFKD;
 	}
 	else
 	{
@@ -67,8 +66,7 @@ uint8_t decompose_initialize(
 		state->property_index2 = NFDIndex2Ptr;
 		state->property_data = NFDDataPtr;
 
-		state->qc_index = QuickCheckNFDIndexPtr;
-		state->qc_data = QuickCheckNFDDataPtr;
+		state->qc_shift = PROPERTY_SHIFT_NFD;
 	}
 
 	return 1;
@@ -144,7 +142,7 @@ uint8_t decompose_execute(DecomposeState* state)
 	/* Read next sequence from input */
 
 	if (state->input->index == state->input->current &&
-		!stream_read(state->input, state->qc_index, state->qc_data))
+		!stream_read(state->input, state->qc_shift))
 	{
 		/* End of data */
 
@@ -230,7 +228,8 @@ uint8_t decompose_execute(DecomposeState* state)
 			/* Use quick check to skip stable codepoints */
 
 			unicode_t decoded_codepoint = *src_codepoint;
-			uint8_t decoded_quick_check = PROPERTY_GET(state->qc_index, state->qc_data, decoded_codepoint);
+			uint32_t decoded_properties = database_queryproperties(decoded_codepoint);
+			uint8_t decoded_quick_check = PROPERTY_RECORD_QC(decoded_properties, state->qc_shift);
 			uint8_t decoded_canonical_combining_class;
 			uint8_t decoded_size;
 
@@ -291,7 +290,7 @@ uint8_t decompose_execute(DecomposeState* state)
 			}
 			else
 			{
-				decoded_canonical_combining_class = PROPERTY_GET_CCC(decoded_codepoint);
+				decoded_canonical_combining_class = PROPERTY_RECORD_CCC(decoded_properties);
 
 				if (uncached)
 				{
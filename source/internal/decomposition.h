@@ -39,8 +39,7 @@
 typedef struct {
 	StreamState* input;
 	StreamState* output;
-	const size_t* qc_index;
-	const uint8_t* qc_data;
+	uint8_t qc_shift;
 	const uint32_t* property_index1;
 	const uint32_t* property_index2;
 	const uint32_t* property_data;
@@ -0,0 +1,195 @@
+/*
+	Copyright (C) 2014-2016 Quinten Lansu
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "length.h"
+
+#include "codepoint.h"
+#include "simd.h"
+
+/*
+	Instead of counting sequences, the functions below count the
+	continuation bytes that belong to a sequence. These are subtracted from
+	the size of the input, leaving one for every lead byte, Basic Latin byte,
+	invalid byte and stray continuation byte.
+*/
+
+size_t length_scalar(const uint8_t* input, size_t inputSize)
+{
+	const uint8_t* src = input;
+	size_t src_size = inputSize;
+	size_t absorbed = 0;
+	uint8_t remaining = 0;
+
+	while (src_size > 0)
+	{
+		/* Skip Basic Latin eight bytes at a time */
+
+		if (*src <= MAX_BASIC_LATIN)
+		{
+			uint64_t block;
+
+			while (src_size >= 8)
+			{
+				memcpy(&block, src, sizeof(block));
+				if ((block & 0x8080808080808080ULL) != 0)
+				{
+					break;
+				}
+
+				src += 8;
+				src_size -= 8;
+			}
+
+			remaining = 0;
+
+			if (src_size == 0)
+			{
+				break;
+			}
+		}
+
+		if ((*src & 0xC0) == 0x80)
+		{
+			/* Continuation byte, part of a sequence when the lead byte allows it */
+
+			if (remaining > 0)
+			{
+				absorbed++;
+				remaining--;
+			}
+		}
+		else
+		{
+			remaining = codepoint_decoded_length[*src] - 1;
+		}
+
+		src++;
+		src_size--;
+	}
+
+	return inputSize - absorbed;
+}
+
+#if UTF8_SIMD_SSE2
+
+/*
+	A continuation byte belongs to a sequence when the lead byte is at most
+	as many bytes back as its decoded length minus one, with only
+	continuation bytes in between. Because the decoded length grows with the
+	value of the lead byte, each distance only needs a minimum lead byte.
+*/
+
+#define LENGTH_PREVIOUS(_current, _previous, _count) \
+	_mm_or_si128(_mm_slli_si128(_current, _count), _mm_srli_si128(_previous, 16 - (_count)))
+
+#define LENGTH_AT_LEAST(_value, _minimum) \
+	_mm_cmpeq_epi8(_mm_max_epu8(_value, _mm_set1_epi8((char)(_minimum))), _value)
+
+#define LENGTH_CONTINUATION(_value) \
+	_mm_cmplt_epi8(_value, _mm_set1_epi8((char)0xC0))
+
+static size_t length_sse2_absorbed(__m128i current, __m128i previous)
+{
+	__m128i previous_1 = LENGTH_PREVIOUS(current, previous, 1);
+	__m128i previous_2 = LENGTH_PREVIOUS(current, previous, 2);
+	__m128i previous_3 = LENGTH_PREVIOUS(current, previous, 3);
+	__m128i previous_4 = LENGTH_PREVIOUS(current, previous, 4);
+	__m128i previous_5 = LENGTH_PREVIOUS(current, previous, 5);
+	__m128i previous_6 = LENGTH_PREVIOUS(current, previous, 6);
+	__m128i absorbed;
+	unsigned int mask;
+
+	/* Work outwards from the lead byte six bytes back */
+
+	absorbed = LENGTH_AT_LEAST(previous_6, 0xFE);
+	absorbed = _mm_or_si128(LENGTH_AT_LEAST(previous_5, 0xFC), _mm_and_si128(LENGTH_CONTINUATION(previous_5), absorbed));
+	absorbed = _mm_or_si128(LENGTH_AT_LEAST(previous_4, 0xF8), _mm_and_si128(LENGTH_CONTINUATION(previous_4), absorbed));
+	absorbed = _mm_or_si128(LENGTH_AT_LEAST(previous_3, 0xF0), _mm_and_si128(LENGTH_CONTINUATION(previous_3), absorbed));
+	absorbed = _mm_or_si128(LENGTH_AT_LEAST(previous_2, 0xE0), _mm_and_si128(LENGTH_CONTINUATION(previous_2), absorbed));
+	absorbed = _mm_or_si128(LENGTH_AT_LEAST(previous_1, 0xC0), _mm_and_si128(LENGTH_CONTINUATION(previous_1), absorbed));
+	absorbed = _mm_and_si128(LENGTH_CONTINUATION(current), absorbed);
+
+	/* Count the bits in the mask */
+
+	mask = (unsigned int)_mm_movemask_epi8(absorbed);
+	mask = mask - ((mask >> 1) & 0x5555);
+	mask = (mask & 0x3333) + ((mask >> 2) & 0x3333);
+	mask = (mask + (mask >> 4)) & 0x0F0F;
+
+	return (mask + (mask >> 8)) & 0x1F;
+}
+
+size_t length_sse2(const uint8_t* input, size_t inputSize)
+{
+	const uint8_t* src = input;
+	size_t src_size = inputSize;
+	size_t absorbed = 0;
+	__m128i previous = _mm_setzero_si128();
+	__m128i current;
+
+	while (src_size >= 16)
+	{
+		current = _mm_loadu_si128((const __m128i*)src);
+
+		/* Basic Latin bytes are never part of a sequence */
+
+		if (_mm_movemask_epi8(current) != 0)
+		{
+			absorbed += length_sse2_absorbed(current, previous);
+		}
+
+		previous = current;
+		src += 16;
+		src_size -= 16;
+	}
+
+	if (src_size > 0)
+	{
+		/* Pad the remainder with NUL bytes, which end every sequence */
+
+		uint8_t block[16] = { 0 };
+		memcpy(block, src, src_size);
+
+		current = _mm_loadu_si128((const __m128i*)block);
+
+		absorbed += length_sse2_absorbed(current, previous);
+	}
+
+	return inputSize - absorbed;
+}
+
+#else
+
+size_t length_sse2(const uint8_t* input, size_t inputSize)
+{
+	return length_scalar(input, inputSize);
+}
+
+#endif
+
+size_t length_execute(const uint8_t* input, size_t inputSize)
+{
+	return length_sse2(input, inputSize);
+}
\ No newline at end of file
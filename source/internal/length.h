@@ -0,0 +1,54 @@
+/*
+	Copyright (C) 2014-2016 Quinten Lansu
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef _UTF8REWIND_INTERNAL_LENGTH_H_
+#define _UTF8REWIND_INTERNAL_LENGTH_H_
+
+/*!
+	\file
+	\brief Length interface.
+
+	\cond INTERNAL
+*/
+
+#include "utf8rewind.h"
+
+/*
+	All functions return the number of code points in the input, counted the
+	same way as utf8len: a sequence is a lead byte followed by at most as
+	many continuation bytes as the lead byte specifies. Every other byte,
+	including a continuation byte that is not part of a sequence and a NUL
+	byte, counts as a single code point.
+*/
+
+size_t length_scalar(const uint8_t* input, size_t inputSize);
+
+size_t length_sse2(const uint8_t* input, size_t inputSize);
+
+size_t length_execute(const uint8_t* input, size_t inputSize);
+
+/*! \endcond */
+
+#endif /* _UTF8REWIND_INTERNAL_LENGTH_H_ */
\ No newline at end of file
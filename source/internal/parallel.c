@@ -0,0 +1,267 @@
+/*
+	Copyright (C) 2014-2016 Quinten Lansu
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "parallel.h"
+
+#include "base.h"
+#include "codepoint.h"
+
+typedef size_t (*ParallelConvertFunction)(const char* input, size_t inputSize, char* target, size_t targetSize, int32_t* errors);
+typedef size_t (*ParallelMeasureFunction)(const char* input, size_t inputSize, int32_t* errors);
+
+typedef struct {
+	const char* input;
+	size_t input_size;
+	size_t output_offset;
+	size_t output_size;
+	int32_t error;
+} ParallelChunk;
+
+typedef struct {
+	ParallelConvertFunction convert;
+	ParallelMeasureFunction measure;
+	char* target;
+	size_t target_size;
+	ParallelChunk chunks[PARALLEL_MAXIMUM_CHUNKS];
+	size_t chunk_count;
+} ParallelState;
+
+static size_t parallel_convert_utf16toutf8(const char* input, size_t inputSize, char* target, size_t targetSize, int32_t* errors)
+{
+	return utf16toutf8((const utf16_t*)input, inputSize, target, targetSize, errors);
+}
+
+static size_t parallel_convert_utf8toutf16(const char* input, size_t inputSize, char* target, size_t targetSize, int32_t* errors)
+{
+	return utf8toutf16(input, inputSize, (utf16_t*)target, targetSize, errors);
+}
+
+static size_t parallel_measure_utf16toutf8(const char* input, size_t inputSize, int32_t* errors)
+{
+	return utf16toutf8_size((const utf16_t*)input, inputSize, errors);
+}
+
+static size_t parallel_measure_utf8toutf16(const char* input, size_t inputSize, int32_t* errors)
+{
+	return utf8toutf16_size(input, inputSize, errors);
+}
+
+static size_t parallel_boundary_utf16(const char* input, size_t inputSize, size_t offset)
+{
+	/* Chunks start on a code unit and never on the low surrogate of a pair */
+
+	const utf16_t* src;
+
+	offset -= offset % sizeof(utf16_t);
+
+	src = (const utf16_t*)(input + offset);
+	if (offset > 0 &&
+		offset + sizeof(utf16_t) <= inputSize &&
+		src[0] >= SURROGATE_LOW_START && src[0] <= SURROGATE_LOW_END &&
+		src[-1] >= SURROGATE_HIGH_START && src[-1] <= SURROGATE_HIGH_END)
+	{
+		offset += sizeof(utf16_t);
+	}
+
+	return offset;
+}
+
+static size_t parallel_boundary_utf8(const char* input, size_t inputSize, size_t offset)
+{
+	/* Chunks start on a byte that is not a continuation byte, which always starts a new sequence */
+
+	while (
+		offset < inputSize &&
+		(input[offset] & 0xC0) == 0x80)
+	{
+		offset++;
+	}
+
+	return offset;
+}
+
+static void parallel_measure_task(void* data, size_t index)
+{
+	ParallelState* state = (ParallelState*)data;
+	ParallelChunk* chunk = &state->chunks[index];
+
+	chunk->output_size = state->measure(chunk->input, chunk->input_size, &chunk->error);
+}
+
+static void parallel_convert_task(void* data, size_t index)
+{
+	ParallelState* state = (ParallelState*)data;
+	ParallelChunk* chunk = &state->chunks[index];
+	size_t available;
+
+	if (chunk->output_offset >= state->target_size)
+	{
+		/* A previous chunk already ran out of space */
+
+		chunk->output_size = 0;
+		chunk->error = UTF8_ERR_NOT_ENOUGH_SPACE;
+
+		return;
+	}
+
+	available = state->target_size - chunk->output_offset;
+	if (available > chunk->output_size)
+	{
+		available = chunk->output_size;
+	}
+
+	chunk->output_size = state->convert(chunk->input, chunk->input_size, state->target + chunk->output_offset, available, &chunk->error);
+}
+
+static size_t parallel_execute(
+	ParallelConvertFunction convert, ParallelMeasureFunction measure, size_t (*boundary)(const char*, size_t, size_t),
+	const char* input, size_t inputSize, char* target, size_t targetSize,
+	const utf8executor_t* executor, int32_t* errors)
+{
+	ParallelState state;
+	size_t chunk_size;
+	size_t chunk_count;
+	size_t chunk_start = 0;
+	size_t bytes_written = 0;
+	int32_t error = UTF8_ERR_NONE;
+	size_t i;
+
+	/* Without tasks that run at the same time, splitting only adds a second pass over the input */
+
+	if (executor == 0 ||
+		executor->execute == 0 ||
+		executor->concurrency <= 1)
+	{
+		return convert(input, inputSize, target, targetSize, errors);
+	}
+
+	/* Split the input evenly over the tasks, without making chunks smaller than the chunk size. There are more chunks than threads, the executor queues the ones that do not fit. */
+
+	chunk_size = (executor->chunkSize > 0) ? executor->chunkSize : PARALLEL_DEFAULT_CHUNK_SIZE;
+	chunk_count = PARALLEL_CHUNKS_PER_TASK * executor->concurrency;
+
+	if (chunk_count > inputSize / chunk_size)
+	{
+		chunk_count = inputSize / chunk_size;
+	}
+
+	if (chunk_count > PARALLEL_MAXIMUM_CHUNKS)
+	{
+		chunk_count = PARALLEL_MAXIMUM_CHUNKS;
+	}
+
+	if (chunk_count <= 1)
+	{
+		return convert(input, inputSize, target, targetSize, errors);
+	}
+
+	state.convert = convert;
+	state.measure = measure;
+	state.target = target;
+	state.target_size = targetSize;
+	state.chunk_count = 0;
+
+	for (i = 1; i <= chunk_count; ++i)
+	{
+		size_t chunk_end = (i == chunk_count) ? inputSize : boundary(input, inputSize, (inputSize / chunk_count) * i);
+
+		if (chunk_end > chunk_start)
+		{
+			ParallelChunk* chunk = &state.chunks[state.chunk_count++];
+
+			chunk->input = input + chunk_start;
+			chunk->input_size = chunk_end - chunk_start;
+
+			chunk_start = chunk_end;
+		}
+	}
+
+	/* Measure the output of every chunk */
+
+	executor->execute(executor->context, parallel_measure_task, &state, state.chunk_count);
+
+	for (i = 0; i < state.chunk_count; ++i)
+	{
+		state.chunks[i].output_offset = bytes_written;
+		bytes_written += state.chunks[i].output_size;
+
+		if (state.chunks[i].error != UTF8_ERR_NONE)
+		{
+			error = state.chunks[i].error;
+		}
+	}
+
+	/* Convert every chunk to its offset in the target */
+
+	if (target != 0)
+	{
+		executor->execute(executor->context, parallel_convert_task, &state, state.chunk_count);
+
+		bytes_written = 0;
+
+		for (i = 0; i < state.chunk_count; ++i)
+		{
+			bytes_written += state.chunks[i].output_size;
+
+			if (state.chunks[i].error == UTF8_ERR_NOT_ENOUGH_SPACE)
+			{
+				error = UTF8_ERR_NOT_ENOUGH_SPACE;
+
+				break;
+			}
+		}
+	}
+
+	if (errors != 0)
+	{
+		*errors = error;
+	}
+
+	return bytes_written;
+}
+
+size_t parallel_utf16toutf8(const utf16_t* input, size_t inputSize, char* target, size_t targetSize, const utf8executor_t* executor, int32_t* errors)
+{
+	utf8result_t* progress = 0;
+
+	UTF8_VALIDATE_PARAMETERS_CHAR(utf16_t, 0);
+
+	return parallel_execute(
+		parallel_convert_utf16toutf8, parallel_measure_utf16toutf8, parallel_boundary_utf16,
+		(const char*)input, inputSize, target, targetSize,
+		executor, errors);
+}
+
+size_t parallel_utf8toutf16(const char* input, size_t inputSize, utf16_t* target, size_t targetSize, const utf8executor_t* executor, int32_t* errors)
+{
+	utf8result_t* progress = 0;
+
+	UTF8_VALIDATE_PARAMETERS(char, utf16_t, 0);
+
+	return parallel_execute(
+		parallel_convert_utf8toutf16, parallel_measure_utf8toutf16, parallel_boundary_utf8,
+		input, inputSize, (char*)target, targetSize,
+		executor, errors);
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+/*
+	Copyright (C) 2014-2016 Quinten Lansu
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef _UTF8REWIND_INTERNAL_PARALLEL_H_
+#define _UTF8REWIND_INTERNAL_PARALLEL_H_
+
+/*!
+	\file
+	\brief Parallel conversion interface.
+
+	\cond INTERNAL
+*/
+
+#include "utf8rewind.h"
+
+/*
+	The input is split into chunks that start on a code point, which are
+	converted independently by the tasks of the executor. The first pass
+	measures the output of every chunk, the prefix sum of these sizes is the
+	offset of each chunk in the target and the second pass converts the
+	chunks to their offset. The result is identical to converting the input
+	in one go, including the errors.
+*/
+
+#define PARALLEL_DEFAULT_CHUNK_SIZE (1 << 20)
+#define PARALLEL_MAXIMUM_CHUNKS (64)
+#define PARALLEL_CHUNKS_PER_TASK (4)
+
+size_t parallel_utf16toutf8(const utf16_t* input, size_t inputSize, char* target, size_t targetSize, const utf8executor_t* executor, int32_t* errors);
+
+size_t parallel_utf8toutf16(const char* input, size_t inputSize, utf16_t* target, size_t targetSize, const utf8executor_t* executor, int32_t* errors);
+
+/*! \endcond */
+
+#endif /* _UTF8REWIND_INTERNAL_PARALLEL_H_ */
\ No newline at end of file
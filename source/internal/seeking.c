@@ -25,7 +25,158 @@
 
 #include "seeking.h"
 
+#include "base.h"
 #include "codepoint.h"
+#include "simd.h"
+
+#if UTF8_SIMD_SSE2
+
+/*
+	Both seeking functions land on the same code points as decoding forward
+	from the start: a continuation byte belongs to a sequence when a valid
+	lead byte at most five bytes back allows it, with only continuation
+	bytes in between. Every other byte starts a code point. This only
+	depends on the preceding bytes, so whole blocks can be skipped by
+	counting the bytes that start a code point.
+*/
+
+#define SEEKING_PREVIOUS(_current, _previous, _count) \
+	_mm_or_si128(_mm_slli_si128(_current, _count), _mm_srli_si128(_previous, 16 - (_count)))
+
+#define SEEKING_LEAD(_value, _minimum) \
+	_mm_and_si128( \
+		_mm_cmpeq_epi8(_mm_max_epu8(_value, _mm_set1_epi8((char)(_minimum))), _value), \
+		_mm_cmpeq_epi8(_mm_min_epu8(_value, _mm_set1_epi8((char)0xFD)), _value))
+
+#define SEEKING_CONTINUATION(_value) \
+	_mm_cmplt_epi8(_value, _mm_set1_epi8((char)0xC0))
+
+static unsigned int seeking_sse2_starts(__m128i current, __m128i previous)
+{
+	__m128i previous_1;
+	__m128i previous_2;
+	__m128i previous_3;
+	__m128i previous_4;
+	__m128i previous_5;
+	__m128i absorbed;
+
+	/* Basic Latin bytes always start a code point */
+
+	if (_mm_movemask_epi8(current) == 0)
+	{
+		return 0xFFFF;
+	}
+
+	previous_1 = SEEKING_PREVIOUS(current, previous, 1);
+	previous_2 = SEEKING_PREVIOUS(current, previous, 2);
+	previous_3 = SEEKING_PREVIOUS(current, previous, 3);
+	previous_4 = SEEKING_PREVIOUS(current, previous, 4);
+	previous_5 = SEEKING_PREVIOUS(current, previous, 5);
+
+	/* Work outwards from the lead byte five bytes back */
+
+	absorbed = SEEKING_LEAD(previous_5, 0xFC);
+	absorbed = _mm_or_si128(SEEKING_LEAD(previous_4, 0xF8), _mm_and_si128(SEEKING_CONTINUATION(previous_4), absorbed));
+	absorbed = _mm_or_si128(SEEKING_LEAD(previous_3, 0xF0), _mm_and_si128(SEEKING_CONTINUATION(previous_3), absorbed));
+	absorbed = _mm_or_si128(SEEKING_LEAD(previous_2, 0xE0), _mm_and_si128(SEEKING_CONTINUATION(previous_2), absorbed));
+	absorbed = _mm_or_si128(SEEKING_LEAD(previous_1, 0xC0), _mm_and_si128(SEEKING_CONTINUATION(previous_1), absorbed));
+	absorbed = _mm_and_si128(SEEKING_CONTINUATION(current), absorbed);
+
+	return ~(unsigned int)_mm_movemask_epi8(absorbed) & 0xFFFF;
+}
+
+static off_t seeking_sse2_count(unsigned int mask)
+{
+	mask = mask - ((mask >> 1) & 0x5555);
+	mask = (mask & 0x3333) + ((mask >> 2) & 0x3333);
+	mask = (mask + (mask >> 4)) & 0x0F0F;
+
+	return (off_t)((mask + (mask >> 8)) & 0x1F);
+}
+
+static const char* seeking_sse2_forward(const char* input, const char* inputEnd, off_t* offset)
+{
+	const char* src = input;
+	const char* last_block = 0;
+	unsigned int last_starts = 0;
+	off_t counted = 0;
+	__m128i previous = _mm_setzero_si128();
+	__m128i current;
+	int last_start;
+
+	while (inputEnd - src >= 16)
+	{
+		unsigned int starts;
+		off_t starts_count;
+
+		current = _mm_loadu_si128((const __m128i*)src);
+
+		starts = seeking_sse2_starts(current, previous);
+		starts_count = seeking_sse2_count(starts);
+
+		if (counted + starts_count > *offset)
+		{
+			/* Requested code point is in this block */
+
+			break;
+		}
+
+		counted += starts_count;
+		last_block = src;
+		last_starts = starts;
+
+		previous = current;
+		src += 16;
+	}
+
+	if (last_block == 0)
+	{
+		return input;
+	}
+
+	/* Continue from the last code point in the skipped blocks, the block cannot consist of continuation bytes only */
+
+	for (last_start = 15; (last_starts & (1 << last_start)) == 0; --last_start)
+	{
+	}
+
+	*offset -= counted - 1;
+
+	return last_block + last_start;
+}
+
+static const char* seeking_sse2_rewind(const char* inputStart, const char* input, off_t* offset)
+{
+	const char* src = input;
+	__m128i current;
+	__m128i previous;
+
+	/* The preceding block is needed to find sequences crossing into the current one */
+
+	while (src - inputStart >= 32)
+	{
+		off_t starts_count;
+
+		current = _mm_loadu_si128((const __m128i*)(src - 16));
+		previous = _mm_loadu_si128((const __m128i*)(src - 32));
+
+		starts_count = seeking_sse2_count(seeking_sse2_starts(current, previous));
+
+		if (starts_count >= -*offset)
+		{
+			/* Requested code point is in this block */
+
+			break;
+		}
+
+		*offset += starts_count;
+		src -= 16;
+	}
+
+	return src;
+}
+
+#endif
 
 const char* seeking_forward(const char* input, const char* inputEnd, size_t inputSize, off_t offset)
 {
@@ -41,6 +192,13 @@ const char* seeking_forward(const char* input, const char* inputEnd, size_t inpu
 		return inputEnd;
 	}
 
+#if UTF8_SIMD_SSE2
+	if (offset >= 16)
+	{
+		input = seeking_sse2_forward(input, inputEnd, &offset);
+	}
+#endif
+
 	do
 	{
 		/* Get decoded length of next sequence */
@@ -96,6 +254,15 @@ const char* seeking_rewind(const char* inputStart, const char* input, size_t inp
 		return inputStart;
 	}
 
+#if UTF8_SIMD_SSE2
+	/* Code points before the remaining input are not affected by what comes after */
+
+	if (offset <= -16)
+	{
+		input = seeking_sse2_rewind(inputStart, input, &offset);
+	}
+#endif
+
 	/* Set up the marker */
 
 	marker = input - 1;
@@ -184,4 +351,193 @@ const char* seeking_rewind(const char* inputStart, const char* input, size_t inp
 		++offset < 0);
 
 	return input;
+}
+
+const char* seeking_next(const char* input, const char* inputEnd)
+{
+	uint8_t codepoint_length;
+
+	if (input >= inputEnd)
+	{
+		return input;
+	}
+
+	codepoint_length = codepoint_decoded_length[(uint8_t)*input];
+	input++;
+
+	if (codepoint_length > 1 &&
+		codepoint_length < 7)
+	{
+		/* Consume continuation bytes until the sequence is complete */
+
+		while (--codepoint_length > 0 &&
+			input < inputEnd &&
+			codepoint_decoded_length[(uint8_t)*input] == 0)
+		{
+			input++;
+		}
+	}
+
+	return input;
+}
+
+const char* seeking_previous(const char* inputStart, const char* input)
+{
+	const char* lead;
+	uint8_t distance;
+
+	if (input <= inputStart)
+	{
+		return input;
+	}
+
+	/*
+		Unlike seeking_rewind, only the bytes that can belong to the previous
+		sequence are read. A valid lead byte absorbs at most five continuation
+		bytes, anything further back cannot affect the previous code point.
+	*/
+
+	for (lead = input - 1, distance = 0;
+		lead >= inputStart && distance < 6;
+		--lead, ++distance)
+	{
+		uint8_t codepoint_length = codepoint_decoded_length[(uint8_t)*lead];
+
+		if (codepoint_length != 0)
+		{
+			if (codepoint_length > distance &&
+				codepoint_length < 7)
+			{
+				/* Sequence ends at the input */
+
+				return lead;
+			}
+
+			break;
+		}
+	}
+
+	/* Single byte */
+
+	return input - 1;
+}
+
+size_t seeking_index(const char* input, size_t inputSize, size_t interval, size_t* target, size_t targetSize, int32_t* errors)
+{
+	const char* src = input;
+	const char* src_end = input + inputSize;
+	size_t header[2];
+	size_t bytes_written = 0;
+	size_t i;
+
+	if (input == 0)
+	{
+		UTF8_SET_ERROR(INVALID_DATA);
+
+		return bytes_written;
+	}
+
+	if (interval == 0)
+	{
+		interval = SEEKING_INDEX_DEFAULT_INTERVAL;
+	}
+
+	header[0] = interval;
+	header[1] = inputSize;
+
+	for (i = 0; i < 2; ++i)
+	{
+		if (target != 0)
+		{
+			if (targetSize < bytes_written + sizeof(size_t))
+			{
+				goto outofspace;
+			}
+
+			target[i] = header[i];
+		}
+
+		bytes_written += sizeof(size_t);
+	}
+
+	/* Every code point takes at least one byte, so the next checkpoint is past the end when fewer bytes remain */
+
+	while (interval < (size_t)(src_end - src))
+	{
+		/* Step over the same sequences as seeking_forward from the start */
+
+		src = seeking_forward(src, src_end, (size_t)(src_end - src), (off_t)interval);
+		if (src >= src_end)
+		{
+			break;
+		}
+
+		if (target != 0)
+		{
+			if (targetSize < bytes_written + sizeof(size_t))
+			{
+				goto outofspace;
+			}
+
+			target[bytes_written / sizeof(size_t)] = (size_t)(src - input);
+		}
+
+		bytes_written += sizeof(size_t);
+	}
+
+	UTF8_SET_ERROR(NONE);
+
+	return bytes_written;
+
+outofspace:
+	UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
+
+	return bytes_written;
+}
+
+const char* seeking_indexed(const char* input, size_t inputSize, off_t offset, const size_t* index, size_t indexSize)
+{
+	const char* input_end = input + inputSize;
+	size_t checkpoint_count;
+	size_t checkpoint;
+
+	if (index == 0 ||
+		indexSize < 2 * sizeof(size_t) ||
+		index[0] == 0 ||             /* Invalid interval */
+		index[0] >= inputSize ||     /* No checkpoints */
+		index[1] != inputSize ||     /* Built for a different string */
+		offset < (off_t)index[0])    /* Before the first checkpoint */
+	{
+		return seeking_forward(input, input_end, inputSize, offset);
+	}
+
+	checkpoint_count = (indexSize / sizeof(size_t)) - 2;
+
+	/* Use the last checkpoint when the string ends before the requested one */
+
+	checkpoint = (size_t)offset / index[0];
+	if (checkpoint > checkpoint_count)
+	{
+		checkpoint = checkpoint_count;
+	}
+
+	/* Checkpoints are one-based, code point zero is the start of the string */
+
+	while (checkpoint > 0 &&
+		index[checkpoint + 1] >= inputSize)
+	{
+		/* Ignore damaged checkpoints */
+
+		checkpoint--;
+	}
+
+	if (checkpoint == 0)
+	{
+		return seeking_forward(input, input_end, inputSize, offset);
+	}
+
+	input += index[checkpoint + 1];
+	offset -= (off_t)(checkpoint * index[0]);
+
+	return seeking_forward(input, input_end, (size_t)(input_end - input), offset);
 }
\ No newline at end of file
@@ -35,10 +35,20 @@
 
 #include "utf8rewind.h"
 
+#define SEEKING_INDEX_DEFAULT_INTERVAL (1024)
+
 const char* seeking_forward(const char* input, const char* inputEnd, size_t inputSize, off_t offset);
 
 const char* seeking_rewind(const char* inputStart, const char* input, size_t inputSize, off_t offset);
 
+const char* seeking_next(const char* input, const char* inputEnd);
+
+const char* seeking_previous(const char* inputStart, const char* input);
+
+size_t seeking_index(const char* input, size_t inputSize, size_t interval, size_t* target, size_t targetSize, int32_t* errors);
+
+const char* seeking_indexed(const char* input, size_t inputSize, off_t offset, const size_t* index, size_t indexSize);
+
 /*! \endcond */
 
 #endif /* _UTF8REWIND_INTERNAL_SEEKING_H_ */
\ No newline at end of file
@@ -0,0 +1,64 @@
+/*
+	Copyright (C) 2014-2016 Quinten Lansu
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef _UTF8REWIND_INTERNAL_SIMD_H_
+#define _UTF8REWIND_INTERNAL_SIMD_H_
+
+/*!
+	\file
+	\brief SIMD interface.
+
+	\cond INTERNAL
+*/
+
+#include "utf8rewind.h"
+
+/*
+	SSE2 is part of every x64 processor and is used whenever the compiler
+	targets it. AVX2 kernels are compiled with a function attribute and are
+	only selected when the processor reports support at runtime, so the
+	library can still be built for the base instruction set.
+*/
+
+#if !UTF8_DISABLE_SIMD
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define UTF8_SIMD_SSE2 (1)
+
+		#include <emmintrin.h>
+	#endif
+
+	#if UTF8_SIMD_SSE2 && (defined(__GNUC__) || defined(__clang__))
+		#define UTF8_SIMD_AVX2 (1)
+		#define UTF8_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+
+		#include <immintrin.h>
+	#endif
+#endif
+
+uint8_t simd_supports_avx2();
+
+/*! \endcond */
+
+#endif /* _UTF8REWIND_INTERNAL_SIMD_H_ */
\ No newline at end of file
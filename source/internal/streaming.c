@@ -27,6 +27,7 @@
 
 #include "codepoint.h"
 #include "database.h"
+#include "../unicodedatabase.h"
 
 uint8_t stream_initialize(StreamState* state, const char* input, size_t inputSize)
 {
@@ -46,13 +47,11 @@ uint8_t stream_initialize(StreamState* state, const char* input, size_t inputSiz
 	return 1;
 }
 
-uint8_t stream_read(StreamState* state, const size_t* propertyIndex, const uint8_t* propertyData)
+uint8_t stream_read(StreamState* state, uint8_t quickCheckShift)
 {
 	/* Ensure input is available */
 
-	if (state->src_size == 0 ||
-		propertyIndex == 0 ||
-		propertyData == 0)
+	if (state->src_size == 0)
 	{
 		return 0;
 	}
@@ -96,6 +95,8 @@ uint8_t stream_read(StreamState* state, const size_t* propertyIndex, const uint8
 
 	while (state->filled < STREAM_SAFE_MAX)
 	{
+		uint32_t properties;
+
 		/* Move the input cursor after peeking */
 
 		if (state->last_length > 0)
@@ -115,8 +116,10 @@ uint8_t stream_read(StreamState* state, const size_t* propertyIndex, const uint8
 		/* Peek the next codepoint */
 
 		state->last_length = codepoint_read(state->src, state->src_size, &state->codepoint[state->filled]);
-		state->quick_check[state->filled] = PROPERTY_GET(propertyIndex, propertyData, state->codepoint[state->filled]);
-		state->canonical_combining_class[state->filled] = PROPERTY_GET_CCC(state->codepoint[state->filled]);
+
+		properties = database_queryproperties(state->codepoint[state->filled]);
+		state->quick_check[state->filled] = PROPERTY_RECORD_QC(properties, quickCheckShift);
+		state->canonical_combining_class[state->filled] = PROPERTY_RECORD_CCC(properties);
 
 		state->filled++;
 
@@ -233,4 +236,92 @@ uint8_t stream_reorder(StreamState* state)
 	while (dirty == 1);
 
 	return 1;
+}
+
+size_t stream_boundary(const char* input, size_t inputSize, size_t minimumSize, uint8_t quickCheckShift)
+{
+	/*
+		Finds the first code point after the minimum size that is a starter
+		and stable in the normalization form. Text on both sides of it can be
+		normalized separately, because nothing after it composes with or is
+		reordered before it.
+	*/
+
+	const char* src;
+	const char* src_end = input + inputSize;
+
+	if (minimumSize >= inputSize)
+	{
+		return inputSize;
+	}
+
+	/* The segment contains at least one code point */
+
+	src = input + ((minimumSize > 0) ? minimumSize : 1);
+
+	/* Skip to the start of the next sequence */
+
+	while (
+		src < src_end &&
+		(*src & 0xC0) == 0x80)
+	{
+		src++;
+	}
+
+	while (src < src_end)
+	{
+		unicode_t decoded;
+		uint32_t properties;
+		uint8_t decoded_size;
+
+		/* Basic Latin is always stable */
+
+		if ((uint8_t)*src <= MAX_BASIC_LATIN)
+		{
+			return (size_t)(src - input);
+		}
+
+		decoded_size = codepoint_read(src, (size_t)(src_end - src), &decoded);
+
+		properties = database_queryproperties(decoded);
+		if (PROPERTY_RECORD_CCC(properties) == CCC_NOT_REORDERED)
+		{
+			if (PROPERTY_RECORD_QC(properties, quickCheckShift) == QuickCheckResult_Yes)
+			{
+				return (size_t)(src - input);
+			}
+			else if (
+				quickCheckShift == PROPERTY_SHIFT_NFD ||
+				quickCheckShift == PROPERTY_SHIFT_NFKD)
+			{
+				/* Decomposed starters are stable when their decomposition starts with a starter */
+
+				const char* decomposition;
+				unicode_t first;
+				uint8_t decomposition_size;
+
+				if (decoded >= HANGUL_S_FIRST &&
+					decoded <= HANGUL_S_LAST)
+				{
+					return (size_t)(src - input);
+				}
+
+				decomposition = (quickCheckShift == PROPERTY_SHIFT_NFD)
+					? database_querydecomposition(decoded, NFDIndex1Ptr, NFDIndex2Ptr, NFDDataPtr, &decomposition_size)
+					: database_querydecomposition(decoded, NFKDIndex1Ptr, NFKDIndex2Ptr, NFKDDataPtr, &decomposition_size);
+				if (decomposition != 0)
+				{
+					codepoint_read(decomposition, decomposition_size, &first);
+					if (PROPERTY_GET_CCC(first) == CCC_NOT_REORDERED)
+					{
+						return (size_t)(src - input);
+					}
+				}
+			}
+		}
+
+		src += decoded_size;
+	}
+
+	return inputSize;
 }
\ No newline at end of file
@@ -73,12 +73,14 @@ typedef struct {
 
 uint8_t stream_initialize(StreamState* state, const char* input, size_t inputSize);
 
-uint8_t stream_read(StreamState* state, const size_t* propertyIndex, const uint8_t* propertyData);
+uint8_t stream_read(StreamState* state, uint8_t quickCheckShift);
 
 uint8_t stream_write(StreamState* state, char** output, size_t* outputSize, uint8_t* bytesWritten);
 
 uint8_t stream_reorder(StreamState* state);
 
+size_t stream_boundary(const char* input, size_t inputSize, size_t minimumSize, uint8_t quickCheckShift);
+
 /*! \endcond */
 
 #endif /* _UTF8REWIND_INTERNAL_STREAMING_H_ */
\ No newline at end of file
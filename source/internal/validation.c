@@ -0,0 +1,390 @@
+/*
+	Copyright (C) 2014-2016 Quinten Lansu
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "validation.h"
+
+#include "codepoint.h"
+#include "simd.h"
+
+static const uint64_t VALIDATION_ASCII_MASK = 0x8080808080808080ULL;
+
+static size_t validation_sequence(const uint8_t* src, size_t srcSize)
+{
+	/* Returns the length of the valid sequence at the cursor, or 0 */
+
+	uint8_t lower = 0x80;
+	uint8_t upper = 0xBF;
+
+	if (*src <= MAX_BASIC_LATIN)
+	{
+		return 1;
+	}
+	else if (
+		*src >= 0xC2 && *src <= 0xDF)
+	{
+		return (srcSize >= 2 &&
+			(src[1] & 0xC0) == 0x80) ? 2 : 0;
+	}
+	else if (
+		*src >= 0xE0 && *src <= 0xEF)
+	{
+		/* Overlong sequences and surrogates */
+
+		if (*src == 0xE0)
+		{
+			lower = 0xA0;
+		}
+		else if (
+			*src == 0xED)
+		{
+			upper = 0x9F;
+		}
+
+		return (srcSize >= 3 &&
+			src[1] >= lower && src[1] <= upper &&
+			(src[2] & 0xC0) == 0x80) ? 3 : 0;
+	}
+	else if (
+		*src >= 0xF0 && *src <= 0xF4)
+	{
+		/* Overlong sequences and code points above U+10FFFF */
+
+		if (*src == 0xF0)
+		{
+			lower = 0x90;
+		}
+		else if (
+			*src == 0xF4)
+		{
+			upper = 0x8F;
+		}
+
+		return (srcSize >= 4 &&
+			src[1] >= lower && src[1] <= upper &&
+			(src[2] & 0xC0) == 0x80 &&
+			(src[3] & 0xC0) == 0x80) ? 4 : 0;
+	}
+
+	/* Continuation bytes, overlong two-byte sequences and invalid lead bytes */
+
+	return 0;
+}
+
+size_t validation_scalar(const uint8_t* input, size_t inputSize)
+{
+	const uint8_t* src = input;
+	size_t src_size = inputSize;
+	size_t length;
+
+	while (src_size > 0)
+	{
+		/* Skip Basic Latin eight bytes at a time */
+
+		if (*src <= MAX_BASIC_LATIN)
+		{
+			uint64_t block;
+
+			while (src_size >= 8)
+			{
+				memcpy(&block, src, sizeof(block));
+				if ((block & VALIDATION_ASCII_MASK) != 0)
+				{
+					break;
+				}
+
+				src += 8;
+				src_size -= 8;
+			}
+
+			if (src_size == 0)
+			{
+				break;
+			}
+		}
+
+		if ((length = validation_sequence(src, src_size)) == 0)
+		{
+			break;
+		}
+
+		src += length;
+		src_size -= length;
+	}
+
+	return src - input;
+}
+
+size_t validation_sse2(const uint8_t* input, size_t inputSize)
+{
+#if UTF8_SIMD_SSE2
+	const uint8_t* src = input;
+	size_t src_size = inputSize;
+	size_t length;
+
+	while (src_size > 0)
+	{
+		/* Skip Basic Latin sixteen bytes at a time */
+
+		if (*src <= MAX_BASIC_LATIN)
+		{
+			while (src_size >= 16 &&
+				_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)src)) == 0)
+			{
+				src += 16;
+				src_size -= 16;
+			}
+
+			if (src_size == 0)
+			{
+				break;
+			}
+		}
+
+		if ((length = validation_sequence(src, src_size)) == 0)
+		{
+			break;
+		}
+
+		src += length;
+		src_size -= length;
+	}
+
+	return src - input;
+#else
+	return validation_scalar(input, inputSize);
+#endif
+}
+
+#if UTF8_SIMD_AVX2
+
+/*
+	Validates 32 bytes per step using the lookup algorithm by Keiser and
+	Lemire ("Validating UTF-8 In Less Than One Instruction Per Byte", 2021).
+	Every pair of adjacent bytes is classified by three table lookups on the
+	high and low nibble of the first byte and the high nibble of the second
+	byte. The bits of the classes that apply to both bytes mark an error.
+*/
+
+#define VALIDATION_TOO_SHORT       (0x01)
+#define VALIDATION_TOO_LONG        (0x02)
+#define VALIDATION_OVERLONG_3      (0x04)
+#define VALIDATION_TOO_LARGE       (0x08)
+#define VALIDATION_SURROGATE       (0x10)
+#define VALIDATION_OVERLONG_2      (0x20)
+#define VALIDATION_TOO_LARGE_1000  (0x40)
+#define VALIDATION_OVERLONG_4      (0x40)
+#define VALIDATION_TWO_CONTS       (0x80)
+#define VALIDATION_CARRY           (VALIDATION_TOO_SHORT | VALIDATION_TOO_LONG | VALIDATION_TWO_CONTS)
+
+#define VALIDATION_TABLE(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _A, _B, _C, _D, _E, _F) \
+	_mm256_setr_epi8( \
+		(char)(_0), (char)(_1), (char)(_2), (char)(_3), (char)(_4), (char)(_5), (char)(_6), (char)(_7), \
+		(char)(_8), (char)(_9), (char)(_A), (char)(_B), (char)(_C), (char)(_D), (char)(_E), (char)(_F), \
+		(char)(_0), (char)(_1), (char)(_2), (char)(_3), (char)(_4), (char)(_5), (char)(_6), (char)(_7), \
+		(char)(_8), (char)(_9), (char)(_A), (char)(_B), (char)(_C), (char)(_D), (char)(_E), (char)(_F))
+
+static const uint8_t* validation_boundary(const uint8_t* input, const uint8_t* src)
+{
+	/* Moves back to the start of a sequence that may continue past the cursor */
+
+	size_t i;
+
+	for (i = 1; i <= 3 && src - i >= input; ++i)
+	{
+		if (*(src - i) <= MAX_BASIC_LATIN)
+		{
+			break;
+		}
+		else if (
+			*(src - i) >= 0xC0)
+		{
+			return src - i;
+		}
+	}
+
+	return src;
+}
+
+UTF8_SIMD_TARGET_AVX2 static __m256i validation_avx2_previous(__m256i current, __m256i previous, const int count)
+{
+	/* Shifts the bytes of the previous block into the current block */
+
+	__m256i spliced = _mm256_permute2x128_si256(previous, current, 0x21);
+
+	switch (count)
+	{
+
+	case 1:
+		return _mm256_alignr_epi8(current, spliced, 15);
+
+	case 2:
+		return _mm256_alignr_epi8(current, spliced, 14);
+
+	default:
+		return _mm256_alignr_epi8(current, spliced, 13);
+
+	}
+}
+
+UTF8_SIMD_TARGET_AVX2 size_t validation_avx2(const uint8_t* input, size_t inputSize)
+{
+	const __m256i byte_1_high = VALIDATION_TABLE(
+		/* 0_______ */
+		VALIDATION_TOO_LONG, VALIDATION_TOO_LONG, VALIDATION_TOO_LONG, VALIDATION_TOO_LONG,
+		VALIDATION_TOO_LONG, VALIDATION_TOO_LONG, VALIDATION_TOO_LONG, VALIDATION_TOO_LONG,
+		/* 10______ */
+		VALIDATION_TWO_CONTS, VALIDATION_TWO_CONTS, VALIDATION_TWO_CONTS, VALIDATION_TWO_CONTS,
+		/* 1100____ */
+		VALIDATION_TOO_SHORT | VALIDATION_OVERLONG_2,
+		/* 1101____ */
+		VALIDATION_TOO_SHORT,
+		/* 1110____ */
+		VALIDATION_TOO_SHORT | VALIDATION_OVERLONG_3 | VALIDATION_SURROGATE,
+		/* 1111____ */
+		VALIDATION_TOO_SHORT | VALIDATION_TOO_LARGE | VALIDATION_TOO_LARGE_1000 | VALIDATION_OVERLONG_4);
+	const __m256i byte_1_low = VALIDATION_TABLE(
+		/* ____0000 */
+		VALIDATION_CARRY | VALIDATION_OVERLONG_3 | VALIDATION_OVERLONG_2 | VALIDATION_OVERLONG_4,
+		/* ____0001 */
+		VALIDATION_CARRY | VALIDATION_OVERLONG_2,
+		/* ____001_ */
+		VALIDATION_CARRY, VALIDATION_CARRY,
+		/* ____0100 */
+		VALIDATION_CARRY | VALIDATION_TOO_LARGE,
+		/* ____0101 - ____1100 */
+		VALIDATION_CARRY | VALIDATION_TOO_LARGE | VALIDATION_TOO_LARGE_1000,
+		VALIDATION_CARRY | VALIDATION_TOO_LARGE | VALIDATION_TOO_LARGE_1000,
+		VALIDATION_CARRY | VALIDATION_TOO_LARGE | VALIDATION_TOO_LARGE_1000,
+		VALIDATION_CARRY | VALIDATION_TOO_LARGE | VALIDATION_TOO_LARGE_1000,
+		VALIDATION_CARRY | VALIDATION_TOO_LARGE | VALIDATION_TOO_LARGE_1000,
+		VALIDATION_CARRY | VALIDATION_TOO_LARGE | VALIDATION_TOO_LARGE_1000,
+		VALIDATION_CARRY | VALIDATION_TOO_LARGE | VALIDATION_TOO_LARGE_1000,
+		VALIDATION_CARRY | VALIDATION_TOO_LARGE | VALIDATION_TOO_LARGE_1000,
+		/* ____1101 */
+		VALIDATION_CARRY | VALIDATION_TOO_LARGE | VALIDATION_TOO_LARGE_1000 | VALIDATION_SURROGATE,
+		/* ____111_ */
+		VALIDATION_CARRY | VALIDATION_TOO_LARGE | VALIDATION_TOO_LARGE_1000,
+		VALIDATION_CARRY | VALIDATION_TOO_LARGE | VALIDATION_TOO_LARGE_1000);
+	const __m256i byte_2_high = VALIDATION_TABLE(
+		/* 0_______ */
+		VALIDATION_TOO_SHORT, VALIDATION_TOO_SHORT, VALIDATION_TOO_SHORT, VALIDATION_TOO_SHORT,
+		VALIDATION_TOO_SHORT, VALIDATION_TOO_SHORT, VALIDATION_TOO_SHORT, VALIDATION_TOO_SHORT,
+		/* 1000____ */
+		VALIDATION_TOO_LONG | VALIDATION_OVERLONG_2 | VALIDATION_TWO_CONTS | VALIDATION_OVERLONG_3 | VALIDATION_TOO_LARGE_1000 | VALIDATION_OVERLONG_4,
+		/* 1001____ */
+		VALIDATION_TOO_LONG | VALIDATION_OVERLONG_2 | VALIDATION_TWO_CONTS | VALIDATION_OVERLONG_3 | VALIDATION_TOO_LARGE,
+		/* 101_____ */
+		VALIDATION_TOO_LONG | VALIDATION_OVERLONG_2 | VALIDATION_TWO_CONTS | VALIDATION_SURROGATE | VALIDATION_TOO_LARGE,
+		VALIDATION_TOO_LONG | VALIDATION_OVERLONG_2 | VALIDATION_TWO_CONTS | VALIDATION_SURROGATE | VALIDATION_TOO_LARGE,
+		/* 11______ */
+		VALIDATION_TOO_SHORT, VALIDATION_TOO_SHORT, VALIDATION_TOO_SHORT, VALIDATION_TOO_SHORT);
+
+	/* Lead bytes in the last three positions need more bytes from the next block */
+
+	const __m256i incomplete_maximum = _mm256_setr_epi8(
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		(char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+	const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+
+	const uint8_t* src = input;
+	size_t src_size = inputSize;
+	__m256i previous_input = _mm256_setzero_si256();
+	__m256i previous_incomplete = _mm256_setzero_si256();
+	__m256i error = _mm256_setzero_si256();
+
+	while (src_size >= 32)
+	{
+		__m256i current = _mm256_loadu_si256((const __m256i*)src);
+
+		if (_mm256_movemask_epi8(current) == 0)
+		{
+			/* Basic Latin only, but the previous block may have ended early */
+
+			error = _mm256_or_si256(error, previous_incomplete);
+		}
+		else
+		{
+			__m256i previous_1 = validation_avx2_previous(current, previous_input, 1);
+			__m256i special_cases;
+			__m256i continuation;
+
+			/* Classify pairs of bytes */
+
+			special_cases = _mm256_and_si256(
+				_mm256_and_si256(
+					_mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(previous_1, 4), nibble_mask)),
+					_mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(previous_1, nibble_mask))),
+				_mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(current, 4), nibble_mask)));
+
+			/* Third and fourth bytes must be continuation bytes */
+
+			continuation = _mm256_or_si256(
+				_mm256_subs_epu8(validation_avx2_previous(current, previous_input, 2), _mm256_set1_epi8((char)(0xE0 - 0x80))),
+				_mm256_subs_epu8(validation_avx2_previous(current, previous_input, 3), _mm256_set1_epi8((char)(0xF0 - 0x80))));
+			continuation = _mm256_and_si256(continuation, _mm256_set1_epi8((char)0x80));
+
+			error = _mm256_or_si256(error, _mm256_xor_si256(continuation, special_cases));
+
+			previous_incomplete = _mm256_subs_epu8(current, incomplete_maximum);
+		}
+
+		if (!_mm256_testz_si256(error, error))
+		{
+			break;
+		}
+
+		previous_input = current;
+		src += 32;
+		src_size -= 32;
+	}
+
+	/* Locate the error or validate the remainder from the start of a sequence */
+
+	_mm256_zeroupper();
+
+	src = validation_boundary(input, src);
+
+	return (src - input) + validation_scalar(src, inputSize - (src - input));
+}
+
+#else
+
+size_t validation_avx2(const uint8_t* input, size_t inputSize)
+{
+	return validation_sse2(input, inputSize);
+}
+
+#endif
+
+size_t validation_execute(const uint8_t* input, size_t inputSize)
+{
+	if (simd_supports_avx2())
+	{
+		return validation_avx2(input, inputSize);
+	}
+
+	return validation_sse2(input, inputSize);
+}
\ No newline at end of file
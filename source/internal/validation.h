@@ -0,0 +1,56 @@
+/*
+	Copyright (C) 2014-2016 Quinten Lansu
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or
+	sell copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef _UTF8REWIND_INTERNAL_VALIDATION_H_
+#define _UTF8REWIND_INTERNAL_VALIDATION_H_
+
+/*!
+	\file
+	\brief Validation interface.
+
+	\cond INTERNAL
+*/
+
+#include "utf8rewind.h"
+
+/*
+	All functions return the offset in bytes of the first invalid sequence,
+	or the size of the input when it is valid. A sequence is invalid when
+	codepoint_read would decode it to the replacement character: overlong
+	sequences, surrogates, code points above U+10FFFF, sequences longer than
+	four bytes, unexpected continuation bytes and truncated sequences.
+*/
+
+size_t validation_scalar(const uint8_t* input, size_t inputSize);
+
+size_t validation_sse2(const uint8_t* input, size_t inputSize);
+
+size_t validation_avx2(const uint8_t* input, size_t inputSize);
+
+size_t validation_execute(const uint8_t* input, size_t inputSize);
+
+/*! \endcond */
+
+#endif /* _UTF8REWIND_INTERNAL_VALIDATION_H_ */
\ No newline at end of file
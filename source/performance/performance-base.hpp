@@ -6,6 +6,7 @@
 
 // STL
 
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
@@ -222,10 +223,19 @@ namespace performance {
 
 	public:
 
+		Suite()
+			: m_processed(0)
+		{
+		}
+
 		virtual void setup() { }
 		virtual void body() = 0;
 		virtual void tearDown() { }
 
+		// Bytes of input handled by each call to body(), used to report throughput
+
+		size_t m_processed;
+
 	};
 
 	class BaseSuiteFactory
@@ -379,6 +389,7 @@ namespace performance {
 				}
 
 				std::vector<uint32_t> timings;
+				uint64_t body_duration = 0;
 
 				clock::time_point total_start = clock::now();
 
@@ -390,7 +401,10 @@ namespace performance {
 
 					suite->body();
 
-					uint32_t test_duration = (uint32_t)(std::chrono::duration_cast<ms>(clock::now() - test_start)).count() / 1000;
+					uint64_t test_duration_us = (uint64_t)(std::chrono::duration_cast<ms>(clock::now() - test_start)).count();
+					uint32_t test_duration = (uint32_t)(test_duration_us / 1000);
+
+					body_duration += test_duration_us;
 
 					if (display_individual)
 					{
@@ -432,6 +446,15 @@ namespace performance {
 				m_logging << " Best case: " << std::setw(8) << best_case << " ms (" << formatDuration((uint32_t)best_case) << ")" << std::endl;
 				m_logging << "Worst case: " << std::setw(8) << worst_case << " ms (" << formatDuration((uint32_t)worst_case) << ")" << std::endl;
 				m_logging << "   Average: " << std::setw(8) << average << " ms (" << formatDuration((uint32_t)average) << ")" << std::endl;
+
+				if (suite->m_processed > 0 &&
+					body_duration > 0)
+				{
+					double throughput = ((double)suite->m_processed * (double)repeat_count) / (double)body_duration;
+
+					m_logging << "Throughput: " << std::setw(8) << throughput << " MB/s" << std::endl;
+				}
+
 				m_logging << std::endl;
 			}
 
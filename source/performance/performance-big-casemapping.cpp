@@ -110,6 +110,23 @@ PERF_TEST_F(BigCaseMapping, Casefold)
 	}
 }
 
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+PERF_TEST_F(BigCaseMapping, CasefoldAlloc)
+{
+	int32_t e;
+	size_t ol;
+
+	char* o = utf8casefold_alloc(m_contents.c_str(), m_contents.length(), UTF8_LOCALE_DEFAULT, nullptr, &ol, &e);
+
+	PERF_ASSERT(ol > 0);
+	PERF_ASSERT(e == UTF8_ERR_NONE);
+
+	utf8free(nullptr, o);
+}
+
+#endif
+
 PERF_TEST_F(BigCaseMapping, Locale)
 {
 	int32_t e;
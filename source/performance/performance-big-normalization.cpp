@@ -111,4 +111,34 @@ PERF_TEST_F(BigNormalization, NFKC)
 
 		delete [] o;
 	}
-}
\ No newline at end of file
+}
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+PERF_TEST_F(BigNormalization, NFDAlloc)
+{
+	int32_t e;
+	size_t ol;
+
+	char* o = utf8normalize_alloc(m_contents.c_str(), m_contents.length(), UTF8_NORMALIZE_DECOMPOSE, nullptr, &ol, &e);
+
+	PERF_ASSERT(ol > 0);
+	PERF_ASSERT(e == UTF8_ERR_NONE);
+
+	utf8free(nullptr, o);
+}
+
+PERF_TEST_F(BigNormalization, NFCAlloc)
+{
+	int32_t e;
+	size_t ol;
+
+	char* o = utf8normalize_alloc(m_contents.c_str(), m_contents.length(), UTF8_NORMALIZE_COMPOSE, nullptr, &ol, &e);
+
+	PERF_ASSERT(ol > 0);
+	PERF_ASSERT(e == UTF8_ERR_NONE);
+
+	utf8free(nullptr, o);
+}
+
+#endif
\ No newline at end of file
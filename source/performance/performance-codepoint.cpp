@@ -0,0 +1,157 @@
+#include "performance-base.hpp"
+
+extern "C" {
+	#include "../internal/codepoint.h"
+}
+
+#if defined(__linux__)
+	#include <linux/perf_event.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+/*
+	Decoding 4 MB of text code point by code point. Since 1.6.0,
+	codepoint_read uses a state machine instead of checking the length,
+	continuation bytes and range of every sequence separately. Best of four
+	runs (x64):
+
+	                           before        after
+	DecodeQuickBrown.Read    374 MB/s     405 MB/s
+	DecodeGreek.Read         380 MB/s     487 MB/s
+
+	On Linux, the branch misses of all iterations are printed after each
+	suite when the processor exposes hardware counters.
+*/
+
+class DecodeBase
+	: public performance::Suite
+{
+
+public:
+
+	DecodeBase()
+		: m_counter(-1)
+	{
+	}
+
+	void fill(const std::string& text)
+	{
+		m_contents.clear();
+		m_contents.reserve(4 * 1024 * 1024 + text.length());
+
+		while (m_contents.length() < 4 * 1024 * 1024)
+		{
+			m_contents += text;
+		}
+
+		m_processed = m_contents.length();
+
+	#if defined(__linux__)
+		struct perf_event_attr attributes;
+		memset(&attributes, 0, sizeof(attributes));
+		attributes.type = PERF_TYPE_HARDWARE;
+		attributes.size = sizeof(attributes);
+		attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+
+		m_counter = (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+	#endif
+	}
+
+	virtual void tearDown() override
+	{
+	#if defined(__linux__)
+		uint64_t misses = 0;
+
+		if (m_counter >= 0)
+		{
+			if (read(m_counter, &misses, sizeof(misses)) == sizeof(misses))
+			{
+				std::cout << "  Branch misses: " << misses << std::endl;
+			}
+
+			close(m_counter);
+		}
+	#endif
+	}
+
+	void decode()
+	{
+		const char* src = m_contents.c_str();
+		size_t src_size = m_contents.length();
+		unicode_t sum = 0;
+
+		while (src_size > 0)
+		{
+			unicode_t decoded;
+			uint8_t length = codepoint_read(src, src_size, &decoded);
+
+			sum += decoded;
+
+			src += length;
+			src_size -= length;
+		}
+
+		PERF_ASSERT(sum > 0);
+	}
+
+	std::string m_contents;
+	int m_counter;
+
+};
+
+class DecodeQuickBrown
+	: public DecodeBase
+{
+
+public:
+
+	virtual void setup() override
+	{
+		std::fstream stream("testdata/quickbrown.txt", std::ios_base::in);
+		PERF_ASSERT(stream.is_open());
+		if (!stream.is_open())
+		{
+			return;
+		}
+
+		std::stringstream ss;
+		ss << stream.rdbuf();
+
+		fill(ss.str());
+
+		stream.close();
+	}
+
+};
+
+PERF_TEST_F(DecodeQuickBrown, Read)
+{
+	decode();
+}
+
+class DecodeGreek
+	: public DecodeBase
+{
+
+public:
+
+	virtual void setup() override
+	{
+		fill("\xCE\x9E\xCE\xB5\xCF\x83\xCE\xBA\xCE\xB5\xCF\x80\xCE\xAC\xCE\xB6\xCF\x89 "
+			"\xCF\x84\xCE\xB7\xCE\xBD \xCF\x88\xCF\x85\xCF\x87\xCE\xBF\xCF\x86\xCE\xB8\xCF\x8C\xCF\x81\xCE\xB1 "
+			"\xCE\xB2\xCE\xB4\xCE\xB5\xCE\xBB\xCF\x85\xCE\xB3\xCE\xBC\xCE\xAF\xCE\xB1.\n");
+	}
+
+};
+
+PERF_TEST_F(DecodeGreek, Read)
+{
+	decode();
+}
+
+#endif
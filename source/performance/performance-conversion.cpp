@@ -1,5 +1,10 @@
 #include "performance-base.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "../helpers/helpers-strings.hpp"
 
 extern "C" {
@@ -371,4 +376,820 @@ PERF_TEST_F(ConvertBasicMultilingualPlane, Utf32Dynamic)
 
 		delete [] o;
 	}
-}
\ No newline at end of file
+}
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+/*
+	Conversion of 1 MB of text per script, repeated from a pangram. The
+	throughput is measured in bytes of UTF-8, for both directions.
+
+	FromUtf16, MB/s, scalar before and with SSE2 blocks after:
+
+		BasicLatin    340 -> 6000
+		Latin         398 -> 1033
+		Greek         530 -> 1175
+		Cyrillic      604 -> 1027
+		CJK           896 -> 2361
+		Emoji         545 ->  521 (every block holds a surrogate pair)
+
+	ToUtf16, MB/s, scalar before and with SSE2 blocks after:
+
+		BasicLatin    424 -> 6173
+		Latin         413 ->  971
+		Greek         389 ->  898
+		Cyrillic      400 ->  910
+		CJK           468 ->  965
+		Emoji         454 ->  358 (surrogate pairs are left to the scalar loop)
+
+	FromUtf32 and ToUtf32, MB/s, scalar before and with AVX2 after:
+
+		              FromUtf32      ToUtf32
+		BasicLatin    417 -> 1700    518 -> 4496
+		Latin         470 -> 1179    499 ->  942
+		Greek         687 -> 1448    464 ->  721
+		Cyrillic      786 -> 1371    466 ->  721
+		CJK          1072 -> 2299    620 ->  693
+		Emoji         709 -> 1381    566 ->  670
+
+	Size queries without a target buffer, MB/s, decoding before and
+	measuring after:
+
+		              FromUtf16       ToUtf16         FromUtf32      ToUtf32
+		BasicLatin   1764 ->  5473   11372 -> 19908  1984 -> 2063  15678 -> 26034
+		Latin        1884 ->  5871    1441 ->  6276  2128 -> 2210   1185 ->  6276
+		Greek        3276 -> 10189    1056 ->  6304  3688 -> 3832    894 ->  6225
+		Cyrillic     3154 ->  9837    1056 ->  6229  3561 -> 3701    888 ->  6243
+		CJK          5276 -> 16452    1044 ->  6228  5969 -> 6197    856 ->  6232
+		Emoji         801 ->  4795     581 ->  6227  3384 -> 3520    830 ->  6231
+*/
+
+class ConvertScript
+	: public performance::Suite
+{
+
+public:
+
+	void fill(const char* text)
+	{
+		while (m_utf8.length() < 1024 * 1024)
+		{
+			m_utf8 += text;
+		}
+
+		m_utf16 = helpers::utf16(m_utf8);
+		m_utf32 = helpers::utf32(m_utf8);
+
+		m_output.resize(m_utf8.length() * 4);
+
+		m_processed = m_utf8.length();
+	}
+
+	void fromUtf16()
+	{
+		int32_t e;
+
+		size_t l = utf16toutf8(&m_utf16[0], m_utf16.size() * sizeof(utf16_t), &m_output[0], m_output.size(), &e);
+
+		PERF_ASSERT(l == m_utf8.length());
+		PERF_ASSERT(e == UTF8_ERR_NONE);
+	}
+
+	void toUtf16()
+	{
+		int32_t e;
+
+		size_t l = utf8toutf16(m_utf8.c_str(), m_utf8.length(), (utf16_t*)&m_output[0], m_output.size(), &e);
+
+		PERF_ASSERT(l == m_utf16.size() * sizeof(utf16_t));
+		PERF_ASSERT(e == UTF8_ERR_NONE);
+	}
+
+	void fromUtf32()
+	{
+		int32_t e;
+
+		size_t l = utf32toutf8(&m_utf32[0], m_utf32.size() * sizeof(unicode_t), &m_output[0], m_output.size(), &e);
+
+		PERF_ASSERT(l == m_utf8.length());
+		PERF_ASSERT(e == UTF8_ERR_NONE);
+	}
+
+	void toUtf32()
+	{
+		int32_t e;
+
+		size_t l = utf8toutf32(m_utf8.c_str(), m_utf8.length(), (unicode_t*)&m_output[0], m_output.size(), &e);
+
+		PERF_ASSERT(l == m_utf32.size() * sizeof(unicode_t));
+		PERF_ASSERT(e == UTF8_ERR_NONE);
+	}
+
+	void fromUtf16Size()
+	{
+		int32_t e;
+
+		size_t l = utf16toutf8_size(&m_utf16[0], m_utf16.size() * sizeof(utf16_t), &e);
+
+		PERF_ASSERT(l == m_utf8.length());
+		PERF_ASSERT(e == UTF8_ERR_NONE);
+	}
+
+	void toUtf16Size()
+	{
+		int32_t e;
+
+		size_t l = utf8toutf16_size(m_utf8.c_str(), m_utf8.length(), &e);
+
+		PERF_ASSERT(l == m_utf16.size() * sizeof(utf16_t));
+		PERF_ASSERT(e == UTF8_ERR_NONE);
+	}
+
+	void fromUtf32Size()
+	{
+		int32_t e;
+
+		size_t l = utf32toutf8_size(&m_utf32[0], m_utf32.size() * sizeof(unicode_t), &e);
+
+		PERF_ASSERT(l == m_utf8.length());
+		PERF_ASSERT(e == UTF8_ERR_NONE);
+	}
+
+	void toUtf32Size()
+	{
+		int32_t e;
+
+		size_t l = utf8toutf32_size(m_utf8.c_str(), m_utf8.length(), &e);
+
+		PERF_ASSERT(l == m_utf32.size() * sizeof(unicode_t));
+		PERF_ASSERT(e == UTF8_ERR_NONE);
+	}
+
+	std::string m_utf8;
+	std::vector<utf16_t> m_utf16;
+	std::vector<unicode_t> m_utf32;
+	std::vector<char> m_output;
+
+};
+
+class ConvertScriptBasicLatin
+	: public ConvertScript
+{
+
+public:
+
+	virtual void setup() override
+	{
+		fill(
+			"The quick brown fox jumps over the lazy dog. ");
+	}
+
+};
+
+PERF_TEST_F(ConvertScriptBasicLatin, FromUtf16)
+{
+	fromUtf16();
+}
+
+PERF_TEST_F(ConvertScriptBasicLatin, ToUtf16)
+{
+	toUtf16();
+}
+
+PERF_TEST_F(ConvertScriptBasicLatin, FromUtf32)
+{
+	fromUtf32();
+}
+
+PERF_TEST_F(ConvertScriptBasicLatin, ToUtf32)
+{
+	toUtf32();
+}
+
+PERF_TEST_F(ConvertScriptBasicLatin, FromUtf16Size)
+{
+	fromUtf16Size();
+}
+
+PERF_TEST_F(ConvertScriptBasicLatin, ToUtf16Size)
+{
+	toUtf16Size();
+}
+
+PERF_TEST_F(ConvertScriptBasicLatin, FromUtf32Size)
+{
+	fromUtf32Size();
+}
+
+PERF_TEST_F(ConvertScriptBasicLatin, ToUtf32Size)
+{
+	toUtf32Size();
+}
+
+class ConvertScriptLatin
+	: public ConvertScript
+{
+
+public:
+
+	virtual void setup() override
+	{
+		fill(
+			"Falsches \xC3\x9C" "ben von Xylophonmusik qu\xC3\xA4lt jeden gr\xC3\xB6"
+			"\xC3\x9F" "eren Zwerg. Voix ambigu\xC3\xAB d'un c\xC5\x93ur qui au z\xC3"
+			"\xA9phyr pr\xC3\xA9" "f\xC3\xA8re les jattes de kiwis. ");
+	}
+
+};
+
+PERF_TEST_F(ConvertScriptLatin, FromUtf16)
+{
+	fromUtf16();
+}
+
+PERF_TEST_F(ConvertScriptLatin, ToUtf16)
+{
+	toUtf16();
+}
+
+PERF_TEST_F(ConvertScriptLatin, FromUtf32)
+{
+	fromUtf32();
+}
+
+PERF_TEST_F(ConvertScriptLatin, ToUtf32)
+{
+	toUtf32();
+}
+
+PERF_TEST_F(ConvertScriptLatin, FromUtf16Size)
+{
+	fromUtf16Size();
+}
+
+PERF_TEST_F(ConvertScriptLatin, ToUtf16Size)
+{
+	toUtf16Size();
+}
+
+PERF_TEST_F(ConvertScriptLatin, FromUtf32Size)
+{
+	fromUtf32Size();
+}
+
+PERF_TEST_F(ConvertScriptLatin, ToUtf32Size)
+{
+	toUtf32Size();
+}
+
+class ConvertScriptGreek
+	: public ConvertScript
+{
+
+public:
+
+	virtual void setup() override
+	{
+		fill(
+			"\xCE\x9E\xCE\xB5\xCF\x83\xCE\xBA\xCE\xB5\xCF\x80\xCE\xAC\xCE\xB6\xCF\x89"
+			" \xCF\x84\xCE\xB7\xCE\xBD \xCF\x88\xCF\x85\xCF\x87\xCE\xBF\xCF\x86\xCE"
+			"\xB8\xCF\x8C\xCF\x81\xCE\xB1 \xCE\xB2\xCE\xB4\xCE\xB5\xCE\xBB\xCF\x85"
+			"\xCE\xB3\xCE\xBC\xCE\xAF\xCE\xB1. ");
+	}
+
+};
+
+PERF_TEST_F(ConvertScriptGreek, FromUtf16)
+{
+	fromUtf16();
+}
+
+PERF_TEST_F(ConvertScriptGreek, ToUtf16)
+{
+	toUtf16();
+}
+
+PERF_TEST_F(ConvertScriptGreek, FromUtf32)
+{
+	fromUtf32();
+}
+
+PERF_TEST_F(ConvertScriptGreek, ToUtf32)
+{
+	toUtf32();
+}
+
+PERF_TEST_F(ConvertScriptGreek, FromUtf16Size)
+{
+	fromUtf16Size();
+}
+
+PERF_TEST_F(ConvertScriptGreek, ToUtf16Size)
+{
+	toUtf16Size();
+}
+
+PERF_TEST_F(ConvertScriptGreek, FromUtf32Size)
+{
+	fromUtf32Size();
+}
+
+PERF_TEST_F(ConvertScriptGreek, ToUtf32Size)
+{
+	toUtf32Size();
+}
+
+class ConvertScriptCyrillic
+	: public ConvertScript
+{
+
+public:
+
+	virtual void setup() override
+	{
+		fill(
+			"\xD0\xA1\xD1\x8A\xD0\xB5\xD1\x88\xD1\x8C \xD0\xB6\xD0\xB5 \xD0\xB5\xD1"
+			"\x89\xD1\x91 \xD1\x8D\xD1\x82\xD0\xB8\xD1\x85 \xD0\xBC\xD1\x8F\xD0\xB3"
+			"\xD0\xBA\xD0\xB8\xD1\x85 \xD1\x84\xD1\x80\xD0\xB0\xD0\xBD\xD1\x86\xD1"
+			"\x83\xD0\xB7\xD1\x81\xD0\xBA\xD0\xB8\xD1\x85 \xD0\xB1\xD1\x83\xD0\xBB"
+			"\xD0\xBE\xD0\xBA, \xD0\xB4\xD0\xB0 \xD0\xB2\xD1\x8B\xD0\xBF\xD0\xB5\xD0"
+			"\xB9 \xD1\x87\xD0\xB0\xD1\x8E. ");
+	}
+
+};
+
+PERF_TEST_F(ConvertScriptCyrillic, FromUtf16)
+{
+	fromUtf16();
+}
+
+PERF_TEST_F(ConvertScriptCyrillic, ToUtf16)
+{
+	toUtf16();
+}
+
+PERF_TEST_F(ConvertScriptCyrillic, FromUtf32)
+{
+	fromUtf32();
+}
+
+PERF_TEST_F(ConvertScriptCyrillic, ToUtf32)
+{
+	toUtf32();
+}
+
+PERF_TEST_F(ConvertScriptCyrillic, FromUtf16Size)
+{
+	fromUtf16Size();
+}
+
+PERF_TEST_F(ConvertScriptCyrillic, ToUtf16Size)
+{
+	toUtf16Size();
+}
+
+PERF_TEST_F(ConvertScriptCyrillic, FromUtf32Size)
+{
+	fromUtf32Size();
+}
+
+PERF_TEST_F(ConvertScriptCyrillic, ToUtf32Size)
+{
+	toUtf32Size();
+}
+
+class ConvertScriptCJK
+	: public ConvertScript
+{
+
+public:
+
+	virtual void setup() override
+	{
+		fill(
+			"\xE5\xA4\xA9\xE5\x9C\xB0\xE7\x8E\x84\xE9\xBB\x84\xE5\xAE\x87\xE5\xAE\x99"
+			"\xE6\xB4\xAA\xE8\x8D\x92\xE6\x97\xA5\xE6\x9C\x88\xE7\x9B\x88\xE6\x98\x83"
+			"\xE8\xBE\xB0\xE5\xAE\xBF\xE5\x88\x97\xE5\xBC\xA0\xE5\xAF\x92\xE6\x9D\xA5"
+			"\xE6\x9A\x91\xE5\xBE\x80\xE7\xA7\x8B\xE6\x94\xB6\xE5\x86\xAC\xE8\x97\x8F"
+			"\xE9\x97\xB0\xE4\xBD\x99\xE6\x88\x90\xE5\xB2\x81\xE5\xBE\x8B\xE5\x90\x95"
+			"\xE8\xB0\x83\xE9\x98\xB3\xE3\x80\x82");
+	}
+
+};
+
+PERF_TEST_F(ConvertScriptCJK, FromUtf16)
+{
+	fromUtf16();
+}
+
+PERF_TEST_F(ConvertScriptCJK, ToUtf16)
+{
+	toUtf16();
+}
+
+PERF_TEST_F(ConvertScriptCJK, FromUtf32)
+{
+	fromUtf32();
+}
+
+PERF_TEST_F(ConvertScriptCJK, ToUtf32)
+{
+	toUtf32();
+}
+
+PERF_TEST_F(ConvertScriptCJK, FromUtf16Size)
+{
+	fromUtf16Size();
+}
+
+PERF_TEST_F(ConvertScriptCJK, ToUtf16Size)
+{
+	toUtf16Size();
+}
+
+PERF_TEST_F(ConvertScriptCJK, FromUtf32Size)
+{
+	fromUtf32Size();
+}
+
+PERF_TEST_F(ConvertScriptCJK, ToUtf32Size)
+{
+	toUtf32Size();
+}
+
+class ConvertScriptEmoji
+	: public ConvertScript
+{
+
+public:
+
+	virtual void setup() override
+	{
+		fill(
+			"\xF0\x9F\x98\x80\xF0\x9F\x98\x83 smile \xF0\x9F\x98\x84\xF0\x9F\x98\x81 "
+			"grin ");
+	}
+
+};
+
+PERF_TEST_F(ConvertScriptEmoji, FromUtf16)
+{
+	fromUtf16();
+}
+
+PERF_TEST_F(ConvertScriptEmoji, ToUtf16)
+{
+	toUtf16();
+}
+
+PERF_TEST_F(ConvertScriptEmoji, FromUtf32)
+{
+	fromUtf32();
+}
+
+PERF_TEST_F(ConvertScriptEmoji, ToUtf32)
+{
+	toUtf32();
+}
+
+PERF_TEST_F(ConvertScriptEmoji, FromUtf16Size)
+{
+	fromUtf16Size();
+}
+
+PERF_TEST_F(ConvertScriptEmoji, ToUtf16Size)
+{
+	toUtf16Size();
+}
+
+PERF_TEST_F(ConvertScriptEmoji, FromUtf32Size)
+{
+	fromUtf32Size();
+}
+
+PERF_TEST_F(ConvertScriptEmoji, ToUtf32Size)
+{
+	toUtf32Size();
+}
+
+/*
+	Conversion of tokens of 16 bytes of UTF-8 each, for which the
+	conversion functions are called once per token.
+*/
+
+class ConvertToken
+	: public performance::Suite
+{
+
+public:
+
+	virtual void setup() override
+	{
+		const char* tokens[] = {
+			"searchengineterm",
+			"\xCE\xBA\xCE\xB1\xCF\x84\xCE\xAC\xCE\xBB\xCE\xBF\xCE\xB3\xCE\xBF",
+			"\xD0\xBF\xD0\xBE\xD0\xB8\xD1\x81\xD0\xBA\xD0\xBE\xD0\xB2\xD0\xB0",
+			"\xE6\xA3\x80\xE7\xB4\xA2\xE5\xBC\x95\xE6\x93\x8E\xE8\xAF\x8D!"
+		};
+
+		m_tokens.resize(64 * 1024);
+		m_tokens32.resize(m_tokens.size());
+
+		for (size_t i = 0; i < m_tokens.size(); ++i)
+		{
+			m_tokens[i] = tokens[i % 4];
+			m_tokens32[i] = helpers::utf32(m_tokens[i]);
+		}
+
+		m_processed = m_tokens.size() * 16;
+	}
+
+	std::vector<std::string> m_tokens;
+	std::vector<std::vector<unicode_t>> m_tokens32;
+
+};
+
+PERF_TEST_F(ConvertToken, FromUtf32)
+{
+	char o[64];
+	int32_t e;
+
+	for (size_t i = 0; i < m_tokens32.size(); ++i)
+	{
+		size_t l = utf32toutf8(&m_tokens32[i][0], m_tokens32[i].size() * sizeof(unicode_t), o, sizeof(o), &e);
+
+		PERF_ASSERT(l == 16);
+	}
+}
+
+PERF_TEST_F(ConvertToken, ToUtf32)
+{
+	unicode_t o[16];
+	int32_t e;
+
+	for (size_t i = 0; i < m_tokens.size(); ++i)
+	{
+		size_t l = utf8toutf32(m_tokens[i].c_str(), 16, o, sizeof(o), &e);
+
+		PERF_ASSERT(l == m_tokens32[i].size() * sizeof(unicode_t));
+	}
+}
+
+#endif
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+/*
+	Parallel conversion of 16 MB of mixed Latin, Cyrillic and CJK text on
+	a fixed pool of worker threads. Throughput is reported in MB/s of
+	UTF-8. Scaling with the amount of workers is unverified, because the
+	numbers have only been gathered on a single core, where more workers
+	can only add the cost of splitting the work. Run these on a machine
+	with at least 16 cores to measure the speedup.
+*/
+
+class ConvertParallelPool
+{
+
+public:
+
+	ConvertParallelPool()
+		: m_task(nullptr)
+		, m_data(nullptr)
+		, m_count(0)
+		, m_next(0)
+		, m_finished(0)
+		, m_active(0)
+		, m_generation(0)
+		, m_stopping(false)
+	{
+	}
+
+	void start(size_t threads)
+	{
+		for (size_t i = 0; i < threads; ++i)
+		{
+			m_workers.emplace_back(&ConvertParallelPool::work, this);
+		}
+	}
+
+	void stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+
+		m_wake.notify_all();
+
+		for (std::thread& worker : m_workers)
+		{
+			worker.join();
+		}
+
+		m_workers.clear();
+	}
+
+	static void execute(void* context, void (*task)(void*, size_t), void* data, size_t count)
+	{
+		ConvertParallelPool* pool = (ConvertParallelPool*)context;
+
+		std::unique_lock<std::mutex> lock(pool->m_mutex);
+
+		pool->m_task = task;
+		pool->m_data = data;
+		pool->m_count = count;
+		pool->m_next.store(0);
+		pool->m_finished = 0;
+		pool->m_generation++;
+
+		pool->m_wake.notify_all();
+
+		// Workers that picked up the tasks must be done with them before the next call can reuse the counter
+
+		pool->m_done.wait(lock, [pool] { return pool->m_finished == pool->m_count && pool->m_active == 0; });
+	}
+
+private:
+
+	void work()
+	{
+		size_t generation = 0;
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		while (1)
+		{
+			m_wake.wait(lock, [&] { return m_stopping || m_generation != generation; });
+
+			if (m_stopping)
+			{
+				return;
+			}
+
+			generation = m_generation;
+
+			void (*task)(void*, size_t) = m_task;
+			void* data = m_data;
+			size_t count = m_count;
+			size_t finished = 0;
+
+			m_active++;
+
+			lock.unlock();
+
+			// Tasks beyond the amount of workers wait until a worker takes the next index
+
+			for (size_t index = m_next.fetch_add(1); index < count; index = m_next.fetch_add(1))
+			{
+				task(data, index);
+
+				finished++;
+			}
+
+			lock.lock();
+
+			m_finished += finished;
+			m_active--;
+
+			if (m_finished == m_count &&
+				m_active == 0)
+			{
+				m_done.notify_one();
+			}
+		}
+	}
+
+	std::vector<std::thread> m_workers;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+	void (*m_task)(void*, size_t);
+	void* m_data;
+	size_t m_count;
+	std::atomic<size_t> m_next;
+	size_t m_finished;
+	size_t m_active;
+	size_t m_generation;
+	bool m_stopping;
+
+};
+
+template <size_t Threads>
+class ConvertParallel
+	: public performance::Suite
+{
+
+public:
+
+	virtual void setup() override
+	{
+		while (m_utf8.length() < 16 * 1024 * 1024)
+		{
+			m_utf8 +=
+				"The quick brown fox jumps over the lazy dog. "
+				"\xD0\xA1\xD1\x8A\xD0\xB5\xD1\x88\xD1\x8C \xD0\xB5\xD1\x89\xD1\x91 \xD1\x8D\xD1\x82\xD0\xB8\xD1\x85 "
+				"\xD0\xBC\xD1\x8F\xD0\xB3\xD0\xBA\xD0\xB8\xD1\x85 \xD1\x84\xD1\x80\xD0\xB0\xD0\xBD\xD1\x86\xD1\x83\xD0\xB7\xD1\x81\xD0\xBA\xD0\xB8\xD1\x85 \xD0\xB1\xD1\x83\xD0\xBB\xD0\xBE\xD0\xBA. "
+				"\xE6\xA3\x80\xE7\xB4\xA2\xE5\xBC\x95\xE6\x93\x8E\xE8\xAF\x8D\xE3\x80\x82 ";
+		}
+
+		m_utf16 = helpers::utf16(m_utf8);
+
+		m_output.resize(m_utf8.length() * 2);
+
+		m_pool.start(Threads);
+
+		m_processed = m_utf8.length();
+	}
+
+	virtual void tearDown() override
+	{
+		m_pool.stop();
+	}
+
+	void fromUtf16()
+	{
+		utf8executor_t executor = { &ConvertParallelPool::execute, &m_pool, Threads, 0 };
+		int32_t e;
+
+		size_t l = utf16toutf8_parallel(&m_utf16[0], m_utf16.size() * sizeof(utf16_t), &m_output[0], m_output.size(), &executor, &e);
+
+		PERF_ASSERT(l == m_utf8.length());
+		PERF_ASSERT(e == UTF8_ERR_NONE);
+	}
+
+	void toUtf16()
+	{
+		utf8executor_t executor = { &ConvertParallelPool::execute, &m_pool, Threads, 0 };
+		int32_t e;
+
+		size_t l = utf8toutf16_parallel(m_utf8.c_str(), m_utf8.length(), (utf16_t*)&m_output[0], m_output.size(), &executor, &e);
+
+		PERF_ASSERT(l == m_utf16.size() * sizeof(utf16_t));
+		PERF_ASSERT(e == UTF8_ERR_NONE);
+	}
+
+	ConvertParallelPool m_pool;
+	std::string m_utf8;
+	std::vector<utf16_t> m_utf16;
+	std::vector<char> m_output;
+
+};
+
+typedef ConvertParallel<1> ConvertParallelThreads1;
+typedef ConvertParallel<2> ConvertParallelThreads2;
+typedef ConvertParallel<4> ConvertParallelThreads4;
+typedef ConvertParallel<8> ConvertParallelThreads8;
+typedef ConvertParallel<16> ConvertParallelThreads16;
+
+PERF_TEST_F(ConvertParallelThreads1, FromUtf16)
+{
+	fromUtf16();
+}
+
+PERF_TEST_F(ConvertParallelThreads1, ToUtf16)
+{
+	toUtf16();
+}
+
+PERF_TEST_F(ConvertParallelThreads2, FromUtf16)
+{
+	fromUtf16();
+}
+
+PERF_TEST_F(ConvertParallelThreads2, ToUtf16)
+{
+	toUtf16();
+}
+
+PERF_TEST_F(ConvertParallelThreads4, FromUtf16)
+{
+	fromUtf16();
+}
+
+PERF_TEST_F(ConvertParallelThreads4, ToUtf16)
+{
+	toUtf16();
+}
+
+PERF_TEST_F(ConvertParallelThreads8, FromUtf16)
+{
+	fromUtf16();
+}
+
+PERF_TEST_F(ConvertParallelThreads8, ToUtf16)
+{
+	toUtf16();
+}
+
+PERF_TEST_F(ConvertParallelThreads16, FromUtf16)
+{
+	fromUtf16();
+}
+
+PERF_TEST_F(ConvertParallelThreads16, ToUtf16)
+{
+	toUtf16();
+}
+
+#endif
\ No newline at end of file
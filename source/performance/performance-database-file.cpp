@@ -0,0 +1,92 @@
+#include "performance-base.hpp"
+
+#if defined(__linux__)
+	#include <unistd.h>
+#endif
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+/*
+	Startup cost of loading the database from a file, compared to using the
+	tables compiled into the library. Each iteration uppercases Greek.txt so
+	the pages used by case mapping are touched.
+
+	The file is mapped with MAP_SHARED, so its pages are resident only once
+	in the page cache no matter how many processes map it. On Linux, the
+	resident set is printed after each suite; the "shared" part is backed by
+	files, including the mapped database.
+*/
+
+class DatabaseFile
+	: public performance::Suite
+{
+
+public:
+
+	virtual void setup() override
+	{
+		std::fstream stream("testdata/dictionaries/Greek.txt", std::ios_base::in);
+		PERF_ASSERT(stream.is_open());
+		if (!stream.is_open())
+		{
+			return;
+		}
+
+		std::stringstream ss;
+		ss << stream.rdbuf();
+
+		m_contents = ss.str();
+		m_processed = m_contents.length();
+
+		stream.close();
+	}
+
+	virtual void tearDown() override
+	{
+	#if defined(__linux__)
+		std::fstream statm("/proc/self/statm", std::ios_base::in);
+		size_t pages_total = 0;
+		size_t pages_resident = 0;
+		size_t pages_shared = 0;
+
+		if (statm >> pages_total >> pages_resident >> pages_shared)
+		{
+			size_t page_kb = (size_t)sysconf(_SC_PAGESIZE) / 1024;
+
+			std::cout << "  Resident: " << std::setw(8) << (pages_resident * page_kb) << " kB (shared " << (pages_shared * page_kb) << " kB)" << std::endl;
+		}
+	#endif
+	}
+
+	void uppercase()
+	{
+		int32_t e;
+
+		size_t ol = utf8toupper(m_contents.c_str(), m_contents.length(), m_output, sizeof(m_output), UTF8_LOCALE_DEFAULT, &e);
+
+		PERF_ASSERT(ol > 0);
+		PERF_ASSERT(e == UTF8_ERR_NONE);
+	}
+
+	std::string m_contents;
+	char m_output[8192];
+
+};
+
+PERF_TEST_F(DatabaseFile, Compiled)
+{
+	uppercase();
+}
+
+PERF_TEST_F(DatabaseFile, Load)
+{
+	int32_t e;
+
+	PERF_ASSERT(utf8loaddatabase("testdata/unicodedatabase.bin", &e) == 1);
+
+	uppercase();
+
+	utf8unloaddatabase();
+}
+
+#endif
@@ -10,7 +10,7 @@ public:
 
 	virtual void setup() override
 	{
-		std::fstream stream("testdata/dictionaries/Greek.dic", std::ios_base::in);
+		std::fstream stream("testdata/dictionaries/Greek.txt", std::ios_base::in);
 		PERF_ASSERT(stream.is_open());
 		if (!stream.is_open())
 		{
@@ -21,6 +21,7 @@ public:
 		ss << stream.rdbuf();
 
 		m_contents = ss.str();
+		m_processed = m_contents.length();
 
 		stream.close();
 	}
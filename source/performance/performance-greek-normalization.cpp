@@ -14,12 +14,13 @@ public:
 
 	virtual void setup() override
 	{
-		m_file.open("testdata/dictionaries/Greek.dic", std::ios_base::in);
+		m_file.open("testdata/dictionaries/Greek.txt", std::ios_base::in);
 
 		std::stringstream ss;
 		ss << m_file.rdbuf();
 
 		m_contents = ss.str();
+		m_processed = m_contents.length();
 
 		m_file.close();
 	}
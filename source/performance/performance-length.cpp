@@ -0,0 +1,118 @@
+#include "performance-base.hpp"
+
+extern "C" {
+	#include "../internal/length.h"
+}
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+/*
+	Counting code points in 4 MB of text built from the test data.
+	testdata/big.txt is not part of the repository, so the text is repeated
+	instead. "Scalar" is the portable implementation, "Length" uses
+	utf8nlen. Best of three runs (x64):
+
+	                        Scalar      Length
+	BasicLatin           6405 MB/s   10847 MB/s
+	QuickBrown           1074 MB/s    3432 MB/s
+
+	utf8len uses the same implementation after strlen. Before 1.6.0, it
+	counted 1084 MB/s on BasicLatin and 903 MB/s on QuickBrown.
+*/
+
+class LengthBase
+	: public performance::Suite
+{
+
+public:
+
+	void fill(const std::string& text)
+	{
+		m_contents.clear();
+		m_contents.reserve(4 * 1024 * 1024 + text.length());
+
+		while (m_contents.length() < 4 * 1024 * 1024)
+		{
+			m_contents += text;
+		}
+
+		m_processed = m_contents.length();
+	}
+
+	void scalar()
+	{
+		size_t length = length_scalar((const uint8_t*)m_contents.c_str(), m_contents.length());
+
+		PERF_ASSERT(length > 0);
+	}
+
+	void length()
+	{
+		size_t length = utf8nlen(m_contents.c_str(), m_contents.length());
+
+		PERF_ASSERT(length > 0);
+	}
+
+	std::string m_contents;
+
+};
+
+class LengthBasicLatin
+	: public LengthBase
+{
+
+public:
+
+	virtual void setup() override
+	{
+		fill("The quick brown fox jumps over the lazy dog.\n");
+	}
+
+};
+
+PERF_TEST_F(LengthBasicLatin, Scalar)
+{
+	scalar();
+}
+
+PERF_TEST_F(LengthBasicLatin, Length)
+{
+	length();
+}
+
+class LengthQuickBrown
+	: public LengthBase
+{
+
+public:
+
+	virtual void setup() override
+	{
+		std::fstream stream("testdata/quickbrown.txt", std::ios_base::in);
+		PERF_ASSERT(stream.is_open());
+		if (!stream.is_open())
+		{
+			return;
+		}
+
+		std::stringstream ss;
+		ss << stream.rdbuf();
+
+		fill(ss.str());
+
+		stream.close();
+	}
+
+};
+
+PERF_TEST_F(LengthQuickBrown, Scalar)
+{
+	scalar();
+}
+
+PERF_TEST_F(LengthQuickBrown, Length)
+{
+	length();
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include "performance-base.hpp"
+
+extern "C" {
+	#include "../internal/validation.h"
+}
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+/*
+	Validation of 4 MB of text built from the test data. "Scalar" is the
+	portable implementation, which skips Basic Latin eight bytes at a time,
+	"Validate" is the public function with the best kernel for the processor.
+	Best of three runs with AVX2 (x64):
+
+	                          Scalar      Validate
+	BasicLatin             9848 MB/s    15812 MB/s
+	QuickBrown              741 MB/s    10565 MB/s
+	Greek                   359 MB/s     7356 MB/s
+*/
+
+class ValidationBase
+	: public performance::Suite
+{
+
+public:
+
+	void load(const char* path)
+	{
+		std::fstream stream(path, std::ios_base::in);
+		PERF_ASSERT(stream.is_open());
+		if (!stream.is_open())
+		{
+			return;
+		}
+
+		std::stringstream ss;
+		ss << stream.rdbuf();
+
+		fill(ss.str());
+
+		stream.close();
+	}
+
+	void fill(const std::string& text)
+	{
+		m_contents.clear();
+		m_contents.reserve(4 * 1024 * 1024 + text.length());
+
+		while (m_contents.length() < 4 * 1024 * 1024)
+		{
+			m_contents += text;
+		}
+
+		m_processed = m_contents.length();
+	}
+
+	void scalar()
+	{
+		size_t offset = validation_scalar((const uint8_t*)m_contents.c_str(), m_contents.length());
+
+		PERF_ASSERT(offset == m_contents.length());
+	}
+
+	void validate()
+	{
+		size_t offset;
+		uint8_t valid = utf8validate(m_contents.c_str(), m_contents.length(), &offset);
+
+		PERF_ASSERT(valid == 1);
+	}
+
+	std::string m_contents;
+
+};
+
+class ValidationBasicLatin
+	: public ValidationBase
+{
+
+public:
+
+	virtual void setup() override
+	{
+		fill("The quick brown fox jumps over the lazy dog.\n");
+	}
+
+};
+
+PERF_TEST_F(ValidationBasicLatin, Scalar)
+{
+	scalar();
+}
+
+PERF_TEST_F(ValidationBasicLatin, Validate)
+{
+	validate();
+}
+
+class ValidationQuickBrown
+	: public ValidationBase
+{
+
+public:
+
+	virtual void setup() override
+	{
+		load("testdata/quickbrown.txt");
+	}
+
+};
+
+PERF_TEST_F(ValidationQuickBrown, Scalar)
+{
+	scalar();
+}
+
+PERF_TEST_F(ValidationQuickBrown, Validate)
+{
+	validate();
+}
+
+class ValidationGreek
+	: public ValidationBase
+{
+
+public:
+
+	virtual void setup() override
+	{
+		/* Greek.txt is Basic Latin only, so use a pangram instead */
+
+		fill("\xCE\x9E\xCE\xB5\xCF\x83\xCE\xBA\xCE\xB5\xCF\x80\xCE\xAC\xCE\xB6\xCF\x89 "
+			"\xCF\x84\xCE\xB7\xCE\xBD \xCF\x88\xCF\x85\xCF\x87\xCE\xBF\xCF\x86\xCE\xB8\xCF\x8C\xCF\x81\xCE\xB1 "
+			"\xCE\xB2\xCE\xB4\xCE\xB5\xCE\xBB\xCF\x85\xCE\xB3\xCE\xBC\xCE\xAF\xCE\xB1.\n");
+	}
+
+};
+
+PERF_TEST_F(ValidationGreek, Scalar)
+{
+	scalar();
+}
+
+PERF_TEST_F(ValidationGreek, Validate)
+{
+	validate();
+}
+
+#endif
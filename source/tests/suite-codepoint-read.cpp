@@ -116,6 +116,16 @@ TEST(CodepointRead, TwoBytesNotEnoughDataOneByte)
 	EXPECT_CPEQ(0xFFFD, o);
 }
 
+TEST(CodepointRead, TwoBytesNotEnoughDataAmountOfBytes)
+{
+	const char* i = "\xCA\x8A";
+	size_t is = 1;
+	unicode_t o;
+
+	EXPECT_EQ(1, codepoint_read(i, is, &o));
+	EXPECT_CPEQ(0xFFFD, o);
+}
+
 TEST(CodepointRead, TwoBytesInvalidContinuationFirstLower)
 {
 	const char* i = "\xCA\x19";
@@ -336,6 +346,16 @@ TEST(CodepointRead, FourBytesNotEnoughDataThreeBytes)
 	EXPECT_CPEQ(0xFFFD, o);
 }
 
+TEST(CodepointRead, FourBytesNotEnoughDataAmountOfBytes)
+{
+	const char* i = "\xF0\x90\xA8\x80";
+	size_t il = 3;
+	unicode_t o;
+
+	EXPECT_EQ(3, codepoint_read(i, il, &o));
+	EXPECT_CPEQ(0xFFFD, o);
+}
+
 TEST(CodepointRead, FourBytesInvalidContinuationFirstLower)
 {
 	const char* i = "\xF3\x1A\x8F\xAA";
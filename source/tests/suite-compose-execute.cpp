@@ -33,8 +33,7 @@ TEST(ComposeExecute, Initialize)
 	EXPECT_EQ(&output, state.output);
 	EXPECT_EQ(0, (int)state.output->current);
 	EXPECT_EQ(0, (int)state.output->filled);
-	EXPECT_EQ(QuickCheckNFCIndexPtr, state.qc_index);
-	EXPECT_EQ(QuickCheckNFCDataPtr, state.qc_data);
+	EXPECT_EQ(PROPERTY_SHIFT_NFC, state.qc_shift);
 }
 
 TEST(ComposeExecute, InitializeInvalidInput)
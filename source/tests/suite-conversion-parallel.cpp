@@ -0,0 +1,324 @@
+#include "tests-base.hpp"
+
+#include <thread>
+
+#include "../helpers/helpers-random.hpp"
+#include "../helpers/helpers-strings.hpp"
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+static void ExecuteThreads(void* context, void (*task)(void* data, size_t index), void* data, size_t count)
+{
+	std::vector<std::thread> threads;
+
+	*(size_t*)context += count;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		threads.emplace_back(task, data, i);
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+static void ExecuteInOrder(void* context, void (*task)(void* data, size_t index), void* data, size_t count)
+{
+	*(size_t*)context += count;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		task(data, i);
+	}
+}
+
+TEST(ConversionParallel, Utf16ToUtf8)
+{
+	std::vector<utf16_t> i = helpers::utf16("Fl\xC3\xBCgel \xF0\x9F\x98\x80 and \xE6\x97\xA5\xE6\x9C\xAC \xF0\x9F\x98\x80\xF0\x9F\x98\x80 the quick brown fox");
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+	size_t tasks = 0;
+	utf8executor_t executor = { ExecuteThreads, &tasks, 4, 16 };
+
+	EXPECT_EQ(52, utf16toutf8_parallel(&i[0], i.size() * sizeof(utf16_t), o, os, &executor, &errors));
+	EXPECT_UTF8EQ("Fl\xC3\xBCgel \xF0\x9F\x98\x80 and \xE6\x97\xA5\xE6\x9C\xAC \xF0\x9F\x98\x80\xF0\x9F\x98\x80 the quick brown fox", o);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	EXPECT_EQ(10, tasks);
+}
+
+TEST(ConversionParallel, Utf16ToUtf8SurrogatePairOnBoundary)
+{
+	std::vector<utf16_t> i;
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+	size_t tasks = 0;
+	utf8executor_t executor = { ExecuteInOrder, &tasks, 2, 0 };
+
+	for (size_t j = 0; j < 8; ++j)
+	{
+		i.push_back(0xD83D);
+		i.push_back(0xDE00);
+	}
+
+	for (size_t j = 0; j < 7; ++j)
+	{
+		executor.chunkSize = j + 1;
+
+		EXPECT_EQ(32, utf16toutf8_parallel(&i[0], i.size() * sizeof(utf16_t), o, os, &executor, &errors));
+		EXPECT_UTF8EQ("\xF0\x9F\x98\x80\xF0\x9F\x98\x80\xF0\x9F\x98\x80\xF0\x9F\x98\x80\xF0\x9F\x98\x80\xF0\x9F\x98\x80\xF0\x9F\x98\x80\xF0\x9F\x98\x80", o);
+		EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	}
+}
+
+TEST(ConversionParallel, Utf16ToUtf8NotEnoughSpace)
+{
+	std::vector<utf16_t> i = helpers::utf16("\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC");
+	char o[256] = { 0 };
+	size_t os = 10;
+	int32_t errors = UTF8_ERR_NONE;
+	size_t tasks = 0;
+	utf8executor_t executor = { ExecuteInOrder, &tasks, 2, 3 };
+
+	EXPECT_EQ(9, utf16toutf8_parallel(&i[0], i.size() * sizeof(utf16_t), o, os, &executor, &errors));
+	EXPECT_UTF8EQ("\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5", o);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, errors);
+}
+
+TEST(ConversionParallel, Utf16ToUtf8InvalidData)
+{
+	utf16_t i[] = { 'a', 'b', 0xDC00, 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 0xD800 };
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+	size_t tasks = 0;
+	utf8executor_t executor = { ExecuteInOrder, &tasks, 2, 7 };
+
+	EXPECT_EQ(18, utf16toutf8_parallel(i, sizeof(i), o, os, &executor, &errors));
+	EXPECT_UTF8EQ("ab\xEF\xBF\xBD" "cdefghijkl\xEF\xBF\xBD", o);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+}
+
+TEST(ConversionParallel, Utf16ToUtf8OverlappingParameters)
+{
+	utf16_t data[64] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+	size_t tasks = 0;
+	utf8executor_t executor = { ExecuteInOrder, &tasks, 2, 7 };
+
+	EXPECT_EQ(0, utf16toutf8_parallel(data, 64, (char*)data + 32, 64, &executor, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_OVERLAPPING_PARAMETERS, errors);
+	EXPECT_EQ(0, tasks);
+}
+
+TEST(ConversionParallel, Utf16ToUtf8MatchesSerial)
+{
+	helpers::Random random(0x2545F491);
+	const char* f[] = {
+		"a", "Z", " ", "\xC3\xA9", "\xD0\x96", "\xE2\x82\xAC", "\xE6\x97\xA5",
+		"\xF0\x9F\x98\x80", "\xF0\x90\x8D\x88", "\xED\xA0\x80", "\xC0\xAF", "\x80", "\xE0\xA4"
+	};
+	size_t tasks = 0;
+	utf8executor_t in_order = { ExecuteInOrder, &tasks, 2, 0 };
+	utf8executor_t threaded = { ExecuteThreads, &tasks, 0, 16 };
+
+	for (size_t n = 0; n < 200; ++n)
+	{
+		std::vector<utf16_t> i = helpers::utf16(random.fragments(f, sizeof(f) / sizeof(f[0]), 1 + random.next(200)));
+		size_t is = i.size() * sizeof(utf16_t) - ((random.next(4) == 0) ? 1 : 0);
+		size_t os = 1 + random.next(i.size() * 3);
+
+		in_order.chunkSize = 1 + random.next(64);
+		threaded.concurrency = 1 + random.next(8);
+
+		const utf8executor_t* executors[] = { &in_order, &threaded, &threaded };
+		size_t targetSizes[] = { os, os, i.size() * 3 };
+
+		for (size_t e = 0; e < 3; ++e)
+		{
+			std::vector<char> expected(targetSizes[e] + 1, 0x55);
+			std::vector<char> actual(targetSizes[e] + 1, 0x55);
+			int32_t expected_errors = UTF8_ERR_NONE;
+			int32_t actual_errors = UTF8_ERR_NONE;
+
+			size_t l = utf16toutf8(&i[0], is, &expected[0], targetSizes[e], &expected_errors);
+			EXPECT_EQ(l, utf16toutf8_parallel(&i[0], is, &actual[0], targetSizes[e], executors[e], &actual_errors));
+			EXPECT_ERROREQ(expected_errors, actual_errors);
+			EXPECT_EQ(std::string(&expected[0], l), std::string(&actual[0], l));
+
+			l = utf16toutf8(&i[0], is, nullptr, 0, &expected_errors);
+			EXPECT_EQ(l, utf16toutf8_parallel(&i[0], is, nullptr, 0, executors[e], &actual_errors));
+			EXPECT_ERROREQ(expected_errors, actual_errors);
+		}
+	}
+}
+
+TEST(ConversionParallel, Utf8ToUtf16)
+{
+	const char* i = "Fl\xC3\xBCgel \xF0\x9F\x98\x80 and \xE6\x97\xA5\xE6\x9C\xAC \xF0\x9F\x98\x80\xF0\x9F\x98\x80 the quick brown fox";
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+	size_t tasks = 0;
+	utf8executor_t executor = { ExecuteThreads, &tasks, 4, 16 };
+
+	EXPECT_EQ(82, utf8toutf16_parallel(i, strlen(i), o, os, &executor, &errors));
+	EXPECT_EQ(0xD83D, o[7]);
+	EXPECT_EQ(0xDE00, o[8]);
+	EXPECT_EQ('x', o[40]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	EXPECT_EQ(6, tasks);
+}
+
+TEST(ConversionParallel, Utf8ToUtf16SequenceOnBoundary)
+{
+	std::string i;
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+	size_t tasks = 0;
+	utf8executor_t executor = { ExecuteInOrder, &tasks, 2, 0 };
+
+	for (size_t j = 0; j < 8; ++j)
+	{
+		i += "\xF0\x9F\x98\x80";
+	}
+
+	for (size_t j = 0; j < 7; ++j)
+	{
+		executor.chunkSize = j + 1;
+
+		EXPECT_EQ(32, utf8toutf16_parallel(i.c_str(), i.length(), o, os, &executor, &errors));
+		EXPECT_EQ(0xD83D, o[14]);
+		EXPECT_EQ(0xDE00, o[15]);
+		EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	}
+}
+
+TEST(ConversionParallel, Utf8ToUtf16NotEnoughSpace)
+{
+	const char* i = "\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC";
+	utf16_t o[256] = { 0 };
+	size_t os = 7;
+	int32_t errors = UTF8_ERR_NONE;
+	size_t tasks = 0;
+	utf8executor_t executor = { ExecuteInOrder, &tasks, 2, 3 };
+
+	EXPECT_EQ(6, utf8toutf16_parallel(i, strlen(i), o, os, &executor, &errors));
+	EXPECT_EQ(0x65E5, o[0]);
+	EXPECT_EQ(0x672C, o[1]);
+	EXPECT_EQ(0x65E5, o[2]);
+	EXPECT_EQ(0, o[3]);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, errors);
+}
+
+TEST(ConversionParallel, Utf8ToUtf16AmountOfBytes)
+{
+	const char* i = "\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC\xF0\x9F\x98\x80\xF0\x9F\x98\x80\xE6\x97";
+	int32_t errors = UTF8_ERR_NONE;
+	size_t tasks = 0;
+	utf8executor_t executor = { ExecuteThreads, &tasks, 4, 4 };
+
+	EXPECT_EQ(18, utf8toutf16_parallel(i, strlen(i), nullptr, 0, &executor, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	EXPECT_EQ(5, tasks);
+}
+
+TEST(ConversionParallel, Utf8ToUtf16MatchesSerial)
+{
+	helpers::Random random(0x2545F491);
+	const char* f[] = {
+		"a", "Z", " ", "\xC3\xA9", "\xD0\x96", "\xE2\x82\xAC", "\xE6\x97\xA5",
+		"\xF0\x9F\x98\x80", "\xF0\x90\x8D\x88", "\xED\xA0\x80", "\xC0\xAF", "\x80", "\xE0\xA4"
+	};
+	size_t tasks = 0;
+	utf8executor_t in_order = { ExecuteInOrder, &tasks, 2, 0 };
+	utf8executor_t threaded = { ExecuteThreads, &tasks, 0, 16 };
+
+	for (size_t n = 0; n < 200; ++n)
+	{
+		std::string i = random.fragments(f, sizeof(f) / sizeof(f[0]), 1 + random.next(200));
+		size_t os = 2 + random.next(i.length() * 2);
+
+		in_order.chunkSize = 1 + random.next(64);
+		threaded.concurrency = 1 + random.next(8);
+
+		const utf8executor_t* executors[] = { &in_order, &threaded, &threaded };
+		size_t targetSizes[] = { os, os, i.length() * 2 };
+
+		for (size_t e = 0; e < 3; ++e)
+		{
+			std::vector<utf16_t> expected(targetSizes[e] / sizeof(utf16_t) + 1, 0x5555);
+			std::vector<utf16_t> actual(targetSizes[e] / sizeof(utf16_t) + 1, 0x5555);
+			int32_t expected_errors = UTF8_ERR_NONE;
+			int32_t actual_errors = UTF8_ERR_NONE;
+
+			size_t l = utf8toutf16(i.c_str(), i.length(), &expected[0], targetSizes[e], &expected_errors);
+			EXPECT_EQ(l, utf8toutf16_parallel(i.c_str(), i.length(), &actual[0], targetSizes[e], executors[e], &actual_errors));
+			EXPECT_ERROREQ(expected_errors, actual_errors);
+			EXPECT_EQ(0, memcmp(&expected[0], &actual[0], l));
+
+			l = utf8toutf16(i.c_str(), i.length(), nullptr, 0, &expected_errors);
+			EXPECT_EQ(l, utf8toutf16_parallel(i.c_str(), i.length(), nullptr, 0, executors[e], &actual_errors));
+			EXPECT_ERROREQ(expected_errors, actual_errors);
+		}
+	}
+}
+
+TEST(ConversionParallel, SmallInputOnCallingThread)
+{
+	const char* i = "Small";
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+	size_t tasks = 0;
+	utf8executor_t executor = { ExecuteThreads, &tasks, 4, 0 };
+
+	EXPECT_EQ(10, utf8toutf16_parallel(i, strlen(i), o, os, &executor, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	EXPECT_EQ(0, tasks);
+}
+
+TEST(ConversionParallel, SingleTaskOnCallingThread)
+{
+	const char* i = "\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC";
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+	size_t tasks = 0;
+	utf8executor_t executor = { ExecuteThreads, &tasks, 1, 1 };
+
+	EXPECT_EQ(16, utf8toutf16_parallel(i, strlen(i), o, os, &executor, &errors));
+	EXPECT_EQ(0x65E5, o[0]);
+	EXPECT_EQ(0x672C, o[7]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	EXPECT_EQ(0, tasks);
+}
+
+TEST(ConversionParallel, NoExecutor)
+{
+	const char* i = "\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC\xE6\x97\xA5\xE6\x9C\xAC";
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(16, utf8toutf16_parallel(i, strlen(i), o, os, nullptr, &errors));
+	EXPECT_EQ(0x65E5, o[0]);
+	EXPECT_EQ(0x672C, o[7]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(ConversionParallel, InvalidData)
+{
+	int32_t errors = UTF8_ERR_NONE;
+	size_t tasks = 0;
+	utf8executor_t executor = { ExecuteThreads, &tasks, 4, 16 };
+
+	EXPECT_EQ(0, utf8toutf16_parallel(nullptr, 1024, nullptr, 0, &executor, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+}
+
+#endif
\ No newline at end of file
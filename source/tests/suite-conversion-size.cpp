@@ -0,0 +1,292 @@
+#include "tests-base.hpp"
+
+extern "C" {
+	#include "../internal/codepoint.h"
+}
+
+#include "../helpers/helpers-random.hpp"
+#include "../helpers/helpers-strings.hpp"
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+TEST(ConversionSize, Utf16BasicLatin)
+{
+	std::vector<utf16_t> i = helpers::utf16("The quick brown fox jumps over the lazy dog.");
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(44, utf16toutf8_size(&i[0], i.size() * sizeof(utf16_t), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(ConversionSize, Utf16Mixed)
+{
+	// LATIN SMALL LETTER E WITH ACUTE
+	// NKO LETTER PA
+	// CJK UNIFIED IDEOGRAPH-5929
+	// GRINNING FACE
+
+	utf16_t i[] = {
+		'a', 0x00E9, 0x07D4, 0x5929, 0xD83D, 0xDE00, 'b', 'c',
+		0x5929, 0xD83D, 0xDE00, 0x00E9, 'd', 'e', 'f', 0x07FF,
+		0x0800, 'g' };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(32, utf16toutf8_size(i, sizeof(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(ConversionSize, Utf16SurrogatePairBetweenBlocks)
+{
+	utf16_t i[] = {
+		'a', 'b', 'c', 'd', 'e', 'f', 'g', 0xD83D,
+		0xDE00, 'h', 'i', 'j', 'k', 'l', 'm', 'n',
+		'o', 'p' };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(20, utf16toutf8_size(i, sizeof(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(ConversionSize, Utf16UnmatchedSurrogate)
+{
+	utf16_t i[] = {
+		'a', 'b', 'c', 'd', 0xDE00, 'e', 'f', 'g',
+		'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o',
+		'p', 0xD83D };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(22, utf16toutf8_size(i, sizeof(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+}
+
+TEST(ConversionSize, Utf16OddSize)
+{
+	std::vector<utf16_t> i = helpers::utf16("The quick brown fox jumps over the lazy dog.");
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(46, utf16toutf8_size(&i[0], (i.size() * sizeof(utf16_t)) - 1, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+}
+
+TEST(ConversionSize, Utf16InvalidData)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf16toutf8_size(nullptr, 8, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+}
+
+TEST(ConversionSize, Utf32Mixed)
+{
+	unicode_t i[] = {
+		'a', 0x00E9, 0x07D4, 0x5929, 0x1F600, 'b', 'c', 0x10FFFF,
+		0x5929, 0xD83D, 0xDE00, 0x00E9, 'd', 'e', 'f', 0x07FF,
+		0x0800, 'g' };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(36, utf32toutf8_size(i, sizeof(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(ConversionSize, Utf32AboveLegalUnicode)
+{
+	unicode_t i[] = {
+		'a', 'b', 0x110000, 'c', 'd', 'e', 'f', 0xFFFFFFFF,
+		'g', 'h' };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(14, utf32toutf8_size(i, sizeof(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(ConversionSize, Utf32UnmatchedSurrogate)
+{
+	unicode_t i[] = {
+		'a', 'b', 'c', 'd', 'e', 'f', 'g', 0xD800,
+		'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o' };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(18, utf32toutf8_size(i, sizeof(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+}
+
+TEST(ConversionSize, Utf8BasicLatin)
+{
+	const char* i = "The quick brown fox jumps over the lazy dog.";
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(88, utf8toutf16_size(i, strlen(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	EXPECT_EQ(176, utf8toutf32_size(i, strlen(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(ConversionSize, Utf8Mixed)
+{
+	const char* i = "z\xC3\xA9\xDF\xBF\xE0\xA0\x80p\xC2\x80\xED\x9F\xBF\xEE\x80\x80h\xC3\xBC\xF0\x90\x80\x80\xF4\x8F\xBF\xBF" "abcdef";
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(40, utf8toutf16_size(i, strlen(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	EXPECT_EQ(72, utf8toutf32_size(i, strlen(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(ConversionSize, Utf8InvalidSequences)
+{
+	// Overlong, surrogate, above U+10FFFF and truncated sequences
+
+	const char* i = "abcdefgh\xF0\x8F\xBF\xBFij\xED\xA0\x80kl\xF4\x90\x80\x80mnopqrstuvwxyz\xF0\x9F\x98";
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(60, utf8toutf16_size(i, strlen(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	EXPECT_EQ(120, utf8toutf32_size(i, strlen(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(ConversionSize, WideToUtf8)
+{
+	std::wstring i = helpers::wide("\xCE\x9E\xCE\xB5\xCF\x83\xCE\xBA\xF0\x9F\x98\x80 \xE5\xA4\xA9\xE5\x9C\xB0 The quick brown fox");
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(39, widetoutf8_size(i.c_str(), i.length() * sizeof(wchar_t), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(ConversionSize, Utf8ToWide)
+{
+	const char* i = "\xCE\x9E\xCE\xB5\xCF\x83\xCE\xBA\xE5\xA4\xA9\xE5\x9C\xB0 The quick brown fox";
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(26 * sizeof(wchar_t), utf8towide_size(i, strlen(i), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(ConversionSize, MatchesConversion)
+{
+	helpers::Random random(0x9E3779B9);
+
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		std::vector<unicode_t> units;
+		std::vector<utf16_t> units16;
+		std::string text;
+		size_t length = random.next(200);
+
+		/* Mostly valid, with surrogates and invalid values mixed in */
+
+		while (units.size() < length)
+		{
+			uint32_t choice = random.next(16);
+
+			if (choice < 6)
+			{
+				units.push_back(random.next() & 0x7F);
+			}
+			else if (
+				choice < 9)
+			{
+				units.push_back(random.next() & 0x7FF);
+			}
+			else if (
+				choice < 11)
+			{
+				units.push_back(random.next() & 0xFFFF);
+			}
+			else if (
+				choice < 13)
+			{
+				units.push_back(SURROGATE_HIGH_START + (random.next() & 0x3FF));
+				units.push_back(SURROGATE_LOW_START + (random.next() & 0x3FF));
+			}
+			else if (
+				choice < 14)
+			{
+				units.push_back(SURROGATE_HIGH_START + (random.next() & 0x7FF));
+			}
+			else if (
+				choice < 15)
+			{
+				units.push_back(0x10000 + random.next(0x100000));
+			}
+			else
+			{
+				units.push_back(random.next());
+			}
+		}
+
+		/* The same values truncated to 16 bits, with an extra unit for odd sizes */
+
+		for (size_t j = 0; j < units.size(); ++j)
+		{
+			units16.push_back((utf16_t)units[j]);
+		}
+
+		units.push_back(0);
+		units16.push_back(0);
+
+		/* Encoded as UTF-8 without checks, with some four byte sequences cut short */
+
+		for (size_t j = 0; j + 1 < units.size(); ++j)
+		{
+			unicode_t codepoint = units[j];
+
+			if (codepoint <= 0x7F)
+			{
+				text += (char)codepoint;
+			}
+			else if (
+				codepoint <= 0x7FF)
+			{
+				text += (char)(0xC0 | (codepoint >> 6));
+				text += (char)(0x80 | (codepoint & 0x3F));
+			}
+			else if (
+				codepoint <= 0xFFFF)
+			{
+				text += (char)(0xE0 | (codepoint >> 12));
+				text += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+				text += (char)(0x80 | (codepoint & 0x3F));
+			}
+			else
+			{
+				text += (char)(0xF0 | ((codepoint >> 18) & 0x0F));
+				text += (char)(0x80 | ((codepoint >> 12) & 0x3F));
+				if (random.next(8) != 0)
+				{
+					text += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+					text += (char)(0x80 | (codepoint & 0x3F));
+				}
+			}
+		}
+
+		SCOPED_TRACE(helpers::hex(text));
+
+		/* Measured sizes match the converted sizes */
+
+		std::vector<unicode_t> output(units.size() * 4 + text.length() + 16);
+		size_t units16_size = (units16.size() - 1) * sizeof(utf16_t) + random.next(2);
+		size_t units_size = (units.size() - 1) * sizeof(unicode_t) + random.next(4);
+		int32_t converted_errors = UTF8_ERR_NONE;
+		int32_t measured_errors = UTF8_ERR_NONE;
+
+		size_t converted = utf16toutf8(&units16[0], units16_size, (char*)&output[0], output.size() * sizeof(unicode_t), &converted_errors);
+		EXPECT_EQ(converted, utf16toutf8_size(&units16[0], units16_size, &measured_errors));
+		EXPECT_ERROREQ(converted_errors, measured_errors);
+
+		converted = utf32toutf8(&units[0], units_size, (char*)&output[0], output.size() * sizeof(unicode_t), &converted_errors);
+		EXPECT_EQ(converted, utf32toutf8_size(&units[0], units_size, &measured_errors));
+		EXPECT_ERROREQ(converted_errors, measured_errors);
+
+		converted = utf8toutf16(text.c_str(), text.length(), (utf16_t*)&output[0], output.size() * sizeof(unicode_t), &converted_errors);
+		EXPECT_EQ(converted, utf8toutf16_size(text.c_str(), text.length(), &measured_errors));
+		EXPECT_ERROREQ(converted_errors, measured_errors);
+
+		converted = utf8toutf32(text.c_str(), text.length(), &output[0], output.size() * sizeof(unicode_t), &converted_errors);
+		EXPECT_EQ(converted, utf8toutf32_size(text.c_str(), text.length(), &measured_errors));
+		EXPECT_ERROREQ(converted_errors, measured_errors);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "tests-base.hpp"
+
+extern "C" {
+	#include "../internal/codepoint.h"
+	#include "../internal/database.h"
+}
+
+#include "../helpers/helpers-strings.hpp"
+
+// Uppercase
+
+TEST(QueryCaseMappingUppercase, Simple)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x00001E0B, UppercaseIndex1Ptr, UppercaseIndex2Ptr, UppercaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x00001E0A, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingUppercase, SimpleFirst)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x000000B5, UppercaseIndex1Ptr, UppercaseIndex2Ptr, UppercaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x0000039C, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingUppercase, SimpleLast)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x000118DF, UppercaseIndex1Ptr, UppercaseIndex2Ptr, UppercaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x000118BF, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingUppercase, SimpleShorter)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x00000131, UppercaseIndex1Ptr, UppercaseIndex2Ptr, UppercaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x00000049, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingUppercase, String)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_UTF8LENGTHEQ("SS", database_querycasemapping(0x000000DF, UppercaseIndex1Ptr, UppercaseIndex2Ptr, UppercaseDataPtr, &mapped, &length), length);
+	EXPECT_CPEQ(0x000000DF, mapped);
+}
+
+TEST(QueryCaseMappingUppercase, StringApostrophe)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_UTF8LENGTHEQ("\xCA\xBCN", database_querycasemapping(0x00000149, UppercaseIndex1Ptr, UppercaseIndex2Ptr, UppercaseDataPtr, &mapped, &length), length);
+	EXPECT_CPEQ(0x00000149, mapped);
+}
+
+TEST(QueryCaseMappingUppercase, Missing)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x00002BAD, UppercaseIndex1Ptr, UppercaseIndex2Ptr, UppercaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x00002BAD, mapped);
+	EXPECT_EQ(0, length);
+}
+
+// Lowercase
+
+TEST(QueryCaseMappingLowercase, Simple)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x00000393, LowercaseIndex1Ptr, LowercaseIndex2Ptr, LowercaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x000003B3, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingLowercase, SimpleFirst)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x000000C0, LowercaseIndex1Ptr, LowercaseIndex2Ptr, LowercaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x000000E0, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingLowercase, SimpleLast)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x000118BF, LowercaseIndex1Ptr, LowercaseIndex2Ptr, LowercaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x000118DF, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingLowercase, SimpleNegative)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x0000A7AD, LowercaseIndex1Ptr, LowercaseIndex2Ptr, LowercaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x0000026C, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingLowercase, String)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_UTF8LENGTHEQ("i\xCC\x87", database_querycasemapping(0x00000130, LowercaseIndex1Ptr, LowercaseIndex2Ptr, LowercaseDataPtr, &mapped, &length), length);
+	EXPECT_CPEQ(0x00000130, mapped);
+}
+
+TEST(QueryCaseMappingLowercase, Missing)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x0000F3AA, LowercaseIndex1Ptr, LowercaseIndex2Ptr, LowercaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x0000F3AA, mapped);
+	EXPECT_EQ(0, length);
+}
+
+// Titlecase
+
+TEST(QueryCaseMappingTitlecase, Simple)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x00000450, TitlecaseIndex1Ptr, TitlecaseIndex2Ptr, TitlecaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x00000400, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingTitlecase, SimpleFirst)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x000000B5, TitlecaseIndex1Ptr, TitlecaseIndex2Ptr, TitlecaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x0000039C, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingTitlecase, SimpleLast)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x000118DF, TitlecaseIndex1Ptr, TitlecaseIndex2Ptr, TitlecaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x000118BF, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingTitlecase, SimpleDigraph)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x000001C6, TitlecaseIndex1Ptr, TitlecaseIndex2Ptr, TitlecaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x000001C5, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingTitlecase, String)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_UTF8LENGTHEQ("Ss", database_querycasemapping(0x000000DF, TitlecaseIndex1Ptr, TitlecaseIndex2Ptr, TitlecaseDataPtr, &mapped, &length), length);
+	EXPECT_CPEQ(0x000000DF, mapped);
+}
+
+TEST(QueryCaseMappingTitlecase, Missing)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x0000ABED, TitlecaseIndex1Ptr, TitlecaseIndex2Ptr, TitlecaseDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x0000ABED, mapped);
+	EXPECT_EQ(0, length);
+}
+
+// CaseFolding
+
+TEST(QueryCaseMappingCaseFolding, Simple)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x00000100, CaseFoldingIndex1Ptr, CaseFoldingIndex2Ptr, CaseFoldingDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x00000101, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingCaseFolding, SimpleFourBytes)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x00010400, CaseFoldingIndex1Ptr, CaseFoldingIndex2Ptr, CaseFoldingDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x00010428, mapped);
+	EXPECT_EQ(0, length);
+}
+
+TEST(QueryCaseMappingCaseFolding, String)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_UTF8LENGTHEQ("ss", database_querycasemapping(0x000000DF, CaseFoldingIndex1Ptr, CaseFoldingIndex2Ptr, CaseFoldingDataPtr, &mapped, &length), length);
+	EXPECT_CPEQ(0x000000DF, mapped);
+}
+
+TEST(QueryCaseMappingCaseFolding, Missing)
+{
+	unicode_t mapped = 0;
+	uint8_t length = 0;
+	EXPECT_EQ(nullptr, database_querycasemapping(0x00000061, CaseFoldingIndex1Ptr, CaseFoldingIndex2Ptr, CaseFoldingDataPtr, &mapped, &length));
+	EXPECT_CPEQ(0x00000061, mapped);
+	EXPECT_EQ(0, length);
+}
\ No newline at end of file
@@ -57,4 +57,14 @@ TEST(QueryComposition, MissingOutOfLowerBounds)
 TEST(QueryComposition, MissingOutOfUpperBounds)
 {
 	EXPECT_EQ(0, database_querycomposition(0xABABABAB, 0xDADADADA));
-}
\ No newline at end of file
+}
+
+TEST(QueryComposition, FoundAllRecords)
+{
+	for (size_t i = 0; i < UnicodeCompositionRecordCount; ++i)
+	{
+		const CompositionRecord* record = UnicodeCompositionRecordPtr + i;
+
+		EXPECT_EQ(record->value, database_querycomposition((unicode_t)(record->key >> 32), (unicode_t)(record->key & 0xFFFFFFFF)));
+	}
+}
@@ -0,0 +1,71 @@
+#include "tests-base.hpp"
+
+extern "C" {
+	#include "../internal/codepoint.h"
+	#include "../internal/database.h"
+}
+
+TEST(QueryProperties, BasicLatin)
+{
+	uint32_t properties = database_queryproperties(0x00000041);
+	EXPECT_EQ(UTF8_CATEGORY_LETTER_UPPERCASE, PROPERTY_RECORD_GC(properties));
+	EXPECT_EQ(CCC_NOT_REORDERED, PROPERTY_RECORD_CCC(properties));
+	EXPECT_EQ(QuickCheckCaseMapped_Lowercase | QuickCheckCaseMapped_Casefolded, PROPERTY_RECORD_CM(properties));
+	EXPECT_EQ(QuickCheckResult_Yes, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFC));
+	EXPECT_EQ(QuickCheckResult_Yes, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFD));
+	EXPECT_EQ(QuickCheckResult_Yes, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFKC));
+	EXPECT_EQ(QuickCheckResult_Yes, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFKD));
+}
+
+TEST(QueryProperties, CombiningMark)
+{
+	uint32_t properties = database_queryproperties(0x00000301);
+	EXPECT_EQ(UTF8_CATEGORY_MARK_NON_SPACING, PROPERTY_RECORD_GC(properties));
+	EXPECT_EQ(230, PROPERTY_RECORD_CCC(properties));
+	EXPECT_EQ(0, PROPERTY_RECORD_CM(properties));
+	EXPECT_EQ(QuickCheckResult_Maybe, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFC));
+	EXPECT_EQ(QuickCheckResult_Yes, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFD));
+	EXPECT_EQ(QuickCheckResult_Maybe, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFKC));
+	EXPECT_EQ(QuickCheckResult_Yes, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFKD));
+}
+
+TEST(QueryProperties, Decomposed)
+{
+	uint32_t properties = database_queryproperties(0x000000C5);
+	EXPECT_EQ(UTF8_CATEGORY_LETTER_UPPERCASE, PROPERTY_RECORD_GC(properties));
+	EXPECT_EQ(CCC_NOT_REORDERED, PROPERTY_RECORD_CCC(properties));
+	EXPECT_EQ(QuickCheckCaseMapped_Lowercase | QuickCheckCaseMapped_Casefolded, PROPERTY_RECORD_CM(properties));
+	EXPECT_EQ(QuickCheckResult_Yes, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFC));
+	EXPECT_EQ(QuickCheckResult_No, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFD));
+	EXPECT_EQ(QuickCheckResult_Yes, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFKC));
+	EXPECT_EQ(QuickCheckResult_No, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFKD));
+}
+
+TEST(QueryProperties, Compatibility)
+{
+	uint32_t properties = database_queryproperties(0x0000FB01);
+	EXPECT_EQ(UTF8_CATEGORY_LETTER_LOWERCASE, PROPERTY_RECORD_GC(properties));
+	EXPECT_EQ(CCC_NOT_REORDERED, PROPERTY_RECORD_CCC(properties));
+	EXPECT_EQ(QuickCheckCaseMapped_Uppercase | QuickCheckCaseMapped_Titlecase | QuickCheckCaseMapped_Casefolded, PROPERTY_RECORD_CM(properties));
+	EXPECT_EQ(QuickCheckResult_Yes, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFC));
+	EXPECT_EQ(QuickCheckResult_Yes, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFD));
+	EXPECT_EQ(QuickCheckResult_No, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFKC));
+	EXPECT_EQ(QuickCheckResult_No, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFKD));
+}
+
+TEST(QueryProperties, Unassigned)
+{
+	uint32_t properties = database_queryproperties(0x0001FFFF);
+	EXPECT_EQ(0, PROPERTY_RECORD_GC(properties));
+	EXPECT_EQ(CCC_NOT_REORDERED, PROPERTY_RECORD_CCC(properties));
+	EXPECT_EQ(0, PROPERTY_RECORD_CM(properties));
+	EXPECT_EQ(QuickCheckResult_Yes, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFC));
+	EXPECT_EQ(QuickCheckResult_Yes, PROPERTY_RECORD_QC(properties, PROPERTY_SHIFT_NFKD));
+}
+
+TEST(QueryProperties, Last)
+{
+	uint32_t properties = database_queryproperties(MAX_LEGAL_UNICODE);
+	EXPECT_EQ(0, PROPERTY_RECORD_GC(properties));
+	EXPECT_EQ(CCC_NOT_REORDERED, PROPERTY_RECORD_CCC(properties));
+}
\ No newline at end of file
@@ -36,8 +36,7 @@ TEST(DecomposeExecute, Initialize)
 	EXPECT_EQ(NFDIndex1Ptr, state.property_index1);
 	EXPECT_EQ(NFDIndex2Ptr, state.property_index2);
 	EXPECT_EQ(NFDDataPtr, state.property_data);
-	EXPECT_EQ(QuickCheckNFDIndexPtr, state.qc_index);
-	EXPECT_EQ(QuickCheckNFDDataPtr, state.qc_data);
+	EXPECT_EQ(PROPERTY_SHIFT_NFD, state.qc_shift);
 }
 
 TEST(DecomposeExecute, InitializeInvalidInput)
@@ -42,12 +42,12 @@ TEST(StreamRead, StartSingleStarter)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x02FC, Yes, 0);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StartSingleNonStarter)
@@ -64,12 +64,12 @@ TEST(StreamRead, StartSingleNonStarter)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x031D, Yes, 220);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StartSingleNonStarterSequence)
@@ -86,17 +86,17 @@ TEST(StreamRead, StartSingleNonStarterSequence)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0F71, Yes, 129);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x00A6, Yes, 0);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StartSingleInvalid)
@@ -113,11 +113,11 @@ TEST(StreamRead, StartSingleInvalid)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0xFFFD, Yes, 0);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StartMultipleStarter)
@@ -134,22 +134,22 @@ TEST(StreamRead, StartMultipleStarter)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x03F4, Yes, 0);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0406, Yes, 0);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0414, Yes, 0);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StartMultipleNonStarterOrdered)
@@ -166,13 +166,13 @@ TEST(StreamRead, StartMultipleNonStarterOrdered)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(2, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x033B, Yes, 220);
 	CHECK_STREAM_ENTRY(state, 1, 0x034B, Yes, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StartMultipleNonStarterUnordered)
@@ -189,13 +189,13 @@ TEST(StreamRead, StartMultipleNonStarterUnordered)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(2, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x034B, Yes, 230);
 	CHECK_STREAM_ENTRY(state, 1, 0x033B, Yes, 220);
 	EXPECT_FALSE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StartMultipleNonStarterSequence)
@@ -212,18 +212,18 @@ TEST(StreamRead, StartMultipleNonStarterSequence)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(2, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0xA953, Yes, 9);
 	CHECK_STREAM_ENTRY(state, 1, 0x07F2, Yes, 220);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x00B1, Yes, 0);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, Sequence)
@@ -240,13 +240,13 @@ TEST(StreamRead, Sequence)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(2, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0041, Yes, 0);
 	CHECK_STREAM_ENTRY(state, 1, 0x0303, Maybe, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, SequenceOrdered)
@@ -263,14 +263,14 @@ TEST(StreamRead, SequenceOrdered)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(3, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0041, Yes, 0);
 	CHECK_STREAM_ENTRY(state, 1, 0x0318, Yes, 220);
 	CHECK_STREAM_ENTRY(state, 2, 0x0310, Yes, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, SequenceUnordered)
@@ -287,14 +287,14 @@ TEST(StreamRead, SequenceUnordered)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(3, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x004F, Yes, 0);
 	CHECK_STREAM_ENTRY(state, 1, 0x0304, Maybe, 230);
 	CHECK_STREAM_ENTRY(state, 2, 0x0328, Maybe, 202);
 	EXPECT_FALSE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, SequenceEndStarterMaybe)
@@ -311,18 +311,18 @@ TEST(StreamRead, SequenceEndStarterMaybe)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(2, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x09C7, Yes, 0);
 	CHECK_STREAM_ENTRY(state, 1, 0x0334, Yes, 1);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x09BE, Maybe, 0);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, SequenceEndNonStarterMaybe)
@@ -339,14 +339,14 @@ TEST(StreamRead, SequenceEndNonStarterMaybe)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(3, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0112, Yes, 0);
 	CHECK_STREAM_ENTRY(state, 1, 0x0334, Yes, 1);
 	CHECK_STREAM_ENTRY(state, 2, 0x0300, Maybe, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, MultipleSequencesOrdered)
@@ -363,20 +363,20 @@ TEST(StreamRead, MultipleSequencesOrdered)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(3, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0061, Yes, 0);
 	CHECK_STREAM_ENTRY(state, 1, 0x0300, Maybe, 230);
 	CHECK_STREAM_ENTRY(state, 2, 0x0301, Maybe, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(2, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0045, Yes, 0);
 	CHECK_STREAM_ENTRY(state, 1, 0x030C, Maybe, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, MultipleSequencesUnordered)
@@ -393,7 +393,7 @@ TEST(StreamRead, MultipleSequencesUnordered)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(5, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0061, Yes, 0);
 	CHECK_STREAM_ENTRY(state, 1, 0x0315, Yes, 232);
@@ -402,12 +402,12 @@ TEST(StreamRead, MultipleSequencesUnordered)
 	CHECK_STREAM_ENTRY(state, 4, 0x0300, Maybe, 230);
 	EXPECT_FALSE(state.stable);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0062, Yes, 0);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, MultipleSequencesNonStarter)
@@ -424,7 +424,7 @@ TEST(StreamRead, MultipleSequencesNonStarter)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(4, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x05B8, Yes, 18);
 	CHECK_STREAM_ENTRY(state, 1, 0x05B9, Yes, 19);
@@ -432,7 +432,7 @@ TEST(StreamRead, MultipleSequencesNonStarter)
 	CHECK_STREAM_ENTRY(state, 3, 0x0591, Yes, 220);
 	EXPECT_FALSE(state.stable);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(4, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x05C3, Yes, 0);
 	CHECK_STREAM_ENTRY(state, 1, 0x05B0, Yes, 10);
@@ -440,7 +440,7 @@ TEST(StreamRead, MultipleSequencesNonStarter)
 	CHECK_STREAM_ENTRY(state, 3, 0x059F, Yes, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, MultipleSequencesInvalid)
@@ -457,15 +457,15 @@ TEST(StreamRead, MultipleSequencesInvalid)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0xFFFD, Yes, 0);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0xFFFD, Yes, 0);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StableStarterAndNonStarter)
@@ -482,13 +482,13 @@ TEST(StreamRead, StableStarterAndNonStarter)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(2, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0041, Yes, 0);
 	CHECK_STREAM_ENTRY(state, 1, 0x0301, Maybe, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StableNonStarterAndStarter)
@@ -505,17 +505,17 @@ TEST(StreamRead, StableNonStarterAndStarter)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0301, Maybe, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0041, Yes, 0);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StableTwoStarter)
@@ -532,17 +532,17 @@ TEST(StreamRead, StableTwoStarter)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0376, Yes, 0);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x037F, Yes, 0);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StableTwoNonStarterEqual)
@@ -559,13 +559,13 @@ TEST(StreamRead, StableTwoNonStarterEqual)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(2, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0308, Maybe, 230);
 	CHECK_STREAM_ENTRY(state, 1, 0x0301, Maybe, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StableTwoNonStarterLesserThan)
@@ -582,13 +582,13 @@ TEST(StreamRead, StableTwoNonStarterLesserThan)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(2, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0327, Maybe, 202);
 	CHECK_STREAM_ENTRY(state, 1, 0x0301, Maybe, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, StableTwoNonStarterGreaterThan)
@@ -605,13 +605,13 @@ TEST(StreamRead, StableTwoNonStarterGreaterThan)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(2, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0301, Maybe, 230);
 	CHECK_STREAM_ENTRY(state, 1, 0x0327, Maybe, 202);
 	EXPECT_FALSE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, BufferOverflow)
@@ -639,7 +639,7 @@ TEST(StreamRead, BufferOverflow)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(30, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0032, Yes, 0);
 	CHECK_STREAM_ENTRY(state, 1, 0x0308, Maybe, 230);
@@ -673,7 +673,7 @@ TEST(StreamRead, BufferOverflow)
 	CHECK_STREAM_ENTRY(state, 29, 0x0308, Maybe, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(18, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x034F, Yes, 0);
 	CHECK_STREAM_ENTRY(state, 1, 0x0308, Maybe, 230);
@@ -695,12 +695,12 @@ TEST(StreamRead, BufferOverflow)
 	CHECK_STREAM_ENTRY(state, 17, 0x0308, Maybe, 230);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	CHECK_STREAM_ENTRY(state, 0, 0x0033, Yes, 0);
 	EXPECT_TRUE(state.stable);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, ContinueAfterEnd)
@@ -717,18 +717,18 @@ TEST(StreamRead, ContinueAfterEnd)
 	StreamState state;
 	EXPECT_TRUE(stream_initialize(&state, i, il));
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 	
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 
-	EXPECT_TRUE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_TRUE(stream_read(&state, PROPERTY_SHIFT_NFC));
 	EXPECT_EQ(1, state.current);
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, NotEnoughData)
@@ -739,7 +739,7 @@ TEST(StreamRead, NotEnoughData)
 	StreamState state;
 	EXPECT_FALSE(stream_initialize(&state, i, il));
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
 
 TEST(StreamRead, InvalidData)
@@ -750,5 +750,5 @@ TEST(StreamRead, InvalidData)
 	StreamState state;
 	EXPECT_FALSE(stream_initialize(&state, i, il));
 
-	EXPECT_FALSE(stream_read(&state, QuickCheckNFCIndexPtr, QuickCheckNFCDataPtr));
+	EXPECT_FALSE(stream_read(&state, PROPERTY_SHIFT_NFC));
 }
\ No newline at end of file
@@ -890,6 +890,118 @@ TEST(Utf16ToUtf8, StringEndsInMiddle)
 	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
 }
 
+TEST(Utf16ToUtf8, StringBlockBasicLatin)
+{
+	utf16_t i[] = {
+		'T', 'h', 'e', ' ', 'q', 'u', 'i', 'c', 'k', ' ', 'b', 'r', 'o', 'w', 'n', ' ',
+		'f', 'o', 'x', ' ', 'j', 'u', 'm', 'p', 's', '.'
+	};
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(26, utf16toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("The quick brown fox jumps.", o);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf16ToUtf8, StringBlockTwoBytes)
+{
+	utf16_t i[] = { 0x039E, 0x03B5, 0x03C3, 0x03BA, 0x03B5, 0x03C0, 0x03AC, 0x03B6, 0x03C9 };
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(18, utf16toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("\xCE\x9E\xCE\xB5\xCF\x83\xCE\xBA\xCE\xB5\xCF\x80\xCE\xAC\xCE\xB6\xCF\x89", o);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf16ToUtf8, StringBlockThreeBytes)
+{
+	utf16_t i[] = { 0x5929, 0x5730, 0x7384, 0x9EC4, 0x5B87, 0x5B99, 0x6D2A, 0x8352, 0xFFFF };
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(27, utf16toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("\xE5\xA4\xA9\xE5\x9C\xB0\xE7\x8E\x84\xE9\xBB\x84\xE5\xAE\x87\xE5\xAE\x99\xE6\xB4\xAA\xE8\x8D\x92\xEF\xBF\xBF", o);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf16ToUtf8, StringBlockMixed)
+{
+	utf16_t i[] = { 'z', 0x00E9, 0x07FF, 0x0800, 'p', 0x0080, 0xD7FF, 0xE000, 'h', 0x00FC };
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(20, utf16toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("z\xC3\xA9\xDF\xBF\xE0\xA0\x80p\xC2\x80\xED\x9F\xBF\xEE\x80\x80h\xC3\xBC", o);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf16ToUtf8, StringBlockSurrogatePair)
+{
+	utf16_t i[] = { 'S', 'm', 'i', 'l', 'e', 0x00E9, ' ', 0xD83D, 0xDE00, ' ', 0x4E2D, 'o', 'k', '!', '?', '!', '.' };
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(22, utf16toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("Smile\xC3\xA9 \xF0\x9F\x98\x80 \xE4\xB8\xADok!?!.", o);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf16ToUtf8, StringBlockUnmatchedSurrogate)
+{
+	utf16_t i[] = { 'a', 'b', 'c', 0xDC00, 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o' };
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(18, utf16toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("abc\xEF\xBF\xBD" "defghijklmno", o);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+}
+
+TEST(Utf16ToUtf8, StringBlockAmountOfBytes)
+{
+	utf16_t i[] = {
+		'h', 'e', 'l', 'l', 'o', ' ', 0x4E16, 0x754C,
+		0x039E, 0x03B5, 0x03C3, 0x03BA, 0x03B5, 0x03C0, 0x03AC, 0x03B6,
+		'.', '.', '.', '.', '.', '.', '.', '.'
+	};
+	size_t is = sizeof(i);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(36, utf16toutf8(i, is, nullptr, 0, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf16ToUtf8, StringBlockNotEnoughSpace)
+{
+	utf16_t i[] = {
+		0x5929, 0x5730, 0x7384, 0x9EC4, 0x5B87, 0x5B99, 0x6D2A, 0x8352,
+		0x5929, 0x5730, 0x7384, 0x9EC4, 0x5B87, 0x5B99, 0x6D2A, 0x8352,
+		0x5929, 0x5730, 0x7384, 0x9EC4, 0x5B87, 0x5B99, 0x6D2A, 0x8352
+	};
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 40;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(39, utf16toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("\xE5\xA4\xA9\xE5\x9C\xB0\xE7\x8E\x84\xE9\xBB\x84\xE5\xAE\x87\xE5\xAE\x99\xE6\xB4\xAA\xE8\x8D\x92\xE5\xA4\xA9\xE5\x9C\xB0\xE7\x8E\x84\xE9\xBB\x84\xE5\xAE\x87", o);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, errors);
+}
+
 TEST(Utf16ToUtf8, ErrorsIsReset)
 {
 	utf16_t c = 0x1A8D;
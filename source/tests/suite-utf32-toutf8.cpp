@@ -1597,6 +1597,94 @@ TEST(Utf32ToUtf8, StringEndsInMiddle)
 	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
 }
 
+TEST(Utf32ToUtf8, StringBlockMixed)
+{
+	unicode_t i[] = { 0x0053, 0x00E9, 0x07FF, 0x0800, 0xFFFF, 0x10000, 0x1F600, 0x10FFFF, 0x006B };
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(24, utf32toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("S\xC3\xA9\xDF\xBF\xE0\xA0\x80\xEF\xBF\xBF\xF0\x90\x80\x80\xF0\x9F\x98\x80\xF4\x8F\xBF\xBFk", o);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf32ToUtf8, StringBlockBasicLatin)
+{
+	unicode_t i[] = { 's', 'e', 'a', 'r', 'c', 'h', 'e', 'n', 'g', 'i', 'n', 'e', 't', 'e', 'r', 'm', '.' };
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(17, utf32toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("searchengineterm.", o);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf32ToUtf8, StringBlockSurrogatePair)
+{
+	unicode_t i[] = { 'a', 'b', 'c', 0xD83D, 0xDE00, 'd', 'e', 'f', 'g' };
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(11, utf32toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("abc\xF0\x9F\x98\x80" "defg", o);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf32ToUtf8, StringBlockUnmatchedSurrogate)
+{
+	unicode_t i[] = { 'a', 'b', 'c', 'd', 0xDC00, 'e', 'f', 'g', 'h' };
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(11, utf32toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("abcd\xEF\xBF\xBD" "efgh", o);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+}
+
+TEST(Utf32ToUtf8, StringBlockAboveLegalUnicode)
+{
+	unicode_t i[] = { 'a', 'b', 0x110000, 'c', 'd', 'e', 'f', 'g', 'h' };
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 255;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(11, utf32toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("ab\xEF\xBF\xBD" "cdefgh", o);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf32ToUtf8, StringBlockAmountOfBytes)
+{
+	unicode_t i[] = { 0x0053, 0x00E9, 0x07FF, 0x0800, 0xFFFF, 0x10000, 0x1F600, 0x10FFFF, 0x006B };
+	size_t is = sizeof(i);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(24, utf32toutf8(i, is, nullptr, 0, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf32ToUtf8, StringBlockNotEnoughSpace)
+{
+	unicode_t i[] = { 0x0053, 0x00E9, 0x07FF, 0x0800, 0xFFFF, 0x10000, 0x1F600, 0x10FFFF, 0x006B };
+	size_t is = sizeof(i);
+	char o[256] = { 0 };
+	size_t os = 20;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(19, utf32toutf8(i, is, o, os, &errors));
+	EXPECT_UTF8EQ("S\xC3\xA9\xDF\xBF\xE0\xA0\x80\xEF\xBF\xBF\xF0\x90\x80\x80\xF0\x9F\x98\x80", o);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, errors);
+}
+
 TEST(Utf32ToUtf8, ErrorsIsReset)
 {
 	unicode_t i[] = { 0x1B001 };
@@ -0,0 +1,294 @@
+#include "tests-base.hpp"
+
+#include "../helpers/helpers-strings.hpp"
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+class Utf8Alloc
+	: public ::testing::Test
+{
+
+protected:
+
+	void SetUp()
+	{
+		allocations = 0;
+		reallocations = 0;
+		deallocations = 0;
+		fail_after = SIZE_MAX;
+		arena_used = 0;
+
+		counting.allocate = &Utf8Alloc::Allocate;
+		counting.reallocate = &Utf8Alloc::Reallocate;
+		counting.deallocate = &Utf8Alloc::Deallocate;
+		counting.context = this;
+
+		arena.allocate = &Utf8Alloc::ArenaAllocate;
+		arena.reallocate = nullptr;
+		arena.deallocate = nullptr;
+		arena.context = this;
+	}
+
+	static void* Allocate(void* context, size_t size)
+	{
+		Utf8Alloc* self = (Utf8Alloc*)context;
+		if (self->allocations + self->reallocations >= self->fail_after)
+		{
+			return nullptr;
+		}
+		self->allocations++;
+		return malloc(size);
+	}
+
+	static void* Reallocate(void* context, void* memory, size_t size)
+	{
+		Utf8Alloc* self = (Utf8Alloc*)context;
+		if (self->allocations + self->reallocations >= self->fail_after)
+		{
+			return nullptr;
+		}
+		self->reallocations++;
+		return realloc(memory, size);
+	}
+
+	static void Deallocate(void* context, void* memory)
+	{
+		Utf8Alloc* self = (Utf8Alloc*)context;
+		self->deallocations++;
+		free(memory);
+	}
+
+	static void* ArenaAllocate(void* context, size_t size)
+	{
+		Utf8Alloc* self = (Utf8Alloc*)context;
+		if (size > sizeof(self->arena_data) - self->arena_used)
+		{
+			return nullptr;
+		}
+		void* memory = self->arena_data + self->arena_used;
+		self->arena_used += size;
+		return memory;
+	}
+
+	size_t allocations;
+	size_t reallocations;
+	size_t deallocations;
+	size_t fail_after;
+	utf8allocator_t counting;
+
+	char arena_data[1024];
+	size_t arena_used;
+	utf8allocator_t arena;
+
+};
+
+TEST_F(Utf8Alloc, ToUpper)
+{
+	const char* c = "Stra\xC3\x9F" "e";
+	size_t s = 0;
+	int32_t errors = UTF8_ERR_NONE;
+
+	char* r = utf8toupper_alloc(c, strlen(c), UTF8_LOCALE_DEFAULT, nullptr, &s, &errors);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(7, s);
+	EXPECT_UTF8EQ("STRASSE", r);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	utf8free(nullptr, r);
+}
+
+TEST_F(Utf8Alloc, ToLower)
+{
+	const char* c = "\xCE\x9F\xCE\x94\xCE\x9F\xCE\xA3";
+	size_t s = 0;
+	int32_t errors = UTF8_ERR_NONE;
+
+	char* r = utf8tolower_alloc(c, strlen(c), UTF8_LOCALE_DEFAULT, &counting, &s, &errors);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(8, s);
+	EXPECT_UTF8EQ("\xCE\xBF\xCE\xB4\xCE\xBF\xCF\x82", r);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	utf8free(&counting, r);
+	EXPECT_EQ(1, allocations);
+	EXPECT_EQ(1, deallocations);
+}
+
+TEST_F(Utf8Alloc, ToTitle)
+{
+	const char* c = "the quick brown fox";
+	size_t s = 0;
+	int32_t errors = UTF8_ERR_NONE;
+
+	char* r = utf8totitle_alloc(c, strlen(c), UTF8_LOCALE_DEFAULT, &counting, &s, &errors);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(19, s);
+	EXPECT_UTF8EQ("The Quick Brown Fox", r);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	utf8free(&counting, r);
+}
+
+TEST_F(Utf8Alloc, CaseFold)
+{
+	const char* c = "\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F\xC3\x9F";
+	size_t s = 0;
+	int32_t errors = UTF8_ERR_NONE;
+
+	char* r = utf8casefold_alloc(c, strlen(c), UTF8_LOCALE_DEFAULT, &counting, &s, &errors);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(32, s);
+	EXPECT_UTF8EQ("ssssssssssssssssssssssssssssssss", r);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	utf8free(&counting, r);
+	EXPECT_EQ(1, allocations);
+	EXPECT_EQ(0, reallocations);
+	EXPECT_EQ(1, deallocations);
+}
+
+TEST_F(Utf8Alloc, CaseFoldInvalidLocale)
+{
+	const char* c = "Text";
+	size_t s = 1337;
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(nullptr, utf8casefold_alloc(c, strlen(c), 1337, &counting, &s, &errors));
+	EXPECT_EQ(0, s);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_LOCALE, errors);
+	EXPECT_EQ(allocations, deallocations);
+}
+
+TEST_F(Utf8Alloc, NormalizeDecompose)
+{
+	const char* c = "\xEA\xB0\x80\xEA\xB0\x80\xEA\xB0\x80\xEA\xB0\x80";
+	size_t s = 0;
+	int32_t errors = UTF8_ERR_NONE;
+
+	char* r = utf8normalize_alloc(c, strlen(c), UTF8_NORMALIZE_DECOMPOSE, &counting, &s, &errors);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(24, s);
+	EXPECT_UTF8EQ("\xE1\x84\x80\xE1\x85\xA1\xE1\x84\x80\xE1\x85\xA1\xE1\x84\x80\xE1\x85\xA1\xE1\x84\x80\xE1\x85\xA1", r);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	utf8free(&counting, r);
+	EXPECT_EQ(1, allocations);
+	EXPECT_EQ(0, reallocations);
+	EXPECT_EQ(1, deallocations);
+}
+
+TEST_F(Utf8Alloc, NormalizeCompose)
+{
+	const char* c = "A\xCC\x8A";
+	size_t s = 0;
+	int32_t errors = UTF8_ERR_NONE;
+
+	char* r = utf8normalize_alloc(c, strlen(c), UTF8_NORMALIZE_COMPOSE, nullptr, &s, &errors);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(2, s);
+	EXPECT_UTF8EQ("\xC3\x85", r);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	utf8free(nullptr, r);
+}
+
+TEST_F(Utf8Alloc, NormalizeInvalidFlag)
+{
+	const char* c = "Text";
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(nullptr, utf8normalize_alloc(c, strlen(c), 0, &counting, nullptr, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, errors);
+	EXPECT_EQ(allocations, deallocations);
+}
+
+TEST_F(Utf8Alloc, GrowsGeometrically)
+{
+	std::string c;
+	std::string e;
+	size_t s = 0;
+	int32_t errors = UTF8_ERR_NONE;
+
+	for (size_t i = 0; i < 4096; ++i)
+	{
+		c += "\xCE\x90";
+		e += "\xCE\x99\xCC\x88\xCC\x81";
+	}
+
+	char* r = utf8toupper_alloc(c.c_str(), c.length(), UTF8_LOCALE_DEFAULT, &counting, &s, &errors);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(e.length(), s);
+	EXPECT_EQ(e, r);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	utf8free(&counting, r);
+	EXPECT_EQ(1, allocations);
+	EXPECT_EQ(2, reallocations);
+	EXPECT_EQ(1, deallocations);
+}
+
+TEST_F(Utf8Alloc, Arena)
+{
+	const char* c = "\xCE\x90\xCE\x90\xCE\x90\xCE\x90\xCE\x90\xCE\x90\xCE\x90\xCE\x90\xCE\x90\xCE\x90\xCE\x90\xCE\x90";
+	size_t s = 0;
+	int32_t errors = UTF8_ERR_NONE;
+
+	char* r = utf8toupper_alloc(c, strlen(c), UTF8_LOCALE_DEFAULT, &arena, &s, &errors);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(72, s);
+	EXPECT_UTF8EQ("\xCE\x99\xCC\x88\xCC\x81\xCE\x99\xCC\x88\xCC\x81\xCE\x99\xCC\x88\xCC\x81\xCE\x99\xCC\x88\xCC\x81\xCE\x99\xCC\x88\xCC\x81\xCE\x99\xCC\x88\xCC\x81\xCE\x99\xCC\x88\xCC\x81\xCE\x99\xCC\x88\xCC\x81\xCE\x99\xCC\x88\xCC\x81\xCE\x99\xCC\x88\xCC\x81\xCE\x99\xCC\x88\xCC\x81\xCE\x99\xCC\x88\xCC\x81", r);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	EXPECT_TRUE(r >= arena_data && r + s < arena_data + sizeof(arena_data));
+
+	utf8free(&arena, r);
+}
+
+TEST_F(Utf8Alloc, OutOfMemory)
+{
+	const char* c = "Text";
+	size_t s = 1337;
+	int32_t errors = UTF8_ERR_NONE;
+
+	fail_after = 0;
+
+	EXPECT_EQ(nullptr, utf8tolower_alloc(c, strlen(c), UTF8_LOCALE_DEFAULT, &counting, &s, &errors));
+	EXPECT_EQ(0, s);
+	EXPECT_ERROREQ(UTF8_ERR_OUT_OF_MEMORY, errors);
+}
+
+TEST_F(Utf8Alloc, OutOfMemoryWhileGrowing)
+{
+	std::string c(64, 'a');
+	int32_t errors = UTF8_ERR_NONE;
+
+	for (size_t i = 0; i < 64; ++i)
+	{
+		c += "\xC5\x89";
+	}
+
+	fail_after = 1;
+
+	EXPECT_EQ(nullptr, utf8toupper_alloc(c.c_str(), c.length(), UTF8_LOCALE_DEFAULT, &counting, nullptr, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_OUT_OF_MEMORY, errors);
+	EXPECT_EQ(1, allocations);
+	EXPECT_EQ(1, deallocations);
+}
+
+TEST_F(Utf8Alloc, InvalidData)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(nullptr, utf8toupper_alloc(nullptr, 1, UTF8_LOCALE_DEFAULT, &counting, nullptr, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+	EXPECT_EQ(allocations, deallocations);
+}
+
+TEST_F(Utf8Alloc, FreeNull)
+{
+	utf8free(nullptr, nullptr);
+	utf8free(&counting, nullptr);
+
+	EXPECT_EQ(0, deallocations);
+}
+
+#endif
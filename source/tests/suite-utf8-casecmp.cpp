@@ -0,0 +1,207 @@
+#include "tests-base.hpp"
+
+#include "../helpers/helpers-casemapping.hpp"
+#include "../helpers/helpers-errors.hpp"
+#include "../helpers/helpers-random.hpp"
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+TEST(Utf8CaseCmp, Equal)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casecmp("Content-Type", 12, "content-type", 12, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, Less)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_GT(0, utf8casecmp("Apple", 5, "banana", 6, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, Greater)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_LT(0, utf8casecmp("cherry", 6, "BANANA", 6, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, Prefix)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_GT(0, utf8casecmp("Accept", 6, "accept-encoding", 15, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_LT(0, utf8casecmp("ACCEPT-ENCODING", 15, "accept", 6, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, Empty)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casecmp("", 0, "", 0, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_GT(0, utf8casecmp("", 0, "a", 1, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, BasicLatinBlock)
+{
+	const char* l = "the quick brown fox jumps over the lazy dog";
+	const char* r = "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG";
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casecmp(l, strlen(l), r, strlen(r), UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, BasicLatinBlockDifference)
+{
+	const char* l = "the quick brown fox jumps over the lazy dog";
+	const char* r = "THE QUICK BROWN FOX JUMPS OVER THE LAZY CAT";
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_LT(0, utf8casecmp(l, strlen(l), r, strlen(r), UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_GT(0, utf8casecmp(r, strlen(r), l, strlen(l), UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, BasicLatinPunctuation)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_GT(0, utf8casecmp("abcdefghijklmnopq[", 18, "ABCDEFGHIJKLMNOPQa", 18, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_GT(0, utf8casecmp("[", 1, "a", 1, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, MultipleCodePoints)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casecmp("Stra\xC3\x9F" "e", 7, "STRASSE", 7, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_EQ(0, utf8casecmp("ss", 2, "\xC3\x9F", 2, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_EQ(0, utf8casecmp("\xC3\x9F", 2, "\xE1\xBA\x9E", 3, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_GT(0, utf8casecmp("s", 1, "\xC3\x9F", 2, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_LT(0, utf8casecmp("\xC3\x9F", 2, "sr", 2, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, Greek)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casecmp("\xCE\x9F\xCE\x94\xCE\x9F\xCE\xA3", 8, "\xCE\xBF\xCE\xB4\xCE\xBF\xCF\x82", 8, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, Turkish)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_NE(0, utf8casecmp("I", 1, "i", 1, UTF8_LOCALE_TURKISH_AND_AZERI_LATIN, &errors));
+	EXPECT_EQ(0, utf8casecmp("I", 1, "\xC4\xB1", 2, UTF8_LOCALE_TURKISH_AND_AZERI_LATIN, &errors));
+	EXPECT_EQ(0, utf8casecmp("\xC4\xB0", 2, "i", 1, UTF8_LOCALE_TURKISH_AND_AZERI_LATIN, &errors));
+	EXPECT_EQ(0, utf8casecmp("I", 1, "i", 1, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, TurkishBasicLatinBlock)
+{
+	const char* l = "DIYARBAKIR VE ISTANBUL";
+	const char* r = "d\xC4\xB1yarbak\xC4\xB1r ve \xC4\xB1stanbul";
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casecmp(l, strlen(l), r, strlen(r), UTF8_LOCALE_TURKISH_AND_AZERI_LATIN, &errors));
+	EXPECT_NE(0, utf8casecmp(l, strlen(l), r, strlen(r), UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, InvalidSequence)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casecmp("a\xFF", 2, "A\xEF\xBF\xBD", 4, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, InvalidData)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casecmp(nullptr, 4, "abcd", 4, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+}
+
+TEST(Utf8CaseCmp, InvalidLocale)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casecmp("a", 1, "b", 1, 7781, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_LOCALE, errors);
+}
+
+TEST(Utf8CaseCmp, Length)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8ncasecmp("Accept", 6, "accept-encoding", 15, 6, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_GT(0, utf8ncasecmp("Accept", 6, "accept-encoding", 15, 7, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_EQ(0, utf8ncasecmp("abc", 3, "xyz", 3, 0, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, LengthCodePoints)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8ncasecmp("\xCE\x9F\xCE\x94\xCE\x91", 6, "\xCE\xBF\xCE\xB4\xCE\xBF", 6, 2, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_EQ(0, utf8ncasecmp("\xC3\x9F", 2, "st", 2, 1, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_GT(0, utf8ncasecmp("\xC3\x9F", 2, "st", 2, 2, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, LengthBasicLatinBlock)
+{
+	const char* l = "the quick brown fox jumps over the lazy dog";
+	const char* r = "THE QUICK BROWN FOX JUMPS OVER THE LAZY CAT";
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8ncasecmp(l, strlen(l), r, strlen(r), 40, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_LT(0, utf8ncasecmp(l, strlen(l), r, strlen(r), 41, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseCmp, RandomMatchesCaseFold)
+{
+	helpers::Random random(0x68E31DA4);
+	const char* f[] = {
+		"a", "A", "I", "i", "s", "S", " ", "the Quick brown fox ", "THE QUICK BROWN FOX ",
+		"\xC3\x9F", "\xE1\xBA\x9E", "\xCE\xA3", "\xCF\x83", "\xCF\x82", "\xC4\xB0", "\xC4\xB1",
+		"\xEF\xAC\x80", "ff", "\xC5\x89", "\xCA\xBCn", "\xE2\x84\xAA", "k", "\xF0\x90\x90\x80", "\xFF"
+	};
+	const size_t locales[] = { UTF8_LOCALE_DEFAULT, UTF8_LOCALE_LITHUANIAN, UTF8_LOCALE_TURKISH_AND_AZERI_LATIN };
+
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		std::string l = random.fragments(f, sizeof(f) / sizeof(f[0]), random.next(40));
+		std::string r = random.fragments(f, sizeof(f) / sizeof(f[0]), random.next(40));
+		size_t locale = locales[i % 3];
+		int32_t errors;
+
+		if (i % 4 == 0)
+		{
+			r = l;
+		}
+
+		int expected = helpers::casefold(l, locale).compare(helpers::casefold(r, locale));
+		int actual = utf8casecmp(l.c_str(), l.length(), r.c_str(), r.length(), locale, &errors);
+
+		EXPECT_EQ((expected > 0) - (expected < 0), (actual > 0) - (actual < 0)) << "Input " << i;
+	}
+}
+
+#endif
\ No newline at end of file
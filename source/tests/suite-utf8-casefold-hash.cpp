@@ -0,0 +1,201 @@
+#include "tests-base.hpp"
+
+#include "../helpers/helpers-errors.hpp"
+#include "../helpers/helpers-random.hpp"
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+static uint64_t hash(const std::string& input, size_t locale)
+{
+	int32_t errors;
+
+	return utf8casefold_hash(input.c_str(), input.length(), locale, 0, &errors);
+}
+
+TEST(Utf8CaseFoldHash, Equal)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(
+		utf8casefold_hash("Content-Type", 12, UTF8_LOCALE_DEFAULT, 0, &errors),
+		utf8casefold_hash("content-type", 12, UTF8_LOCALE_DEFAULT, 0, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseFoldHash, Different)
+{
+	EXPECT_NE(hash("content-type", UTF8_LOCALE_DEFAULT), hash("content-typf", UTF8_LOCALE_DEFAULT));
+	EXPECT_NE(hash("content-type", UTF8_LOCALE_DEFAULT), hash("content-types", UTF8_LOCALE_DEFAULT));
+	EXPECT_NE(hash("content-type", UTF8_LOCALE_DEFAULT), hash("content-typ", UTF8_LOCALE_DEFAULT));
+}
+
+TEST(Utf8CaseFoldHash, TrailingZeroes)
+{
+	EXPECT_NE(hash(std::string("abc"), UTF8_LOCALE_DEFAULT), hash(std::string("abc\0", 4), UTF8_LOCALE_DEFAULT));
+	EXPECT_NE(hash(std::string("abc\0", 4), UTF8_LOCALE_DEFAULT), hash(std::string("abc\0\0", 5), UTF8_LOCALE_DEFAULT));
+}
+
+TEST(Utf8CaseFoldHash, Empty)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(hash("", UTF8_LOCALE_DEFAULT), utf8casefold_hash("", 0, UTF8_LOCALE_DEFAULT, 0, &errors));
+	EXPECT_NE(hash("", UTF8_LOCALE_DEFAULT), hash(std::string("\0", 1), UTF8_LOCALE_DEFAULT));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseFoldHash, Seed)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_NE(
+		utf8casefold_hash("Accept", 6, UTF8_LOCALE_DEFAULT, 0, &errors),
+		utf8casefold_hash("Accept", 6, UTF8_LOCALE_DEFAULT, 1, &errors));
+	EXPECT_EQ(
+		utf8casefold_hash("Accept", 6, UTF8_LOCALE_DEFAULT, 0x8BADF00D, &errors),
+		utf8casefold_hash("ACCEPT", 6, UTF8_LOCALE_DEFAULT, 0x8BADF00D, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8CaseFoldHash, BasicLatinBlocks)
+{
+	EXPECT_EQ(
+		hash("The Quick Brown Fox Jumps Over The Lazy Dog. The Quick Brown Fox Jumps Over The Lazy Dog.", UTF8_LOCALE_DEFAULT),
+		hash("the quick brown fox jumps over the lazy dog. the quick brown fox jumps over the lazy dog.", UTF8_LOCALE_DEFAULT));
+	EXPECT_NE(
+		hash("The Quick Brown Fox Jumps Over The Lazy Dog. The Quick Brown Fox Jumps Over The Lazy Dog.", UTF8_LOCALE_DEFAULT),
+		hash("the quick brown fox jumps over the lazy dog. the quick brown fox jumps over the lazy cat.", UTF8_LOCALE_DEFAULT));
+}
+
+TEST(Utf8CaseFoldHash, BasicLatinBlocksMixed)
+{
+	// U+00E9 at different offsets within and across blocks
+
+	EXPECT_EQ(
+		hash("Caf\xC3\xA9 Au Lait, Cr\xC3\xA8me Br\xC3\xBBl\xC3\xA9" "e And Other Desserts", UTF8_LOCALE_DEFAULT),
+		hash("CAF\xC3\x89 AU LAIT, CR\xC3\x88ME BR\xC3\x9BL\xC3\x89" "E AND OTHER DESSERTS", UTF8_LOCALE_DEFAULT));
+	EXPECT_EQ(
+		hash("0123456789abcdef\xC3\xA9" "0123456789abcdef", UTF8_LOCALE_DEFAULT),
+		hash("0123456789ABCDEF\xC3\x89" "0123456789ABCDEF", UTF8_LOCALE_DEFAULT));
+}
+
+TEST(Utf8CaseFoldHash, SharpS)
+{
+	EXPECT_EQ(hash("Stra\xC3\x9F" "e", UTF8_LOCALE_DEFAULT), hash("STRASSE", UTF8_LOCALE_DEFAULT));
+	EXPECT_EQ(hash("Stra\xE1\xBA\x9E" "e", UTF8_LOCALE_DEFAULT), hash("strasse", UTF8_LOCALE_DEFAULT));
+}
+
+TEST(Utf8CaseFoldHash, GreekSigma)
+{
+	EXPECT_EQ(hash("\xCE\xA3\xCE\xA3", UTF8_LOCALE_DEFAULT), hash("\xCF\x83\xCF\x82", UTF8_LOCALE_DEFAULT));
+}
+
+TEST(Utf8CaseFoldHash, Turkish)
+{
+	EXPECT_EQ(hash("I", UTF8_LOCALE_TURKISH_AND_AZERI_LATIN), hash("\xC4\xB1", UTF8_LOCALE_TURKISH_AND_AZERI_LATIN));
+	EXPECT_EQ(hash("\xC4\xB0", UTF8_LOCALE_TURKISH_AND_AZERI_LATIN), hash("i", UTF8_LOCALE_TURKISH_AND_AZERI_LATIN));
+	EXPECT_NE(hash("I", UTF8_LOCALE_TURKISH_AND_AZERI_LATIN), hash("i", UTF8_LOCALE_TURKISH_AND_AZERI_LATIN));
+	EXPECT_EQ(hash("I", UTF8_LOCALE_DEFAULT), hash("i", UTF8_LOCALE_DEFAULT));
+}
+
+TEST(Utf8CaseFoldHash, TurkishBasicLatinBlocks)
+{
+	EXPECT_EQ(
+		hash("ISTANBUL VE IZMIR ARASINDA", UTF8_LOCALE_TURKISH_AND_AZERI_LATIN),
+		hash("\xC4\xB1stanbul ve \xC4\xB1zm\xC4\xB1r aras\xC4\xB1nda", UTF8_LOCALE_TURKISH_AND_AZERI_LATIN));
+	EXPECT_NE(
+		hash("ISTANBUL VE IZMIR ARASINDA", UTF8_LOCALE_TURKISH_AND_AZERI_LATIN),
+		hash("istanbul ve izmir arasinda", UTF8_LOCALE_TURKISH_AND_AZERI_LATIN));
+}
+
+TEST(Utf8CaseFoldHash, CaseFolded)
+{
+	const char* i = "Die Stra\xC3\x9F" "e ist \xCE\x9F\xCE\x94\xCE\x8C\xCE\xA3 in \xE1\xBA\x9E" "chrift";
+	std::vector<char> o(256);
+	int32_t errors;
+
+	size_t l = utf8casefold(i, strlen(i), &o[0], o.size(), UTF8_LOCALE_DEFAULT, &errors);
+
+	EXPECT_EQ(hash(i, UTF8_LOCALE_DEFAULT), hash(std::string(&o[0], l), UTF8_LOCALE_DEFAULT));
+}
+
+TEST(Utf8CaseFoldHash, MatchesCaseCmp)
+{
+	struct {
+		const char* left;
+		const char* right;
+		size_t locale;
+	} t[] = {
+		{ "Stra\xC3\x9F" "e", "STRASSE", UTF8_LOCALE_DEFAULT },
+		{ "\xEF\xAC\x80", "FF", UTF8_LOCALE_DEFAULT },
+		{ "\xE2\x84\xAA", "k", UTF8_LOCALE_DEFAULT },
+		{ "\xC5\x89", "\xCA\xBCN", UTF8_LOCALE_DEFAULT },
+		{ "\xCE\x9F\xCE\x94\xCE\x9F\xCE\xA3", "\xCE\xBF\xCE\xB4\xCE\xBF\xCF\x82", UTF8_LOCALE_DEFAULT },
+		{ "\xCE\xBF\xCE\xB4\xCE\xBF\xCF\x83", "\xCE\xBF\xCE\xB4\xCE\xBF\xCF\x82", UTF8_LOCALE_DEFAULT },
+		{ "I", "\xC4\xB1", UTF8_LOCALE_TURKISH_AND_AZERI_LATIN },
+		{ "\xC4\xB0", "i", UTF8_LOCALE_TURKISH_AND_AZERI_LATIN },
+		{ "\xF0\x90\x90\x80", "\xF0\x90\x90\xA8", UTF8_LOCALE_DEFAULT }
+	};
+
+	for (size_t i = 0; i < sizeof(t) / sizeof(t[0]); ++i)
+	{
+		EXPECT_EQ(0, utf8casecmp(t[i].left, strlen(t[i].left), t[i].right, strlen(t[i].right), t[i].locale, nullptr)) << "Pair " << i;
+		EXPECT_EQ(hash(t[i].left, t[i].locale), hash(t[i].right, t[i].locale)) << "Pair " << i;
+	}
+}
+
+TEST(Utf8CaseFoldHash, Random)
+{
+	helpers::Random random(0x2F6B91C7);
+	const char* f[] = {
+		"a", "A", "I", "i", "s", "S", " ", "the Quick brown fox ", "THE QUICK BROWN FOX ",
+		"\xC3\x9F", "\xE1\xBA\x9E", "\xCE\xA3", "\xCF\x83", "\xCF\x82", "\xC4\xB0", "\xC4\xB1",
+		"\xEF\xAC\x80", "ff", "\xC5\x89", "\xCA\xBCn", "\xE2\x84\xAA", "k", "\xF0\x90\x90\x80", "\xFF"
+	};
+	size_t locales[] = { UTF8_LOCALE_DEFAULT, UTF8_LOCALE_TURKISH_AND_AZERI_LATIN };
+
+	for (size_t i = 0; i < 5000; ++i)
+	{
+		size_t locale = locales[i % 2];
+		std::string left = random.fragments(f, sizeof(f) / sizeof(f[0]), random.next(40));
+		std::string right = random.fragments(f, sizeof(f) / sizeof(f[0]), random.next(40));
+
+		if (utf8casecmp(left.c_str(), left.length(), right.c_str(), right.length(), locale, nullptr) == 0)
+		{
+			EXPECT_EQ(hash(left, locale), hash(right, locale));
+		}
+		else
+		{
+			EXPECT_NE(hash(left, locale), hash(right, locale));
+		}
+
+		// The same text with a different case always has the same hash
+
+		std::vector<char> upper(left.length() * 4 + 4);
+		size_t l = left.empty() ? 0 : utf8toupper(left.c_str(), left.length(), &upper[0], upper.size(), locale, nullptr);
+		std::string uppercase(upper.begin(), upper.begin() + l);
+
+		if (utf8casecmp(left.c_str(), left.length(), uppercase.c_str(), uppercase.length(), locale, nullptr) == 0)
+		{
+			EXPECT_EQ(hash(left, locale), hash(uppercase, locale));
+		}
+	}
+}
+
+TEST(Utf8CaseFoldHash, InvalidData)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casefold_hash(nullptr, 4, UTF8_LOCALE_DEFAULT, 0, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+}
+
+TEST(Utf8CaseFoldHash, InvalidLocale)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casefold_hash("Accept", 6, UTF8_LOCALE_MAXIMUM, 0, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_LOCALE, errors);
+}
+
+#endif
\ No newline at end of file
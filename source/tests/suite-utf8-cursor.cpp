@@ -0,0 +1,309 @@
+#include "tests-base.hpp"
+
+#include "../helpers/helpers-random.hpp"
+#include "../helpers/helpers-strings.hpp"
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+TEST(Utf8Cursor, Init)
+{
+	const char* i = "Cursor";
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i, strlen(i));
+
+	EXPECT_EQ(i, c.text);
+	EXPECT_EQ(6, c.textSize);
+	EXPECT_EQ(0, c.offset);
+	EXPECT_EQ(0, c.index);
+}
+
+TEST(Utf8Cursor, InitInvalidData)
+{
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, nullptr, 12);
+
+	EXPECT_EQ(nullptr, c.text);
+	EXPECT_EQ(0, c.textSize);
+	EXPECT_EQ(0, utf8cursor_next(&c));
+	EXPECT_EQ(0, utf8cursor_prev(&c));
+	EXPECT_EQ(0, utf8cursor_advance(&c, 3));
+	EXPECT_EQ(0, utf8cursor_codepoint(&c));
+}
+
+TEST(Utf8Cursor, Next)
+{
+	const char* i = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i, strlen(i));
+
+	EXPECT_EQ(1, utf8cursor_next(&c));
+	EXPECT_EQ(1, c.offset);
+	EXPECT_EQ(1, c.index);
+
+	EXPECT_EQ(1, utf8cursor_next(&c));
+	EXPECT_EQ(3, c.offset);
+	EXPECT_EQ(2, c.index);
+
+	EXPECT_EQ(1, utf8cursor_next(&c));
+	EXPECT_EQ(6, c.offset);
+	EXPECT_EQ(3, c.index);
+
+	EXPECT_EQ(1, utf8cursor_next(&c));
+	EXPECT_EQ(10, c.offset);
+	EXPECT_EQ(4, c.index);
+
+	EXPECT_EQ(0, utf8cursor_next(&c));
+	EXPECT_EQ(10, c.offset);
+	EXPECT_EQ(4, c.index);
+}
+
+TEST(Utf8Cursor, NextEmpty)
+{
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, "", 0);
+
+	EXPECT_EQ(0, utf8cursor_next(&c));
+	EXPECT_EQ(0, c.offset);
+	EXPECT_EQ(0, c.index);
+}
+
+TEST(Utf8Cursor, Prev)
+{
+	const char* i = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i, strlen(i));
+	EXPECT_EQ(4, utf8cursor_advance(&c, 10));
+
+	EXPECT_EQ(1, utf8cursor_prev(&c));
+	EXPECT_EQ(6, c.offset);
+	EXPECT_EQ(3, c.index);
+
+	EXPECT_EQ(1, utf8cursor_prev(&c));
+	EXPECT_EQ(3, c.offset);
+	EXPECT_EQ(2, c.index);
+
+	EXPECT_EQ(1, utf8cursor_prev(&c));
+	EXPECT_EQ(1, c.offset);
+	EXPECT_EQ(1, c.index);
+
+	EXPECT_EQ(1, utf8cursor_prev(&c));
+	EXPECT_EQ(0, c.offset);
+	EXPECT_EQ(0, c.index);
+
+	EXPECT_EQ(0, utf8cursor_prev(&c));
+	EXPECT_EQ(0, c.offset);
+	EXPECT_EQ(0, c.index);
+}
+
+TEST(Utf8Cursor, PrevInvalidSequences)
+{
+	const char* i = "\xE2\x82" "\x80\x80" "\xFE" "\xC3";
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i, strlen(i));
+	EXPECT_EQ(4, utf8cursor_advance(&c, 10));
+	EXPECT_EQ(6, c.offset);
+
+	EXPECT_EQ(1, utf8cursor_prev(&c));
+	EXPECT_EQ(5, c.offset);
+
+	EXPECT_EQ(1, utf8cursor_prev(&c));
+	EXPECT_EQ(4, c.offset);
+
+	EXPECT_EQ(1, utf8cursor_prev(&c));
+	EXPECT_EQ(3, c.offset);
+
+	EXPECT_EQ(1, utf8cursor_prev(&c));
+	EXPECT_EQ(0, c.offset);
+
+	EXPECT_EQ(0, c.index);
+}
+
+TEST(Utf8Cursor, PrevContinuationBytes)
+{
+	std::string i = "\xC3" + std::string(1000, '\x80');
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i.c_str(), i.length());
+	EXPECT_EQ(1000, utf8cursor_advance(&c, 2000));
+
+	while (utf8cursor_prev(&c))
+	{
+	}
+
+	EXPECT_EQ(0, c.offset);
+	EXPECT_EQ(0, c.index);
+}
+
+TEST(Utf8Cursor, AdvanceForward)
+{
+	const char* i = "\xCE\xBC\xCE\xB5\xCF\x84\xCF\x81\xE1\xBD\xB1\xCE\xB5\xCE\xB9";
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i, strlen(i));
+
+	EXPECT_EQ(3, utf8cursor_advance(&c, 3));
+	EXPECT_EQ(6, c.offset);
+	EXPECT_EQ(3, c.index);
+
+	EXPECT_EQ(2, utf8cursor_advance(&c, 2));
+	EXPECT_EQ(11, c.offset);
+	EXPECT_EQ(5, c.index);
+}
+
+TEST(Utf8Cursor, AdvanceForwardPastEnd)
+{
+	const char* i = "\xCE\xBC\xCE\xB5\xCF\x84\xCF\x81\xE1\xBD\xB1\xCE\xB5\xCE\xB9";
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i, strlen(i));
+	utf8cursor_next(&c);
+
+	EXPECT_EQ(6, utf8cursor_advance(&c, 100));
+	EXPECT_EQ(15, c.offset);
+	EXPECT_EQ(7, c.index);
+
+	EXPECT_EQ(0, utf8cursor_advance(&c, 1));
+	EXPECT_EQ(15, c.offset);
+	EXPECT_EQ(7, c.index);
+}
+
+TEST(Utf8Cursor, AdvanceForwardToEnd)
+{
+	const char* i = "Cursor";
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i, strlen(i));
+
+	EXPECT_EQ(6, utf8cursor_advance(&c, 6));
+	EXPECT_EQ(6, c.offset);
+	EXPECT_EQ(6, c.index);
+}
+
+TEST(Utf8Cursor, AdvanceBackward)
+{
+	const char* i = "\xCE\xBC\xCE\xB5\xCF\x84\xCF\x81\xE1\xBD\xB1\xCE\xB5\xCE\xB9";
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i, strlen(i));
+	utf8cursor_advance(&c, 7);
+
+	EXPECT_EQ(-4, utf8cursor_advance(&c, -4));
+	EXPECT_EQ(6, c.offset);
+	EXPECT_EQ(3, c.index);
+}
+
+TEST(Utf8Cursor, AdvanceBackwardPastStart)
+{
+	const char* i = "\xCE\xBC\xCE\xB5\xCF\x84\xCF\x81\xE1\xBD\xB1\xCE\xB5\xCE\xB9";
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i, strlen(i));
+	utf8cursor_advance(&c, 5);
+
+	EXPECT_EQ(-5, utf8cursor_advance(&c, -100));
+	EXPECT_EQ(0, c.offset);
+	EXPECT_EQ(0, c.index);
+
+	EXPECT_EQ(0, utf8cursor_advance(&c, -1));
+}
+
+TEST(Utf8Cursor, AdvanceZero)
+{
+	const char* i = "Cursor";
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i, strlen(i));
+	utf8cursor_next(&c);
+
+	EXPECT_EQ(0, utf8cursor_advance(&c, 0));
+	EXPECT_EQ(1, c.offset);
+	EXPECT_EQ(1, c.index);
+}
+
+TEST(Utf8Cursor, Codepoint)
+{
+	const char* i = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i, strlen(i));
+
+	EXPECT_CPEQ(0x61, utf8cursor_codepoint(&c));
+	utf8cursor_next(&c);
+	EXPECT_CPEQ(0xE9, utf8cursor_codepoint(&c));
+	utf8cursor_next(&c);
+	EXPECT_CPEQ(0x20AC, utf8cursor_codepoint(&c));
+	utf8cursor_next(&c);
+	EXPECT_CPEQ(0x1F600, utf8cursor_codepoint(&c));
+	utf8cursor_next(&c);
+	EXPECT_CPEQ(0, utf8cursor_codepoint(&c));
+}
+
+TEST(Utf8Cursor, CodepointInvalid)
+{
+	const char* i = "\xE0\x80" "A" "\xC0\xAF" "\x80";
+	utf8cursor_t c;
+
+	utf8cursor_init(&c, i, strlen(i));
+
+	EXPECT_CPEQ(0xFFFD, utf8cursor_codepoint(&c));
+	utf8cursor_next(&c);
+	EXPECT_CPEQ(0x41, utf8cursor_codepoint(&c));
+	utf8cursor_next(&c);
+	EXPECT_CPEQ(0xFFFD, utf8cursor_codepoint(&c));
+	utf8cursor_next(&c);
+	EXPECT_CPEQ(0xFFFD, utf8cursor_codepoint(&c));
+	EXPECT_EQ(1, utf8cursor_next(&c));
+	EXPECT_EQ(0, utf8cursor_next(&c));
+}
+
+TEST(Utf8Cursor, MatchesSeekRandom)
+{
+	helpers::Random random(0x9E3779B9);
+	const char* f[] = {
+		"a", "Z", " ", "\xC3\xA9", "\xCE\xBA", "\xE2\x82\xAC", "\xE6\xA3\x80", "\xF0\x9F\x98\x80",
+		"\x80", "\xBF", "\xC3", "\xE2\x82", "\xF0\x9F", "\xF8\x88\x80\x80\x80", "\xFC\x84\x80\x80\x80\x80", "\xFE", "\xFF", "\xC0\xAF"
+	};
+
+	for (size_t n = 0; n < 500; ++n)
+	{
+		std::string i = random.fragments(f, sizeof(f) / sizeof(f[0]), random.next(80));
+		const char* s = i.c_str();
+		size_t l = i.length();
+		std::vector<size_t> offsets;
+		utf8cursor_t c;
+
+		utf8cursor_init(&c, s, l);
+
+		do
+		{
+			EXPECT_EQ(utf8seek(s, l, s, (off_t)c.index, SEEK_SET) - s, (ptrdiff_t)c.offset) << "Index " << c.index;
+			offsets.push_back(c.offset);
+		}
+		while (utf8cursor_next(&c));
+
+		while (utf8cursor_prev(&c))
+		{
+			ASSERT_LT(c.index, offsets.size());
+			EXPECT_EQ(offsets[c.index], c.offset);
+		}
+
+		for (size_t m = 0; m < 20; ++m)
+		{
+			off_t delta = (off_t)random.next(41) - 20;
+			size_t index = c.index;
+			off_t moved = utf8cursor_advance(&c, delta);
+
+			EXPECT_EQ(index + moved, c.index);
+			ASSERT_LT(c.index, offsets.size());
+			EXPECT_EQ(offsets[c.index], c.offset);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,220 @@
+#include "tests-base.hpp"
+
+#include "../helpers/helpers-strings.hpp"
+
+/*
+	These cases only run when the library is built with forms or case
+	mappings excluded, e.g. -Dutf8_exclude="UTF8_EXCLUDE_NFD=1 UTF8_EXCLUDE_NFC=1"
+*/
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+#if UTF8_EXCLUDE_NFD
+TEST(Utf8Exclude, NormalizeDecompose)
+{
+	const char* c = "abcdefgh\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9 xyz";
+	const size_t s = 255;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8normalize(c, strlen(c), b, s, UTF8_NORMALIZE_DECOMPOSE, &errors));
+	EXPECT_UTF8EQ("", b);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, errors);
+}
+
+TEST(Utf8Exclude, NormalizeExDecompose)
+{
+	const char* c = "abcdefgh\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9 xyz";
+	const size_t s = 8;
+	char b[256] = { 0 };
+
+	utf8result_t r = utf8normalize_ex(c, strlen(c), b, s, UTF8_NORMALIZE_DECOMPOSE);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_UTF8EQ("", b);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, r.error);
+}
+
+TEST(Utf8Exclude, NormalizeExDecomposeAmountOfBytes)
+{
+	const char* c = "abcdefgh\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9 xyz";
+
+	utf8result_t r = utf8normalize_ex(c, strlen(c), nullptr, 0, UTF8_NORMALIZE_DECOMPOSE);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, r.error);
+}
+
+TEST(Utf8Exclude, NormalizeAllocDecompose)
+{
+	const char* c = "abcdefgh\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9 xyz";
+	size_t l = 12;
+	int32_t errors = UTF8_ERR_NONE;
+
+	char* o = utf8normalize_alloc(c, strlen(c), UTF8_NORMALIZE_DECOMPOSE, nullptr, &l, &errors);
+	EXPECT_EQ(nullptr, o);
+	EXPECT_EQ(0, l);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, errors);
+}
+#endif
+
+#if UTF8_EXCLUDE_NFC
+TEST(Utf8Exclude, NormalizeExCompose)
+{
+	const char* c = "abcdefghE\xCC\x81\xCC\x81\xCC\x81\xCC\x81 xyz";
+	const size_t s = 8;
+	char b[256] = { 0 };
+
+	utf8result_t r = utf8normalize_ex(c, strlen(c), b, s, UTF8_NORMALIZE_COMPOSE);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_UTF8EQ("", b);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, r.error);
+}
+#endif
+
+#if UTF8_EXCLUDE_NFKD
+TEST(Utf8Exclude, NormalizeExCompatibilityDecompose)
+{
+	const char* c = "abcdefgh\xEF\xAC\x80\xEF\xAC\x80\xEF\xAC\x80 xyz";
+	const size_t s = 8;
+	char b[256] = { 0 };
+
+	utf8result_t r = utf8normalize_ex(c, strlen(c), b, s, UTF8_NORMALIZE_DECOMPOSE | UTF8_NORMALIZE_COMPATIBILITY);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_UTF8EQ("", b);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, r.error);
+}
+#endif
+
+#if UTF8_EXCLUDE_NFKC
+TEST(Utf8Exclude, NormalizeExCompatibilityCompose)
+{
+	const char* c = "abcdefgh\xEF\xAC\x80\xEF\xAC\x80\xEF\xAC\x80 xyz";
+	const size_t s = 8;
+	char b[256] = { 0 };
+
+	utf8result_t r = utf8normalize_ex(c, strlen(c), b, s, UTF8_NORMALIZE_COMPOSE | UTF8_NORMALIZE_COMPATIBILITY);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_UTF8EQ("", b);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, r.error);
+}
+#endif
+
+#if UTF8_EXCLUDE_UPPERCASE
+TEST(Utf8Exclude, ToUpper)
+{
+	const char* c = "Stra\xC3\x9F" "e";
+	const size_t s = 255;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8toupper(c, strlen(c), b, s, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_UTF8EQ("", b);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, errors);
+}
+
+TEST(Utf8Exclude, ToUpperInPlace)
+{
+	char t[] = "Stra\xC3\x9F" "e";
+
+	utf8result_t r = utf8toupper_inplace(t, strlen(t), UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_UTF8EQ("Stra\xC3\x9F" "e", t);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, r.error);
+}
+#endif
+
+#if UTF8_EXCLUDE_LOWERCASE
+TEST(Utf8Exclude, ToLowerEx)
+{
+	const char* c = "\xCE\x9F\xCE\x94\xCE\x9F\xCE\xA3";
+	const size_t s = 255;
+	char b[256] = { 0 };
+
+	utf8result_t r = utf8tolower_ex(c, strlen(c), b, s, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_UTF8EQ("", b);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, r.error);
+}
+
+TEST(Utf8Exclude, ToLowerInPlace)
+{
+	char t[] = "ABC";
+
+	utf8result_t r = utf8tolower_inplace(t, strlen(t), UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_UTF8EQ("ABC", t);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, r.error);
+}
+#endif
+
+#if UTF8_EXCLUDE_TITLECASE
+TEST(Utf8Exclude, ToTitle)
+{
+	const char* c = "the quick brown fox";
+	const size_t s = 255;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8totitle(c, strlen(c), b, s, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_UTF8EQ("", b);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, errors);
+}
+#endif
+
+#if UTF8_EXCLUDE_CASEFOLDING
+TEST(Utf8Exclude, CaseFold)
+{
+	const char* c = "Stra\xC3\x9F" "e";
+	const size_t s = 255;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casefold(c, strlen(c), b, s, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_UTF8EQ("", b);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, errors);
+}
+
+TEST(Utf8Exclude, CaseFoldInPlace)
+{
+	char t[] = "ABC";
+
+	utf8result_t r = utf8casefold_inplace(t, strlen(t), UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_UTF8EQ("ABC", t);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, r.error);
+}
+
+TEST(Utf8Exclude, CaseFoldInPlaceInvalidData)
+{
+	utf8result_t r = utf8casefold_inplace(nullptr, 12, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, r.error);
+}
+
+TEST(Utf8Exclude, CaseCmp)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casecmp("Content-Type", 12, "content-typf", 12, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, errors);
+}
+
+TEST(Utf8Exclude, CaseFoldHash)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8casefold_hash("Content-Type", 12, UTF8_LOCALE_DEFAULT, 0, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, errors);
+}
+#endif
+
+#endif
\ No newline at end of file
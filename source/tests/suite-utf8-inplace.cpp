@@ -0,0 +1,245 @@
+#include "tests-base.hpp"
+
+#include "../helpers/helpers-random.hpp"
+#include "../helpers/helpers-strings.hpp"
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+template <typename InPlace, typename Transform>
+static std::string fallback(const std::string& input, InPlace inplace, Transform transform, size_t locale)
+{
+	std::vector<char> text(input.begin(), input.end());
+	text.push_back(0);
+
+	utf8result_t result = inplace(&text[0], input.length(), locale);
+	EXPECT_LE(result.produced, result.consumed);
+
+	std::string output(&text[0], result.produced);
+
+	if (result.error == UTF8_ERR_NOT_ENOUGH_SPACE)
+	{
+		std::vector<char> rest((input.length() - result.consumed) * 4 + 4);
+
+		utf8result_t remaining = transform(&text[result.consumed], input.length() - result.consumed, &rest[0], rest.size(), locale);
+		EXPECT_ERROREQ(UTF8_ERR_NONE, remaining.error);
+
+		output.append(&rest[0], remaining.produced);
+	}
+	else
+	{
+		EXPECT_ERROREQ(UTF8_ERR_NONE, result.error);
+		EXPECT_EQ(input.length(), result.consumed);
+	}
+
+	return output;
+}
+
+template <typename Transform>
+static std::string copy(const std::string& input, Transform transform, size_t locale)
+{
+	std::vector<char> output(input.length() * 4 + 4);
+
+	utf8result_t result = transform(input.c_str(), input.length(), &output[0], output.size(), locale);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, result.error);
+
+	return std::string(&output[0], result.produced);
+}
+
+TEST(Utf8InPlace, ToUpper)
+{
+	char t[] = "Stra\xC3\x9F" "e";
+
+	utf8result_t r = utf8toupper_inplace(t, strlen(t), UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(7, r.consumed);
+	EXPECT_EQ(7, r.produced);
+	EXPECT_UTF8EQ("STRASSE", t);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Utf8InPlace, ToUpperBasicLatin)
+{
+	char t[] = "The quick brown fox jumps over the lazy dog";
+
+	utf8result_t r = utf8toupper_inplace(t, strlen(t), UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(43, r.consumed);
+	EXPECT_EQ(43, r.produced);
+	EXPECT_UTF8EQ("THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG", t);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Utf8InPlace, ToUpperGrows)
+{
+	char t[] = "n\xC5\x89" "a";
+
+	utf8result_t r = utf8toupper_inplace(t, strlen(t), UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(1, r.consumed);
+	EXPECT_EQ(1, r.produced);
+	EXPECT_UTF8EQ("N\xC5\x89" "a", t);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Utf8InPlace, ToUpperShrinkingMakesRoom)
+{
+	char t[] = "\xEF\xAC\x80\xC5\x89";
+
+	utf8result_t r = utf8toupper_inplace(t, strlen(t), UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(5, r.consumed);
+	EXPECT_EQ(5, r.produced);
+	EXPECT_UTF8EQ("FF\xCA\xBCN", t);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Utf8InPlace, ToUpperTurkish)
+{
+	char t[] = "istanbul";
+
+	utf8result_t r = utf8toupper_inplace(t, strlen(t), UTF8_LOCALE_TURKISH_AND_AZERI_LATIN);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_UTF8EQ("istanbul", t);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Utf8InPlace, ToLower)
+{
+	char t[] = "\xCE\x9F\xCE\x94\xCE\x9F\xCE\xA3";
+
+	utf8result_t r = utf8tolower_inplace(t, strlen(t), UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(8, r.consumed);
+	EXPECT_EQ(8, r.produced);
+	EXPECT_UTF8EQ("\xCE\xBF\xCE\xB4\xCE\xBF\xCF\x82", t);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Utf8InPlace, ToLowerGrows)
+{
+	char t[] = "A\xC8\xBA" "B";
+
+	utf8result_t r = utf8tolower_inplace(t, strlen(t), UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(1, r.consumed);
+	EXPECT_EQ(1, r.produced);
+	EXPECT_UTF8EQ("a\xC8\xBA" "B", t);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Utf8InPlace, ToLowerTurkishShrinks)
+{
+	char t[] = "\xC4\xB0STANBUL";
+
+	utf8result_t r = utf8tolower_inplace(t, strlen(t), UTF8_LOCALE_TURKISH_AND_AZERI_LATIN);
+	EXPECT_EQ(9, r.consumed);
+	EXPECT_EQ(8, r.produced);
+	EXPECT_UTF8EQ("istanbul", std::string(t, 8).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Utf8InPlace, ToLowerLithuanian)
+{
+	char t[] = "\xC3\x8C";
+
+	utf8result_t r = utf8tolower_inplace(t, strlen(t), UTF8_LOCALE_LITHUANIAN);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_UTF8EQ("\xC3\x8C", t);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Utf8InPlace, CaseFold)
+{
+	char t[] = "Stra\xC3\x9F" "e";
+
+	utf8result_t r = utf8casefold_inplace(t, strlen(t), UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(7, r.consumed);
+	EXPECT_EQ(7, r.produced);
+	EXPECT_UTF8EQ("strasse", t);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Utf8InPlace, CaseFoldTurkish)
+{
+	char t[] = "\xC4\xB0I";
+
+	utf8result_t r = utf8casefold_inplace(t, strlen(t), UTF8_LOCALE_TURKISH_AND_AZERI_LATIN);
+	EXPECT_EQ(3, r.consumed);
+	EXPECT_EQ(3, r.produced);
+	EXPECT_UTF8EQ("i\xC4\xB1", t);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Utf8InPlace, CaseFoldTurkishGrows)
+{
+	char t[] = "I";
+
+	utf8result_t r = utf8casefold_inplace(t, strlen(t), UTF8_LOCALE_TURKISH_AND_AZERI_LATIN);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_UTF8EQ("I", t);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Utf8InPlace, InvalidSequence)
+{
+	char t[] = "ab\xFF";
+
+	utf8result_t r = utf8tolower_inplace(t, strlen(t), UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(2, r.consumed);
+	EXPECT_EQ(2, r.produced);
+	EXPECT_UTF8EQ("ab\xFF", t);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Utf8InPlace, Empty)
+{
+	char t[] = "";
+
+	utf8result_t r = utf8toupper_inplace(t, 0, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Utf8InPlace, InvalidData)
+{
+	utf8result_t r = utf8casefold_inplace(nullptr, 4, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, r.error);
+}
+
+TEST(Utf8InPlace, InvalidLocale)
+{
+	char t[] = "Abc";
+
+	utf8result_t r = utf8tolower_inplace(t, strlen(t), 8881);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_UTF8EQ("Abc", t);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_LOCALE, r.error);
+}
+
+TEST(Utf8InPlace, RandomMatchesCopy)
+{
+	helpers::Random random(0x2545F491);
+	const char* f[] = {
+		"a", "I", "i", "J", " ", "Stra\xC3\x9F" "e", "the quick brown fox ", "\xCE\x9F\xCE\x94\xCE\x9F\xCE\xA3 ",
+		"\xC4\xB0", "\xC4\xB1", "\xC3\x8C", "\xCC\x87", "\xC5\x89", "\xC8\xBA", "\xC9\x90", "\xEF\xAC\x80", "\xFF"
+	};
+	const size_t locales[] = { UTF8_LOCALE_DEFAULT, UTF8_LOCALE_LITHUANIAN, UTF8_LOCALE_TURKISH_AND_AZERI_LATIN };
+
+	for (size_t i = 0; i < 300; ++i)
+	{
+		std::string input = random.fragments(f, sizeof(f) / sizeof(f[0]), random.next(80));
+		size_t locale = locales[i % 3];
+
+		if (input.empty())
+		{
+			continue;
+		}
+
+		EXPECT_EQ(copy(input, utf8toupper_ex, locale), fallback(input, utf8toupper_inplace, utf8toupper_ex, locale)) << "Input " << i;
+		EXPECT_EQ(copy(input, utf8tolower_ex, locale), fallback(input, utf8tolower_inplace, utf8tolower_ex, locale)) << "Input " << i;
+		EXPECT_EQ(copy(input, utf8casefold_ex, locale), fallback(input, utf8casefold_inplace, utf8casefold_ex, locale)) << "Input " << i;
+	}
+}
+
+#endif
\ No newline at end of file
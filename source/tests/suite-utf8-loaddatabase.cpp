@@ -0,0 +1,294 @@
+#include "tests-base.hpp"
+
+extern "C" {
+	#include "../internal/codepoint.h"
+	#include "../internal/database.h"
+}
+
+#include "../helpers/helpers-strings.hpp"
+
+class LoadDatabase
+	: public ::testing::Test
+{
+
+protected:
+
+	void SetUp()
+	{
+		errors = UTF8_ERR_NONE;
+		compiledProperties = PropertiesDataPtr;
+	}
+
+	void TearDown()
+	{
+		utf8unloaddatabase();
+
+		remove("testdata/corrupted.bin");
+	}
+
+	uint8_t loadCorrupted(size_t section, size_t offset, const void* value, size_t valueSize)
+	{
+		std::ifstream input("testdata/unicodedatabase.bin", std::ios_base::in | std::ios_base::binary);
+		std::vector<char> file((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+		uint32_t section_offset = 0;
+
+		// Header is 16 bytes, followed by the offset and size of every section
+
+		if (section == (size_t)-1)
+		{
+			section_offset = 0;
+		}
+		else
+		{
+			memcpy(&section_offset, &file[16 + section * 8], sizeof(uint32_t));
+		}
+
+		memcpy(&file[section_offset + offset], value, valueSize);
+
+		std::ofstream output("testdata/corrupted.bin", std::ios_base::out | std::ios_base::binary);
+		output.write(&file[0], file.size());
+		output.close();
+
+		return utf8loaddatabase("testdata/corrupted.bin", &errors);
+	}
+
+	int32_t errors;
+	const uint32_t* compiledProperties;
+
+};
+
+TEST_F(LoadDatabase, Load)
+{
+	EXPECT_EQ(1, utf8loaddatabase("testdata/unicodedatabase.bin", &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	EXPECT_NE(compiledProperties, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, LoadMatchesCompiled)
+{
+	std::vector<uint32_t> properties(MAX_LEGAL_UNICODE + 1);
+	std::vector<std::string> uppercase(MAX_LEGAL_UNICODE + 1);
+	std::vector<unicode_t> uppercase_mapped(MAX_LEGAL_UNICODE + 1);
+	uint8_t length = 0;
+	unicode_t mapped = 0;
+	const char* resolved;
+
+	for (unicode_t i = 0; i <= MAX_LEGAL_UNICODE; ++i)
+	{
+		properties[i] = database_queryproperties(i);
+
+		resolved = database_querycasemapping(i, UppercaseIndex1Ptr, UppercaseIndex2Ptr, UppercaseDataPtr, &mapped, &length);
+		uppercase[i] = (resolved != nullptr) ? std::string(resolved, length) : std::string();
+		uppercase_mapped[i] = mapped;
+	}
+
+	EXPECT_EQ(1, utf8loaddatabase("testdata/unicodedatabase.bin", &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	for (unicode_t i = 0; i <= MAX_LEGAL_UNICODE; ++i)
+	{
+		ASSERT_EQ(properties[i], database_queryproperties(i));
+
+		resolved = database_querycasemapping(i, UppercaseIndex1Ptr, UppercaseIndex2Ptr, UppercaseDataPtr, &mapped, &length);
+		ASSERT_EQ(uppercase[i], (resolved != nullptr) ? std::string(resolved, length) : std::string());
+		ASSERT_EQ(uppercase_mapped[i], mapped);
+	}
+}
+
+TEST_F(LoadDatabase, LoadCaseMapping)
+{
+	const char* c = "\xCE\xB1\xCE\xBB\xCF\x86\xCE\xAC\xCE\xB2\xCE\xB7\xCF\x84\xCE\xBF \xE1\xBA\x9E";
+	const size_t s = 255;
+	char b[256] = { 0 };
+
+	EXPECT_EQ(1, utf8loaddatabase("testdata/unicodedatabase.bin", &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	EXPECT_EQ(20, utf8toupper(c, strlen(c), b, s, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_UTF8EQ("\xCE\x91\xCE\x9B\xCE\xA6\xCE\x86\xCE\x92\xCE\x97\xCE\xA4\xCE\x9F \xE1\xBA\x9E", b);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST_F(LoadDatabase, LoadNormalization)
+{
+	const char* c = "A\xCC\x8A\xE1\x84\x80\xE1\x85\xA1\xE1\x86\xA8";
+	const size_t s = 255;
+	char b[256] = { 0 };
+
+	EXPECT_EQ(1, utf8loaddatabase("testdata/unicodedatabase.bin", &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	EXPECT_EQ(5, utf8normalize(c, strlen(c), b, s, UTF8_NORMALIZE_COMPOSE, &errors));
+	EXPECT_UTF8EQ("\xC3\x85\xEA\xB0\x81", b);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST_F(LoadDatabase, LoadTwice)
+{
+	const uint32_t* loaded;
+
+	EXPECT_EQ(1, utf8loaddatabase("testdata/unicodedatabase.bin", &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	loaded = PropertiesDataPtr;
+
+	EXPECT_EQ(1, utf8loaddatabase("testdata/unicodedatabase.bin", &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	EXPECT_NE(compiledProperties, PropertiesDataPtr);
+
+	utf8unloaddatabase();
+
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+	EXPECT_NE(loaded, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, Unload)
+{
+	EXPECT_EQ(1, utf8loaddatabase("testdata/unicodedatabase.bin", &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	utf8unloaddatabase();
+
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+	EXPECT_EQ(940, UnicodeCompositionRecordCount);
+}
+
+TEST_F(LoadDatabase, UnloadNotLoaded)
+{
+	utf8unloaddatabase();
+
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, InvalidFormat)
+{
+	EXPECT_EQ(0, utf8loaddatabase("testdata/CaseMapping.txt", &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, InvalidFormatKeepsLoaded)
+{
+	const uint32_t* loaded;
+
+	EXPECT_EQ(1, utf8loaddatabase("testdata/unicodedatabase.bin", &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	loaded = PropertiesDataPtr;
+
+	EXPECT_EQ(0, utf8loaddatabase("testdata/CaseMapping.txt", &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+	EXPECT_EQ(loaded, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, Version)
+{
+	EXPECT_EQ(0x00070000, utf8databaseversion());
+
+	EXPECT_EQ(1, utf8loaddatabase("testdata/unicodedatabase.bin", &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+	EXPECT_EQ(0x00070000, utf8databaseversion());
+
+	utf8unloaddatabase();
+
+	EXPECT_EQ(0x00070000, utf8databaseversion());
+}
+
+TEST_F(LoadDatabase, InvalidVersion)
+{
+	uint32_t v = 0;
+
+	EXPECT_EQ(0, loadCorrupted((size_t)-1, 8, &v, sizeof(v)));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, InvalidByteOrder)
+{
+	uint32_t f = 0x02000000;
+
+	EXPECT_EQ(0, loadCorrupted((size_t)-1, 4, &f, sizeof(f)));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, InvalidPropertiesIndex1)
+{
+	uint16_t i = 0xFFF0;
+
+	EXPECT_EQ(0, loadCorrupted(0, 0x20 * sizeof(uint16_t), &i, sizeof(i)));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, InvalidPropertiesIndex2)
+{
+	uint16_t i = 0xFFF0;
+
+	EXPECT_EQ(0, loadCorrupted(1, 0, &i, sizeof(i)));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, InvalidDecompositionIndex1)
+{
+	uint32_t i = 0xFFFFFFF0;
+
+	EXPECT_EQ(0, loadCorrupted(3, 0x10F * sizeof(uint32_t), &i, sizeof(i)));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, InvalidDecompositionIndex2)
+{
+	uint32_t i = 0xFFFFFFF0;
+
+	EXPECT_EQ(0, loadCorrupted(4, 0, &i, sizeof(i)));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, InvalidDecompositionString)
+{
+	// U+00C0 LATIN CAPITAL LETTER A WITH GRAVE
+
+	uint32_t d = 0x02FFFFF0;
+
+	EXPECT_EQ(0, loadCorrupted(5, 0xC0 * sizeof(uint32_t), &d, sizeof(d)));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, InvalidCaseMappingString)
+{
+	// U+00DF LATIN SMALL LETTER SHARP S
+
+	uint32_t d = 0x02FFFFF0;
+
+	EXPECT_EQ(0, loadCorrupted(11, 0xDF * sizeof(uint32_t), &d, sizeof(d)));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+}
+
+TEST_F(LoadDatabase, CaseMappingSimpleNotString)
+{
+	// Simple mappings store a distance, which may look like any offset
+
+	uint32_t d = 0x80FFFFFF;
+
+	EXPECT_EQ(1, loadCorrupted(11, 0x61 * sizeof(uint32_t), &d, sizeof(d)));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST_F(LoadDatabase, InvalidPath)
+{
+	EXPECT_EQ(0, utf8loaddatabase(nullptr, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+}
+
+TEST_F(LoadDatabase, InvalidMissingFile)
+{
+	EXPECT_EQ(0, utf8loaddatabase("testdata/missing.bin", &errors));
+	EXPECT_ERROREQ(UTF8_ERR_DATABASE_UNAVAILABLE, errors);
+	EXPECT_EQ(compiledProperties, PropertiesDataPtr);
+}
@@ -0,0 +1,160 @@
+#include "tests-base.hpp"
+
+extern "C" {
+	#include "../internal/codepoint.h"
+	#include "../internal/length.h"
+}
+
+#include "../helpers/helpers-random.hpp"
+#include "../helpers/helpers-strings.hpp"
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+TEST(Utf8NLen, BasicLatin)
+{
+	EXPECT_EQ(5, utf8nlen("%@#!&", 5));
+}
+
+TEST(Utf8NLen, MultiByte)
+{
+	EXPECT_EQ(4, utf8nlen("\xC4\xB3\xE2\x82\xAC\xF0\x9F\x98\x80" "a", 10));
+}
+
+TEST(Utf8NLen, AmountOfBytes)
+{
+	EXPECT_EQ(2, utf8nlen("\xCE\x93\xCE\xB5\xCE\xB9", 4));
+}
+
+TEST(Utf8NLen, AmountOfBytesSplitSequence)
+{
+	EXPECT_EQ(2, utf8nlen("\xCE\x93\xCE\xB5", 3));
+}
+
+TEST(Utf8NLen, EmbeddedNul)
+{
+	EXPECT_EQ(5, utf8nlen("ab\0\xC3\xA9\0", 6));
+}
+
+TEST(Utf8NLen, ContinuationBytes)
+{
+	EXPECT_EQ(3, utf8nlen("\x84\x9A\xB8", 3));
+}
+
+TEST(Utf8NLen, TooManyContinuationBytes)
+{
+	EXPECT_EQ(3, utf8nlen("\xC2\x80\x80\x80", 4));
+}
+
+TEST(Utf8NLen, NotEnoughData)
+{
+	EXPECT_EQ(4, utf8nlen("\xC0\xDA\xCB\xDE", 4));
+}
+
+TEST(Utf8NLen, SixBytes)
+{
+	EXPECT_EQ(2, utf8nlen("\xFC\x80\x80\x80\x80\x80\x80", 7));
+}
+
+TEST(Utf8NLen, IllegalByte)
+{
+	EXPECT_EQ(1, utf8nlen("\xFE\x80\x80\x80\x80\x80\x80", 7));
+}
+
+TEST(Utf8NLen, InvalidData)
+{
+	EXPECT_EQ(0, utf8nlen(nullptr, 12));
+}
+
+TEST(Utf8NLen, InvalidDataEmpty)
+{
+	EXPECT_EQ(0, utf8nlen("", 0));
+}
+
+TEST(Utf8NLen, MatchesSequences)
+{
+	static const char* sequences[] = {
+		"\xC2\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xF8\x88\x80\x80\x80",
+		"\xFC\x84\x80\x80\x80\x80", "\xFF\x80\x80\x80\x80\x80\x80\x80",
+		"\x80\x80", "\xE2\x82", "\xC2\x80\x80"
+	};
+	std::vector<std::string> inputs;
+	helpers::Random random(0x9E3779B9);
+
+	/* Sequences at every position around 16 byte blocks */
+
+	for (size_t position = 0; position < 40; ++position)
+	{
+		std::string prefix(position, 'x');
+
+		for (size_t i = 0; i < sizeof(sequences) / sizeof(sequences[0]); ++i)
+		{
+			inputs.push_back(prefix + sequences[i]);
+			inputs.push_back(prefix + sequences[i] + std::string(20, 'y'));
+			inputs.push_back(prefix + sequences[i] + sequences[i] + "\xC3");
+		}
+	}
+
+	/* Mostly lead and continuation bytes */
+
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		std::string text;
+		size_t length = random.next(100);
+
+		while (text.length() < length)
+		{
+			uint32_t choice = random.next(4);
+
+			if (choice == 0)
+			{
+				text += (char)(random.next() & 0x7F);
+			}
+			else if (
+				choice == 1)
+			{
+				text += (char)(0xC0 | (random.next() & 0x3F));
+			}
+			else
+			{
+				text += (char)(0x80 | (random.next() & 0x3F));
+			}
+		}
+
+		inputs.push_back(text);
+	}
+
+	for (const std::string& input : inputs)
+	{
+		/* Sequence by sequence, the way utf8len counted before 1.6.0 */
+
+		const uint8_t* src = (const uint8_t*)input.c_str();
+		size_t src_size = input.length();
+		size_t expected = 0;
+
+		while (src_size > 0)
+		{
+			uint8_t src_offset = 1;
+			uint8_t codepoint_length = codepoint_decoded_length[*src];
+
+			while (src_offset < codepoint_length &&
+				src_offset < src_size &&
+				(src[src_offset] & 0xC0) == 0x80)
+			{
+				src_offset++;
+			}
+
+			expected++;
+
+			src += src_offset;
+			src_size -= src_offset;
+		}
+
+		SCOPED_TRACE(helpers::hex(input));
+
+		EXPECT_EQ(expected, length_scalar((const uint8_t*)input.c_str(), input.length()));
+		EXPECT_EQ(expected, length_sse2((const uint8_t*)input.c_str(), input.length()));
+		EXPECT_EQ(expected, utf8nlen(input.c_str(), input.length()));
+	}
+}
+
+#endif
\ No newline at end of file
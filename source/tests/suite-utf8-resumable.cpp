@@ -0,0 +1,537 @@
+#include "tests-base.hpp"
+
+#include "../helpers/helpers-random.hpp"
+#include "../helpers/helpers-strings.hpp"
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+template <typename Transform>
+static std::string resume(size_t inputSize, size_t bufferSize, Transform transform)
+{
+	std::string output;
+	std::vector<char> buffer(bufferSize + 1);
+	size_t offset = 0;
+
+	do
+	{
+		utf8result_t result = transform(offset, &buffer[0], bufferSize);
+
+		EXPECT_LE(result.produced, bufferSize);
+		output.append(&buffer[0], result.produced);
+		offset += result.consumed;
+
+		if (result.error != UTF8_ERR_NOT_ENOUGH_SPACE)
+		{
+			break;
+		}
+		else if (
+			result.consumed == 0)
+		{
+			ADD_FAILURE() << "No progress at offset " << offset << " with a buffer of " << bufferSize << " bytes";
+
+			break;
+		}
+	}
+	while (offset < inputSize);
+
+	EXPECT_EQ(inputSize, offset);
+
+	return output;
+}
+
+TEST(Resumable, Utf16ToUtf8)
+{
+	std::vector<utf16_t> i = helpers::utf16("Fl\xC3\xBCgel \xF0\x9F\x98\x80");
+	char o[256] = { 0 };
+	size_t os = 7;
+
+	utf8result_t r = utf16toutf8_ex(&i[0], i.size() * sizeof(utf16_t), o, os);
+	EXPECT_EQ(12, r.consumed);
+	EXPECT_EQ(7, r.produced);
+	EXPECT_UTF8EQ("Fl\xC3\xBCgel", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+
+	r = utf16toutf8_ex(&i[6], i.size() * sizeof(utf16_t) - 12, o, 4);
+	EXPECT_EQ(2, r.consumed);
+	EXPECT_EQ(1, r.produced);
+	EXPECT_UTF8EQ(" ", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+
+	r = utf16toutf8_ex(&i[7], 4, o, 4);
+	EXPECT_EQ(4, r.consumed);
+	EXPECT_EQ(4, r.produced);
+	EXPECT_UTF8EQ("\xF0\x9F\x98\x80", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Resumable, Utf16ToUtf8SurrogatePairNotSplit)
+{
+	utf16_t i[] = { 'a', 0xD83D, 0xDE00 };
+	char o[256] = { 0 };
+	size_t os = 4;
+
+	utf8result_t r = utf16toutf8_ex(i, sizeof(i), o, os);
+	EXPECT_EQ(2, r.consumed);
+	EXPECT_EQ(1, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Resumable, Utf16ToUtf8OddSize)
+{
+	utf16_t i[] = { 'a', 'b', 'c' };
+	char o[256] = { 0 };
+	size_t os = 255;
+
+	utf8result_t r = utf16toutf8_ex(i, 5, o, os);
+	EXPECT_EQ(5, r.consumed);
+	EXPECT_EQ(5, r.produced);
+	EXPECT_UTF8EQ("ab\xEF\xBF\xBD", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, r.error);
+}
+
+TEST(Resumable, Utf16ToUtf8OddSizeNotEnoughSpace)
+{
+	utf16_t i[] = { 'a', 'b', 'c' };
+	char o[256] = { 0 };
+	size_t os = 4;
+
+	utf8result_t r = utf16toutf8_ex(i, 5, o, os);
+	EXPECT_EQ(4, r.consumed);
+	EXPECT_EQ(2, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Resumable, Utf16ToUtf8AmountOfBytes)
+{
+	std::vector<utf16_t> i = helpers::utf16("\xE1\x8F\xA9\xF0\x9F\x98\x80");
+
+	utf8result_t r = utf16toutf8_ex(&i[0], i.size() * sizeof(utf16_t), nullptr, 0);
+	EXPECT_EQ(6, r.consumed);
+	EXPECT_EQ(7, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Resumable, Utf32ToUtf8)
+{
+	unicode_t i[] = { 'h', 0x00E9, 0x1F600, 'x' };
+	char o[256] = { 0 };
+	size_t os = 5;
+
+	utf8result_t r = utf32toutf8_ex(i, sizeof(i), o, os);
+	EXPECT_EQ(8, r.consumed);
+	EXPECT_EQ(3, r.produced);
+	EXPECT_UTF8EQ("h\xC3\xA9", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Resumable, Utf8ToUtf16)
+{
+	const char* i = "gr\xC3\xBC\xF0\x9F\x98\x80n";
+	utf16_t o[256] = { 0 };
+	size_t os = 8;
+
+	utf8result_t r = utf8toutf16_ex(i, strlen(i), o, os);
+	EXPECT_EQ(4, r.consumed);
+	EXPECT_EQ(6, r.produced);
+	EXPECT_EQ('g', o[0]);
+	EXPECT_EQ('r', o[1]);
+	EXPECT_EQ(0x00FC, o[2]);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+
+	r = utf8toutf16_ex(i + 4, strlen(i) - 4, o, os);
+	EXPECT_EQ(5, r.consumed);
+	EXPECT_EQ(6, r.produced);
+	EXPECT_EQ(0xD83D, o[0]);
+	EXPECT_EQ(0xDE00, o[1]);
+	EXPECT_EQ('n', o[2]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Resumable, Utf8ToUtf32)
+{
+	const char* i = "\xE0\xA4\x95\xE0\xA4\xBF Z";
+	unicode_t o[256] = { 0 };
+	size_t os = 9;
+
+	utf8result_t r = utf8toutf32_ex(i, strlen(i), o, os);
+	EXPECT_EQ(6, r.consumed);
+	EXPECT_EQ(8, r.produced);
+	EXPECT_CPEQ(0x0915, o[0]);
+	EXPECT_CPEQ(0x093F, o[1]);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Resumable, Utf8ToUtf32InvalidSequence)
+{
+	const char* i = "a\xE0\xA4" "b";
+	unicode_t o[256] = { 0 };
+	size_t os = 255 * sizeof(unicode_t);
+
+	utf8result_t r = utf8toutf32_ex(i, strlen(i), o, os);
+	EXPECT_EQ(4, r.consumed);
+	EXPECT_EQ(12, r.produced);
+	EXPECT_CPEQ('a', o[0]);
+	EXPECT_CPEQ(0xFFFD, o[1]);
+	EXPECT_CPEQ('b', o[2]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Resumable, WideToUtf8)
+{
+	const wchar_t* i = L"wïde";
+	char o[256] = { 0 };
+	size_t os = 2;
+
+	utf8result_t r = widetoutf8_ex(i, wcslen(i) * sizeof(wchar_t), o, os);
+	EXPECT_EQ(sizeof(wchar_t), r.consumed);
+	EXPECT_EQ(1, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Resumable, Utf8ToWide)
+{
+	const char* i = "w\xC3\xAF" "de";
+	wchar_t o[256] = { 0 };
+	size_t os = 2 * sizeof(wchar_t);
+
+	utf8result_t r = utf8towide_ex(i, strlen(i), o, os);
+	EXPECT_EQ(3, r.consumed);
+	EXPECT_EQ(2 * sizeof(wchar_t), r.produced);
+	EXPECT_EQ(L'w', o[0]);
+	EXPECT_EQ(0x00EF, o[1]);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Resumable, ConversionInvalidData)
+{
+	char o[256] = { 0 };
+	size_t os = 255;
+
+	utf8result_t r = utf32toutf8_ex(nullptr, 8, o, os);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, r.error);
+}
+
+TEST(Resumable, ConversionOverlappingParameters)
+{
+	char data[64] = { 0 };
+
+	utf8result_t r = utf8toutf16_ex(data, 16, (utf16_t*)(data + 8), 32);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_OVERLAPPING_PARAMETERS, r.error);
+}
+
+TEST(Resumable, ConversionMatchesWhole)
+{
+	helpers::Random random(0x2545F491);
+
+	const char* f[] = {
+		"a", "Z", " ", "\xC3\xA9", "\xD0\x96", "\xE2\x82\xAC", "\xE6\x97\xA5",
+		"\xF0\x9F\x98\x80", "\xF0\x90\x8D\x88", "\xED\xA0\x80", "\xC0\xAF", "\x80"
+	};
+
+	for (size_t n = 0; n < 200; ++n)
+	{
+		std::string i = random.fragments(f, sizeof(f) / sizeof(f[0]), random.next(120));
+		std::vector<utf16_t> i16 = helpers::utf16(i);
+		std::vector<unicode_t> i32 = helpers::utf32(i);
+		size_t os = 4 + random.next(40);
+
+		std::vector<char> whole(i.length() * 4 + 16);
+		size_t l = utf8toutf16(i.c_str(), i.length(), (utf16_t*)&whole[0], whole.size(), nullptr);
+		EXPECT_EQ(std::string(&whole[0], l), resume(i.length(), os, [&](size_t offset, char* target, size_t targetSize) {
+			return utf8toutf16_ex(i.c_str() + offset, i.length() - offset, (utf16_t*)target, targetSize);
+		}));
+
+		l = utf8toutf32(i.c_str(), i.length(), (unicode_t*)&whole[0], whole.size(), nullptr);
+		EXPECT_EQ(std::string(&whole[0], l), resume(i.length(), os, [&](size_t offset, char* target, size_t targetSize) {
+			return utf8toutf32_ex(i.c_str() + offset, i.length() - offset, (unicode_t*)target, targetSize);
+		}));
+
+		if (i16.size() > 0)
+		{
+			l = utf16toutf8(&i16[0], i16.size() * sizeof(utf16_t), &whole[0], whole.size(), nullptr);
+			EXPECT_EQ(std::string(&whole[0], l), resume(i16.size() * sizeof(utf16_t), os, [&](size_t offset, char* target, size_t targetSize) {
+				return utf16toutf8_ex((const utf16_t*)((const char*)&i16[0] + offset), i16.size() * sizeof(utf16_t) - offset, target, targetSize);
+			}));
+
+			l = utf32toutf8(&i32[0], i32.size() * sizeof(unicode_t), &whole[0], whole.size(), nullptr);
+			EXPECT_EQ(std::string(&whole[0], l), resume(i32.size() * sizeof(unicode_t), os, [&](size_t offset, char* target, size_t targetSize) {
+				return utf32toutf8_ex((const unicode_t*)((const char*)&i32[0] + offset), i32.size() * sizeof(unicode_t) - offset, target, targetSize);
+			}));
+		}
+	}
+}
+
+TEST(Resumable, ToUpper)
+{
+	const char* i = "stra\xC3\x9F" "e";
+	char o[256] = { 0 };
+	size_t os = 5;
+
+	utf8result_t r = utf8toupper_ex(i, strlen(i), o, os, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(4, r.consumed);
+	EXPECT_EQ(4, r.produced);
+	EXPECT_UTF8EQ("STRA", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+
+	r = utf8toupper_ex(i + 4, strlen(i) - 4, o, os, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(3, r.consumed);
+	EXPECT_EQ(3, r.produced);
+	EXPECT_UTF8EQ("SSE", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Resumable, ToUpperInvalidLocale)
+{
+	const char* i = "text";
+	char o[256] = { 0 };
+	size_t os = 255;
+
+	utf8result_t r = utf8toupper_ex(i, strlen(i), o, os, 1337);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_LOCALE, r.error);
+}
+
+TEST(Resumable, ToLowerFinalSigma)
+{
+	const char* i = "\xCE\x9F\xCE\x94\xCE\x9F\xCE\xA3";
+	char o[256] = { 0 };
+	size_t os = 6;
+
+	utf8result_t r = utf8tolower_ex(i, strlen(i), o, os, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(4, r.consumed);
+	EXPECT_EQ(4, r.produced);
+	EXPECT_UTF8EQ("\xCE\xBF\xCE\xB4", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+
+	r = utf8tolower_ex(i + 4, strlen(i) - 4, o, os, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(4, r.consumed);
+	EXPECT_EQ(4, r.produced);
+	EXPECT_UTF8EQ("\xCE\xBF\xCF\x82", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Resumable, ToLowerAmountOfBytes)
+{
+	const char* i = "\xC3\x80LTER";
+
+	utf8result_t r = utf8tolower_ex(i, strlen(i), nullptr, 0, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(6, r.consumed);
+	EXPECT_EQ(6, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Resumable, ToTitleWord)
+{
+	const char* i = "hello world";
+	char o[256] = { 0 };
+	size_t os = 8;
+
+	utf8result_t r = utf8totitle_ex(i, strlen(i), o, os, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(6, r.consumed);
+	EXPECT_EQ(6, r.produced);
+	EXPECT_UTF8EQ("Hello ", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+
+	r = utf8totitle_ex(i + 6, strlen(i) - 6, o, os, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(5, r.consumed);
+	EXPECT_EQ(5, r.produced);
+	EXPECT_UTF8EQ("World", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Resumable, ToTitleWordDoesNotFit)
+{
+	const char* i = "extraordinary";
+	char o[256] = { 0 };
+	size_t os = 8;
+
+	utf8result_t r = utf8totitle_ex(i, strlen(i), o, os, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Resumable, CaseFold)
+{
+	const char* i = "Ma\xC3\x9F";
+	char o[256] = { 0 };
+	size_t os = 3;
+
+	utf8result_t r = utf8casefold_ex(i, strlen(i), o, os, UTF8_LOCALE_DEFAULT);
+	EXPECT_EQ(2, r.consumed);
+	EXPECT_EQ(2, r.produced);
+	EXPECT_UTF8EQ("ma", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Resumable, CaseFoldTurkish)
+{
+	const char* i = "KIZ";
+	char o[256] = { 0 };
+	size_t os = 2;
+
+	utf8result_t r = utf8casefold_ex(i, strlen(i), o, os, UTF8_LOCALE_TURKISH_AND_AZERI_LATIN);
+	EXPECT_EQ(1, r.consumed);
+	EXPECT_EQ(1, r.produced);
+	EXPECT_UTF8EQ("k", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Resumable, CaseMappingMatchesWhole)
+{
+	helpers::Random random(0x2545F491);
+
+	const char* f[] = {
+		"a", "B", " ", ".", "\xC3\x9F", "\xC3\x89", "I", "i", "J",
+		"\xC4\xB0", "\xC4\xB1", "\xC4\xAE", "\xC3\x8C", "\xCC\x87", "\xCC\x81",
+		"\xCE\xA3", "\xCF\x83", "\xCE\x91", "\xCE\xB1", "\xEF\xAC\x80", "\xD4\xB1"
+	};
+	size_t locales[] = {
+		UTF8_LOCALE_DEFAULT,
+		UTF8_LOCALE_LITHUANIAN,
+		UTF8_LOCALE_TURKISH_AND_AZERI_LATIN
+	};
+
+	for (size_t n = 0; n < 300; ++n)
+	{
+		std::string i;
+		size_t locale = locales[random.next(3)];
+		size_t os = 32 + random.next(32);
+		std::vector<char> whole(1024);
+		size_t l;
+
+		/* Words must fit in the buffer when converted to titlecase */
+
+		for (size_t w = random.next(12); w > 0; --w)
+		{
+			i += random.fragments(f, sizeof(f) / sizeof(f[0]), 1 + random.next(4));
+			i += " ";
+		}
+
+		l = utf8toupper(i.c_str(), i.length(), &whole[0], whole.size(), locale, nullptr);
+		EXPECT_EQ(std::string(&whole[0], l), resume(i.length(), os, [&](size_t offset, char* target, size_t targetSize) {
+			return utf8toupper_ex(i.c_str() + offset, i.length() - offset, target, targetSize, locale);
+		}));
+
+		l = utf8tolower(i.c_str(), i.length(), &whole[0], whole.size(), locale, nullptr);
+		EXPECT_EQ(std::string(&whole[0], l), resume(i.length(), os, [&](size_t offset, char* target, size_t targetSize) {
+			return utf8tolower_ex(i.c_str() + offset, i.length() - offset, target, targetSize, locale);
+		}));
+
+		l = utf8totitle(i.c_str(), i.length(), &whole[0], whole.size(), locale, nullptr);
+		EXPECT_EQ(std::string(&whole[0], l), resume(i.length(), os, [&](size_t offset, char* target, size_t targetSize) {
+			return utf8totitle_ex(i.c_str() + offset, i.length() - offset, target, targetSize, locale);
+		}));
+
+		l = utf8casefold(i.c_str(), i.length(), &whole[0], whole.size(), locale, nullptr);
+		EXPECT_EQ(std::string(&whole[0], l), resume(i.length(), os, [&](size_t offset, char* target, size_t targetSize) {
+			return utf8casefold_ex(i.c_str() + offset, i.length() - offset, target, targetSize, locale);
+		}));
+	}
+}
+
+TEST(Resumable, NormalizeCompose)
+{
+	const char* i = "A\xCC\x8A" "B\xCC\x87" "C";
+	char o[256] = { 0 };
+	size_t os = 4;
+
+	utf8result_t r = utf8normalize_ex(i, strlen(i), o, os, UTF8_NORMALIZE_COMPOSE);
+	EXPECT_EQ(3, r.consumed);
+	EXPECT_EQ(2, r.produced);
+	EXPECT_UTF8EQ("\xC3\x85", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+
+	r = utf8normalize_ex(i + 3, strlen(i) - 3, o, os, UTF8_NORMALIZE_COMPOSE);
+	EXPECT_EQ(4, r.consumed);
+	EXPECT_EQ(4, r.produced);
+	EXPECT_UTF8EQ("\xE1\xB8\x82" "C", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Resumable, NormalizeDecompose)
+{
+	const char* i = "\xC3\xA9t\xC3\xA9";
+	char o[256] = { 0 };
+	size_t os = 5;
+
+	utf8result_t r = utf8normalize_ex(i, strlen(i), o, os, UTF8_NORMALIZE_DECOMPOSE);
+	EXPECT_EQ(3, r.consumed);
+	EXPECT_EQ(4, r.produced);
+	EXPECT_UTF8EQ("e\xCC\x81t", std::string(o, r.produced).c_str());
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Resumable, NormalizeSegmentDoesNotFit)
+{
+	const char* i = "\xEA\xB0\x80";
+	char o[256] = { 0 };
+	size_t os = 5;
+
+	utf8result_t r = utf8normalize_ex(i, strlen(i), o, os, UTF8_NORMALIZE_DECOMPOSE);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, r.error);
+}
+
+TEST(Resumable, NormalizeAmountOfBytes)
+{
+	const char* i = "\xEA\xB0\x80\xC3\xA9";
+
+	utf8result_t r = utf8normalize_ex(i, strlen(i), nullptr, 0, UTF8_NORMALIZE_DECOMPOSE);
+	EXPECT_EQ(5, r.consumed);
+	EXPECT_EQ(9, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, r.error);
+}
+
+TEST(Resumable, NormalizeInvalidFlag)
+{
+	const char* i = "text";
+	char o[256] = { 0 };
+	size_t os = 255;
+
+	utf8result_t r = utf8normalize_ex(i, strlen(i), o, os, 0);
+	EXPECT_EQ(0, r.consumed);
+	EXPECT_EQ(0, r.produced);
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_FLAG, r.error);
+}
+
+TEST(Resumable, NormalizeMatchesWhole)
+{
+	helpers::Random random(0x2545F491);
+
+	const char* f[] = {
+		"a", "E", " ", "\xC3\xA9", "\xC3\x85", "\xCC\x81", "\xCC\x8A", "\xCC\xA3", "\xCC\x87",
+		"\xEA\xB0\x80", "\xE1\x84\x80", "\xE1\x85\xA1", "\xE1\x86\xA8", "\xEF\xAC\x81",
+		"\xE2\x84\xAB", "\xE0\xAD\x87", "\xE0\xAC\xBE", "\xC7\x84", "\x80"
+	};
+	size_t forms[] = {
+		UTF8_NORMALIZE_COMPOSE,
+		UTF8_NORMALIZE_DECOMPOSE,
+		UTF8_NORMALIZE_COMPOSE | UTF8_NORMALIZE_COMPATIBILITY,
+		UTF8_NORMALIZE_DECOMPOSE | UTF8_NORMALIZE_COMPATIBILITY
+	};
+
+	for (size_t n = 0; n < 300; ++n)
+	{
+		size_t flags = forms[random.next(4)];
+
+		/* Composed input is kept short enough to be composed in a single batch */
+
+		std::string i = random.fragments(f, sizeof(f) / sizeof(f[0]), 1 + random.next(((flags & UTF8_NORMALIZE_COMPOSE) != 0) ? 12 : 60));
+		size_t os = 24 + random.next(40);
+		std::vector<char> whole(i.length() * 8 + 16);
+
+		size_t l = utf8normalize(i.c_str(), i.length(), &whole[0], whole.size(), flags, nullptr);
+		EXPECT_EQ(std::string(&whole[0], l), resume(i.length(), os, [&](size_t offset, char* target, size_t targetSize) {
+			return utf8normalize_ex(i.c_str() + offset, i.length() - offset, target, targetSize, flags);
+		}));
+	}
+}
+
+#endif
@@ -1179,4 +1179,36 @@ TEST(Utf8SeekCurrentBackwards, TextEndsInMiddle)
 
 	EXPECT_SEEKEQ(t, 11, 16, strlen(t), 0, -1, SEEK_CUR);
 	EXPECT_SEEKEQ(t, 10, 16, strlen(t), 0, -2, SEEK_CUR);
-}
\ No newline at end of file
+}
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+TEST(Utf8SeekCurrentBackwards, BlockBasicLatin)
+{
+	const char* t = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+	EXPECT_SEEKEQ(t, 42, strlen(t), strlen(t), 0, -20, SEEK_CUR);
+}
+
+TEST(Utf8SeekCurrentBackwards, BlockSequenceCrossesBlock)
+{
+	const char* t = "0123456789ABCDE" "\xE2\x82\xAC" "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" "\xF0\x9F\x98\x80" "0123456789";
+
+	EXPECT_SEEKEQ(t, 53, strlen(t), strlen(t), 0, -12, SEEK_CUR);
+}
+
+TEST(Utf8SeekCurrentBackwards, BlockStrayContinuationBytes)
+{
+	const char* t = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" "\xC3" "\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80" "Z";
+
+	EXPECT_SEEKEQ(t, 36, strlen(t), strlen(t), 0, -21, SEEK_CUR);
+}
+
+TEST(Utf8SeekCurrentBackwards, BlockIllegalBytes)
+{
+	const char* t = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" "\xFE\x80\x80\xFC\x80\x80\x80\x80\x80\x80" "0123456789ABCDEF";
+
+	EXPECT_SEEKEQ(t, 37, strlen(t), strlen(t), 0, -20, SEEK_CUR);
+}
+
+#endif
\ No newline at end of file
@@ -1137,4 +1137,43 @@ TEST(Utf8SeekCurrentForward, TextEndsInMiddle)
 	const char* t = "\xD0\xBE\xD0\xBA\0\xD0\xB0\xD0\xBB";
 
 	EXPECT_SEEKEQ(t, 4, 0, strlen(t), 0, 4, SEEK_CUR);
-}
\ No newline at end of file
+}
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+TEST(Utf8SeekCurrentForward, BlockBasicLatin)
+{
+	const char* t = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+	EXPECT_SEEKEQ(t, 50, 0, strlen(t), 0, 50, SEEK_CUR);
+}
+
+TEST(Utf8SeekCurrentForward, BlockSequenceCrossesBlock)
+{
+	const char* t = "0123456789ABCDE" "\xE2\x82\xAC" "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" "\xF0\x9F\x98\x80" "0123456789";
+
+	EXPECT_SEEKEQ(t, 18, 0, strlen(t), 0, 16, SEEK_CUR);
+}
+
+TEST(Utf8SeekCurrentForward, BlockSequenceAfterBlocks)
+{
+	const char* t = "0123456789ABCDE" "\xE2\x82\xAC" "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" "\xF0\x9F\x98\x80" "0123456789";
+
+	EXPECT_SEEKEQ(t, 60, 0, strlen(t), 0, 55, SEEK_CUR);
+}
+
+TEST(Utf8SeekCurrentForward, BlockStrayContinuationBytes)
+{
+	const char* t = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" "\xC3" "\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80" "Z";
+
+	EXPECT_SEEKEQ(t, 51, 0, strlen(t), 0, 50, SEEK_CUR);
+}
+
+TEST(Utf8SeekCurrentForward, BlockIllegalBytes)
+{
+	const char* t = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" "\xFE\x80\x80\xFC\x80\x80\x80\x80\x80\x80" "0123456789ABCDEF";
+
+	EXPECT_SEEKEQ(t, 45, 0, strlen(t), 0, 40, SEEK_CUR);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "tests-base.hpp"
+
+#include "../helpers/helpers-random.hpp"
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+static std::vector<size_t> build(const std::string& text, size_t interval)
+{
+	int32_t errors = UTF8_ERR_NONE;
+
+	size_t l = utf8seekindex(text.c_str(), text.length(), interval, nullptr, 0, &errors);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	std::vector<size_t> index(l / sizeof(size_t));
+
+	EXPECT_EQ(l, utf8seekindex(text.c_str(), text.length(), interval, &index[0], l, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+
+	return index;
+}
+
+static void expectMatchesSeek(const std::string& text, const std::vector<size_t>& index)
+{
+	const char* s = text.c_str();
+	size_t l = text.length();
+
+	for (off_t o = -1; o <= (off_t)l + 2; ++o)
+	{
+		EXPECT_EQ(utf8seek(s, l, s, o, SEEK_SET) - s, utf8seek_indexed(s, l, s, o, SEEK_SET, &index[0], index.size() * sizeof(size_t)) - s) << "Offset " << o;
+	}
+}
+
+TEST(Utf8SeekIndexed, BuildAmountOfBytes)
+{
+	const char* i = "a\xC3\xA9" "b\xE2\x82\xAC" "c\xF0\x9F\x98\x80" "d";
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(5 * sizeof(size_t), utf8seekindex(i, strlen(i), 2, nullptr, 0, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8SeekIndexed, BuildOffsets)
+{
+	const char* i = "a\xC3\xA9" "b\xE2\x82\xAC" "c\xF0\x9F\x98\x80" "d";
+	size_t o[8] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(5 * sizeof(size_t), utf8seekindex(i, strlen(i), 2, o, sizeof(o), &errors));
+	EXPECT_EQ(2, o[0]);
+	EXPECT_EQ(strlen(i), o[1]);
+	EXPECT_EQ(3, o[2]);
+	EXPECT_EQ(7, o[3]);
+	EXPECT_EQ(12, o[4]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8SeekIndexed, BuildInvalidSequences)
+{
+	const char* i = "\xE0\x80" "A\x80\x80\xC3" "B\xF4";
+	size_t o[8] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(8 * sizeof(size_t), utf8seekindex(i, strlen(i), 1, o, sizeof(o), &errors));
+	EXPECT_EQ(1, o[0]);
+	EXPECT_EQ(strlen(i), o[1]);
+	EXPECT_EQ(2, o[2]);
+	EXPECT_EQ(3, o[3]);
+	EXPECT_EQ(4, o[4]);
+	EXPECT_EQ(5, o[5]);
+	EXPECT_EQ(6, o[6]);
+	EXPECT_EQ(7, o[7]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8SeekIndexed, BuildDefaultInterval)
+{
+	std::string i(3000, 'x');
+	size_t o[8] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(4 * sizeof(size_t), utf8seekindex(i.c_str(), i.length(), 0, o, sizeof(o), &errors));
+	EXPECT_EQ(1024, o[0]);
+	EXPECT_EQ(3000, o[1]);
+	EXPECT_EQ(1024, o[2]);
+	EXPECT_EQ(2048, o[3]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8SeekIndexed, BuildIntervalLargerThanText)
+{
+	const char* i = "Short";
+	size_t o[4] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(2 * sizeof(size_t), utf8seekindex(i, strlen(i), (size_t)-1, o, sizeof(o), &errors));
+	EXPECT_EQ((size_t)-1, o[0]);
+	EXPECT_EQ(5, o[1]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8SeekIndexed, BuildEmpty)
+{
+	const char* i = "";
+	size_t o[4] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(2 * sizeof(size_t), utf8seekindex(i, 0, 4, o, sizeof(o), &errors));
+	EXPECT_EQ(4, o[0]);
+	EXPECT_EQ(0, o[1]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8SeekIndexed, BuildNotEnoughSpace)
+{
+	const char* i = "abcdefghij";
+	size_t o[4] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(3 * sizeof(size_t), utf8seekindex(i, strlen(i), 3, o, 3 * sizeof(size_t) + 1, &errors));
+	EXPECT_EQ(3, o[0]);
+	EXPECT_EQ(10, o[1]);
+	EXPECT_EQ(3, o[2]);
+	EXPECT_EQ(0, o[3]);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, errors);
+}
+
+TEST(Utf8SeekIndexed, BuildNotEnoughSpaceHeader)
+{
+	const char* i = "abcdefghij";
+	size_t o[4] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(sizeof(size_t), utf8seekindex(i, strlen(i), 3, o, sizeof(size_t), &errors));
+	EXPECT_EQ(3, o[0]);
+	EXPECT_EQ(0, o[1]);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, errors);
+}
+
+TEST(Utf8SeekIndexed, BuildInvalidData)
+{
+	size_t o[4] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(0, utf8seekindex(nullptr, 12, 3, o, sizeof(o), &errors));
+	EXPECT_ERROREQ(UTF8_ERR_INVALID_DATA, errors);
+}
+
+TEST(Utf8SeekIndexed, SeekSet)
+{
+	const char* i = "a\xC3\xA9" "b\xE2\x82\xAC" "c\xF0\x9F\x98\x80" "d";
+	std::vector<size_t> index = build(i, 2);
+
+	EXPECT_EQ(i + 7, utf8seek_indexed(i, strlen(i), i, 4, SEEK_SET, &index[0], index.size() * sizeof(size_t)));
+	EXPECT_EQ(i + 8, utf8seek_indexed(i, strlen(i), i, 5, SEEK_SET, &index[0], index.size() * sizeof(size_t)));
+}
+
+TEST(Utf8SeekIndexed, SeekSetMatchesSeek)
+{
+	const char* t[] = {
+		"The quick brown fox",
+		"\xCE\xBA\xCE\xB1\xCF\x84\xCE\xAC \xCE\xBB\xCE\xBF\xCE\xB3\xCE\xBF",
+		"\xE6\xA3\x80\xE7\xB4\xA2\xF0\x9F\x98\x80\xE5\xBC\x95\xE6\x93\x8E",
+		"\xE0\x80" "A\x80\x80\xC3" "B\xF4\x80\x80" "C\xFE\xFF\xC0\xAF"
+	};
+
+	for (size_t i = 0; i < sizeof(t) / sizeof(t[0]); ++i)
+	{
+		for (size_t interval = 1; interval <= 6; ++interval)
+		{
+			expectMatchesSeek(t[i], build(t[i], interval));
+		}
+	}
+}
+
+TEST(Utf8SeekIndexed, SeekSetMatchesSeekRandom)
+{
+	helpers::Random random(0x5F3759DF);
+	const char f[] = { 'a', '\x7F', '\x80', '\xBF', '\xC3', '\xE2', '\xF0', '\xF8', '\xFC', '\xFF' };
+
+	for (size_t n = 0; n < 200; ++n)
+	{
+		std::string i;
+
+		for (size_t l = random.next(64); l > 0; --l)
+		{
+			i += f[random.next(sizeof(f))];
+		}
+
+		expectMatchesSeek(i, build(i, 1 + random.next(8)));
+	}
+}
+
+TEST(Utf8SeekIndexed, SeekSetPartialIndex)
+{
+	std::string i = "\xCE\xBA\xCE\xB1\xCF\x84\xCE\xAC \xCE\xBB\xCE\xBF\xCE\xB3\xCE\xBF";
+	std::vector<size_t> index(3);
+	int32_t errors = UTF8_ERR_NONE;
+
+	utf8seekindex(i.c_str(), i.length(), 2, &index[0], index.size() * sizeof(size_t), &errors);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, errors);
+
+	expectMatchesSeek(i, index);
+}
+
+TEST(Utf8SeekIndexed, SeekSetDamagedIndex)
+{
+	std::string i = "The quick brown fox";
+	std::vector<size_t> index = build(i, 4);
+
+	index[3] = 1000;
+
+	expectMatchesSeek(i, index);
+}
+
+TEST(Utf8SeekIndexed, SeekSetIndexForOtherText)
+{
+	std::string i = "\xCE\xBA\xCE\xB1\xCF\x84\xCE\xAC \xCE\xBB\xCE\xBF\xCE\xB3\xCE\xBF";
+	std::vector<size_t> index = build("The quick brown fox jumps over the lazy dog", 2);
+
+	expectMatchesSeek(i, index);
+}
+
+TEST(Utf8SeekIndexed, SeekSetWithoutIndex)
+{
+	const char* i = "a\xC3\xA9" "b\xE2\x82\xAC" "c";
+
+	EXPECT_EQ(i + 4, utf8seek_indexed(i, strlen(i), i, 3, SEEK_SET, nullptr, 0));
+}
+
+TEST(Utf8SeekIndexed, SeekSetBeforeStart)
+{
+	const char* i = "a\xC3\xA9" "b\xE2\x82\xAC" "c";
+	std::vector<size_t> index = build(i, 1);
+
+	EXPECT_EQ(i, utf8seek_indexed(i, strlen(i) - 1, i + 1, 3, SEEK_SET, &index[0], index.size() * sizeof(size_t)));
+}
+
+TEST(Utf8SeekIndexed, SeekCurrent)
+{
+	const char* i = "a\xC3\xA9" "b\xE2\x82\xAC" "c";
+	std::vector<size_t> index = build(i, 1);
+
+	EXPECT_EQ(i + 7, utf8seek_indexed(i + 1, strlen(i), i, 3, SEEK_CUR, &index[0], index.size() * sizeof(size_t)));
+	EXPECT_EQ(i + 1, utf8seek_indexed(i + 7, strlen(i), i, -3, SEEK_CUR, &index[0], index.size() * sizeof(size_t)));
+}
+
+TEST(Utf8SeekIndexed, SeekEnd)
+{
+	const char* i = "a\xC3\xA9" "b\xE2\x82\xAC" "c";
+	std::vector<size_t> index = build(i, 1);
+
+	EXPECT_EQ(i + 4, utf8seek_indexed(i, strlen(i), i, 2, SEEK_END, &index[0], index.size() * sizeof(size_t)));
+}
+
+TEST(Utf8SeekIndexed, SeekInvalidData)
+{
+	const char* i = "abc";
+	std::vector<size_t> index = build(i, 1);
+
+	EXPECT_EQ(nullptr, utf8seek_indexed(nullptr, 3, i, 1, SEEK_SET, &index[0], index.size() * sizeof(size_t)));
+	EXPECT_EQ(i, utf8seek_indexed(i, 3, nullptr, 1, SEEK_SET, &index[0], index.size() * sizeof(size_t)));
+}
+
+#endif
@@ -961,4 +961,20 @@ TEST(Utf8ToLowerLithuanian, SingleLatinCapitalLetterIWithOgonekMoreAboveOutOfOrd
 	EXPECT_EQ(13, utf8tolower(c, strlen(c), b, s, UTF8_LOCALE_LITHUANIAN, &errors));
 	EXPECT_UTF8EQ("\xC4\xAF\xCC\xB5\xCC\xA7\xE1\xB7\x8E\xCC\x87\xCD\x86", b);
 	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
-}
\ No newline at end of file
+}
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+TEST(Utf8ToLowerLithuanian, BasicLatinBlock)
+{
+	const char* c = "LIETUVOS ISTORIJA IR J\xCC\x81OS KULTURA";
+	const size_t s = 255;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(46, utf8tolower(c, strlen(c), b, s, UTF8_LOCALE_LITHUANIAN, &errors));
+	EXPECT_UTF8EQ("li\xCC\x87\x65tuvos i\xCC\x87stori\xCC\x87j\xCC\x87\x61 i\xCC\x87r j\xCC\x87\xCC\x81os kultura", b);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+#endif
\ No newline at end of file
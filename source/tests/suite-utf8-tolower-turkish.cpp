@@ -289,4 +289,20 @@ TEST(Utf8ToLowerTurkish, SingleSmallLetterDotlessIWithDotAboveAmountOfBytes)
 
 	EXPECT_EQ(4, utf8tolower(c, strlen(c), nullptr, 0, UTF8_LOCALE_TURKISH_AND_AZERI_LATIN, &errors));
 	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
-}
\ No newline at end of file
+}
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+TEST(Utf8ToLowerTurkish, BasicLatinBlock)
+{
+	const char* c = "ISTANBUL IS A BIG CITY I\xCC\x87N TURKEY";
+	const size_t s = 255;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(36, utf8tolower(c, strlen(c), b, s, UTF8_LOCALE_TURKISH_AND_AZERI_LATIN, &errors));
+	EXPECT_UTF8EQ("\xC4\xB1stanbul \xC4\xB1s a b\xC4\xB1g c\xC4\xB1ty in turkey", b);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+#endif
\ No newline at end of file
@@ -720,4 +720,44 @@ TEST(Utf8ToLower, OverlappingParametersTargetInsideInput)
 
 	EXPECT_EQ(0, utf8tolower(i, is, o, os, UTF8_LOCALE_DEFAULT, &errors));
 	EXPECT_ERROREQ(UTF8_ERR_OVERLAPPING_PARAMETERS, errors);
-}
\ No newline at end of file
+}
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+TEST(Utf8ToLower, BasicLatinBlock)
+{
+	const char* c = "The Quick Brown Fox Jumps Over The Lazy Dog";
+	const size_t s = 255;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(43, utf8tolower(c, strlen(c), b, s, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_UTF8EQ("the quick brown fox jumps over the lazy dog", b);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToLower, BasicLatinBlockNotEnoughSpace)
+{
+	const char* c = "The Quick Brown Fox Jumps Over The Lazy Dog";
+	const size_t s = 20;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(20, utf8tolower(c, strlen(c), b, s, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_UTF8EQ("the quick brown fox ", b);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, errors);
+}
+
+TEST(Utf8ToLower, BasicLatinBlockFinalSigma)
+{
+	const char* c = "ABCDEFGHIJKLMNOPQRSTUVWXYZ \xCE\x9F\xCE\x94\xCE\x9F\xCE\xA3";
+	const size_t s = 255;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(35, utf8tolower(c, strlen(c), b, s, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_UTF8EQ("abcdefghijklmnopqrstuvwxyz \xCE\xBF\xCE\xB4\xCE\xBF\xCF\x82", b);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+#endif
\ No newline at end of file
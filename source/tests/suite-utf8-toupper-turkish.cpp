@@ -289,4 +289,20 @@ TEST(Utf8ToUpperTurkish, SingleSmallLetterDotlessIWithDotAboveAmountOfBytes)
 
 	EXPECT_EQ(3, utf8toupper(c, strlen(c), nullptr, 0, UTF8_LOCALE_TURKISH_AND_AZERI_LATIN, &errors));
 	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
-}
\ No newline at end of file
+}
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+TEST(Utf8ToUpperTurkish, BasicLatinBlock)
+{
+	const char* c = "istanbul is a big city in turkey";
+	const size_t s = 255;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(37, utf8toupper(c, strlen(c), b, s, UTF8_LOCALE_TURKISH_AND_AZERI_LATIN, &errors));
+	EXPECT_UTF8EQ("\xC4\xB0STANBUL \xC4\xB0S A B\xC4\xB0G C\xC4\xB0TY \xC4\xB0N TURKEY", b);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+#endif
\ No newline at end of file
@@ -716,4 +716,44 @@ TEST(Utf8ToUpper, OverlappingParametersTargetInsideInput)
 
 	EXPECT_EQ(0, utf8toupper(i, is, o, os, UTF8_LOCALE_DEFAULT, &errors));
 	EXPECT_ERROREQ(UTF8_ERR_OVERLAPPING_PARAMETERS, errors);
-}
\ No newline at end of file
+}
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+TEST(Utf8ToUpper, BasicLatinBlock)
+{
+	const char* c = "The Quick Brown Fox Jumps Over The Lazy Dog";
+	const size_t s = 255;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(43, utf8toupper(c, strlen(c), b, s, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_UTF8EQ("THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG", b);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUpper, BasicLatinBlockNotEnoughSpace)
+{
+	const char* c = "The Quick Brown Fox Jumps Over The Lazy Dog";
+	const size_t s = 20;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(20, utf8toupper(c, strlen(c), b, s, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_UTF8EQ("THE QUICK BROWN FOX ", b);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, errors);
+}
+
+TEST(Utf8ToUpper, BasicLatinBlockMultiByte)
+{
+	const char* c = "Cr\xC3\xA8me br\xC3\xBBl\xC3\xA9\x65 for the table by the window \xCE\xA3";
+	const size_t s = 255;
+	char b[256] = { 0 };
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(46, utf8toupper(c, strlen(c), b, s, UTF8_LOCALE_DEFAULT, &errors));
+	EXPECT_UTF8EQ("CR\xC3\x88ME BR\xC3\x9BL\xC3\x89\x45 FOR THE TABLE BY THE WINDOW \xCE\xA3", b);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+#endif
\ No newline at end of file
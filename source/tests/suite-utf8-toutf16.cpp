@@ -3281,6 +3281,305 @@ TEST(Utf8ToUtf16, StringDataSizeOver)
 	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
 }
 
+TEST(Utf8ToUtf16, StringBlockBasicLatin)
+{
+	const char* i = "The quick brown fox jumps.";
+	size_t is = strlen(i);
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(52, utf8toutf16(i, is, o, os, &errors));
+	EXPECT_CPEQ('T', o[0]);
+	EXPECT_CPEQ('h', o[1]);
+	EXPECT_CPEQ('e', o[2]);
+	EXPECT_CPEQ(' ', o[3]);
+	EXPECT_CPEQ('q', o[4]);
+	EXPECT_CPEQ('u', o[5]);
+	EXPECT_CPEQ('i', o[6]);
+	EXPECT_CPEQ('c', o[7]);
+	EXPECT_CPEQ('k', o[8]);
+	EXPECT_CPEQ(' ', o[9]);
+	EXPECT_CPEQ('b', o[10]);
+	EXPECT_CPEQ('r', o[11]);
+	EXPECT_CPEQ('o', o[12]);
+	EXPECT_CPEQ('w', o[13]);
+	EXPECT_CPEQ('n', o[14]);
+	EXPECT_CPEQ(' ', o[15]);
+	EXPECT_CPEQ('f', o[16]);
+	EXPECT_CPEQ('o', o[17]);
+	EXPECT_CPEQ('x', o[18]);
+	EXPECT_CPEQ(' ', o[19]);
+	EXPECT_CPEQ('j', o[20]);
+	EXPECT_CPEQ('u', o[21]);
+	EXPECT_CPEQ('m', o[22]);
+	EXPECT_CPEQ('p', o[23]);
+	EXPECT_CPEQ('s', o[24]);
+	EXPECT_CPEQ('.', o[25]);
+	EXPECT_CPEQ(0, o[26]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf16, StringBlockTwoBytes)
+{
+	const char* i = "\xCE\x9E\xCE\xB5\xCF\x83\xCE\xBA\xCE\xB5\xCF\x80\xCE\xAC\xCE\xB6\xCF\x89";
+	size_t is = strlen(i);
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(18, utf8toutf16(i, is, o, os, &errors));
+	EXPECT_CPEQ(0x039E, o[0]);
+	EXPECT_CPEQ(0x03B5, o[1]);
+	EXPECT_CPEQ(0x03C3, o[2]);
+	EXPECT_CPEQ(0x03BA, o[3]);
+	EXPECT_CPEQ(0x03B5, o[4]);
+	EXPECT_CPEQ(0x03C0, o[5]);
+	EXPECT_CPEQ(0x03AC, o[6]);
+	EXPECT_CPEQ(0x03B6, o[7]);
+	EXPECT_CPEQ(0x03C9, o[8]);
+	EXPECT_CPEQ(0, o[9]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf16, StringBlockThreeBytes)
+{
+	const char* i = "\xE5\xA4\xA9\xE5\x9C\xB0\xE7\x8E\x84\xE9\xBB\x84\xE5\xAE\x87\xE5\xAE\x99\xE6\xB4\xAA\xE8\x8D\x92\xEF\xBF\xBF";
+	size_t is = strlen(i);
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(18, utf8toutf16(i, is, o, os, &errors));
+	EXPECT_CPEQ(0x5929, o[0]);
+	EXPECT_CPEQ(0x5730, o[1]);
+	EXPECT_CPEQ(0x7384, o[2]);
+	EXPECT_CPEQ(0x9EC4, o[3]);
+	EXPECT_CPEQ(0x5B87, o[4]);
+	EXPECT_CPEQ(0x5B99, o[5]);
+	EXPECT_CPEQ(0x6D2A, o[6]);
+	EXPECT_CPEQ(0x8352, o[7]);
+	EXPECT_CPEQ(0xFFFF, o[8]);
+	EXPECT_CPEQ(0, o[9]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf16, StringBlockMixed)
+{
+	const char* i = "z\xC3\xA9\xDF\xBF\xE0\xA0\x80p\xC2\x80\xED\x9F\xBF\xEE\x80\x80h\xC3\xBC";
+	size_t is = strlen(i);
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(20, utf8toutf16(i, is, o, os, &errors));
+	EXPECT_CPEQ('z', o[0]);
+	EXPECT_CPEQ(0x00E9, o[1]);
+	EXPECT_CPEQ(0x07FF, o[2]);
+	EXPECT_CPEQ(0x0800, o[3]);
+	EXPECT_CPEQ('p', o[4]);
+	EXPECT_CPEQ(0x0080, o[5]);
+	EXPECT_CPEQ(0xD7FF, o[6]);
+	EXPECT_CPEQ(0xE000, o[7]);
+	EXPECT_CPEQ('h', o[8]);
+	EXPECT_CPEQ(0x00FC, o[9]);
+	EXPECT_CPEQ(0, o[10]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf16, StringBlockFourBytes)
+{
+	const char* i = "Smile\xC3\xA9 \xF0\x9F\x98\x80 \xE4\xB8\xADok!?!.";
+	size_t is = strlen(i);
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(34, utf8toutf16(i, is, o, os, &errors));
+	EXPECT_CPEQ('S', o[0]);
+	EXPECT_CPEQ('m', o[1]);
+	EXPECT_CPEQ('i', o[2]);
+	EXPECT_CPEQ('l', o[3]);
+	EXPECT_CPEQ('e', o[4]);
+	EXPECT_CPEQ(0x00E9, o[5]);
+	EXPECT_CPEQ(' ', o[6]);
+	EXPECT_CPEQ(0xD83D, o[7]);
+	EXPECT_CPEQ(0xDE00, o[8]);
+	EXPECT_CPEQ(' ', o[9]);
+	EXPECT_CPEQ(0x4E2D, o[10]);
+	EXPECT_CPEQ('o', o[11]);
+	EXPECT_CPEQ('k', o[12]);
+	EXPECT_CPEQ('!', o[13]);
+	EXPECT_CPEQ('?', o[14]);
+	EXPECT_CPEQ('!', o[15]);
+	EXPECT_CPEQ('.', o[16]);
+	EXPECT_CPEQ(0, o[17]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf16, StringBlockOverlong)
+{
+	const char* i = "\xE0\x80\xAF" "abcdefghijklmnopqr";
+	size_t is = strlen(i);
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(38, utf8toutf16(i, is, o, os, &errors));
+	EXPECT_CPEQ(0xFFFD, o[0]);
+	EXPECT_CPEQ('a', o[1]);
+	EXPECT_CPEQ('b', o[2]);
+	EXPECT_CPEQ('c', o[3]);
+	EXPECT_CPEQ('d', o[4]);
+	EXPECT_CPEQ('e', o[5]);
+	EXPECT_CPEQ('f', o[6]);
+	EXPECT_CPEQ('g', o[7]);
+	EXPECT_CPEQ('h', o[8]);
+	EXPECT_CPEQ('i', o[9]);
+	EXPECT_CPEQ('j', o[10]);
+	EXPECT_CPEQ('k', o[11]);
+	EXPECT_CPEQ('l', o[12]);
+	EXPECT_CPEQ('m', o[13]);
+	EXPECT_CPEQ('n', o[14]);
+	EXPECT_CPEQ('o', o[15]);
+	EXPECT_CPEQ('p', o[16]);
+	EXPECT_CPEQ('q', o[17]);
+	EXPECT_CPEQ('r', o[18]);
+	EXPECT_CPEQ(0, o[19]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf16, StringBlockSurrogate)
+{
+	const char* i = "abcdefgh\xED\xA0\x80ijklmnopq";
+	size_t is = strlen(i);
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(36, utf8toutf16(i, is, o, os, &errors));
+	EXPECT_CPEQ('a', o[0]);
+	EXPECT_CPEQ('b', o[1]);
+	EXPECT_CPEQ('c', o[2]);
+	EXPECT_CPEQ('d', o[3]);
+	EXPECT_CPEQ('e', o[4]);
+	EXPECT_CPEQ('f', o[5]);
+	EXPECT_CPEQ('g', o[6]);
+	EXPECT_CPEQ('h', o[7]);
+	EXPECT_CPEQ(0xFFFD, o[8]);
+	EXPECT_CPEQ('i', o[9]);
+	EXPECT_CPEQ('j', o[10]);
+	EXPECT_CPEQ('k', o[11]);
+	EXPECT_CPEQ('l', o[12]);
+	EXPECT_CPEQ('m', o[13]);
+	EXPECT_CPEQ('n', o[14]);
+	EXPECT_CPEQ('o', o[15]);
+	EXPECT_CPEQ('p', o[16]);
+	EXPECT_CPEQ('q', o[17]);
+	EXPECT_CPEQ(0, o[18]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf16, StringBlockMissingContinuation)
+{
+	const char* i = "abc\xE4\xB8" "defghijklmnopqrs";
+	size_t is = strlen(i);
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(40, utf8toutf16(i, is, o, os, &errors));
+	EXPECT_CPEQ('a', o[0]);
+	EXPECT_CPEQ('b', o[1]);
+	EXPECT_CPEQ('c', o[2]);
+	EXPECT_CPEQ(0xFFFD, o[3]);
+	EXPECT_CPEQ('d', o[4]);
+	EXPECT_CPEQ('e', o[5]);
+	EXPECT_CPEQ('f', o[6]);
+	EXPECT_CPEQ('g', o[7]);
+	EXPECT_CPEQ('h', o[8]);
+	EXPECT_CPEQ('i', o[9]);
+	EXPECT_CPEQ('j', o[10]);
+	EXPECT_CPEQ('k', o[11]);
+	EXPECT_CPEQ('l', o[12]);
+	EXPECT_CPEQ('m', o[13]);
+	EXPECT_CPEQ('n', o[14]);
+	EXPECT_CPEQ('o', o[15]);
+	EXPECT_CPEQ('p', o[16]);
+	EXPECT_CPEQ('q', o[17]);
+	EXPECT_CPEQ('r', o[18]);
+	EXPECT_CPEQ('s', o[19]);
+	EXPECT_CPEQ(0, o[20]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf16, StringBlockUnexpectedContinuation)
+{
+	const char* i = "\xCE\x93\xCE\xB1\x80\xCE\xB6\xC0\xAF\xCE\xB5\xCE\xBC\xCE\xB5\xCE\xBB\xCE\xB9\xCE\xB1";
+	size_t is = strlen(i);
+	utf16_t o[256] = { 0 };
+	size_t os = 255 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(22, utf8toutf16(i, is, o, os, &errors));
+	EXPECT_CPEQ(0x0393, o[0]);
+	EXPECT_CPEQ(0x03B1, o[1]);
+	EXPECT_CPEQ(0xFFFD, o[2]);
+	EXPECT_CPEQ(0x03B6, o[3]);
+	EXPECT_CPEQ(0xFFFD, o[4]);
+	EXPECT_CPEQ(0x03B5, o[5]);
+	EXPECT_CPEQ(0x03BC, o[6]);
+	EXPECT_CPEQ(0x03B5, o[7]);
+	EXPECT_CPEQ(0x03BB, o[8]);
+	EXPECT_CPEQ(0x03B9, o[9]);
+	EXPECT_CPEQ(0x03B1, o[10]);
+	EXPECT_CPEQ(0, o[11]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf16, StringBlockAmountOfBytes)
+{
+	const char* i = "\xCE\x9E\xCE\xB5\xCF\x83\xCE\xBA\xCE\xB5\xCF\x80\xCE\xAC\xCE\xB6\xCF\x89 \xCF\x84\xCE\xB7\xCE\xBD \xCF\x88\xCF\x85\xCF\x87\xCE\xBF\xCF\x86\xCE\xB8\xCF\x8C\xCF\x81\xCE\xB1";
+	size_t is = strlen(i);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(46, utf8toutf16(i, is, nullptr, 0, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf16, StringBlockNotEnoughSpace)
+{
+	const char* i = "\xCE\x9E\xCE\xB5\xCF\x83\xCE\xBA\xCE\xB5\xCF\x80\xCE\xAC\xCE\xB6\xCF\x89 \xCF\x84\xCE\xB7\xCE\xBD \xCF\x88\xCF\x85\xCF\x87\xCE\xBF\xCF\x86\xCE\xB8\xCF\x8C\xCF\x81\xCE\xB1";
+	size_t is = strlen(i);
+	utf16_t o[256] = { 0 };
+	size_t os = 20 * sizeof(utf16_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(40, utf8toutf16(i, is, o, os, &errors));
+	EXPECT_CPEQ(0x039E, o[0]);
+	EXPECT_CPEQ(0x03B5, o[1]);
+	EXPECT_CPEQ(0x03C3, o[2]);
+	EXPECT_CPEQ(0x03BA, o[3]);
+	EXPECT_CPEQ(0x03B5, o[4]);
+	EXPECT_CPEQ(0x03C0, o[5]);
+	EXPECT_CPEQ(0x03AC, o[6]);
+	EXPECT_CPEQ(0x03B6, o[7]);
+	EXPECT_CPEQ(0x03C9, o[8]);
+	EXPECT_CPEQ(' ', o[9]);
+	EXPECT_CPEQ(0x03C4, o[10]);
+	EXPECT_CPEQ(0x03B7, o[11]);
+	EXPECT_CPEQ(0x03BD, o[12]);
+	EXPECT_CPEQ(' ', o[13]);
+	EXPECT_CPEQ(0x03C8, o[14]);
+	EXPECT_CPEQ(0x03C5, o[15]);
+	EXPECT_CPEQ(0x03C7, o[16]);
+	EXPECT_CPEQ(0x03BF, o[17]);
+	EXPECT_CPEQ(0x03C6, o[18]);
+	EXPECT_CPEQ(0x03B8, o[19]);
+	EXPECT_CPEQ(0, o[20]);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, errors);
+}
+
 TEST(Utf8ToUtf16, ErrorsIsReset)
 {
 	const char* i = "\xC2\x89";
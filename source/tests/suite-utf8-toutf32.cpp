@@ -4022,6 +4022,328 @@ TEST(Utf8ToUtf32, StringDataSizeOver)
 	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
 }
 
+TEST(Utf8ToUtf32, StringBlockBasicLatin)
+{
+	const char* i = "The quick brown fox jumps over the lazy dog.";
+	size_t is = strlen(i);
+	unicode_t o[256] = { 0 };
+	size_t os = 255 * sizeof(unicode_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(176, utf8toutf32(i, is, o, os, &errors));
+	EXPECT_CPEQ('T', o[0]);
+	EXPECT_CPEQ('h', o[1]);
+	EXPECT_CPEQ('e', o[2]);
+	EXPECT_CPEQ(' ', o[3]);
+	EXPECT_CPEQ('q', o[4]);
+	EXPECT_CPEQ('u', o[5]);
+	EXPECT_CPEQ('i', o[6]);
+	EXPECT_CPEQ('c', o[7]);
+	EXPECT_CPEQ('k', o[8]);
+	EXPECT_CPEQ(' ', o[9]);
+	EXPECT_CPEQ('b', o[10]);
+	EXPECT_CPEQ('r', o[11]);
+	EXPECT_CPEQ('o', o[12]);
+	EXPECT_CPEQ('w', o[13]);
+	EXPECT_CPEQ('n', o[14]);
+	EXPECT_CPEQ(' ', o[15]);
+	EXPECT_CPEQ('f', o[16]);
+	EXPECT_CPEQ('o', o[17]);
+	EXPECT_CPEQ('x', o[18]);
+	EXPECT_CPEQ(' ', o[19]);
+	EXPECT_CPEQ('j', o[20]);
+	EXPECT_CPEQ('u', o[21]);
+	EXPECT_CPEQ('m', o[22]);
+	EXPECT_CPEQ('p', o[23]);
+	EXPECT_CPEQ('s', o[24]);
+	EXPECT_CPEQ(' ', o[25]);
+	EXPECT_CPEQ('o', o[26]);
+	EXPECT_CPEQ('v', o[27]);
+	EXPECT_CPEQ('e', o[28]);
+	EXPECT_CPEQ('r', o[29]);
+	EXPECT_CPEQ(' ', o[30]);
+	EXPECT_CPEQ('t', o[31]);
+	EXPECT_CPEQ('h', o[32]);
+	EXPECT_CPEQ('e', o[33]);
+	EXPECT_CPEQ(' ', o[34]);
+	EXPECT_CPEQ('l', o[35]);
+	EXPECT_CPEQ('a', o[36]);
+	EXPECT_CPEQ('z', o[37]);
+	EXPECT_CPEQ('y', o[38]);
+	EXPECT_CPEQ(' ', o[39]);
+	EXPECT_CPEQ('d', o[40]);
+	EXPECT_CPEQ('o', o[41]);
+	EXPECT_CPEQ('g', o[42]);
+	EXPECT_CPEQ('.', o[43]);
+	EXPECT_CPEQ(0, o[44]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf32, StringBlockFourBytes)
+{
+	const char* i = "\xF0\x9F\x98\x80\xF0\x9F\x98\x83 smile \xF0\x9F\x98\x84\xF0\x9F\x98\x81 grin \xF0\x90\x80\x80\xF4\x8F\xBF\xBF!";
+	size_t is = strlen(i);
+	unicode_t o[256] = { 0 };
+	size_t os = 255 * sizeof(unicode_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(80, utf8toutf32(i, is, o, os, &errors));
+	EXPECT_CPEQ(0x1F600, o[0]);
+	EXPECT_CPEQ(0x1F603, o[1]);
+	EXPECT_CPEQ(' ', o[2]);
+	EXPECT_CPEQ('s', o[3]);
+	EXPECT_CPEQ('m', o[4]);
+	EXPECT_CPEQ('i', o[5]);
+	EXPECT_CPEQ('l', o[6]);
+	EXPECT_CPEQ('e', o[7]);
+	EXPECT_CPEQ(' ', o[8]);
+	EXPECT_CPEQ(0x1F604, o[9]);
+	EXPECT_CPEQ(0x1F601, o[10]);
+	EXPECT_CPEQ(' ', o[11]);
+	EXPECT_CPEQ('g', o[12]);
+	EXPECT_CPEQ('r', o[13]);
+	EXPECT_CPEQ('i', o[14]);
+	EXPECT_CPEQ('n', o[15]);
+	EXPECT_CPEQ(' ', o[16]);
+	EXPECT_CPEQ(0x10000, o[17]);
+	EXPECT_CPEQ(0x10FFFF, o[18]);
+	EXPECT_CPEQ('!', o[19]);
+	EXPECT_CPEQ(0, o[20]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf32, StringBlockMixed)
+{
+	const char* i = "z\xC3\xA9\xDF\xBF\xE0\xA0\x80p\xC2\x80\xED\x9F\xBF\xEE\x80\x80h\xC3\xBC\xF0\x90\x80\x80\xF4\x8F\xBF\xBF" "abcdef";
+	size_t is = strlen(i);
+	unicode_t o[256] = { 0 };
+	size_t os = 255 * sizeof(unicode_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(72, utf8toutf32(i, is, o, os, &errors));
+	EXPECT_CPEQ('z', o[0]);
+	EXPECT_CPEQ(0x00E9, o[1]);
+	EXPECT_CPEQ(0x07FF, o[2]);
+	EXPECT_CPEQ(0x0800, o[3]);
+	EXPECT_CPEQ('p', o[4]);
+	EXPECT_CPEQ(0x0080, o[5]);
+	EXPECT_CPEQ(0xD7FF, o[6]);
+	EXPECT_CPEQ(0xE000, o[7]);
+	EXPECT_CPEQ('h', o[8]);
+	EXPECT_CPEQ(0x00FC, o[9]);
+	EXPECT_CPEQ(0x10000, o[10]);
+	EXPECT_CPEQ(0x10FFFF, o[11]);
+	EXPECT_CPEQ('a', o[12]);
+	EXPECT_CPEQ('b', o[13]);
+	EXPECT_CPEQ('c', o[14]);
+	EXPECT_CPEQ('d', o[15]);
+	EXPECT_CPEQ('e', o[16]);
+	EXPECT_CPEQ('f', o[17]);
+	EXPECT_CPEQ(0, o[18]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf32, StringBlockOverlong)
+{
+	const char* i = "abcdefgh\xF0\x8F\xBF\xBF" "ijklmnopqrstuvwxyz0123";
+	size_t is = strlen(i);
+	unicode_t o[256] = { 0 };
+	size_t os = 255 * sizeof(unicode_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(124, utf8toutf32(i, is, o, os, &errors));
+	EXPECT_CPEQ('a', o[0]);
+	EXPECT_CPEQ('b', o[1]);
+	EXPECT_CPEQ('c', o[2]);
+	EXPECT_CPEQ('d', o[3]);
+	EXPECT_CPEQ('e', o[4]);
+	EXPECT_CPEQ('f', o[5]);
+	EXPECT_CPEQ('g', o[6]);
+	EXPECT_CPEQ('h', o[7]);
+	EXPECT_CPEQ(0xFFFD, o[8]);
+	EXPECT_CPEQ('i', o[9]);
+	EXPECT_CPEQ('j', o[10]);
+	EXPECT_CPEQ('k', o[11]);
+	EXPECT_CPEQ('l', o[12]);
+	EXPECT_CPEQ('m', o[13]);
+	EXPECT_CPEQ('n', o[14]);
+	EXPECT_CPEQ('o', o[15]);
+	EXPECT_CPEQ('p', o[16]);
+	EXPECT_CPEQ('q', o[17]);
+	EXPECT_CPEQ('r', o[18]);
+	EXPECT_CPEQ('s', o[19]);
+	EXPECT_CPEQ('t', o[20]);
+	EXPECT_CPEQ('u', o[21]);
+	EXPECT_CPEQ('v', o[22]);
+	EXPECT_CPEQ('w', o[23]);
+	EXPECT_CPEQ('x', o[24]);
+	EXPECT_CPEQ('y', o[25]);
+	EXPECT_CPEQ('z', o[26]);
+	EXPECT_CPEQ('0', o[27]);
+	EXPECT_CPEQ('1', o[28]);
+	EXPECT_CPEQ('2', o[29]);
+	EXPECT_CPEQ('3', o[30]);
+	EXPECT_CPEQ(0, o[31]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf32, StringBlockSurrogate)
+{
+	const char* i = "abcdefgh\xED\xA0\x80" "ijklmnopqrstuvwxyz0123";
+	size_t is = strlen(i);
+	unicode_t o[256] = { 0 };
+	size_t os = 255 * sizeof(unicode_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(124, utf8toutf32(i, is, o, os, &errors));
+	EXPECT_CPEQ('a', o[0]);
+	EXPECT_CPEQ('b', o[1]);
+	EXPECT_CPEQ('c', o[2]);
+	EXPECT_CPEQ('d', o[3]);
+	EXPECT_CPEQ('e', o[4]);
+	EXPECT_CPEQ('f', o[5]);
+	EXPECT_CPEQ('g', o[6]);
+	EXPECT_CPEQ('h', o[7]);
+	EXPECT_CPEQ(0xFFFD, o[8]);
+	EXPECT_CPEQ('i', o[9]);
+	EXPECT_CPEQ('j', o[10]);
+	EXPECT_CPEQ('k', o[11]);
+	EXPECT_CPEQ('l', o[12]);
+	EXPECT_CPEQ('m', o[13]);
+	EXPECT_CPEQ('n', o[14]);
+	EXPECT_CPEQ('o', o[15]);
+	EXPECT_CPEQ('p', o[16]);
+	EXPECT_CPEQ('q', o[17]);
+	EXPECT_CPEQ('r', o[18]);
+	EXPECT_CPEQ('s', o[19]);
+	EXPECT_CPEQ('t', o[20]);
+	EXPECT_CPEQ('u', o[21]);
+	EXPECT_CPEQ('v', o[22]);
+	EXPECT_CPEQ('w', o[23]);
+	EXPECT_CPEQ('x', o[24]);
+	EXPECT_CPEQ('y', o[25]);
+	EXPECT_CPEQ('z', o[26]);
+	EXPECT_CPEQ('0', o[27]);
+	EXPECT_CPEQ('1', o[28]);
+	EXPECT_CPEQ('2', o[29]);
+	EXPECT_CPEQ('3', o[30]);
+	EXPECT_CPEQ(0, o[31]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf32, StringBlockAboveLegalUnicode)
+{
+	const char* i = "abcdefgh\xF4\x90\x80\x80" "ijklmnopqrstuvwxyz0123";
+	size_t is = strlen(i);
+	unicode_t o[256] = { 0 };
+	size_t os = 255 * sizeof(unicode_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(124, utf8toutf32(i, is, o, os, &errors));
+	EXPECT_CPEQ('a', o[0]);
+	EXPECT_CPEQ('b', o[1]);
+	EXPECT_CPEQ('c', o[2]);
+	EXPECT_CPEQ('d', o[3]);
+	EXPECT_CPEQ('e', o[4]);
+	EXPECT_CPEQ('f', o[5]);
+	EXPECT_CPEQ('g', o[6]);
+	EXPECT_CPEQ('h', o[7]);
+	EXPECT_CPEQ(0xFFFD, o[8]);
+	EXPECT_CPEQ('i', o[9]);
+	EXPECT_CPEQ('j', o[10]);
+	EXPECT_CPEQ('k', o[11]);
+	EXPECT_CPEQ('l', o[12]);
+	EXPECT_CPEQ('m', o[13]);
+	EXPECT_CPEQ('n', o[14]);
+	EXPECT_CPEQ('o', o[15]);
+	EXPECT_CPEQ('p', o[16]);
+	EXPECT_CPEQ('q', o[17]);
+	EXPECT_CPEQ('r', o[18]);
+	EXPECT_CPEQ('s', o[19]);
+	EXPECT_CPEQ('t', o[20]);
+	EXPECT_CPEQ('u', o[21]);
+	EXPECT_CPEQ('v', o[22]);
+	EXPECT_CPEQ('w', o[23]);
+	EXPECT_CPEQ('x', o[24]);
+	EXPECT_CPEQ('y', o[25]);
+	EXPECT_CPEQ('z', o[26]);
+	EXPECT_CPEQ('0', o[27]);
+	EXPECT_CPEQ('1', o[28]);
+	EXPECT_CPEQ('2', o[29]);
+	EXPECT_CPEQ('3', o[30]);
+	EXPECT_CPEQ(0, o[31]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf32, StringBlockMissingContinuation)
+{
+	const char* i = "abc\xF0\x9F\x98" "defghijklmnopqrstuvwxyz0123";
+	size_t is = strlen(i);
+	unicode_t o[256] = { 0 };
+	size_t os = 255 * sizeof(unicode_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(124, utf8toutf32(i, is, o, os, &errors));
+	EXPECT_CPEQ('a', o[0]);
+	EXPECT_CPEQ('b', o[1]);
+	EXPECT_CPEQ('c', o[2]);
+	EXPECT_CPEQ(0xFFFD, o[3]);
+	EXPECT_CPEQ('d', o[4]);
+	EXPECT_CPEQ('e', o[5]);
+	EXPECT_CPEQ('f', o[6]);
+	EXPECT_CPEQ('g', o[7]);
+	EXPECT_CPEQ('h', o[8]);
+	EXPECT_CPEQ('i', o[9]);
+	EXPECT_CPEQ('j', o[10]);
+	EXPECT_CPEQ('k', o[11]);
+	EXPECT_CPEQ('l', o[12]);
+	EXPECT_CPEQ('m', o[13]);
+	EXPECT_CPEQ('n', o[14]);
+	EXPECT_CPEQ('o', o[15]);
+	EXPECT_CPEQ('p', o[16]);
+	EXPECT_CPEQ('q', o[17]);
+	EXPECT_CPEQ('r', o[18]);
+	EXPECT_CPEQ('s', o[19]);
+	EXPECT_CPEQ('t', o[20]);
+	EXPECT_CPEQ('u', o[21]);
+	EXPECT_CPEQ('v', o[22]);
+	EXPECT_CPEQ('w', o[23]);
+	EXPECT_CPEQ('x', o[24]);
+	EXPECT_CPEQ('y', o[25]);
+	EXPECT_CPEQ('z', o[26]);
+	EXPECT_CPEQ('0', o[27]);
+	EXPECT_CPEQ('1', o[28]);
+	EXPECT_CPEQ('2', o[29]);
+	EXPECT_CPEQ('3', o[30]);
+	EXPECT_CPEQ(0, o[31]);
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf32, StringBlockAmountOfBytes)
+{
+	const char* i = "The quick brown fox jumps over the lazy dog.";
+	size_t is = strlen(i);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(176, utf8toutf32(i, is, nullptr, 0, &errors));
+	EXPECT_ERROREQ(UTF8_ERR_NONE, errors);
+}
+
+TEST(Utf8ToUtf32, StringBlockNotEnoughSpace)
+{
+	const char* i = "The quick brown fox jumps over the lazy dog.";
+	size_t is = strlen(i);
+	unicode_t o[256] = { 0 };
+	size_t os = 40 * sizeof(unicode_t);
+	int32_t errors = UTF8_ERR_NONE;
+
+	EXPECT_EQ(160, utf8toutf32(i, is, o, os, &errors));
+	EXPECT_CPEQ('y', o[38]);
+	EXPECT_CPEQ(' ', o[39]);
+	EXPECT_CPEQ(0, o[40]);
+	EXPECT_ERROREQ(UTF8_ERR_NOT_ENOUGH_SPACE, errors);
+}
+
 TEST(Utf8ToUtf32, ErrorsIsReset)
 {
 	const char* i = "\xE0\xA2\xA8";
@@ -0,0 +1,272 @@
+#include "tests-base.hpp"
+
+extern "C" {
+	#include "../internal/codepoint.h"
+	#include "../internal/simd.h"
+	#include "../internal/validation.h"
+}
+
+#include "../helpers/helpers-random.hpp"
+#include "../helpers/helpers-strings.hpp"
+
+#if UTF8_VERSION_GUARD(1, 6, 0)
+
+TEST(Utf8Validate, Empty)
+{
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(1, utf8validate("", 0, &offset));
+	EXPECT_EQ(0, offset);
+}
+
+TEST(Utf8Validate, BasicLatin)
+{
+	const char* i = "Brown fox jumps over the lazy dog, but only on Sundays.";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(1, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(strlen(i), offset);
+}
+
+TEST(Utf8Validate, MultiByte)
+{
+	const char* i = "\xCE\x93\xCE\xB5\xCE\xB9\xCE\xAC \xE2\x82\xAC\xF0\x9F\x98\x80 \xF4\x8F\xBF\xBF";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(1, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(strlen(i), offset);
+}
+
+TEST(Utf8Validate, ReplacementCharacter)
+{
+	const char* i = "Unknown \xEF\xBF\xBD";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(1, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(strlen(i), offset);
+}
+
+TEST(Utf8Validate, AmountOfBytes)
+{
+	const char* i = "Valid\xC3\xA9\xFF";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(1, utf8validate(i, 7, &offset));
+	EXPECT_EQ(7, offset);
+}
+
+TEST(Utf8Validate, ContinuationByte)
+{
+	const char* i = "abc\x80" "def";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(0, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(3, offset);
+}
+
+TEST(Utf8Validate, IllegalByte)
+{
+	const char* i = "\xC5\x81\xFE";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(0, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(2, offset);
+}
+
+TEST(Utf8Validate, OverlongTwoBytes)
+{
+	const char* i = "\xC0\xAF";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(0, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(0, offset);
+}
+
+TEST(Utf8Validate, OverlongThreeBytes)
+{
+	const char* i = "!\xE0\x9F\xBF";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(0, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(1, offset);
+}
+
+TEST(Utf8Validate, OverlongFourBytes)
+{
+	const char* i = "\xF0\x8F\xBF\xBF";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(0, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(0, offset);
+}
+
+TEST(Utf8Validate, Surrogate)
+{
+	const char* i = "\xE2\x82\xAC\xED\xA0\x80";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(0, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(3, offset);
+}
+
+TEST(Utf8Validate, TooLarge)
+{
+	const char* i = "\xF4\x90\x80\x80";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(0, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(0, offset);
+}
+
+TEST(Utf8Validate, TooLong)
+{
+	const char* i = "\xF0\x90\x80\x80\x80";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(0, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(4, offset);
+}
+
+TEST(Utf8Validate, NotEnoughData)
+{
+	const char* i = "Cafe\xE2\x82";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(0, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(4, offset);
+}
+
+TEST(Utf8Validate, NotEnoughDataFollowedByBasicLatin)
+{
+	const char* i = "\xF0\x9F\x98" "abc";
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(0, utf8validate(i, strlen(i), &offset));
+	EXPECT_EQ(0, offset);
+}
+
+TEST(Utf8Validate, OffsetNull)
+{
+	const char* i = "\xC0";
+
+	EXPECT_EQ(0, utf8validate(i, strlen(i), nullptr));
+}
+
+TEST(Utf8Validate, InvalidData)
+{
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(0, utf8validate(nullptr, 4, &offset));
+	EXPECT_EQ(0, offset);
+}
+
+TEST(Utf8Validate, InvalidDataEmpty)
+{
+	size_t offset = (size_t)-1;
+
+	EXPECT_EQ(1, utf8validate(nullptr, 0, &offset));
+	EXPECT_EQ(0, offset);
+}
+
+TEST(Utf8Validate, BlockBoundaries)
+{
+	/* Errors and sequences split at every position around 16 and 32 byte blocks */
+
+	static const char* invalid[] = {
+		"\x80", "\xC1\xBF", "\xE0\x80\x80", "\xED\xA0\x80", "\xF4\x90\x80\x80",
+		"\xF8\x88\x80\x80\x80", "\xE2\x82", "\xF0\x9F\x98"
+	};
+	static const char* valid[] = {
+		"\xC2\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"
+	};
+
+	for (size_t position = 0; position < 100; ++position)
+	{
+		std::string prefix(position, 'x');
+		std::vector<std::pair<std::string, size_t>> cases;
+
+		for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+		{
+			cases.push_back(std::make_pair(prefix + invalid[i], position));
+			cases.push_back(std::make_pair(prefix + invalid[i] + std::string(64, 'y'), position));
+		}
+
+		for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); ++i)
+		{
+			std::string text = prefix + valid[i] + std::string(40, 'y');
+
+			cases.push_back(std::make_pair(text, text.length()));
+		}
+
+		for (const std::pair<std::string, size_t>& c : cases)
+		{
+			const uint8_t* src = (const uint8_t*)c.first.c_str();
+
+			SCOPED_TRACE(helpers::hex(c.first));
+
+			EXPECT_EQ(c.second, validation_scalar(src, c.first.length()));
+			EXPECT_EQ(c.second, validation_sse2(src, c.first.length()));
+			EXPECT_EQ(c.second, validation_execute(src, c.first.length()));
+
+			if (simd_supports_avx2())
+			{
+				EXPECT_EQ(c.second, validation_avx2(src, c.first.length()));
+			}
+		}
+	}
+}
+
+TEST(Utf8Validate, MatchesDecoder)
+{
+	static const char* f[] = {
+		"a", "Z", " ", "Brown fox ", "\xC2\xA9", "\xDF\xBF", "\xE0\xA0\x80", "\xE2\x82\xAC",
+		"\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBD", "\xF0\x90\x80\x80",
+		"\xF3\xA0\x80\x81", "\xF4\x8F\xBF\xBF"
+	};
+	helpers::Random random(0x2545F491);
+
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		std::string text = random.fragments(f, sizeof(f) / sizeof(f[0]), random.next(60));
+		size_t expected = 0;
+		size_t offset = (size_t)-1;
+
+		/* Corrupt a random byte in most strings */
+
+		if (text.length() > 0 &&
+			random.next(4) != 0)
+		{
+			text[random.next((uint32_t)text.length())] = (char)(random.next() & 0xFF);
+		}
+
+		/* Offset of the first sequence decoded as a replacement character */
+
+		while (expected < text.length())
+		{
+			unicode_t decoded;
+			uint8_t length = codepoint_read(text.c_str() + expected, text.length() - expected, &decoded);
+
+			if (decoded == REPLACEMENT_CHARACTER &&
+				(length != 3 || memcmp(text.c_str() + expected, "\xEF\xBF\xBD", 3) != 0))
+			{
+				break;
+			}
+
+			expected += length;
+		}
+
+		SCOPED_TRACE(helpers::hex(text));
+
+		EXPECT_EQ(expected == text.length(), utf8validate(text.c_str(), text.length(), &offset) == 1);
+		EXPECT_EQ(expected, offset);
+		EXPECT_EQ(expected, validation_scalar((const uint8_t*)text.c_str(), text.length()));
+		EXPECT_EQ(expected, validation_sse2((const uint8_t*)text.c_str(), text.length()));
+
+		if (simd_supports_avx2())
+		{
+			EXPECT_EQ(expected, validation_avx2((const uint8_t*)text.c_str(), text.length()));
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -35,6 +35,16 @@
 
 #include "utf8rewind.h"
 
+/* Tables are compiled in as long as one of the features using them is not excluded */
+
+#define UTF8_DATABASE_NFD           (!UTF8_EXCLUDE_NFD || !UTF8_EXCLUDE_NFC)
+#define UTF8_DATABASE_NFKD          (!UTF8_EXCLUDE_NFKD || !UTF8_EXCLUDE_NFKC)
+#define UTF8_DATABASE_COMPOSITION   (!UTF8_EXCLUDE_NFC || !UTF8_EXCLUDE_NFKC)
+#define UTF8_DATABASE_UPPERCASE     (!UTF8_EXCLUDE_UPPERCASE)
+#define UTF8_DATABASE_LOWERCASE     (!UTF8_EXCLUDE_LOWERCASE || !UTF8_EXCLUDE_TITLECASE)
+#define UTF8_DATABASE_TITLECASE     (!UTF8_EXCLUDE_TITLECASE)
+#define UTF8_DATABASE_CASEFOLDING   (!UTF8_EXCLUDE_CASEFOLDING)
+
 typedef struct {
 	unicode_t codepoint;
 	uint32_t length_and_offset;
@@ -45,26 +55,9 @@ typedef struct {
 	unicode_t value;
 } CompositionRecord;
 
-extern const size_t* GeneralCategoryIndexPtr;
-extern const uint32_t* GeneralCategoryDataPtr;
-
-extern const size_t* CanonicalCombiningClassIndexPtr;
-extern const uint8_t* CanonicalCombiningClassDataPtr;
-
-extern const size_t* QuickCheckCaseMappedIndexPtr;
-extern const uint8_t* QuickCheckCaseMappedDataPtr;
-
-extern const size_t* QuickCheckNFCIndexPtr;
-extern const uint8_t* QuickCheckNFCDataPtr;
-
-extern const size_t* QuickCheckNFDIndexPtr;
-extern const uint8_t* QuickCheckNFDDataPtr;
-
-extern const size_t* QuickCheckNFKCIndexPtr;
-extern const uint8_t* QuickCheckNFKCDataPtr;
-
-extern const size_t* QuickCheckNFKDIndexPtr;
-extern const uint8_t* QuickCheckNFKDDataPtr;
+extern const uint16_t* PropertiesIndex1Ptr;
+extern const uint16_t* PropertiesIndex2Ptr;
+extern const uint32_t* PropertiesDataPtr;
 
 extern const size_t UnicodeNFDRecordCount;
 extern const DecompositionRecord* UnicodeNFDRecordPtr;
@@ -81,7 +74,8 @@ extern const DecompositionRecord* UnicodeLowercaseRecordPtr;
 extern const size_t UnicodeTitlecaseRecordCount;
 extern const DecompositionRecord* UnicodeTitlecaseRecordPtr;
 
-extern const size_t UnicodeCompositionRecordCount;
+extern size_t UnicodeCompositionRecordCount;
+extern const uint16_t* UnicodeCompositionSaltPtr;
 extern const CompositionRecord* UnicodeCompositionRecordPtr;
 
 extern const uint32_t* NFDIndex1Ptr;
@@ -109,7 +103,9 @@ extern const uint32_t* CaseFoldingIndex2Ptr;
 extern const uint32_t* CaseFoldingDataPtr;
 
 extern const char* CompressedStringData;
-extern const size_t CompressedStringDataLength;
+extern size_t CompressedStringDataLength;
+
+extern const uint32_t UnicodeDatabaseVersion;
 
 extern const char* DecompositionData;
 extern const size_t DecompositionDataLength;
@@ -25,21 +25,22 @@
 
 #include "utf8rewind.h"
 
+#include "internal/allocation.h"
 #include "internal/base.h"
 #include "internal/casemapping.h"
 #include "internal/codepoint.h"
 #include "internal/composition.h"
+#include "internal/conversion.h"
 #include "internal/decomposition.h"
+#include "internal/length.h"
+#include "internal/parallel.h"
 #include "internal/database.h"
 #include "internal/seeking.h"
 #include "internal/streaming.h"
+#include "internal/validation.h"
 
 size_t utf8len(const char* text)
 {
-	const uint8_t* src;
-	size_t src_length;
-	size_t length;
-
 	/* Validate input */
 
 	if (text == 0 ||
@@ -48,54 +49,57 @@ size_t utf8len(const char* text)
 		return 0;
 	}
 
-	length = 0;
-
 	/* Determine length in codepoints */
 
-	src = (const uint8_t*)text;
-	src_length = strlen(text);
-
-	while (src_length > 0)
-	{
-		uint8_t src_offset = 1;
+	return length_execute((const uint8_t*)text, strlen(text));
+}
 
-		/* Check if the current byte is part of a multi-byte sequence */
+size_t utf8nlen(const char* text, size_t textSize)
+{
+	/* Validate input */
 
-		uint8_t codepoint_length = codepoint_decoded_length[*src];
-		if (codepoint_length > 1)
-		{
-			/* Check every byte of the sequence */
+	if (text == 0 ||
+		textSize == 0)
+	{
+		return 0;
+	}
 
-			do
-			{
-				if (src[src_offset] < 0x80 ||  /* Not a continuation byte */
-					src[src_offset] > 0xBF)    /* Start of a new sequence */
-				{
-					break;
-				}
-			}
-			while (++src_offset < codepoint_length);
-		}
+	/* Determine length in codepoints */
 
-		/* Found a codepoint */
+	return length_execute((const uint8_t*)text, textSize);
+}
 
-		length++;
+uint8_t utf8validate(const char* input, size_t inputSize, size_t* errorOffset)
+{
+	size_t offset = 0;
 
-		/* Move cursor */
+	/* Validate input */
 
-		if (src_offset >= src_length)
+	if (input == 0 &&
+		inputSize > 0)
+	{
+		if (errorOffset != 0)
 		{
-			break;
+			*errorOffset = 0;
 		}
 
-		src += src_offset;
-		src_length -= src_offset;
+		return 0;
+	}
+
+	if (inputSize > 0)
+	{
+		offset = validation_execute((const uint8_t*)input, inputSize);
 	}
 
-	return length;
+	if (errorOffset != 0)
+	{
+		*errorOffset = offset;
+	}
+
+	return (offset == inputSize) ? 1 : 0;
 }
 
-size_t utf16toutf8(const utf16_t* input, size_t inputSize, char* target, size_t targetSize, int32_t* errors)
+static size_t utf16toutf8_execute(const utf16_t* input, size_t inputSize, char* target, size_t targetSize, int32_t* errors, utf8result_t* progress)
 {
 	const utf16_t* src;
 	size_t src_size;
@@ -105,6 +109,7 @@ size_t utf16toutf8(const utf16_t* input, size_t inputSize, char* target, size_t
 
 	/* Validate parameters */
 
+	UTF8_SET_PROGRESS(0, bytes_written);
 	UTF8_VALIDATE_PARAMETERS_CHAR(utf16_t, bytes_written);
 	UTF8_SET_ERROR(NONE);
 
@@ -120,8 +125,38 @@ size_t utf16toutf8(const utf16_t* input, size_t inputSize, char* target, size_t
 	while (src_size > 0)
 	{
 		unicode_t codepoint;
+		size_t decoded_size = sizeof(utf16_t);
 		uint8_t encoded_size;
 
+		/* Convert code points in the Basic Multilingual Plane in bulk */
+
+		if (src_size >= CONVERSION_MINIMUM_SIZE)
+		{
+			size_t converted;
+			size_t consumed;
+
+			if (dst != 0)
+			{
+				consumed = conversion_utf16toutf8(src, src_size, dst, dst_size, &converted);
+
+				dst += converted;
+				dst_size -= converted;
+			}
+			else
+			{
+				consumed = conversion_utf16toutf8_size(src, src_size, &converted);
+			}
+
+			src += consumed / sizeof(utf16_t);
+			src_size -= consumed;
+			bytes_written += converted;
+
+			if (src_size == 0)
+			{
+				break;
+			}
+		}
+
 		if (src_size < sizeof(utf16_t))
 		{
 			/* Not enough data */
@@ -173,8 +208,7 @@ size_t utf16toutf8(const utf16_t* input, size_t inputSize, char* target, size_t
 						(src[1] - SURROGATE_LOW_START) +
 						((src[0] - SURROGATE_HIGH_START) << 10);
 
-					src++;
-					src_size -= sizeof(utf16_t);
+					decoded_size = 2 * sizeof(utf16_t);
 				}
 			}
 		}
@@ -182,6 +216,7 @@ size_t utf16toutf8(const utf16_t* input, size_t inputSize, char* target, size_t
 		encoded_size = codepoint_write(codepoint, &dst, &dst_size);
 		if (encoded_size == 0)
 		{
+			UTF8_SET_PROGRESS(inputSize - src_size, bytes_written);
 			UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
 
 			return bytes_written;
@@ -189,10 +224,12 @@ size_t utf16toutf8(const utf16_t* input, size_t inputSize, char* target, size_t
 
 		bytes_written += encoded_size;
 
-		src++;
-		src_size -= sizeof(utf16_t);
+		src += decoded_size / sizeof(utf16_t);
+		src_size -= decoded_size;
 	}
 
+	UTF8_SET_PROGRESS(inputSize, bytes_written);
+
 	return bytes_written;
 
 invaliddata:
@@ -200,6 +237,7 @@ invaliddata:
 	{
 		if (dst_size < REPLACEMENT_CHARACTER_STRING_LENGTH)
 		{
+			UTF8_SET_PROGRESS(inputSize - src_size, bytes_written);
 			UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
 
 			return bytes_written;
@@ -210,12 +248,27 @@ invaliddata:
 		memcpy(dst, REPLACEMENT_CHARACTER_STRING, REPLACEMENT_CHARACTER_STRING_LENGTH);
 	}
 
+	UTF8_SET_PROGRESS(inputSize, bytes_written + REPLACEMENT_CHARACTER_STRING_LENGTH);
 	UTF8_SET_ERROR(INVALID_DATA);
 
 	return bytes_written + REPLACEMENT_CHARACTER_STRING_LENGTH;
 }
 
-size_t utf32toutf8(const unicode_t* input, size_t inputSize, char* target, size_t targetSize, int32_t* errors)
+size_t utf16toutf8(const utf16_t* input, size_t inputSize, char* target, size_t targetSize, int32_t* errors)
+{
+	return utf16toutf8_execute(input, inputSize, target, targetSize, errors, 0);
+}
+
+utf8result_t utf16toutf8_ex(const utf16_t* input, size_t inputSize, char* target, size_t targetSize)
+{
+	utf8result_t result;
+
+	utf16toutf8_execute(input, inputSize, target, targetSize, &result.error, &result);
+
+	return result;
+}
+
+static size_t utf32toutf8_execute(const unicode_t* input, size_t inputSize, char* target, size_t targetSize, int32_t* errors, utf8result_t* progress)
 {
 	const unicode_t* src;
 	size_t src_size;
@@ -225,6 +278,7 @@ size_t utf32toutf8(const unicode_t* input, size_t inputSize, char* target, size_
 
 	/* Validate parameters */
 
+	UTF8_SET_PROGRESS(0, bytes_written);
 	UTF8_VALIDATE_PARAMETERS_CHAR(unicode_t, bytes_written);
 	UTF8_SET_ERROR(NONE);
 
@@ -240,8 +294,38 @@ size_t utf32toutf8(const unicode_t* input, size_t inputSize, char* target, size_
 	while (src_size > 0)
 	{
 		unicode_t codepoint;
+		size_t decoded_size = sizeof(unicode_t);
 		uint8_t encoded_size;
 
+		/* Convert valid code points in bulk */
+
+		if (src_size >= CONVERSION_MINIMUM_SIZE)
+		{
+			size_t converted;
+			size_t consumed;
+
+			if (dst != 0)
+			{
+				consumed = conversion_utf32toutf8(src, src_size, dst, dst_size, &converted);
+
+				dst += converted;
+				dst_size -= converted;
+			}
+			else
+			{
+				consumed = conversion_utf32toutf8_size(src, src_size, &converted);
+			}
+
+			src += consumed / sizeof(unicode_t);
+			src_size -= consumed;
+			bytes_written += converted;
+
+			if (src_size == 0)
+			{
+				break;
+			}
+		}
+
 		if (src_size < sizeof(unicode_t))
 		{
 			/* Not enough data */
@@ -293,8 +377,7 @@ size_t utf32toutf8(const unicode_t* input, size_t inputSize, char* target, size_
 						(src[1] - SURROGATE_LOW_START) +
 						((src[0] - SURROGATE_HIGH_START) << 10);
 
-					src++;
-					src_size -= sizeof(unicode_t);
+					decoded_size = 2 * sizeof(unicode_t);
 				}
 			}
 		}
@@ -302,6 +385,7 @@ size_t utf32toutf8(const unicode_t* input, size_t inputSize, char* target, size_
 		encoded_size = codepoint_write(codepoint, &dst, &dst_size);
 		if (encoded_size == 0)
 		{
+			UTF8_SET_PROGRESS(inputSize - src_size, bytes_written);
 			UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
 
 			return bytes_written;
@@ -309,10 +393,12 @@ size_t utf32toutf8(const unicode_t* input, size_t inputSize, char* target, size_
 
 		bytes_written += encoded_size;
 
-		src++;
-		src_size -= sizeof(unicode_t);
+		src += decoded_size / sizeof(unicode_t);
+		src_size -= decoded_size;
 	}
 
+	UTF8_SET_PROGRESS(inputSize, bytes_written);
+
 	return bytes_written;
 
 invaliddata:
@@ -320,6 +406,7 @@ invaliddata:
 	{
 		if (dst_size < REPLACEMENT_CHARACTER_STRING_LENGTH)
 		{
+			UTF8_SET_PROGRESS(inputSize - src_size, bytes_written);
 			UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
 
 			return bytes_written;
@@ -330,11 +417,26 @@ invaliddata:
 		memcpy(dst, REPLACEMENT_CHARACTER_STRING, REPLACEMENT_CHARACTER_STRING_LENGTH);
 	}
 
+	UTF8_SET_PROGRESS(inputSize, bytes_written + REPLACEMENT_CHARACTER_STRING_LENGTH);
 	UTF8_SET_ERROR(INVALID_DATA);
 
 	return bytes_written + REPLACEMENT_CHARACTER_STRING_LENGTH;
 }
 
+size_t utf32toutf8(const unicode_t* input, size_t inputSize, char* target, size_t targetSize, int32_t* errors)
+{
+	return utf32toutf8_execute(input, inputSize, target, targetSize, errors, 0);
+}
+
+utf8result_t utf32toutf8_ex(const unicode_t* input, size_t inputSize, char* target, size_t targetSize)
+{
+	utf8result_t result;
+
+	utf32toutf8_execute(input, inputSize, target, targetSize, &result.error, &result);
+
+	return result;
+}
+
 size_t widetoutf8(const wchar_t* input, size_t inputSize, char* target, size_t targetSize, int32_t* errors)
 {
 #if UTF8_WCHAR_UTF16
@@ -346,7 +448,24 @@ size_t widetoutf8(const wchar_t* input, size_t inputSize, char* target, size_t t
 #endif
 }
 
-size_t utf8toutf16(const char* input, size_t inputSize, utf16_t* target, size_t targetSize, int32_t* errors)
+utf8result_t widetoutf8_ex(const wchar_t* input, size_t inputSize, char* target, size_t targetSize)
+{
+#if UTF8_WCHAR_UTF16
+	return utf16toutf8_ex((const utf16_t*)input, inputSize, target, targetSize);
+#elif UTF8_WCHAR_UTF32
+	return utf32toutf8_ex((const unicode_t*)input, inputSize, target, targetSize);
+#else
+	utf8result_t result;
+
+	result.consumed = 0;
+	result.produced = SIZE_MAX;
+	result.error = UTF8_ERR_NONE;
+
+	return result;
+#endif
+}
+
+static size_t utf8toutf16_execute(const char* input, size_t inputSize, utf16_t* target, size_t targetSize, int32_t* errors, utf8result_t* progress)
 {
 	const char* src;
 	size_t src_size;
@@ -356,6 +475,7 @@ size_t utf8toutf16(const char* input, size_t inputSize, utf16_t* target, size_t
 
 	/* Validate parameters */
 
+	UTF8_SET_PROGRESS(0, bytes_written);
 	UTF8_VALIDATE_PARAMETERS(char, utf16_t, bytes_written);
 
 	/* Setup cursors */
@@ -370,7 +490,38 @@ size_t utf8toutf16(const char* input, size_t inputSize, utf16_t* target, size_t
 	while (src_size > 0)
 	{
 		unicode_t decoded;
-		uint8_t decoded_size = codepoint_read(src, src_size, &decoded);
+		uint8_t decoded_size;
+
+		/* Convert sequences of up to three bytes in bulk */
+
+		if (src_size >= CONVERSION_MINIMUM_SIZE)
+		{
+			size_t converted;
+			size_t consumed;
+
+			if (dst != 0)
+			{
+				consumed = conversion_utf8toutf16(src, src_size, dst, dst_size, &converted);
+
+				dst += converted / sizeof(utf16_t);
+				dst_size -= converted;
+			}
+			else
+			{
+				consumed = conversion_utf8toutf16_size(src, src_size, &converted);
+			}
+
+			src += consumed;
+			src_size -= consumed;
+			bytes_written += converted;
+
+			if (src_size == 0)
+			{
+				break;
+			}
+		}
+
+		decoded_size = codepoint_read(src, src_size, &decoded);
 
 		if (decoded <= MAX_BASIC_MULTILINGUAL_PLANE)
 		{
@@ -382,6 +533,7 @@ size_t utf8toutf16(const char* input, size_t inputSize, utf16_t* target, size_t
 
 				if (dst_size < sizeof(utf16_t))
 				{
+					UTF8_SET_PROGRESS(inputSize - src_size, bytes_written);
 					UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
 
 					return bytes_written;
@@ -403,6 +555,7 @@ size_t utf8toutf16(const char* input, size_t inputSize, utf16_t* target, size_t
 
 				if (dst_size < 2 * sizeof(utf16_t))
 				{
+					UTF8_SET_PROGRESS(inputSize - src_size, bytes_written);
 					UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
 
 					return bytes_written;
@@ -424,12 +577,27 @@ size_t utf8toutf16(const char* input, size_t inputSize, utf16_t* target, size_t
 		src_size -= decoded_size;
 	}
 
+	UTF8_SET_PROGRESS(inputSize, bytes_written);
 	UTF8_SET_ERROR(NONE);
 
 	return bytes_written;
 }
 
-size_t utf8toutf32(const char* input, size_t inputSize, unicode_t* target, size_t targetSize, int32_t* errors)
+size_t utf8toutf16(const char* input, size_t inputSize, utf16_t* target, size_t targetSize, int32_t* errors)
+{
+	return utf8toutf16_execute(input, inputSize, target, targetSize, errors, 0);
+}
+
+utf8result_t utf8toutf16_ex(const char* input, size_t inputSize, utf16_t* target, size_t targetSize)
+{
+	utf8result_t result;
+
+	utf8toutf16_execute(input, inputSize, target, targetSize, &result.error, &result);
+
+	return result;
+}
+
+static size_t utf8toutf32_execute(const char* input, size_t inputSize, unicode_t* target, size_t targetSize, int32_t* errors, utf8result_t* progress)
 {
 	const char* src;
 	size_t src_size;
@@ -439,6 +607,7 @@ size_t utf8toutf32(const char* input, size_t inputSize, unicode_t* target, size_
 
 	/* Validate parameters */
 
+	UTF8_SET_PROGRESS(0, bytes_written);
 	UTF8_VALIDATE_PARAMETERS(char, unicode_t, bytes_written);
 
 	/* Setup cursors */
@@ -453,7 +622,38 @@ size_t utf8toutf32(const char* input, size_t inputSize, unicode_t* target, size_
 	while (src_size > 0)
 	{
 		unicode_t decoded;
-		uint8_t decoded_length = codepoint_read(src, src_size, &decoded);
+		uint8_t decoded_length;
+
+		/* Convert valid sequences in bulk */
+
+		if (src_size >= CONVERSION_MINIMUM_SIZE)
+		{
+			size_t converted;
+			size_t consumed;
+
+			if (dst != 0)
+			{
+				consumed = conversion_utf8toutf32(src, src_size, dst, dst_size, &converted);
+
+				dst += converted / sizeof(unicode_t);
+				dst_size -= converted;
+			}
+			else
+			{
+				consumed = conversion_utf8toutf32_size(src, src_size, &converted);
+			}
+
+			src += consumed;
+			src_size -= consumed;
+			bytes_written += converted;
+
+			if (src_size == 0)
+			{
+				break;
+			}
+		}
+
+		decoded_length = codepoint_read(src, src_size, &decoded);
 
 		if (dst != 0)
 		{
@@ -461,6 +661,7 @@ size_t utf8toutf32(const char* input, size_t inputSize, unicode_t* target, size_
 
 			if (dst_size < sizeof(unicode_t))
 			{
+				UTF8_SET_PROGRESS(inputSize - src_size, bytes_written);
 				UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
 
 				return bytes_written;
@@ -476,11 +677,26 @@ size_t utf8toutf32(const char* input, size_t inputSize, unicode_t* target, size_
 		src_size -= decoded_length;
 	}
 
+	UTF8_SET_PROGRESS(inputSize, bytes_written);
 	UTF8_SET_ERROR(NONE);
 
 	return bytes_written;
 }
 
+size_t utf8toutf32(const char* input, size_t inputSize, unicode_t* target, size_t targetSize, int32_t* errors)
+{
+	return utf8toutf32_execute(input, inputSize, target, targetSize, errors, 0);
+}
+
+utf8result_t utf8toutf32_ex(const char* input, size_t inputSize, unicode_t* target, size_t targetSize)
+{
+	utf8result_t result;
+
+	utf8toutf32_execute(input, inputSize, target, targetSize, &result.error, &result);
+
+	return result;
+}
+
 size_t utf8towide(const char* input, size_t inputSize, wchar_t* target, size_t targetSize, int32_t* errors)
 {
 #if UTF8_WCHAR_UTF16
@@ -492,6 +708,75 @@ size_t utf8towide(const char* input, size_t inputSize, wchar_t* target, size_t t
 #endif
 }
 
+utf8result_t utf8towide_ex(const char* input, size_t inputSize, wchar_t* target, size_t targetSize)
+{
+#if UTF8_WCHAR_UTF16
+	return utf8toutf16_ex(input, inputSize, (utf16_t*)target, targetSize);
+#elif UTF8_WCHAR_UTF32
+	return utf8toutf32_ex(input, inputSize, (unicode_t*)target, targetSize);
+#else
+	utf8result_t result;
+
+	result.consumed = 0;
+	result.produced = SIZE_MAX;
+	result.error = UTF8_ERR_NONE;
+
+	return result;
+#endif
+}
+
+size_t utf16toutf8_parallel(const utf16_t* input, size_t inputSize, char* target, size_t targetSize, const utf8executor_t* executor, int32_t* errors)
+{
+	return parallel_utf16toutf8(input, inputSize, target, targetSize, executor, errors);
+}
+
+size_t utf8toutf16_parallel(const char* input, size_t inputSize, utf16_t* target, size_t targetSize, const utf8executor_t* executor, int32_t* errors)
+{
+	return parallel_utf8toutf16(input, inputSize, target, targetSize, executor, errors);
+}
+
+size_t utf16toutf8_size(const utf16_t* input, size_t inputSize, int32_t* errors)
+{
+	return utf16toutf8(input, inputSize, 0, 0, errors);
+}
+
+size_t utf32toutf8_size(const unicode_t* input, size_t inputSize, int32_t* errors)
+{
+	return utf32toutf8(input, inputSize, 0, 0, errors);
+}
+
+size_t widetoutf8_size(const wchar_t* input, size_t inputSize, int32_t* errors)
+{
+#if UTF8_WCHAR_UTF16
+	return utf16toutf8_size((const utf16_t*)input, inputSize, errors);
+#elif UTF8_WCHAR_UTF32
+	return utf32toutf8_size((const unicode_t*)input, inputSize, errors);
+#else
+	return SIZE_MAX;
+#endif
+}
+
+size_t utf8toutf16_size(const char* input, size_t inputSize, int32_t* errors)
+{
+	return utf8toutf16(input, inputSize, 0, 0, errors);
+}
+
+size_t utf8toutf32_size(const char* input, size_t inputSize, int32_t* errors)
+{
+	return utf8toutf32(input, inputSize, 0, 0, errors);
+}
+
+size_t utf8towide_size(const char* input, size_t inputSize, int32_t* errors)
+{
+#if UTF8_WCHAR_UTF16
+	return utf8toutf16_size(input, inputSize, errors);
+#elif UTF8_WCHAR_UTF32
+	return utf8toutf32_size(input, inputSize, errors);
+#else
+	return SIZE_MAX;
+#endif
+}
+
 const char* utf8seek(const char* text, size_t textSize, const char* textStart, off_t offset, int direction)
 {
 	const char* text_end;
@@ -544,65 +829,238 @@ const char* utf8seek(const char* text, size_t textSize, const char* textStart, o
 	}
 }
 
-UTF8_API size_t utf8envlocale()
+size_t utf8seekindex(const char* text, size_t textSize, size_t interval, size_t* target, size_t targetSize, int32_t* errors)
 {
-	/*
-		Sources for locales and code pages
-
-		Windows
-		https://msdn.microsoft.com/en-US/goglobal/bb896001.aspx
-
-		POSIX
-		https://www-01.ibm.com/support/knowledgecenter/ssw_aix_61/com.ibm.aix.nlsgdrf/support_languages_locales.htm
-	*/
-
-#if WIN32 || _WINDOWS
-	#define UTF8_LOCALE_CHECK(_name, _ansiCodepage, _oemCodepage) \
-		(codepage == _ansiCodepage || codepage == _oemCodepage)
-
-	unsigned int codepage;
-	_locale_t locale = _get_current_locale();
+	return seeking_index(text, textSize, interval, target, targetSize, errors);
+}
 
-	if (locale == 0)
+const char* utf8seek_indexed(const char* text, size_t textSize, const char* textStart, off_t offset, int direction, const size_t* index, size_t indexSize)
+{
+	if (direction != SEEK_SET ||
+		text == 0 ||
+		textStart == 0)
 	{
-		return UTF8_LOCALE_DEFAULT;
+		return utf8seek(text, textSize, textStart, offset, direction);
 	}
 
-	// Microsoft changed the name of the codepage member in VS2015.
-
-	#if _MSC_VER >= 1900
-		codepage = ((__crt_locale_data_public*)(locale)->locinfo)->_locale_lc_codepage;
-	#else
-		codepage = locale->locinfo->lc_codepage;
-	#endif
-#else
-	#define UTF8_LOCALE_CHECK(_name, _ansiCodepage, _oemCodepage) \
-		!strncasecmp(locale, _name, 5)
-
-	const char* locale = setlocale(LC_ALL, 0);
-	if (locale == 0)
+	if (text < textStart)
 	{
-		return UTF8_LOCALE_DEFAULT;
+		return text;
 	}
-#endif
 
-	if (UTF8_LOCALE_CHECK("lt_lt", 1257, 775))
-	{
-		return UTF8_LOCALE_LITHUANIAN;
-	}
-	else if (
-		UTF8_LOCALE_CHECK("tr_tr", 1254, 857) ||
-		UTF8_LOCALE_CHECK("az_az", 1254, 857))
+	return seeking_indexed(textStart, textSize, offset, index, indexSize);
+}
+
+void utf8cursor_init(utf8cursor_t* cursor, const char* text, size_t textSize)
+{
+	if (cursor == 0)
 	{
-		return UTF8_LOCALE_TURKISH_AND_AZERI_LATIN;
+		return;
 	}
 
-	return UTF8_LOCALE_DEFAULT;
+	cursor->text = text;
+	cursor->textSize = (text != 0) ? textSize : 0;
+	cursor->offset = 0;
+	cursor->index = 0;
 }
 
-size_t utf8toupper(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors)
+uint8_t utf8cursor_next(utf8cursor_t* cursor)
 {
+	if (cursor == 0 ||
+		cursor->offset >= cursor->textSize)
+	{
+		return 0;
+	}
+
+	cursor->offset = (size_t)(seeking_next(cursor->text + cursor->offset, cursor->text + cursor->textSize) - cursor->text);
+	cursor->index++;
+
+	return 1;
+}
+
+uint8_t utf8cursor_prev(utf8cursor_t* cursor)
+{
+	if (cursor == 0 ||
+		cursor->offset == 0)
+	{
+		return 0;
+	}
+
+	cursor->offset = (size_t)(seeking_previous(cursor->text, cursor->text + cursor->offset) - cursor->text);
+	cursor->index--;
+
+	return 1;
+}
+
+off_t utf8cursor_advance(utf8cursor_t* cursor, off_t offset)
+{
+	const char* src;
+	const char* src_end;
+	const char* dst;
+
+	if (cursor == 0 ||
+		offset == 0)
+	{
+		return 0;
+	}
+
+	src = cursor->text + cursor->offset;
+	src_end = cursor->text + cursor->textSize;
+
+	if (offset > 0)
+	{
+		off_t moved = 0;
+
+		if (src >= src_end)
+		{
+			return 0;
+		}
+
+		dst = seeking_forward(src, src_end, (size_t)(src_end - src), offset);
+		if (dst < src_end)
+		{
+			moved = offset;
+		}
+		else
+		{
+			/* Stopped at the end, count the code points that were skipped */
+
+			while (src < src_end)
+			{
+				src = seeking_next(src, src_end);
+				moved++;
+			}
+		}
+
+		cursor->offset = (size_t)(dst - cursor->text);
+		cursor->index += (size_t)moved;
+
+		return moved;
+	}
+	else
+	{
+		off_t moved;
+
+		if (cursor->offset == 0)
+		{
+			return 0;
+		}
+
+		dst = seeking_rewind(cursor->text, src, cursor->offset, offset);
+		if (dst > cursor->text)
+		{
+			moved = offset;
+		}
+		else
+		{
+			/* Stopped at the start */
+
+			moved = -(off_t)cursor->index;
+		}
+
+		cursor->offset = (size_t)(dst - cursor->text);
+		cursor->index -= (size_t)-moved;
+
+		return moved;
+	}
+}
+
+unicode_t utf8cursor_codepoint(const utf8cursor_t* cursor)
+{
+	const char* src;
+	unicode_t decoded = 0;
+
+	if (cursor == 0 ||
+		cursor->offset >= cursor->textSize)
+	{
+		return 0;
+	}
+
+	src = cursor->text + cursor->offset;
+
+	/* Decode no further than the next code point */
+
+	codepoint_read(src, (size_t)(seeking_next(src, cursor->text + cursor->textSize) - src), &decoded);
+
+	return decoded;
+}
+
+UTF8_API size_t utf8envlocale()
+{
+	/*
+		Sources for locales and code pages
+
+		Windows
+		https://msdn.microsoft.com/en-US/goglobal/bb896001.aspx
+
+		POSIX
+		https://www-01.ibm.com/support/knowledgecenter/ssw_aix_61/com.ibm.aix.nlsgdrf/support_languages_locales.htm
+	*/
+
+#if WIN32 || _WINDOWS
+	#define UTF8_LOCALE_CHECK(_name, _ansiCodepage, _oemCodepage) \
+		(codepage == _ansiCodepage || codepage == _oemCodepage)
+
+	unsigned int codepage;
+	_locale_t locale = _get_current_locale();
+
+	if (locale == 0)
+	{
+		return UTF8_LOCALE_DEFAULT;
+	}
+
+	// Microsoft changed the name of the codepage member in VS2015.
+
+	#if _MSC_VER >= 1900
+		codepage = ((__crt_locale_data_public*)(locale)->locinfo)->_locale_lc_codepage;
+	#else
+		codepage = locale->locinfo->lc_codepage;
+	#endif
+#else
+	#define UTF8_LOCALE_CHECK(_name, _ansiCodepage, _oemCodepage) \
+		!strncasecmp(locale, _name, 5)
+
+	const char* locale = setlocale(LC_ALL, 0);
+	if (locale == 0)
+	{
+		return UTF8_LOCALE_DEFAULT;
+	}
+#endif
+
+	if (UTF8_LOCALE_CHECK("lt_lt", 1257, 775))
+	{
+		return UTF8_LOCALE_LITHUANIAN;
+	}
+	else if (
+		UTF8_LOCALE_CHECK("tr_tr", 1254, 857) ||
+		UTF8_LOCALE_CHECK("az_az", 1254, 857))
+	{
+		return UTF8_LOCALE_TURKISH_AND_AZERI_LATIN;
+	}
+
+	return UTF8_LOCALE_DEFAULT;
+}
+
+static size_t utf8toupper_execute(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors, utf8result_t* progress)
+{
+#if UTF8_EXCLUDE_UPPERCASE
+	/* Case mapping was excluded from the build */
+
+	(void)input;
+	(void)inputSize;
+	(void)target;
+	(void)targetSize;
+	(void)locale;
+
+	UTF8_SET_PROGRESS(0, 0);
+	UTF8_SET_ERROR(INVALID_FLAG);
+
+	return 0;
+#else
 	CaseMappingState state;
+	CaseMappingExecute execute;
+
+	UTF8_SET_PROGRESS(0, 0);
 
 	/* Validate parameters */
 
@@ -621,28 +1079,81 @@ size_t utf8toupper(const char* input, size_t inputSize, char* target, size_t tar
 		return state.total_bytes_needed;
 	}
 
+	/* Select the engine for the locale once, instead of checking it for every code point */
+
+	execute = casemapping_engine(state.locale);
+
 	/* Execute case mapping as long as input remains */
 
 	while (state.src_size > 0)
 	{
+		const char* sequence = state.src;
 		size_t converted;
 
-		if ((converted = casemapping_execute(&state, errors)) == 0)
+		/* Map runs of Basic Latin at once, a lone space between words of other scripts is cheaper to map by itself */
+
+		if (state.src_size >= 16 &&
+			(uint8_t)(state.src[0] | state.src[1]) <= MAX_BASIC_LATIN &&
+			(converted = casemapping_execute_basic_latin(&state)) > 0)
+		{
+			state.total_bytes_needed += converted;
+
+			continue;
+		}
+
+		if ((converted = execute(&state, errors)) == 0)
 		{
+			UTF8_SET_PROGRESS((size_t)(sequence - input), state.total_bytes_needed);
+
 			return state.total_bytes_needed;
 		}
 
 		state.total_bytes_needed += converted;
 	}
 
+	UTF8_SET_PROGRESS(inputSize, state.total_bytes_needed);
 	UTF8_SET_ERROR(NONE);
 
 	return state.total_bytes_needed;
+#endif
 }
 
-size_t utf8tolower(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors)
+size_t utf8toupper(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors)
+{
+	return utf8toupper_execute(input, inputSize, target, targetSize, locale, errors, 0);
+}
+
+utf8result_t utf8toupper_ex(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale)
 {
+	utf8result_t result;
+
+	utf8toupper_execute(input, inputSize, target, targetSize, locale, &result.error, &result);
+
+	return result;
+}
+
+static size_t utf8tolower_execute(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors, utf8result_t* progress)
+{
+#if UTF8_EXCLUDE_LOWERCASE
+	/* Case mapping was excluded from the build */
+
+	(void)input;
+	(void)inputSize;
+	(void)target;
+	(void)targetSize;
+	(void)locale;
+
+	UTF8_SET_PROGRESS(0, 0);
+	UTF8_SET_ERROR(INVALID_FLAG);
+
+	return 0;
+#else
 	CaseMappingState state;
+	CaseMappingExecute execute;
+	const char* previous = input;
+	size_t previous_total = 0;
+
+	UTF8_SET_PROGRESS(0, 0);
 
 	/* Validate parameters */
 
@@ -661,28 +1172,97 @@ size_t utf8tolower(const char* input, size_t inputSize, char* target, size_t tar
 		return state.total_bytes_needed;
 	}
 
+	/* Select the engine for the locale once, instead of checking it for every code point */
+
+	execute = casemapping_engine(state.locale);
+
 	/* Execute case mapping as long as input remains */
 
 	while (state.src_size > 0)
 	{
+		const char* sequence = state.src;
 		size_t converted;
 
-		if ((converted = casemapping_execute(&state, errors)) == 0)
+		/* Map runs of Basic Latin at once, a lone space between words of other scripts is cheaper to map by itself */
+
+		if (state.src_size >= 16 &&
+			(uint8_t)(state.src[0] | state.src[1]) <= MAX_BASIC_LATIN &&
+			(converted = casemapping_execute_basic_latin(&state)) > 0)
 		{
+			previous = state.src - 1;
+			previous_total = state.total_bytes_needed + converted - 1;
+
+			state.total_bytes_needed += converted;
+
+			continue;
+		}
+
+		if ((converted = execute(&state, errors)) == 0)
+		{
+			/* GREEK CAPITAL LETTER SIGMA depends on the code point before it */
+
+			if (state.last_code_point == CP_GREEK_CAPITAL_LETTER_SIGMA &&
+				sequence != input)
+			{
+				UTF8_SET_PROGRESS((size_t)(previous - input), previous_total);
+			}
+			else
+			{
+				UTF8_SET_PROGRESS((size_t)(sequence - input), state.total_bytes_needed);
+			}
+
 			return state.total_bytes_needed;
 		}
 
+		previous = sequence;
+		previous_total = state.total_bytes_needed;
+
 		state.total_bytes_needed += converted;
 	}
 
+	UTF8_SET_PROGRESS(inputSize, state.total_bytes_needed);
 	UTF8_SET_ERROR(NONE);
 
 	return state.total_bytes_needed;
+#endif
 }
 
-size_t utf8totitle(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors)
+size_t utf8tolower(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors)
+{
+	return utf8tolower_execute(input, inputSize, target, targetSize, locale, errors, 0);
+}
+
+utf8result_t utf8tolower_ex(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale)
 {
+	utf8result_t result;
+
+	utf8tolower_execute(input, inputSize, target, targetSize, locale, &result.error, &result);
+
+	return result;
+}
+
+static size_t utf8totitle_execute(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors, utf8result_t* progress)
+{
+#if UTF8_EXCLUDE_TITLECASE
+	/* Case mapping was excluded from the build */
+
+	(void)input;
+	(void)inputSize;
+	(void)target;
+	(void)targetSize;
+	(void)locale;
+
+	UTF8_SET_PROGRESS(0, 0);
+	UTF8_SET_ERROR(INVALID_FLAG);
+
+	return 0;
+#else
 	CaseMappingState state;
+	CaseMappingExecute execute;
+	const char* word = input;
+	size_t word_total = 0;
+
+	UTF8_SET_PROGRESS(0, 0);
 
 	/* Validate parameters */
 
@@ -701,14 +1281,28 @@ size_t utf8totitle(const char* input, size_t inputSize, char* target, size_t tar
 		return state.total_bytes_needed;
 	}
 
+	/* Select the engine for the locale once, instead of checking it for every code point */
+
+	execute = casemapping_engine(state.locale);
+
 	/* Execute case mapping as long as input remains */
 
 	while (state.src_size > 0)
 	{
 		size_t converted;
-		
-		if ((converted = casemapping_execute(&state, errors)) == 0)
+
+		/* Resume from the start of the word */
+
+		if (state.property_data == TitlecaseDataPtr)
 		{
+			word = state.src;
+			word_total = state.total_bytes_needed;
+		}
+
+		if ((converted = execute(&state, errors)) == 0)
+		{
+			UTF8_SET_PROGRESS((size_t)(word - input), word_total);
+
 			return state.total_bytes_needed;
 		}
 
@@ -744,14 +1338,47 @@ size_t utf8totitle(const char* input, size_t inputSize, char* target, size_t tar
 		state.total_bytes_needed += converted;
 	}
 
+	UTF8_SET_PROGRESS(inputSize, state.total_bytes_needed);
 	UTF8_SET_ERROR(NONE);
 
 	return state.total_bytes_needed;
+#endif
 }
 
-size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors)
+size_t utf8totitle(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors)
 {
+	return utf8totitle_execute(input, inputSize, target, targetSize, locale, errors, 0);
+}
+
+utf8result_t utf8totitle_ex(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale)
+{
+	utf8result_t result;
+
+	utf8totitle_execute(input, inputSize, target, targetSize, locale, &result.error, &result);
+
+	return result;
+}
+
+static size_t utf8casefold_execute(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors, utf8result_t* progress)
+{
+#if UTF8_EXCLUDE_CASEFOLDING
+	/* Case mapping was excluded from the build */
+
+	(void)input;
+	(void)inputSize;
+	(void)target;
+	(void)targetSize;
+	(void)locale;
+
+	UTF8_SET_PROGRESS(0, 0);
+	UTF8_SET_ERROR(INVALID_FLAG);
+
+	return 0;
+#else
 	CaseMappingState state;
+	const char* sequence = input;
+
+	UTF8_SET_PROGRESS(0, 0);
 
 	/* Validate parameters */
 
@@ -778,6 +1405,10 @@ size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t ta
 		{
 			const char* resolved = 0;
 			uint8_t bytes_needed = 0;
+			unicode_t mapped;
+			uint32_t record;
+
+			sequence = state.src;
 
 			/* Read next code point */
 
@@ -786,6 +1417,8 @@ size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t ta
 				goto invaliddata;
 			}
 
+			mapped = state.last_code_point;
+
 			/* Move source cursor */
 
 			if (state.src_size >= state.last_code_point_size)
@@ -815,7 +1448,17 @@ size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t ta
 				}
 				else
 				{
-					resolved = database_querydecomposition(state.last_code_point, state.property_index1, state.property_index2, state.property_data, &bytes_needed);
+					record = CASEMAPPING_GET(state.last_code_point, state.property_index1, state.property_index2, state.property_data);
+					if ((record & CASEMAPPING_RECORD_SIMPLE) != 0)
+					{
+						mapped = CASEMAPPING_RECORD_MAPPED(state.last_code_point, record);
+					}
+					else if (
+						record != 0)
+					{
+						resolved = CASEMAPPING_RECORD_STRING(record);
+						bytes_needed = CASEMAPPING_RECORD_LENGTH(record);
+					}
 				}
 			}
 
@@ -840,9 +1483,9 @@ size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t ta
 			}
 			else
 			{
-				/* Write code point unchanged to output */
+				/* Write code point to output, mapped if it has a simple case mapping */
 
-				if (!(bytes_needed = codepoint_write(state.last_code_point, &state.dst, &state.dst_size)))
+				if (!(bytes_needed = codepoint_write(mapped, &state.dst, &state.dst_size)))
 				{
 					goto outofspace;
 				}
@@ -859,6 +1502,10 @@ size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t ta
 		{
 			const char* resolved = 0;
 			uint8_t bytes_needed = 0;
+			unicode_t mapped;
+			uint32_t record;
+
+			sequence = state.src;
 
 			/* Read next code point */
 
@@ -867,6 +1514,8 @@ size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t ta
 				goto invaliddata;
 			}
 
+			mapped = state.last_code_point;
+
 			/* Move source cursor */
 
 			if (state.src_size >= state.last_code_point_size)
@@ -883,7 +1532,17 @@ size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t ta
 
 			if ((PROPERTY_GET_CM(state.last_code_point) & QuickCheckCaseMapped_Casefolded) != 0)
 			{
-				resolved = database_querydecomposition(state.last_code_point, state.property_index1, state.property_index2, state.property_data, &bytes_needed);
+				record = CASEMAPPING_GET(state.last_code_point, state.property_index1, state.property_index2, state.property_data);
+				if ((record & CASEMAPPING_RECORD_SIMPLE) != 0)
+				{
+					mapped = CASEMAPPING_RECORD_MAPPED(state.last_code_point, record);
+				}
+				else if (
+					record != 0)
+				{
+					resolved = CASEMAPPING_RECORD_STRING(record);
+					bytes_needed = CASEMAPPING_RECORD_LENGTH(record);
+				}
 			}
 
 			if (resolved != 0)
@@ -905,9 +1564,9 @@ size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t ta
 			}
 			else
 			{
-				/* Write code point unchanged to output */
+				/* Write code point to output, mapped if it has a simple case mapping */
 
-				if (!(bytes_needed = codepoint_write(state.last_code_point, &state.dst, &state.dst_size)))
+				if (!(bytes_needed = codepoint_write(mapped, &state.dst, &state.dst_size)))
 				{
 					goto outofspace;
 				}
@@ -917,19 +1576,355 @@ size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t ta
 		}
 	}
 
+	UTF8_SET_PROGRESS(inputSize, state.total_bytes_needed);
 	UTF8_SET_ERROR(NONE);
 
 	return state.total_bytes_needed;
 
 invaliddata:
+	UTF8_SET_PROGRESS((size_t)(sequence - input), state.total_bytes_needed);
 	UTF8_SET_ERROR(INVALID_DATA);
 
 	return state.total_bytes_needed;
 
 outofspace:
+	UTF8_SET_PROGRESS((size_t)(sequence - input), state.total_bytes_needed);
 	UTF8_SET_ERROR(NOT_ENOUGH_SPACE);
 
 	return state.total_bytes_needed;
+#endif
+}
+
+size_t utf8casefold(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale, int32_t* errors)
+{
+	return utf8casefold_execute(input, inputSize, target, targetSize, locale, errors, 0);
+}
+
+utf8result_t utf8casefold_ex(const char* input, size_t inputSize, char* target, size_t targetSize, size_t locale)
+{
+	utf8result_t result;
+
+	utf8casefold_execute(input, inputSize, target, targetSize, locale, &result.error, &result);
+
+	return result;
+}
+
+char* utf8toupper_alloc(const char* input, size_t inputSize, size_t locale, const utf8allocator_t* allocator, size_t* outputSize, int32_t* errors)
+{
+	return allocation_transform(utf8toupper_ex, input, inputSize, locale, allocator, outputSize, errors);
+}
+
+char* utf8tolower_alloc(const char* input, size_t inputSize, size_t locale, const utf8allocator_t* allocator, size_t* outputSize, int32_t* errors)
+{
+	return allocation_transform(utf8tolower_ex, input, inputSize, locale, allocator, outputSize, errors);
+}
+
+char* utf8totitle_alloc(const char* input, size_t inputSize, size_t locale, const utf8allocator_t* allocator, size_t* outputSize, int32_t* errors)
+{
+	return allocation_transform(utf8totitle_ex, input, inputSize, locale, allocator, outputSize, errors);
+}
+
+char* utf8casefold_alloc(const char* input, size_t inputSize, size_t locale, const utf8allocator_t* allocator, size_t* outputSize, int32_t* errors)
+{
+	return allocation_transform(utf8casefold_ex, input, inputSize, locale, allocator, outputSize, errors);
+}
+
+#if !(UTF8_EXCLUDE_UPPERCASE && UTF8_EXCLUDE_LOWERCASE && UTF8_EXCLUDE_CASEFOLDING)
+
+static utf8result_t casemapping_inplace(
+	char* text, size_t textSize,
+	const uint32_t* propertyIndex1, const uint32_t* propertyIndex2, const uint32_t* propertyData,
+	uint8_t quickCheck, size_t locale,
+	CaseMappingExecute execute)
+{
+	CaseMappingState state;
+	char* write = text;
+	char mapped[STREAM_BUFFER_MAX * 4];
+	utf8result_t result;
+
+	result.consumed = 0;
+	result.produced = 0;
+
+	/* Validate parameters */
+
+	if (text == 0)
+	{
+		result.error = UTF8_ERR_INVALID_DATA;
+
+		return result;
+	}
+
+	/* Initialize case mapping */
+
+	if (!casemapping_initialize(
+		&state,
+		text, textSize,
+		mapped, sizeof(mapped),
+		propertyIndex1, propertyIndex2, propertyData,
+		quickCheck, locale,
+		&result.error))
+	{
+		return result;
+	}
+
+	/* Execute case mapping as long as input remains */
+
+	while (state.src_size > 0)
+	{
+		const char* sequence = state.src;
+		size_t converted;
+
+		/* Runs of Basic Latin keep their length, so they can be written directly */
+
+		if (state.src_size >= 16 &&
+			(uint8_t)(state.src[0] | state.src[1]) <= MAX_BASIC_LATIN)
+		{
+			state.dst = write;
+			state.dst_size = (size_t)(state.src - write) + state.src_size;
+
+			if ((converted = casemapping_execute_basic_latin(&state)) > 0)
+			{
+				write += converted;
+				state.total_bytes_needed += converted;
+
+				continue;
+			}
+		}
+
+		/* Code points without a case mapping are left as they are */
+
+		state.last_code_point_size = codepoint_read(state.src, state.src_size, &state.last_code_point);
+		if (state.last_code_point != REPLACEMENT_CHARACTER &&
+			(PROPERTY_GET_CM(state.last_code_point) & quickCheck) == 0)
+		{
+			if (write != sequence)
+			{
+				memmove(write, sequence, state.last_code_point_size);
+			}
+
+			write += state.last_code_point_size;
+			state.src += state.last_code_point_size;
+			state.src_size -= state.last_code_point_size;
+			state.total_bytes_needed += state.last_code_point_size;
+
+			continue;
+		}
+
+		if (execute == casemapping_execute_default ||
+			execute == casemapping_execute_casefold)
+		{
+			/*
+				These engines read the code point before writing its mapping and
+				write nothing when it does not fit, so the mapping can be written
+				directly as long as it does not reach past the code point it replaces
+			*/
+
+			state.dst = write;
+			state.dst_size = (size_t)(sequence - write) + state.last_code_point_size;
+
+			if ((converted = execute(&state, &result.error)) == 0)
+			{
+				result.consumed = (size_t)(sequence - text);
+				result.produced = (size_t)(write - text);
+
+				return result;
+			}
+		}
+		else
+		{
+			/* Locale-specific mappings can span more than one code point, so they are mapped to a buffer first */
+
+			state.dst = mapped;
+			state.dst_size = sizeof(mapped);
+
+			if ((converted = execute(&state, &result.error)) == 0)
+			{
+				result.consumed = (size_t)(sequence - text);
+				result.produced = (size_t)(write - text);
+
+				return result;
+			}
+
+			if (converted > (size_t)(state.src - write))
+			{
+				/* Output would overwrite input that was not read yet, the caller should map the rest to a new buffer */
+
+				result.consumed = (size_t)(sequence - text);
+				result.produced = (size_t)(write - text);
+				result.error = UTF8_ERR_NOT_ENOUGH_SPACE;
+
+				return result;
+			}
+
+			memcpy(write, mapped, converted);
+		}
+
+		write += converted;
+		state.total_bytes_needed += converted;
+	}
+
+	result.consumed = textSize;
+	result.produced = (size_t)(write - text);
+	result.error = UTF8_ERR_NONE;
+
+	return result;
+}
+
+#endif
+
+utf8result_t utf8toupper_inplace(char* text, size_t textSize, size_t locale)
+{
+#if UTF8_EXCLUDE_UPPERCASE
+	utf8result_t result;
+
+	/* Case mapping was excluded from the build */
+
+	(void)text;
+	(void)textSize;
+	(void)locale;
+
+	result.consumed = 0;
+	result.produced = 0;
+	result.error = UTF8_ERR_INVALID_FLAG;
+
+	return result;
+#else
+	return casemapping_inplace(
+		text, textSize,
+		UppercaseIndex1Ptr, UppercaseIndex2Ptr, UppercaseDataPtr,
+		QuickCheckCaseMapped_Uppercase, locale,
+		casemapping_engine(locale));
+#endif
+}
+
+utf8result_t utf8tolower_inplace(char* text, size_t textSize, size_t locale)
+{
+#if UTF8_EXCLUDE_LOWERCASE
+	utf8result_t result;
+
+	/* Case mapping was excluded from the build */
+
+	(void)text;
+	(void)textSize;
+	(void)locale;
+
+	result.consumed = 0;
+	result.produced = 0;
+	result.error = UTF8_ERR_INVALID_FLAG;
+
+	return result;
+#else
+	return casemapping_inplace(
+		text, textSize,
+		LowercaseIndex1Ptr, LowercaseIndex2Ptr, LowercaseDataPtr,
+		QuickCheckCaseMapped_Lowercase, locale,
+		casemapping_engine(locale));
+#endif
+}
+
+utf8result_t utf8casefold_inplace(char* text, size_t textSize, size_t locale)
+{
+#if UTF8_EXCLUDE_CASEFOLDING
+	utf8result_t result;
+
+	/* Case mapping was excluded from the build */
+
+	(void)text;
+	(void)textSize;
+	(void)locale;
+
+	result.consumed = 0;
+	result.produced = 0;
+	result.error = UTF8_ERR_INVALID_FLAG;
+
+	return result;
+#else
+	return casemapping_inplace(
+		text, textSize,
+		CaseFoldingIndex1Ptr, CaseFoldingIndex2Ptr, CaseFoldingDataPtr,
+		QuickCheckCaseMapped_Casefolded, locale,
+		casemapping_execute_casefold);
+#endif
+}
+
+int utf8casecmp(const char* input1, size_t input1Size, const char* input2, size_t input2Size, size_t locale, int32_t* errors)
+{
+	return utf8ncasecmp(input1, input1Size, input2, input2Size, SIZE_MAX, locale, errors);
+}
+
+int utf8ncasecmp(const char* input1, size_t input1Size, const char* input2, size_t input2Size, size_t length, size_t locale, int32_t* errors)
+{
+#if UTF8_EXCLUDE_CASEFOLDING
+	/* Case mapping was excluded from the build */
+
+	(void)input1;
+	(void)input1Size;
+	(void)input2;
+	(void)input2Size;
+	(void)length;
+	(void)locale;
+
+	UTF8_SET_ERROR(INVALID_FLAG);
+
+	return 0;
+#else
+	/* Validate parameters */
+
+	if (input1 == 0 ||
+		input2 == 0)
+	{
+		UTF8_SET_ERROR(INVALID_DATA);
+
+		return 0;
+	}
+
+	if (locale >= UTF8_LOCALE_MAXIMUM)
+	{
+		UTF8_SET_ERROR(INVALID_LOCALE);
+
+		return 0;
+	}
+
+	UTF8_SET_ERROR(NONE);
+
+	return casemapping_compare(input1, input1Size, input2, input2Size, length, locale);
+#endif
+}
+
+uint64_t utf8casefold_hash(const char* input, size_t inputSize, size_t locale, uint64_t seed, int32_t* errors)
+{
+#if UTF8_EXCLUDE_CASEFOLDING
+	/* Case mapping was excluded from the build */
+
+	(void)input;
+	(void)inputSize;
+	(void)locale;
+	(void)seed;
+
+	UTF8_SET_ERROR(INVALID_FLAG);
+
+	return 0;
+#else
+	/* Validate parameters */
+
+	if (input == 0)
+	{
+		UTF8_SET_ERROR(INVALID_DATA);
+
+		return 0;
+	}
+
+	if (locale >= UTF8_LOCALE_MAXIMUM)
+	{
+		UTF8_SET_ERROR(INVALID_LOCALE);
+
+		return 0;
+	}
+
+	UTF8_SET_ERROR(NONE);
+
+	return casemapping_hash(input, inputSize, locale, seed);
+#endif
 }
 
 uint8_t utf8isnormalized(const char* input, size_t inputSize, size_t flags, size_t* offset)
@@ -940,10 +1935,10 @@ uint8_t utf8isnormalized(const char* input, size_t inputSize, size_t flags, size
 	size_t found_offset = 0;
 	uint8_t result = UTF8_NORMALIZATION_RESULT_YES;
 	unicode_t decoded;
+	uint32_t properties;
 	uint8_t canonical_class;
 	uint8_t quick_check;
-	const size_t* property_index;
-	const uint8_t* property_data;
+	uint8_t quick_check_shift;
 
 	/* Validate input and flags */
 
@@ -960,26 +1955,22 @@ uint8_t utf8isnormalized(const char* input, size_t inputSize, size_t flags, size
 	{
 		if ((flags & UTF8_NORMALIZE_COMPATIBILITY) != 0)
 		{
-			property_index = QuickCheckNFKCIndexPtr;
-			property_data = QuickCheckNFKCDataPtr;
+			quick_check_shift = PROPERTY_SHIFT_NFKC;
 		}
 		else
 		{
-			property_index = QuickCheckNFCIndexPtr;
-			property_data = QuickCheckNFCDataPtr;
+			quick_check_shift = PROPERTY_SHIFT_NFC;
 		}
 	}
 	else
 	{
 		if ((flags & UTF8_NORMALIZE_COMPATIBILITY) != 0)
 		{
-			property_index = QuickCheckNFKDIndexPtr;
-			property_data = QuickCheckNFKDDataPtr;
+			quick_check_shift = PROPERTY_SHIFT_NFKD;
 		}
 		else
 		{
-			property_index = QuickCheckNFDIndexPtr;
-			property_data = QuickCheckNFDDataPtr;
+			quick_check_shift = PROPERTY_SHIFT_NFD;
 		}
 	}
 
@@ -997,8 +1988,9 @@ uint8_t utf8isnormalized(const char* input, size_t inputSize, size_t flags, size
 
 		/* Get canonical combining class and quick check value */
 
-		canonical_class = PROPERTY_GET_CCC(decoded);
-		quick_check = PROPERTY_GET(property_index, property_data, decoded);
+		properties = database_queryproperties(decoded);
+		canonical_class = PROPERTY_RECORD_CCC(properties);
+		quick_check = PROPERTY_RECORD_QC(properties, quick_check_shift);
 
 		/* Compare CCC to previous CCC */
 
@@ -1056,6 +2048,7 @@ size_t utf8normalize(const char* input, size_t inputSize, char* target, size_t t
 	StreamState* stream_output;
 	uint8_t finished = 0;
 	size_t bytes_written = 0;
+	utf8result_t* progress = 0;
 
 	/*
 		Decomposition uses the following process:
@@ -1078,6 +2071,9 @@ size_t utf8normalize(const char* input, size_t inputSize, char* target, size_t t
 
 		Although four streaming buffers may seem excessive, they are necessary
 		for preventing allocations on the heap.
+
+		The progress for resuming is tracked per segment by utf8normalize_ex
+		instead, so it is not stored here.
 	*/
 
 	/* Check for valid flags */
@@ -1089,6 +2085,17 @@ size_t utf8normalize(const char* input, size_t inputSize, char* target, size_t t
 		return bytes_written;
 	}
 
+	/* Check that the normalization form was not excluded from the build */
+
+	if (((flags & UTF8_NORMALIZE_COMPOSE) != 0)
+		? (compatibility ? UTF8_EXCLUDE_NFKC : UTF8_EXCLUDE_NFC)
+		: (compatibility ? UTF8_EXCLUDE_NFKD : UTF8_EXCLUDE_NFD))
+	{
+		UTF8_SET_ERROR(INVALID_FLAG);
+
+		return bytes_written;
+	}
+
 	/* Validate parameters */
 
 	UTF8_VALIDATE_PARAMETERS_CHAR(char, bytes_written);
@@ -1144,7 +2151,7 @@ size_t utf8normalize(const char* input, size_t inputSize, char* target, size_t t
 
 				for (i = 0; i < stream[1].current; ++i)
 				{
-					*dst_qc++ = PROPERTY_GET(compose_state.qc_index, compose_state.qc_data, *src_codepoint);
+					*dst_qc++ = PROPERTY_RECORD_QC(database_queryproperties(*src_codepoint), compose_state.qc_shift);
 					*dst_ccc++ = *src_ccc++;
 					*dst_codepoint++ = *src_codepoint++;
 				}
@@ -1222,6 +2229,118 @@ size_t utf8normalize(const char* input, size_t inputSize, char* target, size_t t
 	return bytes_written;
 }
 
+utf8result_t utf8normalize_ex(const char* input, size_t inputSize, char* target, size_t targetSize, size_t flags)
+{
+	utf8result_t result;
+	const char* src = input;
+	size_t src_size = inputSize;
+	size_t segment_minimum = (target != 0) ? targetSize : inputSize;
+	uint8_t compatibility = (flags & UTF8_NORMALIZE_COMPATIBILITY) != 0;
+	uint8_t quick_check_shift;
+
+	result.consumed = 0;
+	result.produced = 0;
+
+	/* Check flags before segmenting, the tables of an excluded form are not compiled in */
+
+	if ((flags & (UTF8_NORMALIZE_DECOMPOSE | UTF8_NORMALIZE_COMPOSE)) == 0 ||
+		(((flags & UTF8_NORMALIZE_COMPOSE) != 0)
+			? (compatibility ? UTF8_EXCLUDE_NFKC : UTF8_EXCLUDE_NFC)
+			: (compatibility ? UTF8_EXCLUDE_NFKD : UTF8_EXCLUDE_NFD)))
+	{
+		result.error = UTF8_ERR_INVALID_FLAG;
+
+		return result;
+	}
+
+	if (input == 0 ||
+		inputSize == 0)
+	{
+		result.produced = utf8normalize(input, inputSize, target, targetSize, flags, &result.error);
+
+		return result;
+	}
+
+	/* Get properties */
+
+	if ((flags & UTF8_NORMALIZE_COMPOSE) != 0)
+	{
+		if ((flags & UTF8_NORMALIZE_COMPATIBILITY) != 0)
+		{
+			quick_check_shift = PROPERTY_SHIFT_NFKC;
+		}
+		else
+		{
+			quick_check_shift = PROPERTY_SHIFT_NFC;
+		}
+	}
+	else
+	{
+		if ((flags & UTF8_NORMALIZE_COMPATIBILITY) != 0)
+		{
+			quick_check_shift = PROPERTY_SHIFT_NFKD;
+		}
+		else
+		{
+			quick_check_shift = PROPERTY_SHIFT_NFD;
+		}
+	}
+
+	/*
+		Normalize the input in segments that do not depend on the text around
+		them, starting with about as much input as fits in the target buffer.
+		When a segment does not fit, a smaller one is attempted, until a
+		single segment does not fit.
+	*/
+
+	while (src_size > 0)
+	{
+		size_t segment_size = stream_boundary(src, src_size, segment_minimum, quick_check_shift);
+		size_t written;
+
+		written = utf8normalize(
+			src, segment_size,
+			(target != 0) ? target + result.produced : 0, targetSize - result.produced,
+			flags, &result.error);
+
+		if (result.error == UTF8_ERR_NOT_ENOUGH_SPACE &&
+			segment_minimum > 1)
+		{
+			segment_minimum /= 2;
+
+			continue;
+		}
+		else if (
+			result.error != UTF8_ERR_NONE)
+		{
+			break;
+		}
+
+		result.consumed += segment_size;
+		result.produced += written;
+
+		src += segment_size;
+		src_size -= segment_size;
+
+		if (target != 0)
+		{
+			segment_minimum = targetSize - result.produced;
+		}
+	}
+
+	return result;
+}
+
+char* utf8normalize_alloc(const char* input, size_t inputSize, size_t flags, const utf8allocator_t* allocator, size_t* outputSize, int32_t* errors)
+{
+	return allocation_transform(utf8normalize_ex, input, inputSize, flags, allocator, outputSize, errors);
+}
+
+void utf8free(const utf8allocator_t* allocator, void* memory)
+{
+	allocation_free(allocator, memory);
+}
+
 size_t utf8iscategory(const char* input, size_t inputSize, size_t flags)
 {
 	const char* src = input;
@@ -1236,8 +2355,7 @@ size_t utf8iscategory(const char* input, size_t inputSize, size_t flags)
 	while (src_size > 0)
 	{
 		unicode_t code_point;
-		uint32_t general_category;
-		uint8_t canonical_combining_class;
+		uint32_t properties;
 		uint8_t offset;
 
 		/* Compatibility fixes */
@@ -1356,10 +2474,10 @@ size_t utf8iscategory(const char* input, size_t inputSize, size_t flags)
 
 		/* Match General Category against flags */
 
-		general_category = PROPERTY_GET_GC(code_point);
-		if ((general_category & flags) == 0 &&
+		properties = database_queryproperties(code_point);
+		if ((PROPERTY_RECORD_GC(properties) & flags) == 0 &&
 			/* Check for the start of the next grapheme cluster */
-			((flags & UTF8_CATEGORY_IGNORE_GRAPHEME_CLUSTER) != 0 || (canonical_combining_class = PROPERTY_GET_CCC(code_point)) == CCC_NOT_REORDERED))
+			((flags & UTF8_CATEGORY_IGNORE_GRAPHEME_CLUSTER) != 0 || PROPERTY_RECORD_CCC(properties) == CCC_NOT_REORDERED))
 		{
 			break;
 		}
@@ -1376,4 +2494,19 @@ size_t utf8iscategory(const char* input, size_t inputSize, size_t flags)
 	}
 
 	return src - input;
+}
+
+uint8_t utf8loaddatabase(const char* path, int32_t* errors)
+{
+	return database_load(path, errors);
+}
+
+void utf8unloaddatabase()
+{
+	database_unload();
+}
+
+uint32_t utf8databaseversion()
+{
+	return database_version();
 }
\ No newline at end of file
@@ -73,7 +73,7 @@ class BlobSplitter:
 				end_index = blob_search.find("\\x00")
 				if end_index == -1:
 					break
-				offset = (end_index / 4) + 1
+				offset = (end_index // 4) + 1
 				if (page_read + offset) >= self.pageSize:
 					break
 				page_read += offset
@@ -2,12 +2,17 @@ import argparse
 import datetime
 import os
 import re
+import struct
 import sys
 import libs.blobsplitter
 import libs.header
 import libs.unicode
 import libs.utf8
 
+# code points below this limit are stored uncompressed at the start of every data table
+
+DIRECT_LOOKUP_COUNT = 0x800
+
 class UnicodeMapping:
 	def __init__(self, db):
 		self.db = db
@@ -34,6 +39,7 @@ class UnicodeMapping:
 		self.quickNFD = 0
 		self.quickNFKC = 0
 		self.quickNFKD = 0
+		self.properties = 0
 		self.numericType = "NumericType_None"
 		self.numericValue = 0
 		self.bidiMirrored = False
@@ -346,29 +352,22 @@ class Compression:
 		self.compressed_size = 0
 		self.uncompressed_size = 0
 		self.compression_ratio = 0.0
-		self.table_index = []
+		self.table_index1 = []
+		self.table_index2 = []
 		self.table_data = []
 
-	def process(self, field, chunkSize):
-		print('Compressing property "' + field + '" with a chunk size of ' + str(chunkSize) + '...')
+	def compress(self, source, target, chunkSize):
+		indices = []
 
-		self.chunk_size = chunkSize
-		self.compressed_size = 0
-		self.uncompressed_size = 0
-		self.table_index = []
-		self.table_data = []
-
-		for i in range(0, len(self.database.recordsOrdered), chunkSize):
-			chunk = []
-			for r in self.database.recordsOrdered[i:i + chunkSize]:
-				chunk.append(r.__dict__[field])
+		for i in range(0, len(source), chunkSize):
+			chunk = source[i:i + chunkSize]
 
 			offset = 0
 			index = 0
 			overlapping = False
 
-			for t in range(len(self.table_data)):
-				if self.table_data[t] == chunk[offset]:
+			for t in range(len(target)):
+				if target[t] == chunk[offset]:
 					offset += 1
 					if offset == len(chunk):
 						overlapping = True
@@ -381,47 +380,65 @@ class Compression:
 				offset = 0
 				index = 0
 
-				if len(self.table_data) > 0:
-					for t in range(len(self.table_data) - 1, 0):
-						if self.table_data[t] != chunk[offset] or offset + 1 == len(chunk):
+				if len(target) > 0:
+					for t in range(len(target) - 1, 0):
+						if target[t] != chunk[offset] or offset + 1 == len(chunk):
 							break
 						offset += 1
-					index = len(self.table_data) - offset
+					index = len(target) - offset
 
-			"""if len(self.table_index) == 396:
-				print('chunk ' + str(chunk))
-				print('overlapping ' + str(overlapping))
-				print('data_size ' + str(len(self.table_data)) + ' index_size ' + str(len(self.table_index)) + ' offset ' + str(offset) + ' index ' + str(index))
-				print('chunk_after ' + str(chunk[offset:]))
-				print('table_chunk ' + str(self.table_data[index:index+32]))
-				print('table_before ' + str(self.table_data))
-				#exit(0)"""
+			indices.append(index)
+			target.extend(chunk[offset:])
 
-			self.table_index.append(index)
-			self.table_data.extend(chunk[offset:])
+		return indices
 
-			self.uncompressed_size += len(chunk)
+	def process(self, field, chunk1Size, chunk2Size):
+		print('Compressing property "' + field + '" with chunk sizes of ' + str(chunk1Size) + ' and ' + str(chunk2Size) + '...')
+
+		self.chunk_size = chunk1Size
+		self.compressed_size = 0
+		self.uncompressed_size = 0
+		self.table_index1 = []
+		self.table_index2 = []
+		self.table_data = []
 
-		self.compressed_size = len(self.table_index) + len(self.table_data)
+		values = []
+		for r in self.database.recordsOrdered:
+			values.append(r.__dict__[field])
+
+		# direct lookup for the two-byte range, the first stage can share these blocks
+
+		self.table_data.extend(values[:DIRECT_LOOKUP_COUNT])
+
+		# first stage maps blocks of code points to deduplicated data
+
+		index_data = self.compress(values, self.table_data, chunk1Size)
+
+		# second stage maps blocks of first stage offsets to deduplicated offsets
+
+		self.table_index1 = self.compress(index_data, self.table_index2, chunk2Size)
+
+		if len(self.table_data) > 0xFFFF or len(self.table_index2) > 0xFFFF:
+			raise ValueError('Compressed property "' + field + '" does not fit in 16-bit offsets')
+
+		self.uncompressed_size = len(values)
+		self.compressed_size = len(self.table_index1) + len(self.table_index2) + len(self.table_data)
 		self.compression_ratio = (1.0 - (self.compressed_size / self.uncompressed_size)) * 100.0
 		print(field + ': uncompressed ' + str(self.uncompressed_size) + ' compressed ' + str(self.compressed_size) + ' savings ' + ('%.2f%%' % self.compression_ratio))
 
-	def render(self, header, name, dataType = 'uint8_t'):
-		print('Rendering compressed data for "' + name + '"...')
-
-		header.newLine()
-		header.writeLine("const size_t " + name + "Index[" + str(len(self.table_index)) + "] = {")
+	def renderArray(self, header, name, dataType, values, valueFormat):
+		header.writeLine("const " + dataType + " " + name + "[" + str(len(values)) + "] = {")
 		header.indent()
 
 		count = 0
-		for c in self.table_index:
+		for c in values:
 			if (count % self.chunk_size) == 0:
 				header.writeIndentation()
 			
-			header.write('%d,' % c)
+			header.write(valueFormat % c)
 			
 			count += 1
-			if count != len(self.table_index):
+			if count != len(values):
 				if (count % self.chunk_size) == 0:
 					header.newLine()
 				else:
@@ -430,42 +447,33 @@ class Compression:
 		header.newLine()
 		header.outdent()
 		header.writeLine("};")
-		header.writeLine("const size_t* " + name + "IndexPtr = " + name + "Index;")
 
-		header.newLine()
+	def render(self, header, name, dataType = 'uint8_t', dataFormat = '0x%02X'):
+		print('Rendering compressed data for "' + name + '"...')
 
-		header.writeLine("const " + dataType + " " + name + "Data[" + str(len(self.table_data)) + "] = {")
-		header.indent()
+		header.newLine()
+		self.renderArray(header, name + "Index1", "uint16_t", self.table_index1, '%d,')
+		header.writeLine("const uint16_t* " + name + "Index1Ptr = " + name + "Index1;")
 
-		count = 0
-		for c in self.table_data:
-			if (count % self.chunk_size) == 0:
-				header.writeIndentation()
-			
-			header.write('0x%02X,' % c)
-			
-			count += 1
-			if count != len(self.table_data):
-				if (count % self.chunk_size) == 0:
-					header.newLine()
-				else:
-					header.write(' ')
+		header.newLine()
+		self.renderArray(header, name + "Index2", "uint16_t", self.table_index2, '%d,')
+		header.writeLine("const uint16_t* " + name + "Index2Ptr = " + name + "Index2;")
 
 		header.newLine()
-		header.outdent()
-		header.writeLine("};")
+		self.renderArray(header, name + "Data", dataType, self.table_data, dataFormat + ',')
 		header.write("const " + dataType + "* " + name + "DataPtr = " + name + "Data;")
 
 class CompressionString:
 	def __init__(self, database):
 		self.database = database
 
-	def process(self, field, chunk1Size, chunk2Size):
+	def process(self, field, chunk1Size, chunk2Size, simpleMappings = False):
 		print('Compressing property "' + field + '" with chunk sizes of ' + str(chunk1Size) + ' and ' + str(chunk2Size) + '...')
 
 		self.compressed_size = 0
 		self.uncompressed_size = 0
 		self.compression_ratio = 0.0
+		self.simple_count = 0
 		self.table_index2 = []
 		self.table_index1 = []
 		self.table_index1_compressed = []
@@ -476,7 +484,13 @@ class CompressionString:
 			chunk = r.__dict__[field]
 			converted = libs.utf8.unicodeToUtf8Hex(chunk)
 			
-			if len(chunk) > 1 or (len(chunk) == 1 and chunk[0] != r.codepoint):
+			if simpleMappings and len(chunk) == 1 and chunk[0] != r.codepoint:
+				# one-to-one mappings store the signed distance to the mapped code point
+				# instead of a string, must match CASEMAPPING_RECORD_* in source/internal/database.h
+
+				self.table_data.append(0x80000000 + ((chunk[0] - r.codepoint) & 0x00FFFFFF))
+				self.simple_count += 1
+			elif len(chunk) > 1 or (len(chunk) == 1 and chunk[0] != r.codepoint):
 				offset = 0
 				index = 0
 				overlapping = False
@@ -504,13 +518,17 @@ class CompressionString:
 				
 				chunk_length = len(re.findall('\\\\x?[^\\\\]+', converted))
 
-				self.table_data.append((chunk_length << 24) + (index / 4))
+				self.table_data.append((chunk_length << 24) + (index // 4))
 
 				self.database.compressed += converted[offset:]
 				self.database.compressed_length += len(re.findall('\\\\x?[^\\\\]+', converted[offset:]))
 			else:
 				self.table_data.append(0)
 
+		# direct lookup for the two-byte range, the first stage can share these blocks
+
+		self.table_data_compressed.extend(self.table_data[:DIRECT_LOOKUP_COUNT])
+
 		for i in range(0, len(self.table_data), chunk1Size):
 			chunk = self.table_data[i:i + chunk1Size]
 
@@ -578,6 +596,9 @@ class CompressionString:
 		self.compression_ratio = (1.0 - (self.compressed_size / self.uncompressed_size)) * 100.0
 		print(field + ': uncompressed ' + str(self.uncompressed_size) + ' compressed ' + str(self.compressed_size) + ' savings ' + ('%.2f%%' % self.compression_ratio))
 
+		if simpleMappings:
+			print(field + ': ' + str(self.simple_count) + ' simple mappings stored as deltas')
+
 	def render(self, header, name):
 		print('Rendering compressed data for "' + name + '"...')
 		
@@ -910,6 +931,17 @@ class Database(libs.unicode.UnicodeVisitor):
 				r.quickCaseMapped |= 0x04
 			if len(r.caseFolding) > 0 and r.caseFolding[0] != r.codepoint:
 				r.quickCaseMapped |= 0x08
+
+			# pack all properties into a single 32-bit record
+
+			r.properties = \
+				r.canonicalCombiningClass | \
+				(r.quickCaseMapped << 8) | \
+				(r.quickNFC << 12) | \
+				(r.quickNFD << 14) | \
+				(r.quickNFKC << 16) | \
+				(r.quickNFKD << 18) | \
+				(r.generalCategoryCombined.bit_length() << 24)
 		
 		if group_category:
 			group_category.end = group_category.start + group_category.count
@@ -980,6 +1012,60 @@ class Database(libs.unicode.UnicodeVisitor):
 		
 		return leftCodepoint.compositionPairs[right]
 	
+	def compositionHash(self, key, salt, count):
+		# must match database_querycomposition
+
+		mask = (1 << 64) - 1
+		hashed = ((((key + salt) * 0x9E3779B97F4A7C15) & mask) ^ ((key * 0x31415926) & mask)) >> 32
+		return (hashed * count) >> 32
+
+	def hashCompositionRecords(self, records):
+		print('Hashing ' + str(len(records)) + ' composition records...')
+
+		# minimal perfect hash: the first hash selects a salt, the salted hash selects the record
+
+		count = len(records)
+		buckets = [[] for i in range(count)]
+		for r in records:
+			buckets[self.compositionHash(r["key"], 0, count)].append(r)
+
+		self.compositionSalts = [0] * count
+		slots = [None] * count
+
+		for b in sorted(range(count), key=lambda index: len(buckets[index]), reverse=True):
+			if len(buckets[b]) == 0:
+				break
+
+			salt = 1
+			while True:
+				if salt > 0xFFFF:
+					raise ValueError('Failed to find a salt for composition bucket ' + str(b))
+
+				found = [self.compositionHash(r["key"], salt, count) for r in buckets[b]]
+				if len(set(found)) == len(found) and all(slots[f] is None for f in found):
+					break
+
+				salt += 1
+
+			self.compositionSalts[b] = salt
+			for r, f in zip(buckets[b], found):
+				slots[f] = r
+
+		return slots
+
+	def writeExcludable(self, header, condition, render, name):
+		# tables can be left out of the build with the UTF8_EXCLUDE_* macros
+
+		header.writeLine("#if " + condition)
+		render()
+		header.newLine()
+		header.writeLine("#else")
+		header.writeLine("const uint32_t* " + name + "Index1Ptr = 0;")
+		header.writeLine("const uint32_t* " + name + "Index2Ptr = 0;")
+		header.writeLine("const uint32_t* " + name + "DataPtr = 0;")
+		header.writeLine("#endif")
+		header.newLine()
+
 	def writeCompositionRecords(self, header):
 		composed = []
 		
@@ -996,9 +1082,33 @@ class Database(libs.unicode.UnicodeVisitor):
 						}
 						composed.append(pair)
 		
-		composed_ordered = sorted(composed, key=lambda item: item["key"])
+		composed_ordered = self.hashCompositionRecords(sorted(composed, key=lambda item: item["key"]))
+		self.compositionRecords = composed_ordered
+		
+		header.writeLine("size_t UnicodeCompositionRecordCount = " + str(len(composed_ordered)) + ";")
+		header.writeLine("const uint16_t UnicodeCompositionSalt[" + str(len(self.compositionSalts)) + "] = {")
+		header.indent()
+		
+		count = 0
+		
+		for c in self.compositionSalts:
+			if (count % 32) == 0:
+				header.writeIndentation()
+			
+			header.write("%d," % c)
+			
+			count += 1
+			if count != len(self.compositionSalts):
+				if (count % 32) == 0:
+					header.newLine()
+				else:
+					header.write(" ")
 		
-		header.writeLine("const size_t UnicodeCompositionRecordCount = " + str(len(composed_ordered)) + ";")
+		header.newLine()
+		header.outdent()
+		header.writeLine("};")
+		header.writeLine("const uint16_t* UnicodeCompositionSaltPtr = UnicodeCompositionSalt;")
+		header.newLine()
 		header.writeLine("const CompositionRecord UnicodeCompositionRecord[" + str(len(composed_ordered)) + "] = {")
 		header.indent()
 		
@@ -1055,26 +1165,8 @@ class Database(libs.unicode.UnicodeVisitor):
 	def writeSource(self, filepath):
 		print('Compressing code point properties...')
 
-		compress_gc = Compression(db)
-		compress_gc.process('generalCategoryCombined', 32)
-		
-		compress_ccc = Compression(db)
-		compress_ccc.process('canonicalCombiningClass', 32)
-
-		compress_qc_cm = Compression(db)
-		compress_qc_cm.process('quickCaseMapped', 32)
-
-		compress_qc_nfc = Compression(db)
-		compress_qc_nfc.process('quickNFC', 32)
-
-		compress_qc_nfd = Compression(db)
-		compress_qc_nfd.process('quickNFD', 32)
-
-		compress_qc_nfkc = Compression(db)
-		compress_qc_nfkc.process('quickNFKC', 32)
-
-		compress_qc_nfkd = Compression(db)
-		compress_qc_nfkd.process('quickNFKD', 32)
+		compress_properties = Compression(db)
+		compress_properties.process('properties', 32, 128)
 
 		self.compressed = ""
 		self.compressed_length = 0
@@ -1086,16 +1178,19 @@ class Database(libs.unicode.UnicodeVisitor):
 		compress_nfkd.process('decomposedNFKD', 32, 128)
 
 		compress_uppercase = CompressionString(db)
-		compress_uppercase.process('uppercase', 32, 128)
+		compress_uppercase.process('uppercase', 32, 128, True)
 		
 		compress_lowercase = CompressionString(db)
-		compress_lowercase.process('lowercase', 32, 128)
+		compress_lowercase.process('lowercase', 32, 128, True)
 
 		compress_titlecase = CompressionString(db)
-		compress_titlecase.process('titlecase', 32, 128)
+		compress_titlecase.process('titlecase', 32, 128, True)
 
 		compress_casefolding = CompressionString(db)
-		compress_casefolding.process('caseFolding', 32, 128)
+		compress_casefolding.process('caseFolding', 32, 128, True)
+
+		self.compressedProperties = compress_properties
+		self.compressedStrings = [ compress_nfd, compress_nfkd, compress_uppercase, compress_lowercase, compress_titlecase, compress_casefolding ]
 		
 		print('Writing database to "' + os.path.realpath(filepath) + '"...')
 		
@@ -1117,55 +1212,34 @@ class Database(libs.unicode.UnicodeVisitor):
 		
 		header.writeLine("#include \"unicodedatabase.h\"")
 		
-		# quick check
-
-		compress_gc.render(header, 'GeneralCategory', 'uint32_t')
-		header.newLine()
-		
-		compress_ccc.render(header, 'CanonicalCombiningClass')
-		header.newLine()
-
-		compress_qc_cm.render(header, 'QuickCheckCaseMapped');
-		header.newLine();
-
-		compress_qc_nfc.render(header, 'QuickCheckNFC')
-		header.newLine()
-
-		compress_qc_nfd.render(header, 'QuickCheckNFD')
-		header.newLine()
-
-		compress_qc_nfkc.render(header, 'QuickCheckNFKC')
-		header.newLine()
+		# properties
 
-		compress_qc_nfkd.render(header, 'QuickCheckNFKD')
+		compress_properties.render(header, 'Properties', 'uint32_t', '0x%08X')
 		header.newLine()
 		
 		# decomposition
 
-		compress_nfd.render(header, 'NFD')
-		header.newLine()
-		
-		compress_nfkd.render(header, 'NFKD')
-		header.newLine()
+		self.writeExcludable(header, 'UTF8_DATABASE_NFD', lambda: compress_nfd.render(header, 'NFD'), 'NFD')
+		self.writeExcludable(header, 'UTF8_DATABASE_NFKD', lambda: compress_nfkd.render(header, 'NFKD'), 'NFKD')
 
 		# case mapping
 
-		compress_uppercase.render(header, 'Uppercase')
-		header.newLine()
-		
-		compress_lowercase.render(header, 'Lowercase')
-		header.newLine()
-
-		compress_titlecase.render(header, 'Titlecase')
-		header.newLine()
-
-		compress_casefolding.render(header, 'CaseFolding')
-		header.newLine()
+		self.writeExcludable(header, 'UTF8_DATABASE_UPPERCASE', lambda: compress_uppercase.render(header, 'Uppercase'), 'Uppercase')
+		self.writeExcludable(header, 'UTF8_DATABASE_LOWERCASE', lambda: compress_lowercase.render(header, 'Lowercase'), 'Lowercase')
+		self.writeExcludable(header, 'UTF8_DATABASE_TITLECASE', lambda: compress_titlecase.render(header, 'Titlecase'), 'Titlecase')
+		self.writeExcludable(header, 'UTF8_DATABASE_CASEFOLDING', lambda: compress_casefolding.render(header, 'CaseFolding'), 'CaseFolding')
 		
 		# composition
 		
 		header.newLine()
+		header.writeLine("#if UTF8_DATABASE_COMPOSITION")
 		self.writeCompositionRecords(header)
+		header.writeLine("#else")
+		header.writeLine("size_t UnicodeCompositionRecordCount = 0;")
+		header.writeLine("const uint16_t* UnicodeCompositionSaltPtr = 0;")
+		header.writeLine("const CompositionRecord* UnicodeCompositionRecordPtr = 0;")
+		header.writeLine("#endif")
+		header.newLine()
 		
 		# decomposition data
 
@@ -1186,8 +1260,60 @@ class Database(libs.unicode.UnicodeVisitor):
 
 		header.outdent()
 		header.writeLine(";")
-		header.write("const size_t CompressedStringDataLength = " + str(self.compressed_length) + ";")
+		header.writeLine("size_t CompressedStringDataLength = " + str(self.compressed_length) + ";")
+		header.newLine()
+		header.write("const uint32_t UnicodeDatabaseVersion = 0x%08X;" % self.unicodeVersion())
+
+	def unicodeVersion(self):
+		# unicode version is taken from the header of the derived properties, stored as 0x00MMmmuu
+
+		with open(os.path.dirname(os.path.realpath(sys.argv[0])) + '/data/DerivedNormalizationProps.txt', 'r') as f:
+			match = re.search('-(\\d+)\\.(\\d+)\\.(\\d+)\\.txt', f.readline())
+			if not match:
+				raise Exception('Unicode version not found in DerivedNormalizationProps.txt')
+
+			return (int(match.group(1)) << 16) + (int(match.group(2)) << 8) + int(match.group(3))
 	
+	def writeBinary(self, filepath):
+		print('Writing binary database to "' + os.path.realpath(filepath) + '"...')
+
+		# must match DatabaseSections in source/internal/database.c
+
+		sections = [
+			struct.pack('<%dH' % len(self.compressedProperties.table_index1), *self.compressedProperties.table_index1),
+			struct.pack('<%dH' % len(self.compressedProperties.table_index2), *self.compressedProperties.table_index2),
+			struct.pack('<%dI' % len(self.compressedProperties.table_data), *self.compressedProperties.table_data),
+		]
+
+		for c in self.compressedStrings:
+			sections.append(struct.pack('<%dI' % len(c.table_index2), *c.table_index2))
+			sections.append(struct.pack('<%dI' % len(c.table_index1_compressed), *c.table_index1_compressed))
+			sections.append(struct.pack('<%dI' % len(c.table_data_compressed), *c.table_data_compressed))
+
+		sections.append(struct.pack('<%dH' % len(self.compositionSalts), *self.compositionSalts))
+		sections.append(b''.join([struct.pack('<QII', r["key"], r["value"], 0) for r in self.compositionRecords]))
+		sections.append(bytes.fromhex(self.compressed.replace('\\x', '')))
+
+		# header, section table and sections aligned on eight bytes
+
+		offset = 16 + (len(sections) * 8)
+		table = b''
+		body = b''
+
+		for s in sections:
+			padding = (8 - (offset % 8)) % 8
+			body += b'\0' * padding
+			offset += padding
+
+			table += struct.pack('<II', offset, len(s))
+			body += s
+			offset += len(s)
+
+		with open(os.path.realpath(filepath), 'wb') as f:
+			f.write(b'U8DB' + struct.pack('<III', 2, self.unicodeVersion(), len(sections)))
+			f.write(table)
+			f.write(body)
+
 	def writeCaseMapping(self, filepath):
 		print('Writing case mapping to "' + os.path.realpath(filepath) + '"...')
 		
@@ -1459,4 +1585,5 @@ if __name__ == '__main__':
 	db.executeQuery(args.query)
 	
 	db.writeSource(script_path + '/../../source/unicodedatabase.c')
+	db.writeBinary(script_path + '/../../testdata/unicodedatabase.bin')
 	db.writeCaseMapping(script_path + '/../../testdata/CaseMapping.txt')
\ No newline at end of file
@@ -0,0 +1,97 @@
+import argparse
+import os
+import re
+import sys
+
+# sizes of the element types used by the generated tables, CompositionRecord is padded to 16 bytes
+
+TYPE_SIZES = {
+	'uint16_t': 2,
+	'uint32_t': 4,
+	'CompositionRecord': 16,
+}
+
+def evaluate(expression, macros):
+	expression = expression.replace('||', ' or ').replace('&&', ' and ')
+	expression = re.sub('!(?!=)', ' not ', expression)
+	expression = re.sub('[A-Za-z_][A-Za-z0-9_]*', lambda m: m.group(0) if m.group(0) in ('not', 'and', 'or') else str(macros.get(m.group(0), 0)), expression)
+	return bool(eval(expression))
+
+def parseConditions(headerPath, macros):
+	conditions = dict()
+
+	with open(headerPath, 'r') as f:
+		for line in f:
+			match = re.match('#define (UTF8_DATABASE_[A-Z]+)\\s+(.+)$', line.strip())
+			if match:
+				conditions[match.group(1)] = evaluate(match.group(2), macros)
+
+	return conditions
+
+def parseTables(sourcePath, conditions):
+	tables = []
+	included = [ True ]
+
+	with open(sourcePath, 'r') as f:
+		for line in f:
+			line = line.strip()
+
+			if line.startswith('#if '):
+				included.append(included[-1] and conditions.get(line[4:].strip(), True))
+			elif line.startswith('#else'):
+				included[-1] = (not included[-1]) and included[-2]
+			elif line.startswith('#endif'):
+				included.pop()
+			elif included[-1]:
+				match = re.match('const (\\w+) (\\w+)\\[(\\d+)\\] = \\{', line)
+				if match and match.group(1) in TYPE_SIZES:
+					tables.append((match.group(2), TYPE_SIZES[match.group(1)] * int(match.group(3))))
+				
+				match = re.match('size_t CompressedStringDataLength = (\\d+);', line)
+				if match:
+					tables.append(('CompressedStringData', int(match.group(1)) + 1))
+
+	return tables
+
+if __name__ == '__main__':
+	parser = argparse.ArgumentParser(description='Prints the size of the Unicode tables compiled into the library.')
+	parser.add_argument(
+		'--output', '-o',
+		dest = 'output',
+		default = '',
+		help = 'also write the report to this file'
+	)
+	parser.add_argument(
+		'source',
+		help = 'path to source/unicodedatabase.c'
+	)
+	parser.add_argument(
+		'defines',
+		nargs = '*',
+		help = 'configuration macros, e.g. UTF8_EXCLUDE_NFKD=1'
+	)
+	args = parser.parse_args()
+
+	macros = dict()
+	for d in args.defines:
+		name, _, value = d.partition('=')
+		macros[name] = int(value) if value else 1
+
+	source_path = os.path.realpath(args.source)
+	conditions = parseConditions(os.path.join(os.path.dirname(source_path), 'unicodedatabase.h'), macros)
+	tables = parseTables(source_path, conditions)
+
+	report = 'Unicode database rodata footprint'
+	if len(args.defines) > 0:
+		report += ' (' + ' '.join(args.defines) + ')'
+	report += ':\n'
+
+	for name, size in tables:
+		report += '  %-24s %8d B\n' % (name, size)
+	report += '  %-24s %8d B\n' % ('Total', sum([size for name, size in tables]))
+
+	sys.stdout.write(report)
+
+	if args.output:
+		with open(args.output, 'w') as f:
+			f.write(report)
@@ -2,6 +2,10 @@
 	'includes': [
 		'build/common.gypi',
 	],
+	'variables': {
+		# Leave Unicode data out of the library, e.g. -Dutf8_exclude="UTF8_EXCLUDE_NFKC=1 UTF8_EXCLUDE_NFKD=1"
+		'utf8_exclude%': '',
+	},
 	'targets': [
 		{
 			'target_name': 'utf8rewind',
@@ -9,8 +13,34 @@
 			'include_dirs': [
 				'include/utf8rewind',
 			],
+			'defines': [
+				'<@(utf8_exclude)',
+			],
+			'actions': [
+				{
+					'action_name': 'footprint',
+					'message': 'Measuring Unicode database footprint',
+					'inputs': [
+						'tools/footprint/footprint.py',
+						'source/unicodedatabase.c',
+						'source/unicodedatabase.h',
+					],
+					'outputs': [
+						'<(INTERMEDIATE_DIR)/unicodedatabase-footprint.txt',
+					],
+					'action': [
+						'python',
+						'tools/footprint/footprint.py',
+						'--output', '<(INTERMEDIATE_DIR)/unicodedatabase-footprint.txt',
+						'source/unicodedatabase.c',
+						'<@(utf8_exclude)',
+					],
+				},
+			],
 			'sources': [
 				'include/utf8rewind/utf8rewind.h',
+				'source/internal/allocation.c',
+				'source/internal/allocation.h',
 				'source/internal/base.h',
 				'source/internal/casemapping.c',
 				'source/internal/casemapping.h',
@@ -18,14 +48,24 @@
 				'source/internal/codepoint.h',
 				'source/internal/composition.c',
 				'source/internal/composition.h',
+				'source/internal/conversion.c',
+				'source/internal/conversion.h',
 				'source/internal/database.c',
 				'source/internal/database.h',
 				'source/internal/decomposition.c',
 				'source/internal/decomposition.h',
+				'source/internal/length.c',
+				'source/internal/length.h',
+				'source/internal/parallel.c',
+				'source/internal/parallel.h',
 				'source/internal/seeking.c',
 				'source/internal/seeking.h',
+				'source/internal/simd.c',
+				'source/internal/simd.h',
 				'source/internal/streaming.c',
 				'source/internal/streaming.h',
+				'source/internal/validation.c',
+				'source/internal/validation.h',
 				'source/unicodedatabase.c',
 				'source/unicodedatabase.h',
 				'source/utf8rewind.c',
@@ -34,6 +74,9 @@
 				'include_dirs': [
 					'include/utf8rewind',
 				],
+				'defines': [
+					'<@(utf8_exclude)',
+				],
 			},
 			'conditions': [
 				['OS=="win"', {
@@ -65,6 +108,8 @@
 				'source/helpers/helpers-locale.hpp',
 				'source/helpers/helpers-normalization.cpp',
 				'source/helpers/helpers-normalization.hpp',
+				'source/helpers/helpers-random.cpp',
+				'source/helpers/helpers-random.hpp',
 				'source/helpers/helpers-seeking.cpp',
 				'source/helpers/helpers-seeking.hpp',
 				'source/helpers/helpers-streams.cpp',
@@ -102,7 +147,11 @@
 				'source/tests/suite-codepoint-read.cpp',
 				'source/tests/suite-codepoint-write.cpp',
 				'source/tests/suite-compose-execute.cpp',
+				'source/tests/suite-conversion-parallel.cpp',
+				'source/tests/suite-conversion-size.cpp',
+				'source/tests/suite-database-querycasemapping.cpp',
 				'source/tests/suite-database-querycomposition.cpp',
+				'source/tests/suite-database-queryproperties.cpp',
 				'source/tests/suite-database-querydecomposition.cpp',
 				'source/tests/suite-decompose-execute.cpp',
 				'source/tests/suite-stream-read.cpp',
@@ -110,21 +159,31 @@
 				'source/tests/suite-stream-write.cpp',
 				'source/tests/suite-utf16-toutf8.cpp',
 				'source/tests/suite-utf32-toutf8.cpp',
+				'source/tests/suite-utf8-alloc.cpp',
+				'source/tests/suite-utf8-casecmp.cpp',
 				'source/tests/suite-utf8-casefold.cpp',
+				'source/tests/suite-utf8-casefold-hash.cpp',
 				'source/tests/suite-utf8-casefold-turkish.cpp',
+				'source/tests/suite-utf8-cursor.cpp',
 				'source/tests/suite-utf8-envlocale.cpp',
+				'source/tests/suite-utf8-exclude.cpp',
+				'source/tests/suite-utf8-inplace.cpp',
 				'source/tests/suite-utf8-iscategory.cpp',
 				'source/tests/suite-utf8-isnormalized-compose.cpp',
 				'source/tests/suite-utf8-isnormalized-decompose.cpp',
 				'source/tests/suite-utf8-isnormalized.cpp',
 				'source/tests/suite-utf8-len.cpp',
+				'source/tests/suite-utf8-loaddatabase.cpp',
+				'source/tests/suite-utf8-nlen.cpp',
 				'source/tests/suite-utf8-normalize-compose.cpp',
 				'source/tests/suite-utf8-normalize-decompose.cpp',
 				'source/tests/suite-utf8-normalize.cpp',
+				'source/tests/suite-utf8-resumable.cpp',
 				'source/tests/suite-utf8-seek-current.cpp',
 				'source/tests/suite-utf8-seek-current-backwards.cpp',
 				'source/tests/suite-utf8-seek-current-forward.cpp',
 				'source/tests/suite-utf8-seek-end.cpp',
+				'source/tests/suite-utf8-seek-indexed.cpp',
 				'source/tests/suite-utf8-seek-set.cpp',
 				'source/tests/suite-utf8-seek.cpp',
 				'source/tests/suite-utf8-tolower.cpp',
@@ -142,6 +201,7 @@
 				'source/tests/suite-utf8-toutf16.cpp',
 				'source/tests/suite-utf8-toutf32.cpp',
 				'source/tests/suite-utf8-towide.cpp',
+				'source/tests/suite-utf8-validate.cpp',
 				'source/tests/suite-wide-toutf8.cpp',
 				'source/tests/tests-base.hpp',
 				'source/tests/tests-main.cpp',
@@ -150,6 +210,11 @@
 				['OS!="win"', {
 					'product_dir': 'output/<(platform_name)/<(architecture_name)/<(CONFIGURATION_NAME)',
 				}],
+				['OS=="linux"', {
+					# std::thread is used for running conversions in parallel
+					'cflags': [ '-pthread' ],
+					'ldflags': [ '-pthread' ],
+				}],
 			],
 		},
 		{
@@ -193,21 +258,30 @@
 				'source/performance/performance-big-seeking.cpp',
 				'source/performance/performance-casemapping.cpp',
 				'source/performance/performance-category.cpp',
+				'source/performance/performance-codepoint.cpp',
 				'source/performance/performance-conversion.cpp',
+				'source/performance/performance-database-file.cpp',
 				'source/performance/performance-database.cpp',
 				'source/performance/performance-greek-casemapping.cpp',
 				'source/performance/performance-greek-category.cpp',
 				'source/performance/performance-greek-conversion.cpp',
 				'source/performance/performance-greek-normalization.cpp',
 				'source/performance/performance-greek-seeking.cpp',
+				'source/performance/performance-length.cpp',
 				'source/performance/performance-main.cpp',
 				'source/performance/performance-normalization.cpp',
 				'source/performance/performance-properties.cpp',
+				'source/performance/performance-validation.cpp',
 			],
 			'conditions': [
 				['OS!="win"', {
 					'product_dir': 'output/<(platform_name)/<(architecture_name)/<(CONFIGURATION_NAME)',
 				}],
+				['OS=="linux"', {
+					# std::thread is used for running conversions in parallel
+					'cflags': [ '-pthread' ],
+					'ldflags': [ '-pthread' ],
+				}],
 			],
 		},
 		{